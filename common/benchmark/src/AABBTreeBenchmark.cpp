@@ -37,6 +37,8 @@
 
 #include <vecmath/bbox.h>
 
+#include <vector>
+
 #include "BenchmarkUtils.h"
 #include "../../test/src/Catch2.h"
 
@@ -69,4 +71,74 @@ namespace TrenchBroom {
             }
         }, "Add objects to AABB tree");
     }
+
+    TEST_CASE("AABBTreeBenchmark.benchMoveNodes", "[AABBTreeBenchmark]") {
+        const auto mapPath = IO::Disk::getCurrentWorkingDir() + IO::Path("fixture/benchmark/AABBTree/ne_ruins.map");
+        const auto file = IO::Disk::openFile(mapPath);
+        auto fileReader = file->reader().buffer();
+
+        IO::TestParserStatus status;
+        IO::WorldReader worldReader(fileReader.stringView(), Model::MapFormat::Standard, {});
+
+        const vm::bbox3 worldBounds(8192.0);
+        auto world = worldReader.read(worldBounds, status);
+
+        auto nodes = std::vector<Model::Node*>{};
+        world->accept(kdl::overload(
+            [] (auto&& thisLambda, Model::WorldNode* world_)  { world_->visitChildren(thisLambda); },
+            [] (auto&& thisLambda, Model::LayerNode* layer)   { layer->visitChildren(thisLambda); },
+            [] (auto&& thisLambda, Model::GroupNode* group)   { group->visitChildren(thisLambda); },
+            [&](auto&& thisLambda, Model::EntityNode* entity) { entity->visitChildren(thisLambda); nodes.push_back(entity); },
+            [&](Model::BrushNode* brush)                      { nodes.push_back(brush); },
+            [&](Model::PatchNode* patch)                      { nodes.push_back(patch); }
+        ));
+
+        // move every tenth node back and forth, as when dragging a selection around
+        auto movedNodes = std::vector<Model::Node*>{};
+        for (size_t i = 0; i < nodes.size(); i += 10) {
+            movedNodes.push_back(nodes[i]);
+        }
+
+        const auto getBounds = [](const auto* node) { return node->physicalBounds(); };
+
+        const auto movedBounds = [](const Model::Node* node, const size_t round) {
+            const auto delta = vm::vec3(16.0, 8.0, 0.0) * static_cast<FloatType>(round % 2u == 0u ? 1.0 : 0.0);
+            return node->physicalBounds().translate(delta);
+        };
+
+        const auto rounds = size_t(100);
+
+        auto removeInsertTree = AABB{};
+        removeInsertTree.clearAndBuild(nodes, getBounds);
+        timeLambda([&]() {
+            for (size_t round = 0; round < rounds; ++round) {
+                for (auto* node : movedNodes) {
+                    removeInsertTree.remove(node);
+                    removeInsertTree.insert(movedBounds(node, round), node);
+                }
+            }
+        }, "Move nodes by removing and inserting them");
+
+        auto updateTree = AABB{};
+        updateTree.clearAndBuild(nodes, getBounds);
+        timeLambda([&]() {
+            for (size_t round = 0; round < rounds; ++round) {
+                for (auto* node : movedNodes) {
+                    updateTree.update(movedBounds(node, round), node);
+                }
+            }
+        }, "Move nodes by updating them");
+
+        auto updateAllTree = AABB{};
+        updateAllTree.clearAndBuild(nodes, getBounds);
+        timeLambda([&]() {
+            for (size_t round = 0; round < rounds; ++round) {
+                updateAllTree.updateAll(movedNodes, [&](const auto* node) { return movedBounds(node, round); });
+            }
+        }, "Move nodes by updating them in a batch");
+
+        const auto query = removeInsertTree.bounds();
+        CHECK(updateTree.findIntersectors(query).size() == removeInsertTree.findIntersectors(query).size());
+        CHECK(updateAllTree.findIntersectors(query).size() == removeInsertTree.findIntersectors(query).size());
+    }
 }
@@ -0,0 +1,139 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BenchmarkResults.h"
+
+#include "Exceptions.h"
+#include "EL/EvaluationContext.h"
+#include "EL/Expression.h"
+#include "EL/Value.h"
+#include "IO/ELParser.h"
+
+#include <cstdio>
+#include <sstream>
+#include <unordered_map>
+
+namespace TrenchBroom {
+    BenchmarkResults& BenchmarkResults::instance() {
+        static BenchmarkResults instance;
+        return instance;
+    }
+
+    void BenchmarkResults::add(std::string name, const double milliseconds) {
+        m_results.push_back(BenchmarkResult{std::move(name), milliseconds});
+    }
+
+    const std::vector<BenchmarkResult>& BenchmarkResults::results() const {
+        return m_results;
+    }
+
+    void BenchmarkResults::addMemoryUsage(std::string name, const size_t bytes) {
+        m_memoryUsage.push_back(BenchmarkMemoryUsage{std::move(name), bytes});
+    }
+
+    const std::vector<BenchmarkMemoryUsage>& BenchmarkResults::memoryUsage() const {
+        return m_memoryUsage;
+    }
+
+    static std::string escapeJsonString(const std::string& str) {
+        auto result = std::string{};
+        result.reserve(str.size());
+        for (const auto c : str) {
+            switch (c) {
+                case '"':
+                    result += "\\\"";
+                    break;
+                case '\\':
+                    result += "\\\\";
+                    break;
+                case '\n':
+                    result += "\\n";
+                    break;
+                case '\t':
+                    result += "\\t";
+                    break;
+                default:
+                    result += c;
+                    break;
+            }
+        }
+        return result;
+    }
+
+    std::string writeBenchmarkResults(const std::vector<BenchmarkResult>& results, const std::vector<BenchmarkMemoryUsage>& memoryUsage) {
+        auto str = std::stringstream{};
+        str << "{\n";
+        str << "    \"version\": 1,\n";
+        str << "    \"results\": [";
+        for (size_t i = 0u; i < results.size(); ++i) {
+            char milliseconds[64];
+            std::snprintf(milliseconds, sizeof(milliseconds), "%.3f", results[i].milliseconds);
+
+            str << (i == 0u ? "\n" : ",\n");
+            str << "        { \"name\": \"" << escapeJsonString(results[i].name) << "\", \"milliseconds\": " << milliseconds << " }";
+        }
+        str << "\n    ],\n";
+        str << "    \"memory\": [";
+        for (size_t i = 0u; i < memoryUsage.size(); ++i) {
+            str << (i == 0u ? "\n" : ",\n");
+            str << "        { \"name\": \"" << escapeJsonString(memoryUsage[i].name) << "\", \"bytes\": " << memoryUsage[i].bytes << " }";
+        }
+        str << "\n    ]\n";
+        str << "}\n";
+        return str.str();
+    }
+
+    std::vector<BenchmarkResult> readBenchmarkResults(const std::string_view str) {
+        auto parser = IO::ELParser{IO::ELParser::Mode::Strict, str};
+        const auto root = parser.parse().evaluate(EL::EvaluationContext());
+
+        const auto version = root["version"].numberValue();
+        if (version != 1.0) {
+            throw ParserException("Unsupported benchmark results version: " + std::to_string(version));
+        }
+
+        const auto resultsValue = root["results"];
+
+        auto results = std::vector<BenchmarkResult>{};
+        for (const auto& result : resultsValue.arrayValue()) {
+            results.push_back(BenchmarkResult{result["name"].stringValue(), result["milliseconds"].numberValue()});
+        }
+        return results;
+    }
+
+    std::vector<BenchmarkRegression> compareBenchmarkResults(const std::vector<BenchmarkResult>& baseline, const std::vector<BenchmarkResult>& current, const double tolerance, const double minimumDifferenceMilliseconds) {
+        auto baselineByName = std::unordered_map<std::string, double>{};
+        for (const auto& result : baseline) {
+            baselineByName[result.name] = result.milliseconds;
+        }
+
+        auto regressions = std::vector<BenchmarkRegression>{};
+        for (const auto& result : current) {
+            const auto it = baselineByName.find(result.name);
+            if (it != std::end(baselineByName)) {
+                const auto baselineMilliseconds = it->second;
+                if (result.milliseconds - baselineMilliseconds > minimumDifferenceMilliseconds &&
+                    result.milliseconds > baselineMilliseconds * (1.0 + tolerance)) {
+                    regressions.push_back(BenchmarkRegression{result.name, baselineMilliseconds, result.milliseconds});
+                }
+            }
+        }
+        return regressions;
+    }
+}
@@ -0,0 +1,83 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace TrenchBroom {
+    struct BenchmarkResult {
+        std::string name;
+        double milliseconds;
+    };
+
+    struct BenchmarkMemoryUsage {
+        std::string name;
+        size_t bytes;
+    };
+
+    struct BenchmarkRegression {
+        std::string name;
+        double baselineMilliseconds;
+        double currentMilliseconds;
+    };
+
+    /**
+     * Collects the timings measured by timeLambda so that they can be written to a file and compared against a
+     * baseline after all benchmarks have run. Benchmarks can also record the memory used by the data they operate on.
+     */
+    class BenchmarkResults {
+    private:
+        std::vector<BenchmarkResult> m_results;
+        std::vector<BenchmarkMemoryUsage> m_memoryUsage;
+    public:
+        static BenchmarkResults& instance();
+
+        void add(std::string name, double milliseconds);
+        const std::vector<BenchmarkResult>& results() const;
+
+        void addMemoryUsage(std::string name, size_t bytes);
+        const std::vector<BenchmarkMemoryUsage>& memoryUsage() const;
+    };
+
+    /**
+     * Returns the given results as a JSON document of the form
+     *
+     * { "version": 1, "results": [ { "name": "...", "milliseconds": 1.234 }, ... ], "memory": [ { "name": "...", "bytes": 1234 }, ... ] }
+     *
+     * The memory usage is informational only, it is not compared against baselines.
+     */
+    std::string writeBenchmarkResults(const std::vector<BenchmarkResult>& results, const std::vector<BenchmarkMemoryUsage>& memoryUsage = {});
+
+    /**
+     * Parses a JSON document written by writeBenchmarkResults.
+     *
+     * @throws ParserException if the given string cannot be parsed
+     */
+    std::vector<BenchmarkResult> readBenchmarkResults(std::string_view str);
+
+    /**
+     * Returns the results which took longer than their baseline by more than the given relative tolerance. Results
+     * without a baseline and changes of less than the given minimum absolute difference are ignored.
+     */
+    std::vector<BenchmarkRegression> compareBenchmarkResults(const std::vector<BenchmarkResult>& baseline, const std::vector<BenchmarkResult>& current, double tolerance, double minimumDifferenceMilliseconds = 1.0);
+}
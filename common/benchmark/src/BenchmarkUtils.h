@@ -19,6 +19,8 @@
 
 #pragma once
 
+#include "BenchmarkResults.h"
+
 #include <chrono>
 #include <string>
 
@@ -35,8 +37,10 @@ TB_NOINLINE static void timeLambda(L&& lambda, const std::string& message) {
     lambda();
     const auto end = std::chrono::high_resolution_clock::now();
 
-    printf("Time elapsed for '%s': %fms\n", message.c_str(),
-           std::chrono::duration<double>(end - start).count() * 1000.0);
+    const auto milliseconds = std::chrono::duration<double>(end - start).count() * 1000.0;
+    printf("Time elapsed for '%s': %fms\n", message.c_str(), milliseconds);
+
+    TrenchBroom::BenchmarkResults::instance().add(message, milliseconds);
 }
 
 
@@ -0,0 +1,66 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "IO/NodeWriter.h"
+#include "IO/TestParserStatus.h"
+#include "IO/WorldReader.h"
+#include "Model/EntityProperties.h"
+#include "Model/LayerNode.h"
+#include "Model/MapFormat.h"
+#include "Model/WorldNode.h"
+
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "BenchmarkUtils.h"
+#include "SyntheticMap.h"
+#include "../../test/src/Catch2.h"
+
+namespace TrenchBroom {
+    namespace IO {
+        TEST_CASE("MapSerializationBenchmark.writeMap", "[MapSerializationBenchmark]") {
+            const auto brushCount = benchmarkBrushCount();
+            const auto world = makeSyntheticWorld(brushCount);
+
+            auto str = std::stringstream{};
+            timeLambda([&]() {
+                NodeWriter writer(*world, str);
+                writer.writeMap();
+            }, "write synthetic map with " + std::to_string(brushCount) + " brushes");
+
+            CHECK_FALSE(str.str().empty());
+        }
+
+        TEST_CASE("MapSerializationBenchmark.readMap", "[MapSerializationBenchmark]") {
+            const auto brushCount = benchmarkBrushCount();
+            const auto map = makeSyntheticMap(brushCount);
+
+            TestParserStatus status;
+            std::unique_ptr<Model::WorldNode> world;
+            timeLambda([&]() {
+                WorldReader worldReader(map, Model::MapFormat::Standard, Model::EntityPropertyConfig{});
+                world = worldReader.read(syntheticMapWorldBounds(), status);
+            }, "read synthetic map with " + std::to_string(brushCount) + " brushes");
+
+            REQUIRE(world != nullptr);
+            CHECK(world->defaultLayer()->childCount() == makeSyntheticWorld(brushCount)->defaultLayer()->childCount());
+        }
+    }
+}
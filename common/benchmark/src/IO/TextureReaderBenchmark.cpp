@@ -0,0 +1,127 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Logger.h"
+#include "Assets/Palette.h"
+#include "Assets/Texture.h"
+#include "Assets/TextureBuffer.h"
+#include "IO/DiskIO.h"
+#include "IO/DiskFileSystem.h"
+#include "IO/File.h"
+#include "IO/IdMipTextureReader.h"
+#include "IO/Path.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "../../test/src/Catch2.h"
+
+namespace TrenchBroom {
+    namespace IO {
+        static constexpr size_t NumMipTextures = 512;
+        static constexpr size_t MipTextureSize = 128;
+        static constexpr size_t MipLevels = 4;
+
+        static void appendInt32(std::vector<char>& data, const size_t value) {
+            const auto i = static_cast<int32_t>(value);
+            char bytes[sizeof(i)];
+            std::memcpy(bytes, &i, sizeof(i));
+            data.insert(std::end(data), std::begin(bytes), std::end(bytes));
+        }
+
+        /**
+         * Creates the contents of a mip texture as stored in a WAD file, with random palette indices for every pixel.
+         */
+        static std::vector<char> makeMipTexture(const std::string& name, const size_t width, const size_t height, std::mt19937& random) {
+            static constexpr size_t NameLength = 16u;
+            static constexpr size_t HeaderSize = NameLength + (2u + MipLevels) * sizeof(int32_t);
+
+            auto data = std::vector<char>{};
+
+            auto nameBytes = std::vector<char>(NameLength, '\0');
+            std::copy_n(std::begin(name), std::min(name.size(), NameLength - 1u), std::begin(nameBytes));
+            data.insert(std::end(data), std::begin(nameBytes), std::end(nameBytes));
+
+            appendInt32(data, width);
+            appendInt32(data, height);
+
+            auto offset = HeaderSize;
+            for (size_t level = 0u; level < MipLevels; ++level) {
+                appendInt32(data, offset);
+                const auto size = Assets::sizeAtMipLevel(width, height, level);
+                offset += size.x() * size.y();
+            }
+
+            while (data.size() < offset) {
+                data.push_back(static_cast<char>(random() & 0xFFu));
+            }
+
+            return data;
+        }
+
+        TEST_CASE("TextureReaderBenchmark.readMipTextures", "[TextureReaderBenchmark]") {
+            auto random = std::mt19937{0u};
+
+            // a grayscale ramp, the actual colors don't matter for decoding
+            auto paletteData = std::vector<unsigned char>{};
+            for (size_t i = 0u; i < 256u; ++i) {
+                paletteData.insert(std::end(paletteData), 3u, static_cast<unsigned char>(i));
+            }
+            const auto palette = Assets::Palette{paletteData};
+
+            auto textureData = std::vector<std::vector<char>>{};
+            auto files = std::vector<std::shared_ptr<File>>{};
+            textureData.reserve(NumMipTextures);
+            files.reserve(NumMipTextures);
+            for (size_t i = 0u; i < NumMipTextures; ++i) {
+                const auto name = "texture" + std::to_string(i);
+                const auto& data = textureData.emplace_back(makeMipTexture(name, MipTextureSize, MipTextureSize, random));
+                files.push_back(std::make_shared<NonOwningBufferFile>(Path{name + ".D"}, data.data(), data.data() + data.size()));
+            }
+
+            auto fs = DiskFileSystem{Disk::getCurrentWorkingDir()};
+            auto logger = NullLogger{};
+            const auto nameStrategy = TextureReader::TextureNameStrategy{};
+            const auto textureReader = IdMipTextureReader{nameStrategy, fs, logger, palette};
+
+            auto textures = std::vector<Assets::Texture>{};
+            textures.reserve(NumMipTextures);
+            timeLambda([&]() {
+                for (const auto& file : files) {
+                    textures.push_back(textureReader.readTexture(file));
+                }
+            }, "decode " + std::to_string(NumMipTextures) + " mip textures of " + std::to_string(MipTextureSize) + "x" + std::to_string(MipTextureSize) + " pixels");
+
+            REQUIRE(textures.size() == NumMipTextures);
+            for (size_t i = 0u; i < NumMipTextures; ++i) {
+                // the reader returns a default texture if decoding fails
+                CHECK(textures[i].name() == "texture" + std::to_string(i));
+                CHECK(textures[i].width() == MipTextureSize);
+                CHECK(textures[i].height() == MipTextureSize);
+                CHECK(textures[i].buffersIfUnprepared().size() == MipLevels);
+            }
+        }
+    }
+}
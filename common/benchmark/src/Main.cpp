@@ -17,6 +17,94 @@
  along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
  */
 
-// Hack to reuse the same main() function as the test suite
+#define CATCH_CONFIG_RUNNER
+
+// Hack to reuse the same preference manager as the test suite
 #include "../../test/src/TestPreferenceManager.cpp"
-#include "../../test/src/RunAllTests.cpp"
+
+#include "BenchmarkResults.h"
+#include "Ensure.h"
+#include "Exceptions.h"
+#include "SyntheticMap.h"
+#include "TrenchBroomApp.h"
+#include "IO/IOUtils.h"
+#include "IO/Path.h"
+
+#include <clocale>
+#include <cstdio>
+#include <iterator>
+#include <string>
+
+#include "../../test/src/Catch2.h"
+
+/**
+ * Runs the benchmarks like the test suite does. In addition to Catch's own options, the following options are
+ * supported:
+ *
+ * --brushes <count>     the number of brushes in the synthetic maps, defaults to 1000
+ * --json <path>         write the results of all timed benchmarks to the given JSON file
+ * --baseline <path>     compare the results to a JSON file written by a previous run and fail if any benchmark
+ *                       is slower than its baseline by more than the tolerance
+ * --tolerance <ratio>   the relative tolerance for the comparison, defaults to 0.2
+ */
+int main(int argc, char **argv) {
+    TrenchBroom::PreferenceManager::createInstance<TrenchBroom::TestPreferenceManager>();
+    TrenchBroom::View::TrenchBroomApp app(argc, argv);
+
+    TrenchBroom::View::setCrashReportGUIEnbled(false);
+
+    ensure(qApp == &app, "invalid app instance");
+
+    // set the locale to US so that we can parse floats attribute
+    std::setlocale(LC_NUMERIC, "C");
+
+    auto session = Catch::Session{};
+
+    auto brushCount = TrenchBroom::benchmarkBrushCount();
+    auto jsonPath = std::string{};
+    auto baselinePath = std::string{};
+    auto tolerance = 0.2;
+
+    using namespace Catch::clara;
+    session.cli(session.cli()
+        | Opt(brushCount, "count")["--brushes"]("number of brushes in the synthetic maps")
+        | Opt(jsonPath, "path")["--json"]("write the benchmark results to a JSON file")
+        | Opt(baselinePath, "path")["--baseline"]("compare the benchmark results to a JSON file")
+        | Opt(tolerance, "ratio")["--tolerance"]("relative tolerance when comparing to the baseline"));
+
+    if (const auto result = session.applyCommandLine(argc, argv); result != 0) {
+        return result;
+    }
+
+    TrenchBroom::setBenchmarkBrushCount(brushCount);
+
+    auto result = session.run();
+
+    const auto& results = TrenchBroom::BenchmarkResults::instance().results();
+    if (!jsonPath.empty()) {
+        auto stream = TrenchBroom::IO::openPathAsOutputStream(TrenchBroom::IO::Path(jsonPath));
+        stream << TrenchBroom::writeBenchmarkResults(results, TrenchBroom::BenchmarkResults::instance().memoryUsage());
+        std::printf("Wrote %zu benchmark results to '%s'\n", results.size(), jsonPath.c_str());
+    }
+
+    if (!baselinePath.empty()) {
+        auto stream = TrenchBroom::IO::openPathAsInputStream(TrenchBroom::IO::Path(baselinePath));
+        const auto str = std::string{std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{}};
+
+        try {
+            const auto baseline = TrenchBroom::readBenchmarkResults(str);
+            const auto regressions = TrenchBroom::compareBenchmarkResults(baseline, results, tolerance);
+            for (const auto& regression : regressions) {
+                std::printf("Regression in '%s': %fms (baseline %fms)\n", regression.name.c_str(), regression.currentMilliseconds, regression.baselineMilliseconds);
+            }
+            if (!regressions.empty()) {
+                result = 1;
+            }
+        } catch (const TrenchBroom::Exception& e) {
+            std::printf("Could not read baseline '%s': %s\n", baselinePath.c_str(), e.what());
+            result = 1;
+        }
+    }
+
+    return result;
+}
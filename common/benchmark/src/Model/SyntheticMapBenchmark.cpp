@@ -0,0 +1,404 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Logger.h"
+#include "MemoryReport.h"
+#include "Assets/Texture.h"
+#include "Assets/TextureCollection.h"
+#include "Assets/TextureManager.h"
+#include "IO/TestParserStatus.h"
+#include "IO/WorldReader.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushError.h"
+#include "Model/BrushFace.h"
+#include "Model/BrushNode.h"
+#include "Model/ConvexPolyhedronSnapshot.h"
+#include "Model/EditorContext.h"
+#include "Model/EntityNode.h"
+#include "Model/EntityProperties.h"
+#include "Model/Group.h"
+#include "Model/GroupNode.h"
+#include "Model/Issue.h"
+#include "Model/LayerNode.h"
+#include "Model/MapFormat.h"
+#include "Model/ModelUtils.h"
+#include "Model/NonIntegerVerticesIssueGenerator.h"
+#include "Model/PatchNode.h"
+#include "Model/PickResult.h"
+#include "Model/Polyhedron.h"
+#include "Model/Tag.h"
+#include "Model/TagManager.h"
+#include "Model/TagMatcher.h"
+#include "Model/UpdateLinkedGroupsError.h"
+#include "Model/WorldBoundsIssueGenerator.h"
+#include "Model/WorldNode.h"
+
+#include <kdl/overload.h>
+#include <kdl/result.h>
+#include <kdl/vector_utils.h>
+
+#include <vecmath/bbox.h>
+#include <vecmath/ray.h>
+#include <vecmath/vec.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "BenchmarkResults.h"
+#include "BenchmarkUtils.h"
+#include "SyntheticMap.h"
+#include "../../test/src/Catch2.h"
+
+namespace TrenchBroom {
+    namespace Model {
+        TEST_CASE("SyntheticMapBenchmark.createBrushes", "[SyntheticMapBenchmark]") {
+            const auto brushCount = benchmarkBrushCount();
+            const auto worldBounds = syntheticMapWorldBounds();
+            const auto allBounds = makeSyntheticBrushBounds(brushCount);
+            const auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+            auto brushes = std::vector<Brush>{};
+            brushes.reserve(brushCount);
+            timeLambda([&]() {
+                for (const auto& bounds : allBounds) {
+                    brushes.push_back(builder.createCuboid(bounds, "texture").value());
+                }
+            }, "create " + std::to_string(brushCount) + " cuboid brushes");
+
+            auto rebuilt = std::vector<Brush>{};
+            rebuilt.reserve(brushCount);
+            timeLambda([&]() {
+                for (const auto& brush : brushes) {
+                    rebuilt.push_back(Brush::create(worldBounds, brush.faces()).value());
+                }
+            }, "rebuild geometry of " + std::to_string(brushCount) + " brushes");
+
+            CHECK(rebuilt.size() == brushCount);
+        }
+
+        TEST_CASE("SyntheticMapBenchmark.subtractBrushes", "[SyntheticMapBenchmark]") {
+            const auto brushCount = benchmarkBrushCount();
+            const auto worldBounds = syntheticMapWorldBounds();
+            const auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+            // subtract a brush that overlaps one corner of each brush
+            auto pairs = std::vector<std::pair<Brush, Brush>>{};
+            pairs.reserve(brushCount);
+            for (const auto& bounds : makeSyntheticBrushBounds(brushCount)) {
+                const auto subtrahendBounds = bounds.translate(bounds.size() / 2.0);
+                pairs.emplace_back(builder.createCuboid(bounds, "texture").value(), builder.createCuboid(subtrahendBounds, "texture").value());
+            }
+
+            auto fragmentCount = size_t(0);
+            timeLambda([&]() {
+                for (const auto& [minuend, subtrahend] : pairs) {
+                    fragmentCount += minuend.subtract(MapFormat::Standard, worldBounds, "texture", subtrahend).size();
+                }
+            }, "subtract " + std::to_string(brushCount) + " brushes");
+
+            CHECK(fragmentCount > 0u);
+        }
+
+        TEST_CASE("SyntheticMapBenchmark.intersectPolyhedra", "[SyntheticMapBenchmark]") {
+            const auto pairCount = benchmarkBrushCount();
+            const auto pairs = makeSyntheticPolyhedronPairs(pairCount);
+
+            auto expectedIntersections = std::vector<bool>{};
+            auto expectedContainments = std::vector<bool>{};
+            expectedIntersections.reserve(pairCount);
+            expectedContainments.reserve(pairCount);
+            timeLambda([&]() {
+                for (const auto& [lhs, rhs] : pairs) {
+                    expectedIntersections.push_back(lhs.intersects(rhs));
+                    expectedContainments.push_back(lhs.contains(rhs));
+                }
+            }, "intersect and contain " + std::to_string(pairCount) + " pairs of polyhedra");
+
+            auto snapshots = std::vector<std::pair<ConvexPolyhedronSnapshot, ConvexPolyhedronSnapshot>>{};
+            snapshots.reserve(pairCount);
+            timeLambda([&]() {
+                for (const auto& [lhs, rhs] : pairs) {
+                    snapshots.emplace_back(ConvexPolyhedronSnapshot(lhs), ConvexPolyhedronSnapshot(rhs));
+                }
+            }, "create snapshots of " + std::to_string(pairCount) + " pairs of polyhedra");
+
+            auto intersections = std::vector<bool>{};
+            auto containments = std::vector<bool>{};
+            intersections.reserve(pairCount);
+            containments.reserve(pairCount);
+            timeLambda([&]() {
+                for (const auto& [lhs, rhs] : snapshots) {
+                    intersections.push_back(lhs.intersects(rhs));
+                    containments.push_back(lhs.contains(rhs));
+                }
+            }, "intersect and contain " + std::to_string(pairCount) + " pairs of polyhedron snapshots");
+
+            CHECK(intersections == expectedIntersections);
+            CHECK(containments == expectedContainments);
+        }
+
+        TEST_CASE("SyntheticMapBenchmark.loadMap", "[SyntheticMapBenchmark]") {
+            const auto brushCount = benchmarkBrushCount();
+            const auto map = makeSyntheticMap(brushCount);
+
+            auto logger = NullLogger{};
+            auto textureManager = Assets::TextureManager(0, 0, logger);
+            {
+                auto textures = std::vector<Assets::Texture>{};
+                for (size_t i = 0u; i < 64u; ++i) {
+                    textures.emplace_back("synthetic/texture" + std::to_string(i), 16, 16);
+                }
+                textures.front().setSurfaceParms({"liquid"});
+
+                auto collections = std::vector<Assets::TextureCollection>{};
+                collections.emplace_back(std::move(textures));
+                textureManager.setTextureCollections(std::move(collections));
+            }
+
+            auto tagManager = TagManager{};
+            tagManager.registerSmartTags({
+                SmartTag("texture", {}, std::make_unique<TextureNameTagMatcher>("synthetic/texture1*")),
+                SmartTag("liquid", {}, std::make_unique<SurfaceParmTagMatcher>("liquid")),
+                SmartTag("light", {}, std::make_unique<EntityClassNameTagMatcher>("light", ""))
+            });
+
+            const auto readWorld = [&]() {
+                auto status = IO::TestParserStatus{};
+                auto worldReader = IO::WorldReader{map, MapFormat::Standard, EntityPropertyConfig{}};
+                return worldReader.read(syntheticMapWorldBounds(), status);
+            };
+
+            // one whole map traversal per pass, as MapDocument used to initialize a loaded world
+            auto serialWorld = std::unique_ptr<WorldNode>{};
+            timeLambda([&]() {
+                serialWorld = readWorld();
+                serialWorld->accept(kdl::overload(
+                    [] (auto&& thisLambda, WorldNode* world)   { world->visitChildren(thisLambda); },
+                    [] (auto&& thisLambda, LayerNode* layer)   { layer->visitChildren(thisLambda); },
+                    [] (auto&& thisLambda, GroupNode* group)   { group->visitChildren(thisLambda); },
+                    [] (auto&& thisLambda, EntityNode* entity) { entity->visitChildren(thisLambda); },
+                    [&](BrushNode* brushNode) {
+                        for (size_t i = 0u; i < brushNode->brush().faceCount(); ++i) {
+                            brushNode->setFaceTexture(i, textureManager.texture(brushNode->brush().face(i).attributes().textureName()));
+                        }
+                    },
+                    [&](PatchNode* patchNode) { patchNode->setTexture(textureManager.texture(patchNode->patch().textureName())); }
+                ));
+                serialWorld->accept([&](auto&& thisLambda, Node* node) {
+                    node->initializeTags(tagManager);
+                    node->visitChildren(thisLambda);
+                });
+            }, "load synthetic map with " + std::to_string(brushCount) + " brushes, initializing nodes serially");
+
+            auto world = std::unique_ptr<WorldNode>{};
+            timeLambda([&]() {
+                world = readWorld();
+                initializeNodes(collectNodes({world.get()}), textureManager, tagManager);
+            }, "load synthetic map with " + std::to_string(brushCount) + " brushes, initializing nodes in parallel");
+
+            const auto serialNodes = collectNodes({serialWorld.get()});
+            const auto nodes = collectNodes({world.get()});
+            REQUIRE(nodes.size() == serialNodes.size());
+
+            const auto getTagMask = [](const auto* node) { return node->tagMask(); };
+            CHECK(kdl::vec_transform(nodes, getTagMask) == kdl::vec_transform(serialNodes, getTagMask));
+
+            const auto serialBrushNodes = filterBrushNodes(serialNodes);
+            const auto brushNodes = filterBrushNodes(nodes);
+            auto mismatchedFaceCount = size_t(0);
+            for (size_t i = 0u; i < brushNodes.size(); ++i) {
+                for (size_t j = 0u; j < brushNodes[i]->brush().faceCount(); ++j) {
+                    const auto& face = brushNodes[i]->brush().face(j);
+                    const auto& serialFace = serialBrushNodes[i]->brush().face(j);
+                    if (face.texture() != serialFace.texture() || face.tagMask() != serialFace.tagMask()) {
+                        ++mismatchedFaceCount;
+                    }
+                }
+            }
+            CHECK(mismatchedFaceCount == 0u);
+        }
+
+        TEST_CASE("SyntheticMapBenchmark.pick", "[SyntheticMapBenchmark]") {
+            const auto brushCount = benchmarkBrushCount();
+            const auto world = makeSyntheticWorld(brushCount);
+            const auto bounds = world->defaultLayer()->physicalBounds();
+            const auto editorContext = EditorContext{};
+
+            // cast rays along the X axis through a regular grid of points on the YZ plane
+            static const auto RayGridSize = 32u;
+            auto rays = std::vector<vm::ray3>{};
+            for (size_t i = 0u; i < RayGridSize; ++i) {
+                for (size_t j = 0u; j < RayGridSize; ++j) {
+                    const auto y = bounds.min.y() + bounds.size().y() * (static_cast<FloatType>(i) + 0.5) / RayGridSize;
+                    const auto z = bounds.min.z() + bounds.size().z() * (static_cast<FloatType>(j) + 0.5) / RayGridSize;
+                    rays.emplace_back(vm::vec3(bounds.min.x() - 1.0, y, z), vm::vec3::pos_x());
+                }
+            }
+
+            auto hitCount = size_t(0);
+            timeLambda([&]() {
+                for (const auto& ray : rays) {
+                    auto pickResult = PickResult::byDistance();
+                    world->pick(editorContext, ray, pickResult);
+                    hitCount += pickResult.size();
+                }
+            }, "pick " + std::to_string(rays.size()) + " rays in a map with " + std::to_string(brushCount) + " brushes");
+
+            CHECK(hitCount > 0u);
+        }
+
+        TEST_CASE("SyntheticMapBenchmark.selectNodes", "[SyntheticMapBenchmark]") {
+            const auto brushCount = benchmarkBrushCount();
+            const auto world = makeSyntheticWorld(brushCount);
+            const auto editorContext = EditorContext{};
+
+            auto selectableNodes = std::vector<Node*>{};
+            timeLambda([&]() {
+                selectableNodes = collectSelectableNodes({world.get()}, editorContext);
+                for (auto* node : selectableNodes) {
+                    node->select();
+                }
+            }, "select all nodes of a map with " + std::to_string(brushCount) + " brushes");
+
+            auto selectionBounds = vm::bbox3{};
+            timeLambda([&]() {
+                selectionBounds = computeLogicalBounds(collectSelectedNodes({world.get()}));
+            }, "compute the bounds of " + std::to_string(selectableNodes.size()) + " selected nodes");
+            CHECK(selectionBounds == world->defaultLayer()->logicalBounds());
+
+            timeLambda([&]() {
+                for (auto* node : selectableNodes) {
+                    node->deselect();
+                }
+            }, "deselect all nodes of a map with " + std::to_string(brushCount) + " brushes");
+            CHECK(world->descendantSelectionCount() == 0u);
+
+            // select touching and select inside with a brush that covers the lower half of the map
+            const auto half = vm::bbox3{selectionBounds.min, selectionBounds.max - vm::vec3{0.0, 0.0, selectionBounds.size().z() / 2.0}};
+            auto selectorNode = BrushNode{BrushBuilder{MapFormat::Standard, syntheticMapWorldBounds()}.createCuboid(half, "texture").value()};
+            const auto selectors = std::vector<BrushNode*>{&selectorNode};
+
+            auto touchingNodes = std::vector<Node*>{};
+            timeLambda([&]() {
+                touchingNodes = collectTouchingNodes({world.get()}, selectors);
+            }, "collect nodes touching a brush in a map with " + std::to_string(brushCount) + " brushes");
+
+            auto containedNodes = std::vector<Node*>{};
+            timeLambda([&]() {
+                containedNodes = collectContainedNodes({world.get()}, selectors);
+            }, "collect nodes inside a brush in a map with " + std::to_string(brushCount) + " brushes");
+
+            CHECK_FALSE(containedNodes.empty());
+            CHECK(containedNodes.size() <= touchingNodes.size());
+            CHECK(touchingNodes.size() < selectableNodes.size());
+        }
+
+        TEST_CASE("SyntheticMapBenchmark.generateIssues", "[SyntheticMapBenchmark]") {
+            const auto brushCount = benchmarkBrushCount();
+            auto world = makeSyntheticWorld(brushCount);
+            world->registerIssueGenerator(new NonIntegerVerticesIssueGenerator());
+            world->registerIssueGenerator(new WorldBoundsIssueGenerator(syntheticMapWorldBounds()));
+
+            const auto& issueGenerators = world->registeredIssueGenerators();
+
+            auto issueCount = size_t(0);
+            timeLambda([&]() {
+                for (auto* node : world->defaultLayer()->children()) {
+                    issueCount += node->issues(issueGenerators).size();
+                }
+            }, "generate issues for " + std::to_string(brushCount) + " brushes");
+
+            // the synthetic brushes have integer vertices and are within the world bounds
+            CHECK(issueCount == 0u);
+        }
+
+        TEST_CASE("SyntheticMapBenchmark.updateLinkedGroups", "[SyntheticMapBenchmark]") {
+            static const auto TargetGroupCount = size_t(15);
+
+            const auto brushCount = benchmarkBrushCount();
+            const auto worldBounds = syntheticMapWorldBounds();
+            const auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+            // one sixteenth of the brushes are in the source group, the rest is in its linked copies
+            auto sourceGroupNode = GroupNode{Group{"source"}};
+            for (const auto& bounds : makeSyntheticBrushBounds(std::max(size_t(1), brushCount / (TargetGroupCount + 1u)))) {
+                sourceGroupNode.addChild(new BrushNode(builder.createCuboid(bounds, "texture").value()));
+            }
+
+            auto group = sourceGroupNode.group();
+            group.setLinkedGroupId("linked");
+            sourceGroupNode.setGroup(std::move(group));
+
+            auto targetGroupNodes = std::vector<GroupNode*>{};
+            for (size_t i = 0u; i < TargetGroupCount; ++i) {
+                targetGroupNodes.push_back(static_cast<GroupNode*>(sourceGroupNode.cloneRecursively(worldBounds)));
+            }
+
+            auto updatedGroupCount = size_t(0);
+            timeLambda([&]() {
+                updateLinkedGroups(sourceGroupNode, targetGroupNodes, worldBounds)
+                    .visit(kdl::overload(
+                        [&](const UpdateLinkedGroupsResult& result) {
+                            updatedGroupCount = result.size();
+                        },
+                        [](const UpdateLinkedGroupsError) {}
+                    ));
+            }, "update " + std::to_string(TargetGroupCount) + " linked groups with " + std::to_string(sourceGroupNode.childCount()) + " brushes each");
+
+            CHECK(updatedGroupCount == TargetGroupCount);
+
+            kdl::vec_clear_and_delete(targetGroupNodes);
+        }
+
+        TEST_CASE("SyntheticMapBenchmark.memoryUsage", "[SyntheticMapBenchmark]") {
+            const auto brushCount = benchmarkBrushCount();
+            const auto world = makeSyntheticWorld(brushCount);
+
+            const auto recordMemoryUsage = [&](const std::string& suffix) {
+                auto report = MemoryReport{};
+                reportMemoryUsage(*world, report, 0u);
+                for (const auto& subsystem : report.subsystems()) {
+                    BenchmarkResults::instance().addMemoryUsage(subsystem.name + " of a map with " + std::to_string(brushCount) + " brushes" + suffix, subsystem.bytes);
+                }
+                return report.totalBytes();
+            };
+
+            const auto bytes = recordMemoryUsage("");
+
+            // the brushes were just created and count as used, so they are only compacted on the second call
+            for (size_t i = 0u; i < 2u; ++i) {
+                world->accept(kdl::overload(
+                    [](auto&& thisLambda, WorldNode* worldNode)  { worldNode->visitChildren(thisLambda); },
+                    [](auto&& thisLambda, LayerNode* layer)      { layer->visitChildren(thisLambda); },
+                    [](auto&& thisLambda, GroupNode* group)      { group->visitChildren(thisLambda); },
+                    [](auto&& thisLambda, EntityNode* entity)    { entity->visitChildren(thisLambda); },
+                    [](BrushNode* brush)                         { brush->compactGeometryIfUnused(); },
+                    [](PatchNode*)                               {}
+                ));
+            }
+
+            const auto compactedBytes = recordMemoryUsage(" with compacted brush geometry");
+            CHECK(compactedBytes < bytes);
+        }
+    }
+}
@@ -0,0 +1,70 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Assets/Texture.h"
+#include "Renderer/BrushRendererArrays.h"
+#include "Renderer/FaceRenderer.h"
+
+#include <kdl/vector_utils.h>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "../../test/src/Catch2.h"
+
+namespace TrenchBroom {
+    namespace Renderer {
+        static constexpr size_t NumBatchTextures = 2'000;
+        static constexpr size_t NumBatchIndicesPerTexture = 600;
+        static constexpr size_t NumBatchFrames = 1'000;
+
+        TEST_CASE("FaceRendererBenchmark.buildBatches", "[FaceRendererBenchmark]") {
+            auto textures = std::vector<Assets::Texture*>{};
+            auto indexArrayMap = std::unordered_map<const Assets::Texture*, std::shared_ptr<BrushIndexArray>>{};
+
+            for (size_t i = 0; i < NumBatchTextures; ++i) {
+                // make every 10th texture a masked texture
+                const auto type = (i % 10 == 0) ? Assets::TextureType::Masked : Assets::TextureType::Opaque;
+                auto* texture = new Assets::Texture("texture " + std::to_string(i), 64, 64, GL_RGBA, type);
+                textures.push_back(texture);
+
+                auto indexArray = std::make_shared<BrushIndexArray>();
+                // leave every 20th index array empty, these must be skipped
+                if (i % 20 != 0) {
+                    indexArray->getPointerToInsertElementsAt(NumBatchIndicesPerTexture);
+                }
+                indexArrayMap.emplace(texture, std::move(indexArray));
+            }
+
+            size_t batchCount = 0;
+            timeLambda([&]() {
+                for (size_t i = 0; i < NumBatchFrames; ++i) {
+                    batchCount += FaceRenderer::buildBatches(indexArrayMap).size();
+                }
+            }, "build face render batches for " + std::to_string(NumBatchTextures) + " textures " + std::to_string(NumBatchFrames) + " times");
+
+            CHECK(batchCount == NumBatchFrames * (NumBatchTextures - NumBatchTextures / 20));
+
+            kdl::vec_clear_and_delete(textures);
+        }
+    }
+}
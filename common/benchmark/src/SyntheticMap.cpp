@@ -0,0 +1,169 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SyntheticMap.h"
+
+#include "IO/NodeWriter.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushNode.h"
+#include "Model/Entity.h"
+#include "Model/EntityNode.h"
+#include "Model/EntityProperties.h"
+#include "Model/LayerNode.h"
+#include "Model/MapFormat.h"
+#include "Model/Polyhedron.h"
+#include "Model/WorldNode.h"
+
+#include <kdl/result.h>
+
+#include <vecmath/vec.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <sstream>
+
+namespace TrenchBroom {
+    static size_t BenchmarkBrushCount = 1'000u;
+
+    size_t benchmarkBrushCount() {
+        return BenchmarkBrushCount;
+    }
+
+    void setBenchmarkBrushCount(const size_t brushCount) {
+        BenchmarkBrushCount = brushCount;
+    }
+
+    static const auto SyntheticMapCellSize = 64;
+    static const auto SyntheticMapTextureCount = 64u;
+
+    vm::bbox3 syntheticMapWorldBounds() {
+        return vm::bbox3(16384.0);
+    }
+
+    std::vector<vm::bbox3> makeSyntheticBrushBounds(const size_t count, const std::uint32_t seed) {
+        // std::mt19937 produces the same sequence on every platform, but the standard distributions don't, so we
+        // derive the random values from the raw output of the generator
+        auto random = std::mt19937{seed};
+
+        const auto cellsPerAxis = std::max(size_t(1), static_cast<size_t>(std::ceil(std::cbrt(static_cast<double>(count)))));
+        const auto origin = -static_cast<FloatType>(cellsPerAxis * SyntheticMapCellSize / 2);
+
+        auto result = std::vector<vm::bbox3>{};
+        result.reserve(count);
+        for (size_t i = 0u; i < count; ++i) {
+            const auto cell = vm::vec3(
+                static_cast<FloatType>(i % cellsPerAxis),
+                static_cast<FloatType>((i / cellsPerAxis) % cellsPerAxis),
+                static_cast<FloatType>(i / (cellsPerAxis * cellsPerAxis)));
+            const auto cellMin = vm::vec3::fill(origin) + cell * static_cast<FloatType>(SyntheticMapCellSize);
+
+            // offset in [0, 16), size in [16, 48]
+            auto min = vm::vec3::zero();
+            auto max = vm::vec3::zero();
+            for (size_t j = 0u; j < 3u; ++j) {
+                const auto offset = static_cast<FloatType>(random() % 16u);
+                const auto size = static_cast<FloatType>(16u + random() % 33u);
+                min[j] = cellMin[j] + offset;
+                max[j] = min[j] + size;
+            }
+            result.emplace_back(min, max);
+        }
+        return result;
+    }
+
+    std::unique_ptr<Model::WorldNode> makeSyntheticWorld(const size_t count, const std::uint32_t seed) {
+        const auto mapFormat = Model::MapFormat::Standard;
+        const auto worldBounds = syntheticMapWorldBounds();
+
+        auto world = std::make_unique<Model::WorldNode>(Model::EntityPropertyConfig{}, Model::Entity{}, mapFormat);
+        auto* layer = world->defaultLayer();
+
+        const auto builder = Model::BrushBuilder{mapFormat, worldBounds};
+        const auto allBounds = makeSyntheticBrushBounds(count, seed);
+
+        auto nodes = std::vector<Model::Node*>{};
+        nodes.reserve(count + count / 64u + 1u);
+        for (size_t i = 0u; i < allBounds.size(); ++i) {
+            const auto& bounds = allBounds[i];
+            const auto textureName = "synthetic/texture" + std::to_string(i % SyntheticMapTextureCount);
+            nodes.push_back(new Model::BrushNode(builder.createCuboid(bounds, textureName).value()));
+
+            if (i % 64u == 0u) {
+                const auto origin = bounds.center() + vm::vec3(0, 0, bounds.size().z());
+                nodes.push_back(new Model::EntityNode(Model::Entity{Model::EntityPropertyConfig{}, {
+                    {Model::EntityPropertyKeys::Classname, "light"},
+                    {Model::EntityPropertyKeys::Origin,
+                        std::to_string(static_cast<int>(origin.x())) + " " +
+                        std::to_string(static_cast<int>(origin.y())) + " " +
+                        std::to_string(static_cast<int>(origin.z()))},
+                    {"light", "300"}
+                }}));
+            }
+        }
+
+        layer->addChildren(nodes);
+        return world;
+    }
+
+    std::string makeSyntheticMap(const size_t count, const std::uint32_t seed) {
+        const auto world = makeSyntheticWorld(count, seed);
+
+        auto str = std::stringstream{};
+        auto writer = IO::NodeWriter{*world, str};
+        writer.writeMap();
+        return str.str();
+    }
+
+    static Model::BrushGeometry makeSyntheticPolyhedron(std::mt19937& random) {
+        const auto randomCoord = [&](const std::uint32_t range) {
+            return static_cast<FloatType>(random() % (2u * range + 1u)) - static_cast<FloatType>(range);
+        };
+
+        while (true) {
+            const auto center = vm::vec3(randomCoord(16u), randomCoord(16u), randomCoord(16u));
+            const auto pointCount = 4u + random() % 13u;
+
+            auto points = std::vector<vm::vec3>{};
+            points.reserve(pointCount);
+            for (size_t i = 0u; i < pointCount; ++i) {
+                points.push_back(center + vm::vec3(randomCoord(16u), randomCoord(16u), randomCoord(16u)));
+            }
+
+            auto geometry = Model::BrushGeometry(std::move(points));
+            if (geometry.polyhedron()) {
+                return geometry;
+            }
+        }
+    }
+
+    std::vector<std::pair<Model::BrushGeometry, Model::BrushGeometry>> makeSyntheticPolyhedronPairs(const size_t count, const std::uint32_t seed) {
+        auto random = std::mt19937{seed};
+
+        auto result = std::vector<std::pair<Model::BrushGeometry, Model::BrushGeometry>>{};
+        result.reserve(count);
+        for (size_t i = 0u; i < count; ++i) {
+            auto lhs = makeSyntheticPolyhedron(random);
+            auto rhs = makeSyntheticPolyhedron(random);
+            result.emplace_back(std::move(lhs), std::move(rhs));
+        }
+        return result;
+    }
+}
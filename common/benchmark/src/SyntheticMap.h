@@ -0,0 +1,78 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "FloatType.h"
+#include "Model/BrushGeometry.h"
+
+#include <vecmath/bbox.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Model {
+        class WorldNode;
+    }
+
+    /**
+     * The number of brushes in the synthetic maps used by the benchmarks. Can be set on the command line with the
+     * --brushes option so that the benchmarks can be run at different scales.
+     */
+    size_t benchmarkBrushCount();
+    void setBenchmarkBrushCount(size_t brushCount);
+
+    /**
+     * The world bounds of every synthetic map. Large enough for more than a million brushes.
+     */
+    vm::bbox3 syntheticMapWorldBounds();
+
+    /**
+     * Returns the bounds of the given number of axis aligned brushes. The brushes are placed into the cells of a
+     * cubic grid so that they do not overlap, and their positions and sizes within the cells are chosen by a random
+     * number generator seeded with the given seed. All coordinates are integers.
+     *
+     * The result only depends on the parameters and is identical on all platforms.
+     */
+    std::vector<vm::bbox3> makeSyntheticBrushBounds(size_t brushCount, std::uint32_t seed = 0u);
+
+    /**
+     * Creates a world in Standard map format that contains the given number of brushes with bounds created by
+     * makeSyntheticBrushBounds. Every 64th brush is accompanied by a light entity.
+     */
+    std::unique_ptr<Model::WorldNode> makeSyntheticWorld(size_t brushCount, std::uint32_t seed = 0u);
+
+    /**
+     * Returns the map file of a world created by makeSyntheticWorld.
+     */
+    std::string makeSyntheticMap(size_t brushCount, std::uint32_t seed = 0u);
+
+    /**
+     * Returns the given number of pairs of random convex polyhedra with integer vertices, e.g. to compare
+     * intersection tests. The polyhedra of each pair are the convex hulls of random points around two random centers
+     * which are close enough for many of the pairs to intersect.
+     *
+     * The result only depends on the parameters and is identical on all platforms.
+     */
+    std::vector<std::pair<Model::BrushGeometry, Model::BrushGeometry>> makeSyntheticPolyhedronPairs(size_t pairCount, std::uint32_t seed = 0u);
+}
@@ -27,9 +27,13 @@
 #include <vecmath/ray.h>
 #include <vecmath/intersection.h>
 
+#include <algorithm>
 #include <cassert>
 #include <iosfwd>
+#include <optional>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace TrenchBroom {
@@ -85,6 +89,35 @@ namespace TrenchBroom {
         LambdaVisitor(I_V innerNodeVisitor, L_V outerNodeVisitor) -> LambdaVisitor<I_V, L_V>;
 #endif
 
+        /**
+         * Returns the cost of the given bounds according to the surface area heuristic, that is, the sum of the areas of
+         * the box's sides that meet at a corner. For a three dimensional box, this is half of its surface area.
+         *
+         * The probability that a query hits a node is roughly proportional to the surface area of its bounds, so this is
+         * used to decide whether a node's bounds have become too loose and whether a rotation improves the tree.
+         */
+        static T cost(const Box& bounds) {
+            const auto size = bounds.size();
+
+            auto result = T(0);
+            for (size_t i = 0; i < S; ++i) {
+                auto area = T(1);
+                for (size_t j = 0; j < S; ++j) {
+                    if (j != i) {
+                        area *= size[j];
+                    }
+                }
+                result += area;
+            }
+            return result;
+        }
+
+        /**
+         * When the bounds of a leaf change, the leaf is kept in place and its ancestors are refitted if the cost of its
+         * parent's bounds does not grow by more than this factor. Otherwise, the leaf is removed and inserted again.
+         */
+        static constexpr T MaxRefitCostFactor = T(2);
+
         class Node {
         public:
             Box m_bounds;
@@ -263,6 +296,84 @@ namespace TrenchBroom {
                 return newTreeRoot;
             }
 
+        public: // refitting
+            /**
+             * Returns the child of this node that is not the given child.
+             *
+             * @param child either m_left or m_right
+             * @return the other child
+             */
+            const Node* sibling(const Node* child) const {
+                assert(child == m_left || child == m_right);
+                return child == m_left ? m_right : m_left;
+            }
+
+            /**
+             * The bounds of the children of this node changed. Tries to improve this node by rotating one of its children
+             * with a grandchild, then recomputes the bounds and the height of this node.
+             *
+             * @return true if the bounds or the height of this node changed
+             */
+            bool refit() {
+                const auto oldBounds = this->bounds();
+                const auto oldHeight = m_height;
+
+                rotate();
+                updateBounds();
+                updateHeight();
+
+                return this->bounds() != oldBounds || m_height != oldHeight;
+            }
+
+        private:
+            /**
+             * Swaps a child of this node with a child of its sibling if that reduces the cost of the sibling's bounds.
+             * Of the (at most) four possible swaps, the one with the largest reduction is performed. The bounds of this
+             * node are unaffected by a rotation.
+             */
+            void rotate() {
+                auto bestGain = T(0);
+                Node** bestChild = nullptr;
+                Node** bestGrandchild = nullptr;
+                InnerNode* bestInner = nullptr;
+
+                const auto findRotation = [&](Node*& child, Node* other) {
+                    if (other->height() > 1) {
+                        auto* inner = static_cast<InnerNode*>(other);
+                        const auto innerCost = cost(inner->bounds());
+
+                        // swapping child with one of inner's children leaves inner with child and the other grandchild
+                        const auto leftGain = innerCost - cost(merge(child->bounds(), inner->m_right->bounds()));
+                        if (leftGain > bestGain) {
+                            bestGain = leftGain;
+                            bestChild = &child;
+                            bestGrandchild = &inner->m_left;
+                            bestInner = inner;
+                        }
+
+                        const auto rightGain = innerCost - cost(merge(inner->m_left->bounds(), child->bounds()));
+                        if (rightGain > bestGain) {
+                            bestGain = rightGain;
+                            bestChild = &child;
+                            bestGrandchild = &inner->m_right;
+                            bestInner = inner;
+                        }
+                    }
+                };
+
+                findRotation(m_left, m_right);
+                findRotation(m_right, m_left);
+
+                if (bestInner != nullptr) {
+                    std::swap(*bestChild, *bestGrandchild);
+                    (*bestChild)->m_parent = this;
+                    (*bestGrandchild)->m_parent = bestInner;
+
+                    bestInner->updateBounds();
+                    bestInner->updateHeight();
+                }
+            }
+
         public: // Node overrides
             ~InnerNode() override {
                 delete m_left;
@@ -424,6 +535,7 @@ namespace TrenchBroom {
                 return m_data;
             }
 
+            using Node::setBounds;
         public: // Node overrides
             size_t height() const override {
                 return 1;
@@ -482,6 +594,20 @@ namespace TrenchBroom {
             return it != m_leafForData.end();
         }
 
+        /**
+         * Returns the bounds with which the given data was inserted into this tree.
+         *
+         * @param data the data to find
+         * @return the bounds of the given data or an empty optional if this tree does not contain the given data
+         */
+        std::optional<Box> boundsOf(const U& data) const {
+            auto it = m_leafForData.find(data);
+            if (it == m_leafForData.end()) {
+                return std::nullopt;
+            }
+            return it->second->bounds();
+        }
+
         /**
          * Clears this tree and rebuilds it by inserting given objects.
          *
@@ -549,18 +675,111 @@ namespace TrenchBroom {
         /**
          * Updates the node with the given data with the given new bounds.
          *
+         * If the new bounds still fit the node's position in the tree, the node is updated in place and the bounds of its
+         * ancestors are refitted, rotating subtrees along the way where that reduces their cost. Otherwise, the node is
+         * removed and inserted again.
+         *
          * @param newBounds the new bounds of the node
          * @param data the node data of the node to update
          *
-         * @throws NodeTreeException if no node with the given data can be found in this tree
+         * @throws NodeTreeException if no node with the given data can be found in this tree, or the bounds contains NaN
          */
         void update(const Box& newBounds, const U& data) {
             check(newBounds);
 
-            if (!remove(data)) {
+            auto it = m_leafForData.find(data);
+            if (it == m_leafForData.end()) {
                 throw NodeTreeException("AABB node not found");
             }
-            insert(newBounds, data);
+
+            LeafNode* leaf = it->second;
+            if (leaf->bounds() == newBounds) {
+                return;
+            }
+
+            if (canRefit(*leaf, newBounds)) {
+                leaf->setBounds(newBounds);
+                for (auto* node = leaf->m_parent; node != nullptr && node->refit(); node = node->m_parent) {}
+            } else {
+                remove(data);
+                insert(newBounds, data);
+            }
+        }
+
+        /**
+         * Updates the nodes with the given data with their new bounds. This is equivalent to calling `update` for each of
+         * the given objects, except that ancestors shared by several updated nodes are only refitted once.
+         *
+         * @param objects the objects to update, a list of DataType
+         * @param getBounds a function from DataType -> Box to compute the new bounds of each object
+         *
+         * @throws NodeTreeException if any of the given objects cannot be found in this tree or its new bounds contains
+         * NaN; the tree is not modified in that case
+         */
+        template <typename DataList, typename GetBounds>
+        void updateAll(const DataList& objects, GetBounds&& getBounds) {
+            auto refitLeafs = std::vector<std::pair<LeafNode*, Box>>{};
+            auto reinsertions = std::vector<std::pair<Box, U>>{};
+
+            for (const U& object : objects) {
+                const auto newBounds = getBounds(object);
+                check(newBounds);
+
+                auto it = m_leafForData.find(object);
+                if (it == m_leafForData.end()) {
+                    throw NodeTreeException("AABB node not found");
+                }
+
+                LeafNode* leaf = it->second;
+                if (leaf->bounds() != newBounds) {
+                    if (canRefit(*leaf, newBounds)) {
+                        refitLeafs.emplace_back(leaf, newBounds);
+                    } else {
+                        reinsertions.emplace_back(newBounds, object);
+                    }
+                }
+            }
+
+            // remove first so that the refitted ancestors do not have to account for the old bounds of these nodes
+            auto removedCount = size_t(0);
+            for (size_t i = 0; i < reinsertions.size(); ++i) {
+                // duplicates are removed only once, so they are also inserted only once
+                if (remove(reinsertions[i].second)) {
+                    if (i != removedCount) {
+                        reinsertions[removedCount] = std::move(reinsertions[i]);
+                    }
+                    ++removedCount;
+                }
+            }
+            reinsertions.erase(std::next(std::begin(reinsertions), static_cast<std::ptrdiff_t>(removedCount)), std::end(reinsertions));
+
+            auto dirtyNodes = std::vector<InnerNode*>{};
+            auto queuedNodes = std::unordered_set<InnerNode*>{};
+            for (auto& [leaf, newBounds] : refitLeafs) {
+                leaf->setBounds(newBounds);
+                if (leaf->m_parent != nullptr && queuedNodes.insert(leaf->m_parent).second) {
+                    dirtyNodes.push_back(leaf->m_parent);
+                }
+            }
+
+            // A child has a smaller height than its parent, so refitting the nodes by increasing height refits every
+            // node after all of its dirty descendants.
+            const auto higher = [](const InnerNode* lhs, const InnerNode* rhs) { return lhs->height() > rhs->height(); };
+            std::make_heap(std::begin(dirtyNodes), std::end(dirtyNodes), higher);
+            while (!dirtyNodes.empty()) {
+                std::pop_heap(std::begin(dirtyNodes), std::end(dirtyNodes), higher);
+                auto* node = dirtyNodes.back();
+                dirtyNodes.pop_back();
+
+                if (node->refit() && node->m_parent != nullptr && queuedNodes.insert(node->m_parent).second) {
+                    dirtyNodes.push_back(node->m_parent);
+                    std::push_heap(std::begin(dirtyNodes), std::end(dirtyNodes), higher);
+                }
+            }
+
+            for (const auto& [newBounds, object] : reinsertions) {
+                insert(newBounds, object);
+            }
         }
     private:
         void check(const Box& bounds) const {
@@ -568,6 +787,21 @@ namespace TrenchBroom {
                 throw NodeTreeException("Cannot add node to AABB tree with invalid bounds");
             }
         }
+
+        /**
+         * Indicates whether the given leaf can keep its position in the tree if its bounds change to the given bounds.
+         * This is the case if merging the new bounds with the bounds of the leaf's sibling does not increase the cost of
+         * the parent's bounds by more than MaxRefitCostFactor.
+         */
+        bool canRefit(const LeafNode& leaf, const Box& newBounds) const {
+            const auto* parent = leaf.m_parent;
+            if (parent == nullptr) {
+                return true;
+            }
+
+            const auto* sibling = parent->sibling(&leaf);
+            return cost(merge(sibling->bounds(), newBounds)) <= MaxRefitCostFactor * cost(parent->bounds());
+        }
     public:
         /**
          * Clears this node tree.
@@ -589,6 +823,23 @@ namespace TrenchBroom {
             return m_root == nullptr;
         }
 
+        /**
+         * Returns an estimate of the number of bytes allocated for this tree, its nodes and its leaf lookup table.
+         *
+         * @return the number of bytes
+         */
+        size_t memoryUsage() const {
+            const auto leafCount = m_leafForData.size();
+            const auto innerCount = leafCount > 0u ? leafCount - 1u : 0u;
+
+            // hash map elements are allocated individually together with a pointer to the next element
+            return sizeof(AABBTree)
+                + leafCount * sizeof(LeafNode)
+                + innerCount * sizeof(InnerNode)
+                + m_leafForData.bucket_count() * sizeof(void*)
+                + leafCount * (sizeof(typename std::unordered_map<U, LeafNode*>::value_type) + sizeof(void*));
+        }
+
         /**
          * Returns the bounds of all nodes in this tree.
          *
@@ -653,6 +904,45 @@ namespace TrenchBroom {
             }
         }
 
+        /**
+         * Finds every data item in this tree whose bounding box intersects with the given box and returns a list of
+         * those items.
+         *
+         * @param box the box to test
+         * @return a list containing all found data items
+         */
+        List findIntersectors(const Box& box) const {
+            List result;
+            findIntersectors(box, std::back_inserter(result));
+            return result;
+        }
+
+        /**
+         * Finds every data item in this tree whose bounding box intersects with the given box and appends it to the
+         * given output iterator.
+         *
+         * @tparam O the output iterator type
+         * @param box the box to test
+         * @param out the output iterator to append to
+         */
+        template <typename O>
+        void findIntersectors(const Box& box, O out) const {
+            if (!empty()) {
+                LambdaVisitor visitor(
+                    [&](const InnerNode* innerNode) {
+                        return innerNode->bounds().intersects(box);
+                    },
+                    [&](const LeafNode* leaf) {
+                        if (leaf->bounds().intersects(box)) {
+                            out = leaf->data();
+                            ++out;
+                        }
+                    }
+                );
+                m_root->accept(visitor);
+            }
+        }
+
         /**
          * Finds every data item in this tree whose bounding box contains the given point and returns a list of those items.
          *
@@ -691,6 +981,85 @@ namespace TrenchBroom {
             }
         }
 
+        /**
+         * Finds every data item in this tree whose bounding box contains the given box and returns a list of those
+         * items.
+         *
+         * @param box the box to test
+         * @return a list containing all found data items
+         */
+        List findContainers(const Box& box) const {
+            List result;
+            findContainers(box, std::back_inserter(result));
+            return result;
+        }
+
+        /**
+         * Finds every data item in this tree whose bounding box contains the given box and appends it to the given
+         * output iterator. Since the bounds of an inner node contain the bounds of all of its descendants, only the
+         * subtrees whose bounds contain the given box need to be visited.
+         *
+         * @tparam O the output iterator type
+         * @param box the box to test
+         * @param out the output iterator to append to
+         */
+        template <typename O>
+        void findContainers(const Box& box, O out) const {
+            if (!empty()) {
+                LambdaVisitor visitor(
+                    [&](const InnerNode* innerNode) {
+                        return innerNode->bounds().contains(box);
+                    },
+                    [&](const LeafNode* leaf) {
+                        if (leaf->bounds().contains(box)) {
+                            out = leaf->data();
+                            ++out;
+                        }
+                    }
+                );
+                m_root->accept(visitor);
+            }
+        }
+
+        /**
+         * Finds every data item in this tree whose bounding box is contained in the given box and returns a list of
+         * those items.
+         *
+         * @param box the box to test
+         * @return a list containing all found data items
+         */
+        List findContained(const Box& box) const {
+            List result;
+            findContained(box, std::back_inserter(result));
+            return result;
+        }
+
+        /**
+         * Finds every data item in this tree whose bounding box is contained in the given box and appends it to the
+         * given output iterator.
+         *
+         * @tparam O the output iterator type
+         * @param box the box to test
+         * @param out the output iterator to append to
+         */
+        template <typename O>
+        void findContained(const Box& box, O out) const {
+            if (!empty()) {
+                LambdaVisitor visitor(
+                    [&](const InnerNode* innerNode) {
+                        return innerNode->bounds().intersects(box);
+                    },
+                    [&](const LeafNode* leaf) {
+                        if (box.contains(leaf->bounds())) {
+                            out = leaf->data();
+                            ++out;
+                        }
+                    }
+                );
+                m_root->accept(visitor);
+            }
+        }
+
         /**
          * Prints a textual representation of this tree to the given output stream.
          *
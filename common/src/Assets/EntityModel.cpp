@@ -20,6 +20,8 @@
 #include "EntityModel.h"
 
 #include "AABBTree.h"
+#include "MemoryReport.h"
+#include "Assets/Texture.h"
 #include "Assets/TextureCollection.h"
 #include "Renderer/IndexRangeMap.h"
 #include "Renderer/PrimType.h"
@@ -102,6 +104,12 @@ namespace TrenchBroom {
             return closestDistance;
         }
 
+        size_t EntityModelLoadedFrame::memoryUsage() const {
+            return sizeof(EntityModelLoadedFrame)
+                + heapMemoryUsage(m_name)
+                + m_tris.capacity() * sizeof(vm::vec3f);
+        }
+
         void EntityModelLoadedFrame::addToSpacialTree(const std::vector<EntityModelVertex>& vertices, const Renderer::PrimType primType, const size_t index, const size_t count) {
             switch (primType) {
                 case Renderer::PrimType::Points:
@@ -223,6 +231,10 @@ namespace TrenchBroom {
             float intersect(const vm::ray3f& /* ray */) const override {
                 return vm::nan<float>();
             }
+
+            size_t memoryUsage() const override {
+                return sizeof(EntityModelUnloadedFrame);
+            }
         };
 
         // EntityModel::Mesh
@@ -244,6 +256,14 @@ namespace TrenchBroom {
         public:
             virtual ~EntityModelMesh() = default;
         public:
+            /**
+             * Returns the number of bytes allocated for the vertices of this mesh. The index ranges are not included
+             * because they are negligible compared to the vertices.
+             */
+            size_t memoryUsage() const {
+                return sizeof(EntityModelMesh) + m_vertices.capacity() * sizeof(EntityModelVertex);
+            }
+
             /**
              * Returns a renderer that renders this mesh with the given texture.
              *
@@ -367,6 +387,19 @@ namespace TrenchBroom {
             return m_skins->textureCount();
         }
 
+        size_t EntityModelSurface::memoryUsage() const {
+            auto result = sizeof(EntityModelSurface) + m_meshes.capacity() * sizeof(std::unique_ptr<EntityModelMesh>);
+            for (const auto& mesh : m_meshes) {
+                if (mesh) {
+                    result += mesh->memoryUsage();
+                }
+            }
+            for (const auto& skin : m_skins->textures()) {
+                result += sizeof(Texture) + skin.bufferSize();
+            }
+            return result;
+        }
+
         const Texture* EntityModelSurface::skin(const std::string& name) const {
             return m_skins->textureByName(name);
         }
@@ -473,6 +506,17 @@ namespace TrenchBroom {
             return m_surfaces.size();
         }
 
+        size_t EntityModel::memoryUsage() const {
+            auto result = sizeof(EntityModel);
+            for (const auto& frame : m_frames) {
+                result += frame->memoryUsage();
+            }
+            for (const auto& surface : m_surfaces) {
+                result += surface->memoryUsage();
+            }
+            return result;
+        }
+
         std::vector<const EntityModelFrame*> EntityModel::frames() const {
             return kdl::vec_transform(m_frames, [](const auto& frame) { return const_cast<const EntityModelFrame*>(frame.get()); });
         }
@@ -140,6 +140,12 @@ namespace TrenchBroom {
              * @return the distance to the point of intersection or NaN if the given ray does not intersect this frame
              */
             virtual float intersect(const vm::ray3f& ray) const = 0;
+
+            /**
+             * Returns the number of bytes allocated for this frame and its hit testing data, not including the nodes
+             * of its spacial tree.
+             */
+            virtual size_t memoryUsage() const = 0;
         };
 
         /**
@@ -177,6 +183,7 @@ namespace TrenchBroom {
             PitchType pitchType() const override;
             Orientation orientation() const override;
             float intersect(const vm::ray3f& ray) const override;
+            size_t memoryUsage() const override;
 
             /**
              * Adds the given primitives to the spacial tree for this frame.
@@ -278,6 +285,13 @@ namespace TrenchBroom {
              */
             size_t skinCount() const;
 
+            /**
+             * Returns the number of bytes allocated for the meshes and skins of this surface.
+             *
+             * @return the number of bytes
+             */
+            size_t memoryUsage() const;
+
             /**
              * Returns the skin with the given name.
              *
@@ -399,6 +413,13 @@ namespace TrenchBroom {
              */
             size_t surfaceCount() const;
 
+            /**
+             * Returns the number of bytes allocated for the frames and surfaces of this model.
+             *
+             * @return the number of bytes
+             */
+            size_t memoryUsage() const;
+
             /**
              * Returns all frames of this model.
              *
@@ -110,6 +110,18 @@ namespace TrenchBroom {
             }
         }
 
+        size_t EntityModelManager::modelCount() const {
+            return m_models.size();
+        }
+
+        size_t EntityModelManager::memoryUsage() const {
+            auto result = size_t(0);
+            for (const auto& [path, model] : m_models) {
+                result += model->memoryUsage();
+            }
+            return result;
+        }
+
         EntityModel* EntityModelManager::model(const IO::Path& path) const {
             if (path.isEmpty()) {
                 return nullptr;
@@ -84,6 +84,16 @@ namespace TrenchBroom {
             Renderer::TexturedRenderer* renderer(const ModelSpecification& spec) const;
 
             const EntityModelFrame* frame(const ModelSpecification& spec) const;
+
+            /**
+             * Returns the number of models that are currently loaded.
+             */
+            size_t modelCount() const;
+
+            /**
+             * Returns the number of bytes allocated for the loaded models.
+             */
+            size_t memoryUsage() const;
         private:
             EntityModel* model(const IO::Path& path) const;
             EntityModel* safeGetModel(const IO::Path& path) const;
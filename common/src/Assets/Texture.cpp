@@ -21,11 +21,13 @@
 #include "Macros.h"
 #include "Assets/TextureBuffer.h"
 #include "Assets/TextureCollection.h"
+#include "Assets/TextureResidency.h"
 #include "Renderer/GL.h"
 
 #include <algorithm> // for std::max
 #include <cassert>
 #include <ostream>
+#include <utility>
 
 namespace TrenchBroom {
     namespace Assets {
@@ -59,6 +61,9 @@ namespace TrenchBroom {
         m_culling(TextureCulling::CullDefault),
         m_blendFunc{TextureBlendFunc::Enable::UseDefault, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA},
         m_textureId{0},
+        m_residency{nullptr},
+        m_minFilter{0},
+        m_magFilter{0},
         m_gameData{std::move(gameData)} {
             assert(m_width > 0);
             assert(m_height > 0);
@@ -79,6 +84,9 @@ namespace TrenchBroom {
         m_blendFunc{TextureBlendFunc::Enable::UseDefault, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA},
         m_textureId(0),
         m_buffers{std::move(buffers)},
+        m_residency{nullptr},
+        m_minFilter{0},
+        m_magFilter{0},
         m_gameData{std::move(gameData)} {
             assert(m_width > 0);
             assert(m_height > 0);
@@ -104,9 +112,16 @@ namespace TrenchBroom {
         m_culling(TextureCulling::CullDefault),
         m_blendFunc{TextureBlendFunc::Enable::UseDefault, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA},
         m_textureId{0},
+        m_residency{nullptr},
+        m_minFilter{0},
+        m_magFilter{0},
         m_gameData{std::move(gameData)} {}
 
-        Texture::~Texture() = default;
+        Texture::~Texture() {
+            if (m_residency != nullptr) {
+                m_residency->release(*this);
+            }
+        }
 
         Texture::Texture(Texture&& other) :
         m_name{std::move(other.m_name)},
@@ -124,9 +139,22 @@ namespace TrenchBroom {
         m_blendFunc{std::move(other.m_blendFunc)},
         m_textureId{std::move(other.m_textureId)},
         m_buffers{std::move(other.m_buffers)},
-        m_gameData{std::move(other.m_gameData)} {}
+        m_residency{std::exchange(other.m_residency, nullptr)},
+        m_minFilter{other.m_minFilter},
+        m_magFilter{other.m_magFilter},
+        m_gameData{std::move(other.m_gameData)} {
+            if (m_residency != nullptr) {
+                // the residency manager refers to textures by address, so this texture is uploaded again on demand
+                m_residency->release(other);
+                m_textureId = 0;
+            }
+        }
 
         Texture& Texture::operator=(Texture&& other) {
+            if (m_residency != nullptr) {
+                m_residency->release(*this);
+            }
+
             m_name = std::move(other.m_name);
             m_absolutePath = std::move(other.m_absolutePath);
             m_relativePath = std::move(other.m_relativePath);
@@ -142,7 +170,15 @@ namespace TrenchBroom {
             m_blendFunc = std::move(other.m_blendFunc);
             m_textureId = std::move(other.m_textureId);
             m_buffers = std::move(other.m_buffers);
+            m_residency = std::exchange(other.m_residency, nullptr);
+            m_minFilter = other.m_minFilter;
+            m_magFilter = other.m_magFilter;
             m_gameData = std::move(other.m_gameData);
+
+            if (m_residency != nullptr) {
+                m_residency->release(other);
+                m_textureId = 0;
+            }
             return *this;
         }
 
@@ -253,52 +289,125 @@ namespace TrenchBroom {
         void Texture::prepare(const GLuint textureId, const int minFilter, const int magFilter) {
             assert(textureId > 0);
             assert(m_textureId == 0);
+            assert(m_residency == nullptr);
 
             if (!m_buffers.empty()) {
-                glAssert(glPixelStorei(GL_UNPACK_SWAP_BYTES, false));
-                glAssert(glPixelStorei(GL_UNPACK_LSB_FIRST, false));
-                glAssert(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
-                glAssert(glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0));
-                glAssert(glPixelStorei(GL_UNPACK_SKIP_ROWS, 0));
-                glAssert(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
-
-                glAssert(glBindTexture(GL_TEXTURE_2D, textureId));
-                glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter));
-                glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilter));
-                glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT));
-                glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT));
+                uploadBuffers(textureId, minFilter, magFilter);
+                m_buffers.clear();
+                m_textureId = textureId;
+            }
+        }
 
-                if (m_type == TextureType::Masked) {
-                    // masked textures don't work well with automatic mipmaps, so we force GL_NEAREST filtering and don't generate any
-                    glAssert(glTexParameteri(GL_TEXTURE_2D, GL_GENERATE_MIPMAP, GL_FALSE));
-                    glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
-                    glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
-                } else if (m_buffers.size() == 1) {
-                    // generate mipmaps if we don't have any
-                    glAssert(glTexParameteri(GL_TEXTURE_2D, GL_GENERATE_MIPMAP, GL_TRUE));
-                } else {
-                    glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(m_buffers.size() - 1)));
-                }
+        void Texture::prepareOnDemand(TextureResidency& residency, const int minFilter, const int magFilter) {
+            assert(m_textureId == 0);
+            assert(m_residency == nullptr);
 
-                // Upload only the first mipmap for masked textures.
-                const auto mipmapsToUpload = (m_type == TextureType::Masked) ? 1u : m_buffers.size();
+            m_residency = &residency;
+            m_minFilter = minFilter;
+            m_magFilter = magFilter;
+        }
 
-                for (size_t j = 0; j < mipmapsToUpload; ++j) {
-                    const auto mipSize = sizeAtMipLevel(m_width, m_height, j);
+        size_t Texture::residentSize() const {
+            if (m_buffers.empty()) {
+                return 0u;
+            }
 
-                    const GLvoid* data = reinterpret_cast<const GLvoid*>(m_buffers[j].data());
-                    glAssert(glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(j), GL_RGBA,
-                                          static_cast<GLsizei>(mipSize.x()),
-                                          static_cast<GLsizei>(mipSize.y()),
-                                          0, m_format, GL_UNSIGNED_BYTE, data));
+            // textures are always stored as RGBA in video memory
+            const auto mipLevelSize = [&](const size_t level) {
+                const auto mipSize = sizeAtMipLevel(m_width, m_height, level);
+                return 4u * mipSize.x() * mipSize.y();
+            };
+
+            auto result = size_t(0);
+            if (m_type == TextureType::Masked) {
+                result = mipLevelSize(0u);
+            } else if (m_buffers.size() == 1u) {
+                // mipmaps are generated down to 1x1
+                for (size_t level = 0u; ; ++level) {
+                    result += mipLevelSize(level);
+                    if ((m_width >> level) <= 1u && (m_height >> level) <= 1u) {
+                        break;
+                    }
+                }
+            } else {
+                for (size_t level = 0u; level < m_buffers.size(); ++level) {
+                    result += mipLevelSize(level);
                 }
+            }
+            return result;
+        }
 
-                m_buffers.clear();
+        size_t Texture::bufferSize() const {
+            auto result = size_t(0);
+            for (const auto& buffer : m_buffers) {
+                result += buffer.size();
+            }
+            return result;
+        }
+
+        void Texture::upload() const {
+            assert(m_textureId == 0);
+
+            if (!m_buffers.empty()) {
+                GLuint textureId;
+                glAssert(glGenTextures(1, &textureId));
+                uploadBuffers(textureId, m_minFilter, m_magFilter);
+                glAssert(glBindTexture(GL_TEXTURE_2D, 0));
                 m_textureId = textureId;
             }
         }
 
+        void Texture::evict() const {
+            if (m_textureId != 0) {
+                glAssert(glDeleteTextures(1, &m_textureId));
+                m_textureId = 0;
+            }
+        }
+
+        void Texture::uploadBuffers(const GLuint textureId, const int minFilter, const int magFilter) const {
+            glAssert(glPixelStorei(GL_UNPACK_SWAP_BYTES, false));
+            glAssert(glPixelStorei(GL_UNPACK_LSB_FIRST, false));
+            glAssert(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+            glAssert(glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0));
+            glAssert(glPixelStorei(GL_UNPACK_SKIP_ROWS, 0));
+            glAssert(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+
+            glAssert(glBindTexture(GL_TEXTURE_2D, textureId));
+            glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter));
+            glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilter));
+            glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT));
+            glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT));
+
+            if (m_type == TextureType::Masked) {
+                // masked textures don't work well with automatic mipmaps, so we force GL_NEAREST filtering and don't generate any
+                glAssert(glTexParameteri(GL_TEXTURE_2D, GL_GENERATE_MIPMAP, GL_FALSE));
+                glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
+                glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
+            } else if (m_buffers.size() == 1) {
+                // generate mipmaps if we don't have any
+                glAssert(glTexParameteri(GL_TEXTURE_2D, GL_GENERATE_MIPMAP, GL_TRUE));
+            } else {
+                glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(m_buffers.size() - 1)));
+            }
+
+            // Upload only the first mipmap for masked textures.
+            const auto mipmapsToUpload = (m_type == TextureType::Masked) ? 1u : m_buffers.size();
+
+            for (size_t j = 0; j < mipmapsToUpload; ++j) {
+                const auto mipSize = sizeAtMipLevel(m_width, m_height, j);
+
+                const GLvoid* data = reinterpret_cast<const GLvoid*>(m_buffers[j].data());
+                glAssert(glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(j), GL_RGBA,
+                                      static_cast<GLsizei>(mipSize.x()),
+                                      static_cast<GLsizei>(mipSize.y()),
+                                      0, m_format, GL_UNSIGNED_BYTE, data));
+            }
+        }
+
         void Texture::setMode(const int minFilter, const int magFilter) {
+            m_minFilter = minFilter;
+            m_magFilter = magFilter;
+
             if (isPrepared()) {
                 activate();
                 if (m_type == TextureType::Masked) {
@@ -314,6 +423,10 @@ namespace TrenchBroom {
         }
 
         void Texture::activate() const {
+            if (m_residency != nullptr) {
+                m_residency->use(*this);
+            }
+
             if (isPrepared()) {
                 glAssert(glBindTexture(GL_TEXTURE_2D, m_textureId));
 
@@ -36,6 +36,7 @@
 namespace TrenchBroom {
     namespace Assets {
         class TextureCollection;
+        class TextureResidency;
 
         enum class TextureType {
             Opaque,
@@ -118,6 +119,11 @@ namespace TrenchBroom {
             mutable GLuint m_textureId;
             mutable BufferList m_buffers;
 
+            // only set for textures that are uploaded on demand
+            TextureResidency* m_residency;
+            int m_minFilter;
+            int m_magFilter;
+
             GameData m_gameData;
         public:
             Texture(const std::string& name, size_t width, size_t height, const Color& averageColor, Buffer&& buffer, GLenum format, TextureType type, GameData gameData = std::monostate{});
@@ -178,14 +184,44 @@ namespace TrenchBroom {
 
             bool isPrepared() const;
             void prepare(GLuint textureId, int minFilter, int magFilter);
+
+            /**
+             * Prepares this texture to be uploaded when it is first activated. The texture data is retained so that the
+             * given residency manager can evict the texture from video memory and upload it again later.
+             */
+            void prepareOnDemand(TextureResidency& residency, int minFilter, int magFilter);
             void setMode(int minFilter, int magFilter);
 
+            /**
+             * Returns the number of bytes this texture occupies in video memory when it is uploaded, including mipmaps.
+             */
+            size_t residentSize() const;
+
+            /**
+             * Returns the number of bytes of texture data that this texture retains in main memory. The data of
+             * textures that were uploaded with prepare() is released after uploading.
+             */
+            size_t bufferSize() const;
+
+            /**
+             * Creates a texture object and uploads the texture data. Called by the residency manager only.
+             */
+            void upload() const;
+
+            /**
+             * Deletes the texture object, but keeps the texture data. Called by the residency manager only.
+             */
+            void evict() const;
+
             void activate() const;
             void deactivate() const;
+        private:
+            void uploadBuffers(GLuint textureId, int minFilter, int magFilter) const;
         public: // exposed for tests only
             /**
              * Returns the texture data in the format returned by format().
-             * Once prepare() is called, this will be an empty vector.
+             * Once prepare() is called, this will be an empty vector. Textures which are uploaded on demand keep their
+             * texture data.
              */
             const BufferList& buffersIfUnprepared() const;
             /**
@@ -29,20 +29,24 @@
 namespace TrenchBroom {
     namespace Assets {
         TextureCollection::TextureCollection() :
-        m_loaded(false) {}
+        m_loaded(false),
+        m_prepared(false) {}
 
         TextureCollection::TextureCollection(std::vector<Texture> textures) :
         m_loaded(false),
-        m_textures(std::move(textures)) {}
+        m_textures(std::move(textures)),
+        m_prepared(false) {}
 
         TextureCollection::TextureCollection(const IO::Path& path) :
         m_loaded(false),
-        m_path(path) {}
+        m_path(path),
+        m_prepared(false) {}
 
         TextureCollection::TextureCollection(const IO::Path& path, std::vector<Texture> textures) :
         m_loaded(true),
         m_path(path),
-        m_textures(std::move(textures)) {}
+        m_textures(std::move(textures)),
+        m_prepared(false) {}
 
         TextureCollection::~TextureCollection() {
             if (!m_textureIds.empty()) {
@@ -104,7 +108,7 @@ namespace TrenchBroom {
         }
 
         bool TextureCollection::prepared() const {
-            return !m_textureIds.empty();
+            return m_prepared;
         }
 
         void TextureCollection::prepare(const int minFilter, const int magFilter) {
@@ -120,6 +124,16 @@ namespace TrenchBroom {
                     texture.prepare(m_textureIds[i], minFilter, magFilter);
                 }
             }
+            m_prepared = true;
+        }
+
+        void TextureCollection::prepare(TextureResidency& residency, const int minFilter, const int magFilter) {
+            assert(!prepared());
+
+            for (auto& texture : m_textures) {
+                texture.prepareOnDemand(residency, minFilter, magFilter);
+            }
+            m_prepared = true;
         }
 
         void TextureCollection::setTextureMode(const int minFilter, const int magFilter) {
@@ -28,6 +28,8 @@
 
 namespace TrenchBroom {
     namespace Assets {
+        class TextureResidency;
+
         class TextureCollection {
         private:
             using TextureIdList = std::vector<GLuint>;
@@ -37,6 +39,7 @@ namespace TrenchBroom {
             std::vector<Texture> m_textures;
 
             TextureIdList m_textureIds;
+            bool m_prepared;
 
             friend class Texture;
         public:
@@ -69,6 +72,11 @@ namespace TrenchBroom {
 
             bool prepared() const;
             void prepare(int minFilter, int magFilter);
+
+            /**
+             * Prepares the textures of this collection to be uploaded on demand by the given residency manager.
+             */
+            void prepare(TextureResidency& residency, int minFilter, int magFilter);
             void setTextureMode(int minFilter, int magFilter);
         };
     }
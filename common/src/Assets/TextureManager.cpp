@@ -23,6 +23,7 @@
 #include "Logger.h"
 #include "Assets/Texture.h"
 #include "Assets/TextureCollection.h"
+#include "Assets/TextureResidency.h"
 #include "IO/TextureLoader.h"
 
 #include <kdl/map_utils.h>
@@ -58,6 +59,7 @@ namespace TrenchBroom {
 
         TextureManager::TextureManager(int magFilter, int minFilter, Logger& logger) :
         m_logger(logger),
+        m_residency(std::make_unique<TextureResidency>()),
         m_minFilter(minFilter),
         m_magFilter(magFilter),
         m_resetTextureMode(false) {}
@@ -131,6 +133,14 @@ namespace TrenchBroom {
             m_resetTextureMode = true;
         }
 
+        void TextureManager::setResidencyBudget(const size_t budget) {
+            m_residency->setBudget(budget);
+        }
+
+        const TextureResidencyStats& TextureManager::residencyStats() const {
+            return m_residency->stats();
+        }
+
         void TextureManager::commitChanges() {
             resetTextureMode();
             prepare();
@@ -170,7 +180,7 @@ namespace TrenchBroom {
         void TextureManager::prepare() {
             for (const size_t index : m_toPrepare) {
                 auto& collection = m_collections[index];
-                collection.prepare(m_minFilter, m_magFilter);
+                collection.prepare(*m_residency, m_minFilter, m_magFilter);
             }
             m_toPrepare.clear();
         }
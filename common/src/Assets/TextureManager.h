@@ -22,6 +22,7 @@
 #include "Assets/TextureCollection.h"
 
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -36,6 +37,8 @@ namespace TrenchBroom {
     namespace Assets {
         class Texture;
         class TextureCollection;
+        class TextureResidency;
+        struct TextureResidencyStats;
 
         class TextureManager {
         private:
@@ -43,6 +46,9 @@ namespace TrenchBroom {
 
             Logger& m_logger;
 
+            // must be destroyed after the texture collections
+            std::unique_ptr<TextureResidency> m_residency;
+
             std::vector<TextureCollection> m_collections;
 
             std::vector<size_t> m_toPrepare;
@@ -66,6 +72,15 @@ namespace TrenchBroom {
             void clear();
 
             void setTextureMode(int minFilter, int magFilter);
+
+            /**
+             * Sets the maximum number of bytes of video memory that textures may occupy. Textures are uploaded when they
+             * are first used, and the least recently used textures are evicted if the budget is exceeded. A budget of 0
+             * means that the texture memory is not limited.
+             */
+            void setResidencyBudget(size_t budget);
+            const TextureResidencyStats& residencyStats() const;
+
             void commitChanges();
 
             const Texture* texture(const std::string& name) const;
@@ -0,0 +1,118 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TextureResidency.h"
+
+#include "Ensure.h"
+#include "Assets/Texture.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace TrenchBroom {
+    namespace Assets {
+        TextureResidency::Backend::~Backend() = default;
+
+        class GLTextureResidencyBackend : public TextureResidency::Backend {
+        public:
+            void upload(const Texture& texture) override {
+                texture.upload();
+            }
+
+            void evict(const Texture& texture) override {
+                texture.evict();
+            }
+        };
+
+        TextureResidency::TextureResidency(const size_t budget) :
+        TextureResidency{std::make_unique<GLTextureResidencyBackend>(), budget} {}
+
+        TextureResidency::TextureResidency(std::unique_ptr<Backend> backend, const size_t budget) :
+        m_backend{std::move(backend)} {
+            ensure(m_backend != nullptr, "backend must not be null");
+            m_stats.budget = budget;
+        }
+
+        TextureResidency::~TextureResidency() = default;
+
+        void TextureResidency::setBudget(const size_t budget) {
+            // textures are evicted the next time one is used because there may be no current OpenGL context now
+            m_stats.budget = budget;
+        }
+
+        void TextureResidency::use(const Texture& texture) {
+            const auto it = m_resident.find(&texture);
+            if (it != std::end(m_resident)) {
+                // move to the front of the LRU list
+                m_lru.splice(std::begin(m_lru), m_lru, it->second.lruPosition);
+            } else {
+                m_backend->upload(texture);
+                m_lru.push_front(&texture);
+
+                const auto size = texture.residentSize();
+                m_resident.emplace(&texture, Entry{std::begin(m_lru), size});
+
+                m_stats.residentCount += 1u;
+                m_stats.residentBytes += size;
+                m_stats.uploadCount += 1u;
+                m_stats.peakResidentBytes = std::max(m_stats.peakResidentBytes, m_stats.residentBytes);
+            }
+
+            evictUntilWithinBudget();
+        }
+
+        void TextureResidency::release(const Texture& texture) {
+            if (m_resident.count(&texture) > 0u) {
+                evict(texture);
+            }
+        }
+
+        bool TextureResidency::resident(const Texture& texture) const {
+            return m_resident.count(&texture) > 0u;
+        }
+
+        const TextureResidencyStats& TextureResidency::stats() const {
+            return m_stats;
+        }
+
+        void TextureResidency::evict(const Texture& texture) {
+            const auto it = m_resident.find(&texture);
+            assert(it != std::end(m_resident));
+
+            m_backend->evict(texture);
+            m_stats.residentCount -= 1u;
+            m_stats.residentBytes -= it->second.size;
+
+            m_lru.erase(it->second.lruPosition);
+            m_resident.erase(it);
+        }
+
+        void TextureResidency::evictUntilWithinBudget() {
+            if (m_stats.budget == 0u) {
+                return;
+            }
+
+            // never evict the most recently used texture, it is about to be rendered
+            while (m_stats.residentBytes > m_stats.budget && m_lru.size() > 1u) {
+                evict(*m_lru.back());
+                m_stats.evictionCount += 1u;
+            }
+        }
+    }
+}
@@ -0,0 +1,107 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+namespace TrenchBroom {
+    namespace Assets {
+        class Texture;
+
+        struct TextureResidencyStats {
+            /** The memory budget in bytes, 0 means unlimited. */
+            size_t budget = 0u;
+            size_t residentCount = 0u;
+            size_t residentBytes = 0u;
+            size_t peakResidentBytes = 0u;
+            size_t uploadCount = 0u;
+            size_t evictionCount = 0u;
+        };
+
+        /**
+         * Keeps track of which textures are resident in video memory.
+         *
+         * Textures are uploaded when they are first used and evicted in least recently used order once the resident
+         * textures exceed the memory budget. Evicted textures keep their CPU side copies and are uploaded again when
+         * they are used the next time.
+         *
+         * The actual uploading and evicting is delegated to a backend so that the residency logic can be tested without
+         * an OpenGL context.
+         */
+        class TextureResidency {
+        public:
+            class Backend {
+            public:
+                virtual ~Backend();
+
+                virtual void upload(const Texture& texture) = 0;
+                virtual void evict(const Texture& texture) = 0;
+            };
+        private:
+            using LruList = std::list<const Texture*>;
+
+            struct Entry {
+                LruList::iterator lruPosition;
+                size_t size;
+            };
+
+            std::unique_ptr<Backend> m_backend;
+
+            // the most recently used texture is at the front
+            LruList m_lru;
+            std::unordered_map<const Texture*, Entry> m_resident;
+
+            TextureResidencyStats m_stats;
+        public:
+            /**
+             * Creates a new residency manager that uploads and evicts textures using OpenGL.
+             */
+            explicit TextureResidency(size_t budget = 0u);
+            TextureResidency(std::unique_ptr<Backend> backend, size_t budget);
+            ~TextureResidency();
+
+            /**
+             * Sets the budget in bytes. If the resident textures exceed the new budget, they are evicted when the next
+             * texture is used.
+             */
+            void setBudget(size_t budget);
+
+            /**
+             * Marks the given texture as most recently used and uploads it if it is not resident. Afterwards, the least
+             * recently used textures are evicted until the budget is met, but the given texture is never evicted.
+             */
+            void use(const Texture& texture);
+
+            /**
+             * Evicts the given texture if it is resident and forgets about it. Must be called before a texture is
+             * destroyed.
+             */
+            void release(const Texture& texture);
+
+            bool resident(const Texture& texture) const;
+            const TextureResidencyStats& stats() const;
+        private:
+            void evict(const Texture& texture);
+            void evictUntilWithinBudget();
+        };
+    }
+}
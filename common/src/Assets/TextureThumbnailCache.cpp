@@ -0,0 +1,171 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TextureThumbnailCache.h"
+
+#include "Assets/Texture.h"
+#include "Assets/TextureBuffer.h"
+
+#include <kdl/parallel.h>
+#include <kdl/vector_utils.h>
+
+#include <vecmath/vec.h>
+
+#include <algorithm>
+#include <cassert>
+
+namespace TrenchBroom {
+    namespace Assets {
+        std::optional<TextureThumbnail> makeTextureThumbnail(const Texture& texture, const size_t maxSize) {
+            const auto& buffers = texture.buffersIfUnprepared();
+            if (buffers.empty() || maxSize == 0u) {
+                return std::nullopt;
+            }
+
+            // find the largest mip level that fits, or the smallest one if none fits
+            auto level = size_t(0);
+            auto size = sizeAtMipLevel(texture.width(), texture.height(), level);
+            while (level + 1u < buffers.size() && std::max(size.x(), size.y()) > maxSize) {
+                ++level;
+                size = sizeAtMipLevel(texture.width(), texture.height(), level);
+            }
+
+            const auto bytesPerPixel = bytesPerPixelForFormat(texture.format());
+            const auto* source = buffers[level].data();
+
+            // downsample the mip level if it is still too large, point sampling is sufficient for previews
+            const auto sourceWidth = size.x();
+            const auto sourceHeight = size.y();
+            const auto scale = std::min(1.0, static_cast<double>(maxSize) / static_cast<double>(std::max(sourceWidth, sourceHeight)));
+            const auto width = std::max(size_t(1), static_cast<size_t>(static_cast<double>(sourceWidth) * scale));
+            const auto height = std::max(size_t(1), static_cast<size_t>(static_cast<double>(sourceHeight) * scale));
+
+            auto pixels = std::vector<unsigned char>(width * height * bytesPerPixel);
+            for (size_t y = 0u; y < height; ++y) {
+                const auto sourceY = y * sourceHeight / height;
+                for (size_t x = 0u; x < width; ++x) {
+                    const auto sourceX = x * sourceWidth / width;
+                    const auto* sourcePixel = source + (sourceY * sourceWidth + sourceX) * bytesPerPixel;
+                    std::copy_n(sourcePixel, bytesPerPixel, std::begin(pixels) + static_cast<std::ptrdiff_t>((y * width + x) * bytesPerPixel));
+                }
+            }
+
+            return TextureThumbnail{width, height, texture.format(), std::move(pixels)};
+        }
+
+        TextureThumbnailCache::TextureThumbnailCache(const size_t maxSize) :
+        m_maxSize(maxSize) {}
+
+        TextureThumbnailCache::~TextureThumbnailCache() {
+            // there may be no current OpenGL context here, so the owner must have deleted the textures already
+            assert(m_toDelete.empty());
+            assert(std::all_of(std::begin(m_thumbnails), std::end(m_thumbnails), [](const auto& entry) {
+                return entry.second == 0u;
+            }));
+        }
+
+        size_t TextureThumbnailCache::maxSize() const {
+            return m_maxSize;
+        }
+
+        void TextureThumbnailCache::setMaxSize(const size_t maxSize) {
+            if (maxSize != m_maxSize) {
+                m_maxSize = maxSize;
+                clear();
+            }
+        }
+
+        void TextureThumbnailCache::prepare(const std::vector<const Texture*>& textures) {
+            deletePendingTextures();
+
+            auto missing = kdl::vec_filter(textures, [&](const Texture* texture) {
+                return m_thumbnails.count(texture) == 0u;
+            });
+            missing = kdl::vec_sort_and_remove_duplicates(std::move(missing));
+            if (missing.empty()) {
+                return;
+            }
+
+            const auto maxSize = m_maxSize;
+            const auto thumbnails = kdl::vec_parallel_transform(missing, [&](const Texture* texture) {
+                return makeTextureThumbnail(*texture, maxSize);
+            });
+
+            auto textureIds = std::vector<GLuint>(missing.size());
+            glAssert(glGenTextures(static_cast<GLsizei>(textureIds.size()), textureIds.data()));
+
+            glAssert(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+            for (size_t i = 0u; i < missing.size(); ++i) {
+                const auto textureId = textureIds[i];
+                if (const auto& thumbnail = thumbnails[i]) {
+                    glAssert(glBindTexture(GL_TEXTURE_2D, textureId));
+                    glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
+                    glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+                    glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+                    glAssert(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+                    glAssert(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA,
+                                          static_cast<GLsizei>(thumbnail->width),
+                                          static_cast<GLsizei>(thumbnail->height),
+                                          0, thumbnail->format, GL_UNSIGNED_BYTE, thumbnail->pixels.data()));
+                    m_thumbnails.emplace(missing[i], textureId);
+                } else {
+                    // remember that this texture has no thumbnail so that we don't try again
+                    m_toDelete.push_back(textureId);
+                    m_thumbnails.emplace(missing[i], 0u);
+                }
+            }
+            glAssert(glBindTexture(GL_TEXTURE_2D, 0));
+        }
+
+        bool TextureThumbnailCache::activate(const Texture& texture) const {
+            const auto it = m_thumbnails.find(&texture);
+            if (it == std::end(m_thumbnails) || it->second == 0u) {
+                return false;
+            }
+
+            glAssert(glBindTexture(GL_TEXTURE_2D, it->second));
+            return true;
+        }
+
+        void TextureThumbnailCache::deactivate() const {
+            glAssert(glBindTexture(GL_TEXTURE_2D, 0));
+        }
+
+        void TextureThumbnailCache::clear() {
+            for (const auto& [texture, textureId] : m_thumbnails) {
+                if (textureId != 0u) {
+                    m_toDelete.push_back(textureId);
+                }
+            }
+            m_thumbnails.clear();
+        }
+
+        void TextureThumbnailCache::deleteTextures() {
+            clear();
+            deletePendingTextures();
+        }
+
+        void TextureThumbnailCache::deletePendingTextures() {
+            if (!m_toDelete.empty()) {
+                glAssert(glDeleteTextures(static_cast<GLsizei>(m_toDelete.size()), m_toDelete.data()));
+                m_toDelete.clear();
+            }
+        }
+    }
+}
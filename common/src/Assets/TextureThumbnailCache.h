@@ -0,0 +1,101 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Renderer/GL.h"
+
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Assets {
+        class Texture;
+
+        struct TextureThumbnail {
+            size_t width;
+            size_t height;
+            GLenum format;
+            std::vector<unsigned char> pixels;
+        };
+
+        /**
+         * Creates a thumbnail of the given texture that fits into a square of the given size. The thumbnail is taken
+         * from the largest mip level that fits, and is downsampled further if no mip level fits.
+         *
+         * Returns nothing if the texture has no CPU side texture data, e.g. because it was uploaded already.
+         */
+        std::optional<TextureThumbnail> makeTextureThumbnail(const Texture& texture, size_t maxSize);
+
+        /**
+         * Keeps small textures for previewing textures in the texture browser.
+         *
+         * Rendering the browser with thumbnails does not upload the full size textures with all of their mip levels,
+         * so scrolling through the browser does not evict the textures that are used by the map from video memory.
+         *
+         * The owner must call deleteTextures with its OpenGL context current before the cache is destroyed, since the
+         * destructor cannot assume that there is a current context.
+         */
+        class TextureThumbnailCache {
+        private:
+            size_t m_maxSize;
+            std::unordered_map<const Texture*, GLuint> m_thumbnails;
+            std::vector<GLuint> m_toDelete;
+        public:
+            explicit TextureThumbnailCache(size_t maxSize = 64u);
+            ~TextureThumbnailCache();
+
+            TextureThumbnailCache(const TextureThumbnailCache&) = delete;
+            TextureThumbnailCache& operator=(const TextureThumbnailCache&) = delete;
+
+            size_t maxSize() const;
+
+            /**
+             * Sets the maximum thumbnail size and discards all thumbnails if it changes.
+             */
+            void setMaxSize(size_t maxSize);
+
+            /**
+             * Creates the missing thumbnails for the given textures. The thumbnails are computed in parallel and then
+             * uploaded. Must be called with a current OpenGL context.
+             */
+            void prepare(const std::vector<const Texture*>& textures);
+
+            /**
+             * Binds the thumbnail of the given texture and returns true, or returns false if there is no thumbnail.
+             */
+            bool activate(const Texture& texture) const;
+            void deactivate() const;
+
+            /**
+             * Discards all thumbnails. The texture objects are deleted the next time prepare is called, since there may
+             * be no current OpenGL context now.
+             */
+            void clear();
+
+            /**
+             * Discards all thumbnails and deletes their texture objects. Must be called with a current OpenGL context.
+             */
+            void deleteTextures();
+        private:
+            void deletePendingTextures();
+        };
+    }
+}
@@ -32,14 +32,27 @@
 
 namespace TrenchBroom {
     FileLogger::FileLogger(const IO::Path& filePath) :
-    m_file(nullptr) {
+    m_file(nullptr),
+    m_stop(false) {
         const auto fixedPath = IO::Disk::fixPath(filePath);
         IO::Disk::ensureDirectoryExists(fixedPath.deleteLastComponent());
         m_file = openPathAsFILE(fixedPath, "w");
         ensure(m_file != nullptr, "log file could not be opened");
+
+        m_writerThread = std::thread{[&]() { runWriter(); }};
     }
 
     FileLogger::~FileLogger() {
+        {
+            const auto lock = std::lock_guard<std::mutex>{m_queueMutex};
+            m_stop = true;
+        }
+        m_queueCondition.notify_one();
+        m_writerThread.join();
+
+        // write any messages that were logged while the writer was shutting down
+        writeQueuedMessages();
+
         if (m_file != nullptr) {
             fclose(m_file);
             m_file = nullptr;
@@ -51,14 +64,48 @@ namespace TrenchBroom {
         return Instance;
     }
 
-    void FileLogger::doLog(const LogLevel /* level */, const std::string& message) {
+    void FileLogger::flush() {
+        writeQueuedMessages();
+    }
+
+    void FileLogger::runWriter() {
+        auto lock = std::unique_lock<std::mutex>{m_queueMutex};
+        while (!m_stop) {
+            m_queueCondition.wait(lock, [&]() { return m_stop || !m_queue.empty(); });
+
+            lock.unlock();
+            writeQueuedMessages();
+            lock.lock();
+        }
+    }
+
+    void FileLogger::writeQueuedMessages() {
+        // hold the file lock while taking the messages from the queue so that batches are written in order
+        const auto fileLock = std::lock_guard<std::mutex>{m_fileMutex};
+
+        auto messages = std::vector<std::string>{};
+        {
+            const auto queueLock = std::lock_guard<std::mutex>{m_queueMutex};
+            std::swap(messages, m_queue);
+        }
+
         assert(m_file != nullptr);
-        if (m_file != nullptr) {
-            std::fprintf(m_file, "%s\n", message.c_str());
+        if (m_file != nullptr && !messages.empty()) {
+            for (const auto& message : messages) {
+                std::fprintf(m_file, "%s\n", message.c_str());
+            }
             std::fflush(m_file);
         }
     }
 
+    void FileLogger::doLog(const LogLevel /* level */, const std::string& message) {
+        {
+            const auto lock = std::lock_guard<std::mutex>{m_queueMutex};
+            m_queue.push_back(message);
+        }
+        m_queueCondition.notify_one();
+    }
+
     void FileLogger::doLog(const LogLevel level, const QString& message) {
         log(level, message.toStdString());
     }
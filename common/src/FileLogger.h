@@ -22,7 +22,12 @@
 #include "Macros.h"
 #include "Logger.h"
 
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 class QString;
 
@@ -31,15 +36,42 @@ namespace TrenchBroom {
         class Path;
     }
 
+    /**
+     * Writes log messages to a file. Messages are queued and written in batches by a background thread so that
+     * logging does not block the calling thread on file IO. This logger can be used from any thread.
+     */
     class FileLogger : public Logger {
     private:
         FILE* m_file;
+
+        /**
+         * Guards the file. Acquired before m_queueMutex if both are needed.
+         */
+        std::mutex m_fileMutex;
+
+        /**
+         * Guards the queue and the stop flag.
+         */
+        std::mutex m_queueMutex;
+        std::condition_variable m_queueCondition;
+        std::vector<std::string> m_queue;
+        bool m_stop;
+
+        std::thread m_writerThread;
     public:
         explicit FileLogger(const IO::Path& filePath);
         ~FileLogger() override;
 
         static FileLogger& instance();
+
+        /**
+         * Writes all queued messages to the file and returns when they have been written.
+         */
+        void flush();
     private:
+        void runWriter();
+        void writeQueuedMessages();
+
         void doLog(LogLevel level, const std::string& message) override;
         void doLog(LogLevel level, const QString& message) override;
 
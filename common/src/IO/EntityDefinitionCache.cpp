@@ -0,0 +1,128 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "EntityDefinitionCache.h"
+
+#include "Exceptions.h"
+#include "IO/DiskIO.h"
+#include "IO/EntityDefinitionParser.h"
+#include "IO/File.h"
+#include "IO/ParserStatus.h"
+#include "IO/Reader.h"
+#include "IO/RecordingParserStatus.h"
+
+#include <functional>
+
+namespace TrenchBroom {
+    namespace IO {
+        static size_t hashContents(const std::string_view contents) {
+            return std::hash<std::string_view>{}(contents);
+        }
+
+        static bool isUnchanged(const Path& path, const size_t size, const size_t hash) {
+            try {
+                auto file = Disk::openFile(path);
+                auto reader = file->reader().buffer();
+                const auto contents = reader.stringView();
+                return contents.size() == size && hashContents(contents) == hash;
+            } catch (const Exception&) {
+                return false;
+            }
+        }
+
+        std::vector<Assets::EntityDefinition*> EntityDefinitionCache::loadDefinitions(EntityDefinitionParser& parser, const Path& path, const std::string_view contents, ParserStatus& status) {
+            if (auto classInfos = findClassInfos(path, contents, status)) {
+                return parser.createDefinitions(status, *classInfos);
+            }
+
+            auto recordingStatus = RecordingParserStatus{};
+            auto classInfos = std::vector<EntityDefinitionClassInfo>{};
+            try {
+                classInfos = parser.parseClassInfos(recordingStatus);
+            } catch (...) {
+                RecordingParserStatus::replay(recordingStatus.messages(), status);
+                throw;
+            }
+            RecordingParserStatus::replay(recordingStatus.messages(), status);
+
+            auto entry = Entry{
+                FileHash{path, contents.size(), hashContents(contents)},
+                {},
+                classInfos,
+                recordingStatus.releaseMessages()
+            };
+
+            // the included files are read again to hash them, this is cheap compared to parsing them
+            for (const auto& includedPath : parser.includedFiles()) {
+                try {
+                    auto file = Disk::openFile(includedPath);
+                    auto reader = file->reader().buffer();
+                    const auto includedContents = reader.stringView();
+                    entry.includedFiles.push_back(FileHash{includedPath, includedContents.size(), hashContents(includedContents)});
+                } catch (const Exception&) {
+                    // don't cache the result if an included file cannot be read anymore
+                    return parser.createDefinitions(status, classInfos);
+                }
+            }
+
+            {
+                const auto lock = std::lock_guard<std::mutex>{m_mutex};
+                m_entries[path] = std::move(entry);
+            }
+
+            return parser.createDefinitions(status, classInfos);
+        }
+
+        size_t EntityDefinitionCache::size() const {
+            const auto lock = std::lock_guard<std::mutex>{m_mutex};
+            return m_entries.size();
+        }
+
+        void EntityDefinitionCache::clear() {
+            const auto lock = std::lock_guard<std::mutex>{m_mutex};
+            m_entries.clear();
+        }
+
+        std::optional<std::vector<EntityDefinitionClassInfo>> EntityDefinitionCache::findClassInfos(const Path& path, const std::string_view contents, ParserStatus& status) const {
+            auto entry = std::optional<Entry>{};
+            {
+                const auto lock = std::lock_guard<std::mutex>{m_mutex};
+                const auto it = m_entries.find(path);
+                if (it == std::end(m_entries)) {
+                    return std::nullopt;
+                }
+                entry = it->second;
+            }
+
+            if (entry->file.size != contents.size() || entry->file.hash != hashContents(contents)) {
+                return std::nullopt;
+            }
+
+            for (const auto& includedFile : entry->includedFiles) {
+                if (!isUnchanged(includedFile.path, includedFile.size, includedFile.hash)) {
+                    return std::nullopt;
+                }
+            }
+
+            RecordingParserStatus::replay(entry->messages, status);
+
+            return std::move(entry->classInfos);
+        }
+    }
+}
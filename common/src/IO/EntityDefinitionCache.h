@@ -0,0 +1,93 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "IO/EntityDefinitionClassInfo.h"
+#include "IO/Path.h"
+#include "IO/RecordingParserStatus.h"
+
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Assets {
+        class EntityDefinition;
+    }
+
+    namespace IO {
+        class EntityDefinitionParser;
+        class ParserStatus;
+
+        /**
+         * Caches the class infos parsed from entity definition files, so that opening another map that uses the same
+         * definition file does not have to parse it again.
+         *
+         * An entry is keyed by the path of the definition file and is only used if the contents of that file and of
+         * every file it included are unchanged. The messages that were logged while parsing are recorded and replayed
+         * when an entry is used. The entity definitions themselves are always created anew because they are owned by
+         * the entity definition manager of each document.
+         *
+         * The cache only lives in memory. Persisting it to disk keyed by path and modification time would also speed
+         * up the first load after starting the editor, but it requires a serialization format for class infos,
+         * property definitions and model definition expressions, none of which exist yet.
+         *
+         * This class is thread safe.
+         */
+        class EntityDefinitionCache {
+        private:
+            struct FileHash {
+                Path path;
+                size_t size;
+                size_t hash;
+            };
+
+            struct Entry {
+                FileHash file;
+                std::vector<FileHash> includedFiles;
+                std::vector<EntityDefinitionClassInfo> classInfos;
+                std::vector<RecordingParserStatus::Message> messages;
+            };
+
+            std::map<Path, Entry> m_entries;
+            mutable std::mutex m_mutex;
+        public:
+            /**
+             * Creates the entity definitions for the given file, either from the cached class infos or by parsing the
+             * file with the given parser.
+             *
+             * @param parser the parser to use if the file is not cached, must have been created for the given contents
+             * @param path the path of the definition file
+             * @param contents the contents of the definition file
+             * @param status the status to log to
+             * @return the entity definitions, the caller takes ownership
+             */
+            std::vector<Assets::EntityDefinition*> loadDefinitions(EntityDefinitionParser& parser, const Path& path, std::string_view contents, ParserStatus& status);
+
+            size_t size() const;
+            void clear();
+        private:
+            std::optional<std::vector<EntityDefinitionClassInfo>> findClassInfos(const Path& path, std::string_view contents, ParserStatus& status) const;
+        };
+    }
+}
@@ -25,6 +25,7 @@
 #include "Assets/PropertyDefinition.h"
 #include "IO/EntityDefinitionClassInfo.h"
 #include "IO/ParserStatus.h"
+#include "IO/Path.h"
 #include "Model/EntityProperties.h"
 
 #include <kdl/vector_utils.h>
@@ -40,6 +41,10 @@ namespace TrenchBroom {
         m_defaultEntityColor(defaultEntityColor) {}
         
         EntityDefinitionParser::~EntityDefinitionParser() {}
+
+        const Color& EntityDefinitionParser::defaultEntityColor() const {
+            return m_defaultEntityColor;
+        }
         
         static std::shared_ptr<Assets::PropertyDefinition> mergeAttributes(const Assets::PropertyDefinition& inheritingClassAttribute, const Assets::PropertyDefinition& superClassAttribute) {
             assert(inheritingClassAttribute.key() == superClassAttribute.key());
@@ -343,5 +348,9 @@ namespace TrenchBroom {
             auto classInfos = parseClassInfos(status);
             return createDefinitions(status, std::move(classInfos));
         }
+
+        std::vector<Path> EntityDefinitionParser::includedFiles() const {
+            return {};
+        }
     }
 }
@@ -35,6 +35,7 @@ namespace TrenchBroom {
     namespace IO {
         struct EntityDefinitionClassInfo;
         class ParserStatus;
+        class Path;
 
         // exposed for testing
         std::vector<EntityDefinitionClassInfo> resolveInheritance(ParserStatus& status, const std::vector<EntityDefinitionClassInfo>& classInfos);
@@ -52,11 +53,22 @@ namespace TrenchBroom {
             virtual ~EntityDefinitionParser();
             
             EntityDefinitionList parseDefinitions(ParserStatus& status);
+
+            /**
+             * Parsing the class infos and creating the definitions from them are exposed separately so that the
+             * parsed class infos can be cached, see EntityDefinitionCache.
+             */
+            virtual std::vector<EntityDefinitionClassInfo> parseClassInfos(ParserStatus& status) = 0;
+            std::vector<Assets::EntityDefinition*> createDefinitions(ParserStatus& status, const std::vector<EntityDefinitionClassInfo>& classInfos) const;
+
+            /**
+             * Returns the absolute paths of all files that were included by the last call to parseClassInfos.
+             */
+            virtual std::vector<Path> includedFiles() const;
+        protected:
+            const Color& defaultEntityColor() const;
         private:
             std::unique_ptr<Assets::EntityDefinition> createDefinition(const EntityDefinitionClassInfo& classInfo) const;
-            std::vector<Assets::EntityDefinition*> createDefinitions(ParserStatus& status, const std::vector<EntityDefinitionClassInfo>& classInfos) const;
- 
-            virtual std::vector<EntityDefinitionClassInfo> parseClassInfos(ParserStatus& status) = 0;
         };
     }
 }
@@ -26,18 +26,41 @@
 #include "IO/ELParser.h"
 #include "IO/LegacyModelDefinitionParser.h"
 #include "IO/ParserStatus.h"
+#include "IO/RecordingParserStatus.h"
 
+#include <kdl/parallel.h>
 #include <kdl/string_compare.h>
 #include <kdl/string_format.h>
 #include <kdl/string_utils.h>
 #include <kdl/vector_utils.h>
 
+#include <exception>
 #include <memory>
 #include <string>
 #include <vector>
 
 namespace TrenchBroom {
     namespace IO {
+        /**
+         * An include directive that was resolved while parsing a file. The included file is parsed once the including
+         * file has been parsed.
+         */
+        struct FgdParser::PendingInclude {
+            /** The number of class infos of the including file that precede the directive. */
+            size_t classInfoIndex;
+            /** The number of messages of the including file that precede the directive. */
+            size_t messageIndex;
+            size_t line;
+            Path path;
+            std::shared_ptr<File> file;
+        };
+
+        struct FgdParser::IncludeResult {
+            std::vector<EntityDefinitionClassInfo> classInfos;
+            std::vector<Path> includedFiles;
+            std::vector<RecordingParserStatus::Message> messages;
+        };
+
         FgdTokenizer::FgdTokenizer(std::string_view str) :
         Tokenizer(std::move(str), "", 0) {}
 
@@ -139,6 +162,16 @@ namespace TrenchBroom {
         FgdParser::FgdParser(std::string_view str, const Color& defaultEntityColor) :
         FgdParser(std::move(str), defaultEntityColor, Path()) {}
 
+        FgdParser::FgdParser(std::string_view str, const Color& defaultEntityColor, std::shared_ptr<FileSystem> fs, std::vector<Path> paths) :
+        EntityDefinitionParser(defaultEntityColor),
+        m_paths(std::move(paths)),
+        m_fs(std::move(fs)),
+        m_tokenizer(FgdTokenizer(std::move(str))) {}
+
+        std::vector<Path> FgdParser::includedFiles() const {
+            return m_includedFiles;
+        }
+
         FgdParser::TokenNameMap FgdParser::tokenNames() const {
             using namespace FgdToken;
 
@@ -159,30 +192,11 @@ namespace TrenchBroom {
             return names;
         }
 
-        class FgdParser::PushIncludePath {
-        private:
-            FgdParser* m_parser;
-        public:
-            PushIncludePath(FgdParser* parser, const Path& path) :
-                m_parser(parser) {
-                m_parser->pushIncludePath(path);
-            }
-
-            ~PushIncludePath() {
-                m_parser->popIncludePath();
-            }
-        };
-
         void FgdParser::pushIncludePath(const Path& path) {
             assert(!isRecursiveInclude(path));
             m_paths.push_back(path);
         }
 
-        void FgdParser::popIncludePath() {
-            assert(!m_paths.empty());
-            m_paths.pop_back();
-        }
-
         Path FgdParser::currentRoot() const {
             if (!m_paths.empty()) {
                 assert(!m_paths.back().isEmpty());
@@ -202,29 +216,67 @@ namespace TrenchBroom {
         }
 
         std::vector<EntityDefinitionClassInfo> FgdParser::parseClassInfos(ParserStatus& status) {
-            std::vector<EntityDefinitionClassInfo> classInfos;
-            auto token = m_tokenizer.peekToken();
-            while (!token.hasType(FgdToken::Eof)) {
-                parseClassInfoOrInclude(status, classInfos);
-                token = m_tokenizer.peekToken();
+            // The included files are parsed in parallel after this file has been parsed. The messages of this file are
+            // recorded so that all messages can be logged in the same order as if the included files were parsed in place.
+            auto fileStatus = RecordingParserStatus{};
+            auto fileClassInfos = std::vector<EntityDefinitionClassInfo>{};
+            auto includes = std::vector<PendingInclude>{};
+            try {
+                auto token = m_tokenizer.peekToken();
+                while (!token.hasType(FgdToken::Eof)) {
+                    parseClassInfoOrInclude(fileStatus, fileClassInfos, includes);
+                    status.progress(m_tokenizer.progress());
+                    token = m_tokenizer.peekToken();
+                }
+            } catch (...) {
+                RecordingParserStatus::replay(fileStatus.messages(), status);
+                throw;
             }
+
+            auto includeResults = kdl::vec_parallel_transform(includes, [&](const PendingInclude& include) {
+                return parsePendingInclude(include);
+            });
+
+            const auto& fileMessages = fileStatus.messages();
+            auto classInfos = std::vector<EntityDefinitionClassInfo>{};
+            size_t classInfoIndex = 0u;
+            size_t messageIndex = 0u;
+
+            const auto appendFileResults = [&](const size_t classInfoEnd, const size_t messageEnd) {
+                for (; classInfoIndex < classInfoEnd; ++classInfoIndex) {
+                    classInfos.push_back(std::move(fileClassInfos[classInfoIndex]));
+                }
+                for (; messageIndex < messageEnd; ++messageIndex) {
+                    status.logRecorded(fileMessages[messageIndex].first, fileMessages[messageIndex].second);
+                }
+            };
+
+            for (size_t i = 0u; i < includes.size(); ++i) {
+                appendFileResults(includes[i].classInfoIndex, includes[i].messageIndex);
+
+                auto& includeResult = includeResults[i];
+                RecordingParserStatus::replay(includeResult.messages, status);
+                classInfos = kdl::vec_concat(std::move(classInfos), std::move(includeResult.classInfos));
+                m_includedFiles.push_back(m_fs->makeAbsolute(includes[i].path));
+                m_includedFiles = kdl::vec_concat(std::move(m_includedFiles), std::move(includeResult.includedFiles));
+            }
+            appendFileResults(fileClassInfos.size(), fileMessages.size());
+
             return classInfos;
         }
 
-        void FgdParser::parseClassInfoOrInclude(ParserStatus& status, std::vector<EntityDefinitionClassInfo>& classInfos) {
+        void FgdParser::parseClassInfoOrInclude(RecordingParserStatus& status, std::vector<EntityDefinitionClassInfo>& classInfos, std::vector<PendingInclude>& includes) {
             auto token = expect(status, FgdToken::Eof | FgdToken::Word, m_tokenizer.peekToken());
             if (token.hasType(FgdToken::Eof)) {
                 return;
             }
 
             if (kdl::ci::str_is_equal(token.data(), "@include")) {
-                auto includedClassInfos = parseInclude(status);
-                classInfos = kdl::vec_concat(classInfos, std::move(includedClassInfos));
+                parseInclude(status, classInfos.size(), includes);
             } else {
                 if (auto classInfo = parseClassInfo(status)) {
                     classInfos.push_back(std::move(*classInfo));
                 }
-                status.progress(m_tokenizer.progress());
             }
         }
 
@@ -700,42 +752,55 @@ namespace TrenchBroom {
             }
         }
 
-        std::vector<EntityDefinitionClassInfo> FgdParser::parseInclude(ParserStatus& status) {
+        void FgdParser::parseInclude(RecordingParserStatus& status, const size_t classInfoIndex, std::vector<PendingInclude>& includes) {
             auto token = expect(status, FgdToken::Word, m_tokenizer.nextToken());
             assert(kdl::ci::str_is_equal(token.data(), "@include"));
 
             expect(status, FgdToken::String, token = m_tokenizer.nextToken());
             const auto path = Path(token.data());
-            return handleInclude(status, path);
+            handleInclude(status, path, classInfoIndex, includes);
         }
 
-        std::vector<EntityDefinitionClassInfo> FgdParser::handleInclude(ParserStatus& status, const Path& path) {
+        void FgdParser::handleInclude(RecordingParserStatus& status, const Path& path, const size_t classInfoIndex, std::vector<PendingInclude>& includes) {
             if (m_fs == nullptr) {
-                status.error(m_tokenizer.line(), kdl::str_to_string("Cannot include file without host file path"));
-                return {};
+                status.error(m_tokenizer.line(), kdl::str_to_string("Cannot include file without host file path"));
+                return;
             }
-        
-            const auto snapshot = m_tokenizer.snapshotStateAndSource();
-            auto result = std::vector<EntityDefinitionClassInfo>();
+
             try {
                 status.debug(m_tokenizer.line(), "Parsing included file '" + path.asString() + "'");
-                const auto file = m_fs->openFile(currentRoot() + path);
+                auto file = m_fs->openFile(currentRoot() + path);
                 const auto filePath = file->path();
                 status.debug(m_tokenizer.line(), "Resolved '" + path.asString() + "' to '" + filePath.asString() + "'");
 
                 if (!isRecursiveInclude(filePath)) {
-                    const PushIncludePath pushIncludePath(this, filePath);
-                    auto reader = file->reader().buffer();
-                    m_tokenizer.replaceState(reader.stringView());
-                    result = parseClassInfos(status);
+                    includes.push_back(PendingInclude{classInfoIndex, status.messages().size(), m_tokenizer.line(), filePath, std::move(file)});
                 } else {
                     status.error(m_tokenizer.line(), kdl::str_to_string("Skipping recursively included file: ", path.asString(), " (", filePath, ")"));
                 }
             } catch (const Exception &e) {
                 status.error(m_tokenizer.line(), kdl::str_to_string("Failed to parse included file: ", e.what()));
             }
+        }
 
-            m_tokenizer.restoreStateAndSource(snapshot);
+        /**
+         * Parses the given include with a parser of its own, this is called on worker threads. Nothing may be thrown
+         * from here, so every failure is reported as a message of the include.
+         */
+        FgdParser::IncludeResult FgdParser::parsePendingInclude(const PendingInclude& include) const {
+            auto includeStatus = RecordingParserStatus{};
+            auto result = IncludeResult{};
+            try {
+                auto reader = include.file->reader().buffer();
+                auto parser = FgdParser(reader.stringView(), defaultEntityColor(), m_fs, kdl::vec_concat(m_paths, std::vector<Path>{include.path}));
+                result.classInfos = parser.parseClassInfos(includeStatus);
+                result.includedFiles = parser.includedFiles();
+            } catch (const std::exception& e) {
+                includeStatus.error(include.line, kdl::str_to_string("Failed to parse included file: ", e.what()));
+            } catch (...) {
+                includeStatus.error(include.line, "Failed to parse included file: unknown error");
+            }
+            result.messages = includeStatus.releaseMessages();
             return result;
         }
     }
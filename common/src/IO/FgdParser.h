@@ -38,9 +38,11 @@ namespace TrenchBroom {
     namespace IO {
         struct EntityDefinitionClassInfo;
         enum class EntityDefinitionClassType;
+        class File;
         class FileSystem;
         class ParserStatus;
         class Path;
+        class RecordingParserStatus;
 
         namespace FgdToken {
             using Type = unsigned int;
@@ -72,16 +74,22 @@ namespace TrenchBroom {
             using Token = FgdTokenizer::Token;
 
             std::vector<Path> m_paths;
+            std::vector<Path> m_includedFiles;
             std::shared_ptr<FileSystem> m_fs;
 
             FgdTokenizer m_tokenizer;
         public:
             FgdParser(std::string_view str, const Color& defaultEntityColor, const Path& path);
             FgdParser(std::string_view str, const Color& defaultEntityColor);
+
+            std::vector<Path> includedFiles() const override;
         private:
-            class PushIncludePath;
+            struct PendingInclude;
+            struct IncludeResult;
+
+            FgdParser(std::string_view str, const Color& defaultEntityColor, std::shared_ptr<FileSystem> fs, std::vector<Path> paths);
+
             void pushIncludePath(const Path& path);
-            void popIncludePath();
 
             Path currentRoot() const;
             bool isRecursiveInclude(const Path& path) const;
@@ -90,7 +98,7 @@ namespace TrenchBroom {
 
             std::vector<EntityDefinitionClassInfo> parseClassInfos(ParserStatus& status) override;
 
-            void parseClassInfoOrInclude(ParserStatus& status, std::vector<EntityDefinitionClassInfo>& classInfos);
+            void parseClassInfoOrInclude(RecordingParserStatus& status, std::vector<EntityDefinitionClassInfo>& classInfos, std::vector<PendingInclude>& includes);
 
             std::optional<EntityDefinitionClassInfo> parseClassInfo(ParserStatus& status);
             EntityDefinitionClassInfo parseSolidClassInfo(ParserStatus& status);
@@ -126,8 +134,9 @@ namespace TrenchBroom {
             Color parseColor(ParserStatus& status);
             std::string parseString(ParserStatus& status);
 
-            std::vector<EntityDefinitionClassInfo> parseInclude(ParserStatus& status);
-            std::vector<EntityDefinitionClassInfo> handleInclude(ParserStatus& status, const Path& path);
+            void parseInclude(RecordingParserStatus& status, size_t classInfoIndex, std::vector<PendingInclude>& includes);
+            void handleInclude(RecordingParserStatus& status, const Path& path, size_t classInfoIndex, std::vector<PendingInclude>& includes);
+            IncludeResult parsePendingInclude(const PendingInclude& include) const;
         };
     }
 }
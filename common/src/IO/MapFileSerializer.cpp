@@ -243,12 +243,17 @@ namespace TrenchBroom {
 
         void MapFileSerializer::doBeginFile(const std::vector<const Model::Node*>& rootNodes) {
             ensure(m_nodeToPrecomputedString.empty(), "MapFileSerializer may not be reused");
+            doPrepareNodes(rootNodes);
+        }
+
+        void MapFileSerializer::doEndFile() {}
 
+        void MapFileSerializer::doPrepareNodes(const std::vector<const Model::Node*>& nodes) {
             // collect nodes
             std::vector<std::variant<const Model::BrushNode*, const Model::PatchNode*>> nodesToSerialize;
-            nodesToSerialize.reserve(rootNodes.size());
+            nodesToSerialize.reserve(nodes.size());
 
-            Model::Node::visitAll(rootNodes, kdl::overload(
+            Model::Node::visitAll(nodes, kdl::overload(
                 [](auto&& thisLambda, const Model::WorldNode* world) { world->visitChildren(thisLambda); },
                 [](auto&& thisLambda, const Model::LayerNode* layer) { layer->visitChildren(thisLambda); },
                 [](auto&& thisLambda, const Model::GroupNode* group) { group->visitChildren(thisLambda); },
@@ -267,7 +272,7 @@ namespace TrenchBroom {
                 [&](const auto& node) {
                     return std::visit(kdl::overload(
                         [&](const Model::BrushNode* brushNode) {
-                            return Entry{brushNode, writeBrushFaces(brushNode->brush())};
+                            return Entry{brushNode, writeBrushFaces(brushNode->brushWithoutRestoringGeometry())};
                         },
                         [&](const Model::PatchNode* patchNode) {
                             return Entry{patchNode, writePatch(patchNode->patch())};
@@ -281,8 +286,6 @@ namespace TrenchBroom {
             }
         }
 
-        void MapFileSerializer::doEndFile() {}
-
         void MapFileSerializer::doBeginEntity(const Model::Node* /* node */) {
             fmt::format_to(std::ostreambuf_iterator<char>(m_stream), "// entity {}\n", entityNo());
             ++m_line;
@@ -317,6 +320,7 @@ namespace TrenchBroom {
             const PrecomputedString& precomputedString = it->second;
             m_stream << precomputedString.string;
             m_line += precomputedString.lineCount;
+            m_nodeToPrecomputedString.erase(it);
 
             fmt::format_to(std::ostreambuf_iterator<char>(m_stream), "}}\n");
             ++m_line;
@@ -341,6 +345,7 @@ namespace TrenchBroom {
             const PrecomputedString& precomputedString = it->second;
             m_stream << precomputedString.string;
             m_line += precomputedString.lineCount;
+            m_nodeToPrecomputedString.erase(it);
 
             setFilePosition(patchNode);
         }
@@ -57,6 +57,7 @@ namespace TrenchBroom {
         private:
             void doBeginFile(const std::vector<const Model::Node*>& rootNodes) override;
             void doEndFile() override;
+            void doPrepareNodes(const std::vector<const Model::Node*>& nodes) override;
 
             void doBeginEntity(const Model::Node* node) override;
             void doEndEntity(const Model::Node* node) override;
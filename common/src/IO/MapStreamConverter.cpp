@@ -0,0 +1,233 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "MapStreamConverter.h"
+
+#include "IO/MapFileSerializer.h"
+#include "IO/NodeSerializer.h"
+#include "IO/ParserStatus.h"
+#include "Model/Brush.h"
+#include "Model/BrushError.h"
+#include "Model/BrushFace.h"
+#include "Model/BrushNode.h"
+#include "Model/Entity.h"
+#include "Model/EntityNode.h"
+#include "Model/EntityProperties.h"
+#include "Model/MapFormat.h"
+#include "Model/PatchNode.h"
+
+#include <kdl/overload.h>
+#include <kdl/parallel.h>
+#include <kdl/result.h>
+#include <kdl/string_utils.h>
+#include <kdl/vector_utils.h>
+
+#include <algorithm>
+#include <cassert>
+#include <exception>
+#include <utility>
+
+namespace TrenchBroom {
+    namespace IO {
+        const size_t MapStreamConverter::DefaultChunkSize = 4096u;
+
+        MapStreamConverter::MapStreamConverter(std::string_view str, const Model::MapFormat sourceMapFormat, const Model::MapFormat targetMapFormat, std::ostream& stream, const size_t chunkSize) :
+        StandardMapParser{str, sourceMapFormat, targetMapFormat},
+        m_serializer{MapFileSerializer::create(targetMapFormat, stream)},
+        m_chunkSize{chunkSize} {
+            assert(m_chunkSize > 0u);
+        }
+
+        MapStreamConverter::~MapStreamConverter() = default;
+
+        void MapStreamConverter::convert(const vm::bbox3& worldBounds, ParserStatus& status) {
+            m_worldBounds = worldBounds;
+            m_serializer->beginFile({});
+            parseEntities(status);
+            m_serializer->endFile();
+        }
+
+        void MapStreamConverter::onBeginEntity(const size_t /* line */, std::vector<Model::EntityProperty> properties, ParserStatus& /* status */) {
+            assert(m_currentEntity == nullptr);
+
+            const auto& classname = Model::findProperty(properties, Model::EntityPropertyKeys::Classname);
+            if (Model::isWorldspawn(classname, properties)) {
+                updateValveVersion(properties);
+            }
+
+            // the node only receives the file position assigned by the serializer, its properties are written as is
+            m_currentEntity = std::make_unique<Model::EntityNode>(Model::Entity{});
+            m_serializer->beginEntity(m_currentEntity.get(), properties, {});
+        }
+
+        void MapStreamConverter::onEndEntity(const size_t /* startLine */, const size_t /* lineCount */, ParserStatus& status) {
+            assert(m_currentEntity != nullptr);
+
+            writeObjects(status);
+            m_serializer->endEntity(m_currentEntity.get());
+            m_currentEntity.reset();
+        }
+
+        void MapStreamConverter::updateValveVersion(std::vector<Model::EntityProperty>& worldspawnProperties) const {
+            const auto toParallel = Model::isParallelTexCoordSystem(m_targetMapFormat);
+            if (toParallel == Model::isParallelTexCoordSystem(m_sourceMapFormat)) {
+                return;
+            }
+
+            // Valve 220 maps are marked by a property of the worldspawn entity
+            auto it = std::find_if(std::begin(worldspawnProperties), std::end(worldspawnProperties), [](const Model::EntityProperty& property) {
+                return property.hasKey(Model::EntityPropertyKeys::ValveVersion);
+            });
+            if (toParallel) {
+                if (it != std::end(worldspawnProperties)) {
+                    it->setValue("220");
+                } else {
+                    worldspawnProperties.emplace_back(Model::EntityPropertyKeys::ValveVersion, "220");
+                }
+            } else if (it != std::end(worldspawnProperties)) {
+                worldspawnProperties.erase(it);
+            }
+        }
+
+        void MapStreamConverter::onBeginBrush(const size_t /* line */, ParserStatus& /* status */) {
+            m_objectInfos.push_back(BrushInfo{{}, 0, 0});
+        }
+
+        void MapStreamConverter::onEndBrush(const size_t startLine, const size_t lineCount, ParserStatus& status) {
+            assert(std::holds_alternative<BrushInfo>(m_objectInfos.back()));
+
+            BrushInfo& brush = std::get<BrushInfo>(m_objectInfos.back());
+            brush.startLine = startLine;
+            brush.lineCount = lineCount;
+
+            writeObjectsIfChunkIsFull(status);
+        }
+
+        void MapStreamConverter::onStandardBrushFace(const size_t line, const Model::MapFormat /* targetMapFormat */, const vm::vec3& point1, const vm::vec3& point2, const vm::vec3& point3, const Model::BrushFaceAttributes& attribs, ParserStatus& /* status */) {
+            assert(std::holds_alternative<BrushInfo>(m_objectInfos.back()));
+            std::get<BrushInfo>(m_objectInfos.back()).faces.push_back(StandardFaceInfo{line, point1, point2, point3, attribs});
+        }
+
+        void MapStreamConverter::onValveBrushFace(const size_t line, const Model::MapFormat /* targetMapFormat */, const vm::vec3& point1, const vm::vec3& point2, const vm::vec3& point3, const Model::BrushFaceAttributes& attribs, const vm::vec3& texAxisX, const vm::vec3& texAxisY, ParserStatus& /* status */) {
+            assert(std::holds_alternative<BrushInfo>(m_objectInfos.back()));
+            std::get<BrushInfo>(m_objectInfos.back()).faces.push_back(ValveFaceInfo{line, point1, point2, point3, attribs, texAxisX, texAxisY});
+        }
+
+        void MapStreamConverter::onPatch(const size_t startLine, const size_t lineCount, Model::MapFormat, const size_t rowCount, const size_t columnCount, std::vector<vm::vec<FloatType, 5>> controlPoints, std::string textureName, ParserStatus& status) {
+            m_objectInfos.push_back(PatchInfo{rowCount, columnCount, std::move(controlPoints), std::move(textureName), startLine, lineCount});
+            writeObjectsIfChunkIsFull(status);
+        }
+
+        void MapStreamConverter::writeObjectsIfChunkIsFull(ParserStatus& status) {
+            if (m_objectInfos.size() >= m_chunkSize) {
+                writeObjects(status);
+            }
+        }
+
+        namespace {
+            struct NodeError {
+                size_t line;
+                std::string msg;
+            };
+
+            struct CreateNodeResult {
+                std::unique_ptr<Model::Node> node;
+                std::vector<NodeError> errors;
+            };
+        }
+
+        /**
+         * Creates the brush faces of the given brush info in the given map format, which converts their texture
+         * coordinate systems if necessary, and creates a brush node from them.
+         */
+        static CreateNodeResult createBrushNode(MapStreamConverter::BrushInfo brushInfo, const Model::MapFormat targetMapFormat, const vm::bbox3& worldBounds) {
+            auto result = CreateNodeResult{};
+
+            auto faces = std::vector<Model::BrushFace>{};
+            faces.reserve(brushInfo.faces.size());
+
+            for (const auto& faceInfo : brushInfo.faces) {
+                const auto line = std::visit([](const auto& f) { return f.line; }, faceInfo);
+                std::visit(kdl::overload(
+                    [&](const MapStreamConverter::StandardFaceInfo& f) {
+                        return Model::BrushFace::createFromStandard(f.point1, f.point2, f.point3, f.attribs, targetMapFormat);
+                    },
+                    [&](const MapStreamConverter::ValveFaceInfo& f) {
+                        return Model::BrushFace::createFromValve(f.point1, f.point2, f.point3, f.attribs, f.texAxisX, f.texAxisY, targetMapFormat);
+                    }
+                ), faceInfo)
+                    .and_then([&](Model::BrushFace&& face) {
+                        face.setFilePosition(line, 1u);
+                        faces.push_back(std::move(face));
+                    }).handle_errors([&](const Model::BrushError e) {
+                        result.errors.push_back({line, kdl::str_to_string("Skipping face: ", e)});
+                    });
+            }
+
+            Model::Brush::create(worldBounds, std::move(faces))
+                .and_then([&](Model::Brush&& brush) {
+                    result.node = std::make_unique<Model::BrushNode>(std::move(brush));
+                }).handle_errors([&](const Model::BrushError e) {
+                    result.errors.push_back({brushInfo.startLine, kdl::str_to_string(e)});
+                });
+
+            return result;
+        }
+
+        void MapStreamConverter::writeObjects(ParserStatus& status) {
+            if (m_objectInfos.empty()) {
+                return;
+            }
+
+            auto results = kdl::vec_parallel_transform(std::move(m_objectInfos), [&](ObjectInfo&& objectInfo) {
+                // exceptions must not escape the worker, so they are reported as an error of the object
+                const auto startLine = std::visit([](const auto& info) { return info.startLine; }, objectInfo);
+                try {
+                    return std::visit(kdl::overload(
+                        [&](BrushInfo&& brushInfo) {
+                            return createBrushNode(std::move(brushInfo), m_targetMapFormat, m_worldBounds);
+                        },
+                        [&](PatchInfo&& patchInfo) {
+                            return CreateNodeResult{std::make_unique<Model::PatchNode>(Model::BezierPatch{patchInfo.rowCount, patchInfo.columnCount, std::move(patchInfo.controlPoints), std::move(patchInfo.textureName)}), {}};
+                        }
+                    ), std::move(objectInfo));
+                } catch (const std::exception& e) {
+                    return CreateNodeResult{nullptr, {{startLine, kdl::str_to_string("Skipping object: ", e.what())}}};
+                } catch (...) {
+                    return CreateNodeResult{nullptr, {{startLine, "Skipping object: unknown error"}}};
+                }
+            });
+            m_objectInfos.clear();
+
+            auto nodes = std::vector<const Model::Node*>{};
+            nodes.reserve(results.size());
+            for (const auto& result : results) {
+                for (const auto& error : result.errors) {
+                    status.error(error.line, error.msg);
+                }
+                if (result.node) {
+                    nodes.push_back(result.node.get());
+                }
+            }
+
+            m_serializer->entityObjects(nodes);
+        }
+    }
+}
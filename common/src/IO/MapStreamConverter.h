@@ -0,0 +1,134 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include "FloatType.h"
+#include "IO/StandardMapParser.h"
+#include "Model/BezierPatch.h"
+#include "Model/BrushFaceAttributes.h"
+
+#include <vecmath/bbox.h>
+#include <vecmath/vec.h>
+
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Model {
+        class EntityNode;
+        enum class MapFormat;
+    }
+
+    namespace IO {
+        class NodeSerializer;
+        class ParserStatus;
+
+        /**
+         * Converts a map file from one map format to another without creating a world.
+         *
+         * Every entity is written as soon as it has been parsed. Its brushes and patches are collected in chunks of
+         * a fixed size; the brushes of each chunk are created and converted to the target format in parallel, then
+         * the chunk is written and discarded. Therefore, only one chunk of brushes exists at any time, no matter how
+         * large the map is.
+         *
+         * Layers, groups and other information stored in entity properties are copied verbatim.
+         */
+        class MapStreamConverter : public StandardMapParser {
+        public:
+            static const size_t DefaultChunkSize;
+        public: // only public so that helper methods can see these declarations
+            struct StandardFaceInfo {
+                size_t line;
+                vm::vec3 point1, point2, point3;
+                Model::BrushFaceAttributes attribs;
+            };
+
+            struct ValveFaceInfo {
+                size_t line;
+                vm::vec3 point1, point2, point3;
+                Model::BrushFaceAttributes attribs;
+                vm::vec3 texAxisX, texAxisY;
+            };
+
+            using FaceInfo = std::variant<StandardFaceInfo, ValveFaceInfo>;
+
+            struct BrushInfo {
+                std::vector<FaceInfo> faces;
+                size_t startLine;
+                size_t lineCount;
+            };
+
+            struct PatchInfo {
+                size_t rowCount;
+                size_t columnCount;
+                std::vector<Model::BezierPatch::Point> controlPoints;
+                std::string textureName;
+                size_t startLine;
+                size_t lineCount;
+            };
+
+            using ObjectInfo = std::variant<BrushInfo, PatchInfo>;
+        private:
+            std::unique_ptr<NodeSerializer> m_serializer;
+            size_t m_chunkSize;
+            vm::bbox3 m_worldBounds;
+
+            std::unique_ptr<Model::EntityNode> m_currentEntity;
+            std::vector<ObjectInfo> m_objectInfos;
+        public:
+            /**
+             * Creates a new converter which parses the given string in the given source map format and writes it to
+             * the given stream in the given target format.
+             *
+             * @param str the string to parse
+             * @param sourceMapFormat the expected format of the given string
+             * @param targetMapFormat the format to write
+             * @param stream the stream to write to
+             * @param chunkSize the maximum number of brushes and patches that are created at once
+             */
+            MapStreamConverter(std::string_view str, Model::MapFormat sourceMapFormat, Model::MapFormat targetMapFormat, std::ostream& stream, size_t chunkSize = DefaultChunkSize);
+            ~MapStreamConverter() override;
+
+            /**
+             * Converts the map. Invalid brush faces and brushes are reported to the given status and skipped.
+             *
+             * @throws ParserException if parsing fails; the stream may contain partial output in this case
+             */
+            void convert(const vm::bbox3& worldBounds, ParserStatus& status);
+        private: // implement MapParser interface
+            void onBeginEntity(size_t line, std::vector<Model::EntityProperty> properties, ParserStatus& status) override;
+            void onEndEntity(size_t startLine, size_t lineCount, ParserStatus& status) override;
+            void onBeginBrush(size_t line, ParserStatus& status) override;
+            void onEndBrush(size_t startLine, size_t lineCount, ParserStatus& status) override;
+            void onStandardBrushFace(size_t line, Model::MapFormat targetMapFormat, const vm::vec3& point1, const vm::vec3& point2, const vm::vec3& point3, const Model::BrushFaceAttributes& attribs, ParserStatus& status) override;
+            void onValveBrushFace(size_t line, Model::MapFormat targetMapFormat, const vm::vec3& point1, const vm::vec3& point2, const vm::vec3& point3, const Model::BrushFaceAttributes& attribs, const vm::vec3& texAxisX, const vm::vec3& texAxisY, ParserStatus& status) override;
+            void onPatch(size_t startLine, size_t lineCount, Model::MapFormat targetMapFormat, size_t rowCount, size_t columnCount, std::vector<vm::vec<FloatType, 5>> controlPoints, std::string textureName, ParserStatus& status) override;
+        private:
+            void updateValveVersion(std::vector<Model::EntityProperty>& worldspawnProperties) const;
+            void writeObjectsIfChunkIsFull(ParserStatus& status);
+            void writeObjects(ParserStatus& status);
+        };
+    }
+}
@@ -160,6 +160,24 @@ namespace TrenchBroom {
             entityProperties(extraAttributes);
         }
 
+        void NodeSerializer::entityObjects(const std::vector<const Model::Node*>& nodes) {
+            doPrepareNodes(nodes);
+            for (const auto* node : nodes) {
+                node->accept(kdl::overload(
+                    [] (const Model::WorldNode*)   {},
+                    [] (const Model::LayerNode*)   {},
+                    [] (const Model::GroupNode*)   {},
+                    [] (const Model::EntityNode*)  {},
+                    [&](const Model::BrushNode* b) {
+                        brush(b);
+                    },
+                    [&](const Model::PatchNode* p)   {
+                        patch(p);
+                    }
+                ));
+            }
+        }
+
         void NodeSerializer::beginEntity(const Model::Node* node) {
             m_brushNo = 0;
             doBeginEntity(node);
@@ -284,5 +302,7 @@ namespace TrenchBroom {
             }
             return kdl::str_escape_if_necessary(str, "\"");
         }
+
+        void NodeSerializer::doPrepareNodes(const std::vector<const Model::Node*>& /* nodes */) {}
     }
 }
@@ -90,10 +90,19 @@ namespace TrenchBroom {
 
             void entity(const Model::Node* node, const std::vector<Model::EntityProperty>& properties, const std::vector<Model::EntityProperty>& parentProperties, const Model::Node* brushParent);
             void entity(const Model::Node* node, const std::vector<Model::EntityProperty>& properties, const std::vector<Model::EntityProperty>& parentProperties, const std::vector<Model::BrushNode*>& entityBrushes);
-        private:
+        public: // streaming
+            /**
+             * Writes an entity in chunks so that a map can be written without all of its nodes existing at once. Call
+             * beginEntity(), then entityObjects() any number of times, then endEntity().
+             *
+             * The brush and patch nodes passed to entityObjects() need not have been passed to beginFile(). They are
+             * prepared for serialization when they are written and may be destroyed afterwards.
+             */
             void beginEntity(const Model::Node* node, const std::vector<Model::EntityProperty>& properties, const std::vector<Model::EntityProperty>& extraAttributes);
-            void beginEntity(const Model::Node* node);
+            void entityObjects(const std::vector<const Model::Node*>& nodes);
             void endEntity(const Model::Node* node);
+        private:
+            void beginEntity(const Model::Node* node);
 
             void entityProperties(const std::vector<Model::EntityProperty>& properties);
             void entityProperty(const Model::EntityProperty& property);
@@ -117,6 +126,8 @@ namespace TrenchBroom {
             virtual void doBeginFile(const std::vector<const Model::Node*>& nodes) = 0;
             virtual void doEndFile() = 0;
 
+            virtual void doPrepareNodes(const std::vector<const Model::Node*>& nodes);
+
             virtual void doBeginEntity(const Model::Node* node) = 0;
             virtual void doEndEntity(const Model::Node* node) = 0;
             virtual void doEntityProperty(const Model::EntityProperty& property) = 0;
@@ -21,6 +21,7 @@
 
 #include "Ensure.h"
 #include "Assets/Texture.h"
+#include "Model/Brush.h"
 #include "Model/BrushNode.h"
 #include "Model/BrushFace.h"
 #include "Model/BrushGeometry.h"
@@ -32,6 +33,7 @@
 #include <fmt/format.h>
 
 #include <iostream>
+#include <optional>
 
 namespace TrenchBroom {
     namespace IO {
@@ -165,14 +167,23 @@ namespace TrenchBroom {
         void ObjSerializer::doEndEntity(const Model::Node* /* node */) {}
         void ObjSerializer::doEntityProperty(const Model::EntityProperty& /* property */) {}
 
-        void ObjSerializer::doBrush(const Model::BrushNode* brush) {
+        void ObjSerializer::doBrush(const Model::BrushNode* brushNode) {
+            // the face vertices are needed, so the geometry of an unused brush is restored on a copy
+            const auto& nodeBrush = brushNode->brushWithoutRestoringGeometry();
+            auto restoredBrush = std::optional<Model::Brush>{};
+            if (nodeBrush.geometryCompacted()) {
+                restoredBrush = nodeBrush;
+                restoredBrush->restoreGeometry();
+            }
+            const auto& brush = restoredBrush ? *restoredBrush : nodeBrush;
+
             m_currentBrush = BrushObject{entityNo(), brushNo(), {}};
-            m_currentBrush->faces.reserve(brush->brush().faceCount());
+            m_currentBrush->faces.reserve(brush.faceCount());
 
             // Vertex positions inserted from now on should get new indices
             m_vertices.clearIndices();
 
-            for (const Model::BrushFace& face : brush->brush().faces()) {
+            for (const Model::BrushFace& face : brush.faces()) {
                 doBrushFace(face);
             }
 
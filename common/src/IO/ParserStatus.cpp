@@ -101,6 +101,10 @@ namespace TrenchBroom {
             throw ParserException(buildMessage(str));
         }
 
+        void ParserStatus::logRecorded(const LogLevel level, const std::string& message) {
+            doLog(level, m_prefix.empty() ? message : m_prefix + ": " + message);
+        }
+
         void ParserStatus::log(const LogLevel level, const size_t line, const size_t column, const std::string& str) {
             doLog(level, buildMessage(line, column, str));
         }
@@ -54,6 +54,12 @@ namespace TrenchBroom {
             void warn(const std::string& str);
             void error(const std::string& str);
             [[noreturn]] void errorAndThrow(const std::string& str);
+
+            /**
+             * Logs a message that was already built by another parser status without a prefix, e.g. a message recorded
+             * by a RecordingParserStatus. Only this status' prefix is added.
+             */
+            void logRecorded(LogLevel level, const std::string& message);
         private:
             void log(LogLevel level, size_t line, size_t column, const std::string& str);
             std::string buildMessage(size_t line, size_t column, const std::string& str) const;
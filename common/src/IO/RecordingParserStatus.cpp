@@ -0,0 +1,55 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "RecordingParserStatus.h"
+
+#include "Logger.h"
+
+namespace TrenchBroom {
+    namespace IO {
+        static NullLogger& nullLogger() {
+            static auto logger = NullLogger{};
+            return logger;
+        }
+
+        RecordingParserStatus::RecordingParserStatus() :
+        ParserStatus(nullLogger(), "") {}
+
+        const std::vector<RecordingParserStatus::Message>& RecordingParserStatus::messages() const {
+            return m_messages;
+        }
+
+        std::vector<RecordingParserStatus::Message> RecordingParserStatus::releaseMessages() {
+            return std::move(m_messages);
+        }
+
+        void RecordingParserStatus::replay(const std::vector<Message>& messages, ParserStatus& status) {
+            for (const auto& [level, message] : messages) {
+                status.logRecorded(level, message);
+            }
+        }
+
+        void RecordingParserStatus::doProgress(const double /* progress */) {}
+
+        void RecordingParserStatus::doLog(const LogLevel level, const std::string& str) {
+            m_messages.emplace_back(level, str);
+        }
+    }
+}
@@ -0,0 +1,58 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include "IO/ParserStatus.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace TrenchBroom {
+    enum class LogLevel;
+
+    namespace IO {
+        /**
+         * Records the messages that are logged to it instead of logging them, so that they can be replayed to another
+         * parser status later. This is used for parsers that run on worker threads and for parse results that are
+         * reused from a cache. Progress is not recorded.
+         */
+        class RecordingParserStatus : public ParserStatus {
+        public:
+            using Message = std::pair<LogLevel, std::string>;
+        private:
+            std::vector<Message> m_messages;
+        public:
+            RecordingParserStatus();
+
+            const std::vector<Message>& messages() const;
+            std::vector<Message> releaseMessages();
+
+            /**
+             * Logs the given recorded messages to the given parser status in the order in which they were recorded.
+             */
+            static void replay(const std::vector<Message>& messages, ParserStatus& status);
+        private:
+            void doProgress(double progress) override;
+            void doLog(LogLevel level, const std::string& str) override;
+        };
+    }
+}
@@ -55,12 +55,19 @@ namespace TrenchBroom {
         // WorldReader
 
         WorldReader::WorldReader(std::string_view str, const Model::MapFormat sourceAndTargetMapFormat, const Model::EntityPropertyConfig& entityPropertyConfig) :
-        MapReader(std::move(str), sourceAndTargetMapFormat, sourceAndTargetMapFormat, entityPropertyConfig),
-        m_world(std::make_unique<Model::WorldNode>(entityPropertyConfig, Model::Entity{}, sourceAndTargetMapFormat)) {
+        WorldReader(std::move(str), sourceAndTargetMapFormat, sourceAndTargetMapFormat, entityPropertyConfig) {}
+
+        WorldReader::WorldReader(std::string_view str, const Model::MapFormat sourceMapFormat, const Model::MapFormat targetMapFormat, const Model::EntityPropertyConfig& entityPropertyConfig) :
+        MapReader(std::move(str), sourceMapFormat, targetMapFormat, entityPropertyConfig),
+        m_world(std::make_unique<Model::WorldNode>(entityPropertyConfig, Model::Entity{}, targetMapFormat)) {
             m_world->disableNodeTreeUpdates();
         }
 
         std::unique_ptr<Model::WorldNode> WorldReader::tryRead(std::string_view str, const std::vector<Model::MapFormat>& mapFormatsToTry, const vm::bbox3& worldBounds, const Model::EntityPropertyConfig& entityPropertyConfig, ParserStatus& status) {
+            return tryRead(str, mapFormatsToTry, Model::MapFormat::Unknown, worldBounds, entityPropertyConfig, status);
+        }
+
+        std::unique_ptr<Model::WorldNode> WorldReader::tryRead(std::string_view str, const std::vector<Model::MapFormat>& mapFormatsToTry, const Model::MapFormat targetMapFormat, const vm::bbox3& worldBounds, const Model::EntityPropertyConfig& entityPropertyConfig, ParserStatus& status) {
             std::vector<std::tuple<Model::MapFormat, std::string>> parserExceptions;
 
             for (const auto mapFormat : mapFormatsToTry) {
@@ -69,7 +76,8 @@ namespace TrenchBroom {
                 }
 
                 try {
-                    WorldReader reader{str, mapFormat, entityPropertyConfig};
+                    const auto readerTargetMapFormat = targetMapFormat != Model::MapFormat::Unknown ? targetMapFormat : mapFormat;
+                    WorldReader reader{str, mapFormat, readerTargetMapFormat, entityPropertyConfig};
                     return reader.read(worldBounds, status);
                 } catch (const ParserException& e) {
                     parserExceptions.emplace_back(mapFormat, std::string{e.what()});
@@ -49,6 +49,7 @@ namespace TrenchBroom {
             std::unique_ptr<Model::WorldNode> m_world;
         public:
             WorldReader(std::string_view str, Model::MapFormat sourceAndTargetMapFormat, const Model::EntityPropertyConfig& entityPropertyConfig);
+            WorldReader(std::string_view str, Model::MapFormat sourceMapFormat, Model::MapFormat targetMapFormat, const Model::EntityPropertyConfig& entityPropertyConfig);
 
             std::unique_ptr<Model::WorldNode> read(const vm::bbox3& worldBounds, ParserStatus& status);
 
@@ -64,6 +65,20 @@ namespace TrenchBroom {
              * @throws WorldReaderException if `str` can't be parsed by any of the given formats
              */
             static std::unique_ptr<Model::WorldNode> tryRead(std::string_view str, const std::vector<Model::MapFormat>& mapFormatsToTry, const vm::bbox3& worldBounds, const Model::EntityPropertyConfig& entityPropertyConfig, ParserStatus& status);
+
+            /**
+             * Like the above, but converts the parsed brushes to the given target format while reading. If the
+             * target format is Model::MapFormat::Unknown, the world keeps the format it was parsed as.
+             *
+             * @param str the string to parse
+             * @param mapFormatsToTry formats to try, in order
+             * @param targetMapFormat the format of the returned world
+             * @param worldBounds world bounds
+             * @param status status
+             * @return the world node
+             * @throws WorldReaderException if `str` can't be parsed by any of the given formats
+             */
+            static std::unique_ptr<Model::WorldNode> tryRead(std::string_view str, const std::vector<Model::MapFormat>& mapFormatsToTry, Model::MapFormat targetMapFormat, const vm::bbox3& worldBounds, const Model::EntityPropertyConfig& entityPropertyConfig, ParserStatus& status);
         private:            
             void sanitizeLayerSortIndicies(ParserStatus& status);            
         private: // implement MapReader interface
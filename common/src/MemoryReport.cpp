@@ -0,0 +1,94 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MemoryReport.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <iterator>
+#include <ostream>
+
+namespace TrenchBroom {
+    void MemoryReport::addSubsystem(std::string name, const size_t count, const size_t bytes) {
+        m_subsystems.push_back(MemoryUsage{std::move(name), count, bytes});
+    }
+
+    void MemoryReport::addBreakdown(std::string name, std::vector<MemoryUsage> items, const size_t maxItems) {
+        const auto count = std::min(maxItems, items.size());
+        std::partial_sort(std::begin(items), std::next(std::begin(items), static_cast<std::ptrdiff_t>(count)), std::end(items),
+            [](const auto& lhs, const auto& rhs) { return lhs.bytes > rhs.bytes; });
+        items.resize(count);
+
+        m_breakdowns.emplace_back(std::move(name), std::move(items));
+    }
+
+    const std::vector<MemoryUsage>& MemoryReport::subsystems() const {
+        return m_subsystems;
+    }
+
+    const std::vector<MemoryReport::Breakdown>& MemoryReport::breakdowns() const {
+        return m_breakdowns;
+    }
+
+    size_t MemoryReport::totalBytes() const {
+        auto result = size_t(0);
+        for (const auto& subsystem : m_subsystems) {
+            result += subsystem.bytes;
+        }
+        return result;
+    }
+
+    size_t heapMemoryUsage(const std::string& str) {
+        static const auto inlineCapacity = std::string{}.capacity();
+        return str.capacity() > inlineCapacity ? str.capacity() + 1u : 0u;
+    }
+
+    std::string formatMemorySize(const size_t bytes) {
+        static const char* Units[] = { "B", "KiB", "MiB", "GiB" };
+
+        auto size = static_cast<double>(bytes);
+        auto unit = size_t(0);
+        while (size >= 1024.0 && unit < 3u) {
+            size /= 1024.0;
+            ++unit;
+        }
+
+        char buffer[64];
+        if (unit == 0u) {
+            std::snprintf(buffer, sizeof(buffer), "%zu %s", bytes, Units[unit]);
+        } else {
+            std::snprintf(buffer, sizeof(buffer), "%.1f %s", size, Units[unit]);
+        }
+        return buffer;
+    }
+
+    std::ostream& operator<<(std::ostream& str, const MemoryReport& report) {
+        str << "Memory usage: " << formatMemorySize(report.totalBytes()) << "\n";
+        for (const auto& subsystem : report.subsystems()) {
+            str << "  " << subsystem.name << ": " << formatMemorySize(subsystem.bytes) << " (" << subsystem.count << " objects)\n";
+        }
+        for (const auto& [name, items] : report.breakdowns()) {
+            str << name << ":\n";
+            for (const auto& item : items) {
+                str << "  " << item.name << ": " << formatMemorySize(item.bytes) << "\n";
+            }
+        }
+        return str;
+    }
+}
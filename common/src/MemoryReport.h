@@ -0,0 +1,76 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace TrenchBroom {
+    struct MemoryUsage {
+        std::string name;
+        size_t count;
+        size_t bytes;
+    };
+
+    /**
+     * Collects the memory used by the subsystems of a document. Every subsystem reports the number of objects it
+     * holds and the number of bytes allocated for them. In addition, a report can contain breakdowns that list the
+     * largest individual consumers, e.g. the largest nodes or undo commands.
+     *
+     * The reported sizes are estimates computed from the sizes of the objects and the capacities of their
+     * containers. They don't include allocator overhead.
+     */
+    class MemoryReport {
+    public:
+        using Breakdown = std::pair<std::string, std::vector<MemoryUsage>>;
+    private:
+        std::vector<MemoryUsage> m_subsystems;
+        std::vector<Breakdown> m_breakdowns;
+    public:
+        void addSubsystem(std::string name, size_t count, size_t bytes);
+
+        /**
+         * Adds a breakdown with the given name. The given items are sorted by their size in descending order, and
+         * only the given maximum number of items is kept.
+         */
+        void addBreakdown(std::string name, std::vector<MemoryUsage> items, size_t maxItems);
+
+        const std::vector<MemoryUsage>& subsystems() const;
+        const std::vector<Breakdown>& breakdowns() const;
+
+        /**
+         * Returns the sum of the bytes reported by all subsystems.
+         */
+        size_t totalBytes() const;
+    };
+
+    /**
+     * Returns the number of bytes that the given string has allocated on the heap. Strings that are short enough to
+     * be stored in the string object itself don't allocate.
+     */
+    size_t heapMemoryUsage(const std::string& str);
+
+    std::string formatMemorySize(size_t bytes);
+
+    std::ostream& operator<<(std::ostream& str, const MemoryReport& report);
+}
@@ -20,6 +20,7 @@
 #include "BezierPatch.h"
 
 #include "Ensure.h"
+#include "MemoryReport.h"
 #include "Assets/Texture.h"
 
 #include <vecmath/bezier_surface.h>
@@ -102,6 +103,12 @@ namespace TrenchBroom {
             return m_bounds;
         }
 
+        size_t BezierPatch::memoryUsage() const {
+            return sizeof(BezierPatch)
+                + m_controlPoints.capacity() * sizeof(Point)
+                + heapMemoryUsage(m_textureName);
+        }
+
         const std::string& BezierPatch::textureName() const {
             return m_textureName;
         }
@@ -72,6 +72,11 @@ namespace TrenchBroom {
 
             const vm::bbox3& bounds() const;
 
+            /**
+             * Returns the number of bytes allocated for this patch and its control points.
+             */
+            size_t memoryUsage() const;
+
             const std::string& textureName() const;
             void setTextureName(std::string textureName);
 
@@ -21,11 +21,14 @@
 
 #include "Exceptions.h"
 #include "FloatType.h"
+#include "MemoryReport.h"
 #include "Polyhedron.h"
 #include "Polyhedron_Matcher.h"
 #include "Model/BrushError.h"
 #include "Model/BrushFace.h"
 #include "Model/BrushGeometry.h"
+#include "Model/CompactBrushGeometry.h"
+#include "Model/ConvexPolyhedronSnapshot.h"
 #include "Model/MapFormat.h"
 #include "Model/TexCoordSystem.h"
 
@@ -62,7 +65,8 @@ namespace TrenchBroom {
 
         Brush::Brush(const Brush& other) :
         m_faces(other.m_faces),
-        m_geometry(other.m_geometry ? std::make_unique<BrushGeometry>(*other.m_geometry, CopyCallback()) : nullptr) {
+        m_geometry(other.m_geometry ? std::make_unique<BrushGeometry>(*other.m_geometry, CopyCallback()) : nullptr),
+        m_compactGeometry(other.m_compactGeometry ? std::make_unique<CompactBrushGeometry>(*other.m_compactGeometry) : nullptr) {
             if (m_geometry) {
                 for (BrushFaceGeometry* faceGeometry : m_geometry->faces()) {
                     if (const auto faceIndex = faceGeometry->payload()) {
@@ -75,7 +79,8 @@ namespace TrenchBroom {
 
         Brush::Brush(Brush&& other) noexcept :
         m_faces(std::move(other.m_faces)),
-        m_geometry(std::move(other.m_geometry)) {}
+        m_geometry(std::move(other.m_geometry)),
+        m_compactGeometry(std::move(other.m_compactGeometry)) {}
 
         Brush& Brush::operator=(Brush other) noexcept {
             using std::swap;
@@ -87,6 +92,7 @@ namespace TrenchBroom {
             using std::swap;
             swap(lhs.m_faces, rhs.m_faces);
             swap(lhs.m_geometry, rhs.m_geometry);
+            swap(lhs.m_compactGeometry, rhs.m_compactGeometry);
         }
         
         Brush::~Brush() = default;
@@ -139,6 +145,7 @@ namespace TrenchBroom {
 
             m_faces = std::move(remainingFaces);
             m_geometry = std::move(geometry);
+            m_compactGeometry.reset();
             
             assert(checkFaceLinks());
 
@@ -146,10 +153,63 @@ namespace TrenchBroom {
         }
         
         const vm::bbox3& Brush::bounds() const {
+            if (m_compactGeometry) {
+                return m_compactGeometry->bounds();
+            }
+
             ensure(m_geometry != nullptr, "geometry is null");
             return m_geometry->bounds();
         }
 
+        size_t Brush::memoryUsage() const {
+            auto result = sizeof(Brush) + m_faces.capacity() * sizeof(BrushFace);
+            for (const auto& face : m_faces) {
+                result += heapMemoryUsage(face.attributes().textureName());
+            }
+
+            if (m_compactGeometry) {
+                result += m_compactGeometry->memoryUsage();
+            } else if (m_geometry) {
+                result += m_geometry->memoryUsage();
+            }
+            return result;
+        }
+
+        void Brush::compactGeometry() {
+            if (m_compactGeometry) {
+                return;
+            }
+
+            ensure(m_geometry != nullptr, "geometry is null");
+            m_compactGeometry = std::make_unique<CompactBrushGeometry>(*m_geometry);
+            for (auto& face : m_faces) {
+                face.setGeometry(nullptr);
+            }
+            m_geometry.reset();
+        }
+
+        void Brush::restoreGeometry() {
+            if (!m_compactGeometry) {
+                return;
+            }
+
+            m_geometry = std::make_unique<BrushGeometry>(m_compactGeometry->restore());
+            for (BrushFaceGeometry* faceGeometry : m_geometry->faces()) {
+                m_faces[*faceGeometry->payload()].setGeometry(faceGeometry);
+            }
+            m_compactGeometry.reset();
+
+            assert(checkFaceLinks());
+        }
+
+        bool Brush::geometryCompacted() const {
+            return m_compactGeometry != nullptr;
+        }
+
+        const CompactBrushGeometry* Brush::compactedGeometry() const {
+            return m_compactGeometry.get();
+        }
+
         std::optional<size_t> Brush::findFace(const std::string& textureName) const {
             return kdl::vec_index_of(m_faces, [&](const BrushFace& face) { return face.attributes().textureName() == textureName; });
         }
@@ -918,7 +978,17 @@ namespace TrenchBroom {
         }
 
         bool Brush::contains(const Brush& brush) const {
-            return m_geometry->contains(*brush.m_geometry);
+            if (!bounds().contains(brush.bounds())) {
+                return false;
+            }
+            return convexSnapshot().contains(brush.convexSnapshot());
+        }
+
+        bool Brush::contains(const ConvexPolyhedronSnapshot& snapshot, const Brush& brush) const {
+            if (!bounds().contains(brush.bounds())) {
+                return false;
+            }
+            return snapshot.contains(brush.convexSnapshot());
         }
 
         bool Brush::intersects(const vm::bbox3& bounds) const {
@@ -926,7 +996,26 @@ namespace TrenchBroom {
         }
 
         bool Brush::intersects(const Brush& brush) const {
-            return m_geometry->intersects(*brush.m_geometry);
+            if (!bounds().intersects(brush.bounds())) {
+                return false;
+            }
+            return convexSnapshot().intersects(brush.convexSnapshot());
+        }
+
+        bool Brush::intersects(const ConvexPolyhedronSnapshot& snapshot, const Brush& brush) const {
+            if (!bounds().intersects(brush.bounds())) {
+                return false;
+            }
+            return snapshot.intersects(brush.convexSnapshot());
+        }
+
+        ConvexPolyhedronSnapshot Brush::convexSnapshot() const {
+            if (m_compactGeometry) {
+                return ConvexPolyhedronSnapshot(*m_compactGeometry);
+            }
+
+            ensure(m_geometry != nullptr, "geometry is null");
+            return ConvexPolyhedronSnapshot(*m_geometry);
         }
 
         kdl::result<Brush, BrushError> Brush::createBrush(const MapFormat mapFormat, const vm::bbox3& worldBounds, const std::string& defaultTextureName, const BrushGeometry& geometry, const std::vector<const Brush*>& subtrahends) const {
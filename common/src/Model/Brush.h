@@ -36,6 +36,9 @@ namespace TrenchBroom {
     namespace Model {
         template <typename P> class PolyhedronMatcher;
 
+        class CompactBrushGeometry;
+        class ConvexPolyhedronSnapshot;
+
         enum class BrushError;
         enum class MapFormat;
 
@@ -53,6 +56,7 @@ namespace TrenchBroom {
         private:
             std::vector<BrushFace> m_faces;
             std::unique_ptr<BrushGeometry> m_geometry;
+            std::unique_ptr<CompactBrushGeometry> m_compactGeometry;
         public:
             Brush();
 
@@ -71,6 +75,33 @@ namespace TrenchBroom {
             kdl::result<void, BrushError> updateGeometryFromFaces(const vm::bbox3& worldBounds);
         public:
             const vm::bbox3& bounds() const;
+
+            /**
+             * Returns the number of bytes allocated for this brush, its faces and its geometry, regardless of whether
+             * the geometry is compacted or not.
+             */
+            size_t memoryUsage() const;
+        public: // geometry compaction
+            /**
+             * Replaces the half edge geometry of this brush with a compact representation that uses much less memory.
+             *
+             * While the geometry is compacted, only the faces' attributes and boundaries, the bounds, containsPoint, the
+             * brush intersection and containment tests and the compacted geometry itself may be accessed. Everything else requires the half edge geometry and must
+             * not be called before restoreGeometry() has been called.
+             */
+            void compactGeometry();
+
+            /**
+             * Restores the half edge geometry of this brush if it was compacted.
+             */
+            void restoreGeometry();
+
+            bool geometryCompacted() const;
+
+            /**
+             * Returns the compacted geometry, or null if the geometry is not compacted.
+             */
+            const CompactBrushGeometry* compactedGeometry() const;
         public: // face management:
             std::optional<size_t> findFace(const std::string& textureName) const;
             std::optional<size_t> findFace(const vm::vec3& normal) const;
@@ -243,6 +274,19 @@ namespace TrenchBroom {
             bool contains(const Brush& brush) const;
             bool intersects(const vm::bbox3& bounds) const;
             bool intersects(const Brush& brush) const;
+
+            /**
+             * Same as contains(const Brush&) and intersects(const Brush&), but these use the given snapshot of this
+             * brush instead of taking a new one. Use them when one brush is tested against many others.
+             */
+            bool contains(const ConvexPolyhedronSnapshot& snapshot, const Brush& brush) const;
+            bool intersects(const ConvexPolyhedronSnapshot& snapshot, const Brush& brush) const;
+
+            /**
+             * Returns a snapshot of this brush's geometry for intersection and containment tests. The snapshot can be
+             * taken regardless of whether the geometry is compacted.
+             */
+            ConvexPolyhedronSnapshot convexSnapshot() const;
         private:
             /**
              * Final step of CSG subtraction; takes the geometry that is the result of the subtraction, and turns it
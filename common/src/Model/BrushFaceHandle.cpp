@@ -31,7 +31,7 @@ namespace TrenchBroom {
         m_node(node),
         m_faceIndex(faceIndex) {
             assert(m_node != nullptr);
-            ensure(m_faceIndex < m_node->brush().faceCount(), "face index must be valid");
+            ensure(m_faceIndex < m_node->brushWithoutRestoringGeometry().faceCount(), "face index must be valid");
         }
 
         BrushNode* BrushFaceHandle::node() const {
@@ -43,7 +43,7 @@ namespace TrenchBroom {
         }
         
         const BrushFace& BrushFaceHandle::face() const {
-            return m_node->brush().face(m_faceIndex);
+            return m_node->brushWithoutRestoringGeometry().face(m_faceIndex);
         }
 
         bool operator==(const BrushFaceHandle& lhs, const BrushFaceHandle& rhs) {
@@ -60,8 +60,8 @@ namespace TrenchBroom {
 
         std::vector<BrushFaceHandle> toHandles(BrushNode* brushNode) {
             std::vector<BrushFaceHandle> result;
-            result.reserve(brushNode->brush().faceCount());
-            for (size_t i = 0u; i < brushNode->brush().faceCount(); ++i) {
+            result.reserve(brushNode->brushWithoutRestoringGeometry().faceCount());
+            for (size_t i = 0u; i < brushNode->brushWithoutRestoringGeometry().faceCount(); ++i) {
                 result.emplace_back(brushNode, i);
             }
             return result;
@@ -37,7 +37,7 @@ namespace TrenchBroom {
         }
 
         BrushFaceHandle BrushFaceReference::resolve() const {
-            if (const auto faceIndex = m_node->brush().findFace(m_facePlane)) {
+            if (const auto faceIndex = m_node->brushWithoutRestoringGeometry().findFace(m_facePlane)) {
                 return BrushFaceHandle(m_node, *faceIndex);
             } else {
                 throw BrushFaceReferenceException();
@@ -29,6 +29,7 @@
 #include "Model/BrushFace.h"
 #include "Model/BrushFaceHandle.h"
 #include "Model/BrushGeometry.h"
+#include "Model/CompactBrushGeometry.h"
 #include "Model/EditorContext.h"
 #include "Model/EntityNode.h"
 #include "Model/GroupNode.h"
@@ -57,6 +58,7 @@
 #include <vecmath/util.h>
 
 #include <algorithm> // for std::remove
+#include <cassert>
 #include <iterator>
 #include <set>
 #include <string>
@@ -94,8 +96,32 @@ namespace TrenchBroom {
         }
 
         const Brush& BrushNode::brush() const {
+            ensure(!m_brush.geometryCompacted(), "brush geometry must be restored before it is accessed");
             return m_brush;
         }
+
+        const Brush& BrushNode::brushWithoutRestoringGeometry() const {
+            return m_brush;
+        }
+
+        void BrushNode::restoreGeometry() {
+            m_brush.restoreGeometry();
+            m_geometryUsed = true;
+        }
+
+        bool BrushNode::compactGeometryIfUnused() {
+            if (m_brush.geometryCompacted() || transitivelySelected() || hasSelectedFaces()) {
+                return false;
+            }
+
+            if (m_geometryUsed) {
+                m_geometryUsed = false;
+                return false;
+            }
+
+            m_brush.compactGeometry();
+            return true;
+        }
         
         Brush BrushNode::setBrush(Brush brush) {
             const auto nodeChange = NotifyNodeChange{*this};
@@ -103,8 +129,13 @@ namespace TrenchBroom {
 
             using std::swap;
             swap(m_brush, brush);
+            m_geometryUsed = true;
             
             updateSelectedFaceCount();
+            if (transitivelySelected() || hasSelectedFaces()) {
+                // the new brush may be a copy of an unused brush, but tools expect the geometry of selected brushes
+                m_brush.restoreGeometry();
+            }
             invalidateIssues();
             invalidateVertexCache();
 
@@ -156,14 +187,30 @@ namespace TrenchBroom {
                 [](const LayerNode*)          { return false; },
                 [&](const GroupNode* group)   { return m_brush.contains(group->logicalBounds()); },
                 [&](const EntityNode* entity) { return m_brush.contains(entity->logicalBounds()); },
-                [&](const BrushNode* brush)   { return m_brush.contains(brush->brush()); },
+                [&](const BrushNode* other)   { return m_brush.contains(other->brushWithoutRestoringGeometry()); },
+                [&](const PatchNode* patch)   { return containsPatch(m_brush, patch->grid()); }
+            ));
+        }
+
+        bool BrushNode::contains(const ConvexPolyhedronSnapshot& snapshot, const Node* node) const {
+            return node->accept(kdl::overload(
+                [](const WorldNode*)          { return false; },
+                [](const LayerNode*)          { return false; },
+                [&](const GroupNode* group)   { return m_brush.contains(group->logicalBounds()); },
+                [&](const EntityNode* entity) { return m_brush.contains(entity->logicalBounds()); },
+                [&](const BrushNode* other)   { return m_brush.contains(snapshot, other->brushWithoutRestoringGeometry()); },
                 [&](const PatchNode* patch)   { return containsPatch(m_brush, patch->grid()); }
             ));
         }
 
-        static bool faceIntersectsEdge(const BrushFace& face, const vm::vec3& p0, const vm::vec3& p1) {
+        static bool faceIntersectsEdge(const Brush& brush, const size_t faceIndex, const vm::vec3& p0, const vm::vec3& p1) {
             const auto ray = vm::ray3{p0, p1 - p0}; // not normalized
-            if (const auto dist = face.intersectWithRay(ray); !vm::is_nan(dist)) {
+            const auto& face = brush.face(faceIndex);
+            const auto* compactGeometry = brush.compactedGeometry();
+            const auto dist = compactGeometry != nullptr
+                ? compactGeometry->intersectFaceWithRay(faceIndex, face.boundary(), ray)
+                : face.intersectWithRay(ray);
+            if (!vm::is_nan(dist)) {
                 // dist is scaled by inverse of vm::length(p1 - p0)
                 return dist >= 0.0 && dist <= 1.0;
             }
@@ -183,13 +230,13 @@ namespace TrenchBroom {
             }
 
             // now check if any quad edge of the given grid intersects with any face
-            for (const auto& face : brush.faces()) {
+            for (size_t faceIndex = 0u; faceIndex < brush.faceCount(); ++faceIndex) {
                 // check row edges
                 for (size_t row = 0u; row < grid.pointRowCount; ++row) {
                     for (size_t col = 0u; col < grid.pointColumnCount - 1u; ++col) {
                         const auto& p0 = grid.point(row, col).position;
                         const auto& p1 = grid.point(row, col + 1u).position;
-                        if (faceIntersectsEdge(face, p0, p1)) {
+                        if (faceIntersectsEdge(brush, faceIndex, p0, p1)) {
                             return true;
                         }
                     }
@@ -199,7 +246,7 @@ namespace TrenchBroom {
                     for (size_t row = 0u; row < grid.pointRowCount - 1u; ++row) {
                         const auto& p0 = grid.point(row, col).position;
                         const auto& p1 = grid.point(row + 1u, col).position;
-                        if (faceIntersectsEdge(face, p0, p1)) {
+                        if (faceIntersectsEdge(brush, faceIndex, p0, p1)) {
                             return true;
                         }
                     }
@@ -215,7 +262,18 @@ namespace TrenchBroom {
                 [](const LayerNode*)          { return false; },
                 [&](const GroupNode* group)   { return m_brush.intersects(group->logicalBounds()); },
                 [&](const EntityNode* entity) { return m_brush.intersects(entity->logicalBounds()); },
-                [&](const BrushNode* brush)   { return m_brush.intersects(brush->brush()); },
+                [&](const BrushNode* other)   { return m_brush.intersects(other->brushWithoutRestoringGeometry()); },
+                [&](const PatchNode* patch)   { return intersectsPatch(m_brush, patch->grid()); }
+            ));
+        }
+
+        bool BrushNode::intersects(const ConvexPolyhedronSnapshot& snapshot, const Node* node) const {
+            return node->accept(kdl::overload(
+                [](const WorldNode*)          { return false; },
+                [](const LayerNode*)          { return false; },
+                [&](const GroupNode* group)   { return m_brush.intersects(group->logicalBounds()); },
+                [&](const EntityNode* entity) { return m_brush.intersects(entity->logicalBounds()); },
+                [&](const BrushNode* other)   { return m_brush.intersects(snapshot, other->brushWithoutRestoringGeometry()); },
                 [&](const PatchNode* patch)   { return intersectsPatch(m_brush, patch->grid()); }
             ));
         }
@@ -255,7 +313,7 @@ namespace TrenchBroom {
             const auto normal = vm::vec3::axis(axis);
 
             auto result = static_cast<FloatType>(0);
-            for (const auto& face : m_brush.faces()) {
+            for (const auto& face : brush().faces()) {
                 // only consider one side of the brush -- doesn't matter which one!
                 if (vm::dot(face.boundary().normal, normal) > 0.0) {
                     result += face.projectedArea(axis);
@@ -322,6 +380,17 @@ namespace TrenchBroom {
 
         std::optional<std::tuple<FloatType, size_t>> BrushNode::findFaceHit(const vm::ray3& ray) const {
             if (!vm::is_nan(vm::intersect_ray_bbox(ray, logicalBounds()))) {
+                if (const auto* compactGeometry = m_brush.compactedGeometry()) {
+                    // pick unused brushes without restoring their geometry
+                    for (size_t i = 0u; i < m_brush.faceCount(); ++i) {
+                        const auto distance = compactGeometry->intersectFaceWithRay(i, m_brush.face(i).boundary(), ray);
+                        if (!vm::is_nan(distance)) {
+                            return std::make_tuple(distance, i);
+                        }
+                    }
+                    return std::nullopt;
+                }
+
                 for (size_t i = 0u; i < m_brush.faceCount(); ++i) {
                     const auto& face = m_brush.face(i);
                     const auto distance = face.intersectWithRay(ray);
@@ -413,7 +482,7 @@ namespace TrenchBroom {
         }
 
         bool operator==(const BrushNode& lhs, const BrushNode& rhs) {
-            return lhs.brush() == rhs.brush();
+            return lhs.brushWithoutRestoringGeometry() == rhs.brushWithoutRestoringGeometry();
         }
 
         bool operator!=(const BrushNode& lhs, const BrushNode& rhs) {
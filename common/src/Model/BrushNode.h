@@ -63,6 +63,7 @@ namespace TrenchBroom {
             mutable std::unique_ptr<Renderer::BrushRendererBrushCache> m_brushRendererBrushCache; // unique_ptr for breaking header dependencies
             Brush m_brush; // must be destroyed before the brush renderer cache
             size_t m_selectedFaceCount = 0u;
+            bool m_geometryUsed = true;
         public:
             explicit BrushNode(Brush brush);
             ~BrushNode() override;
@@ -72,9 +73,34 @@ namespace TrenchBroom {
             EntityNodeBase* entity();
             const EntityNodeBase* entity() const;
             
+            /**
+             * Returns the brush. Its geometry must not be compacted, so callers that may encounter unused brushes
+             * must call restoreGeometry() first. The geometry of selected brushes, of brushes with selected faces and
+             * of the brush nearest to the pick ray in MapDocument::pick is always available.
+             */
             const Brush& brush() const;
             Brush setBrush(Brush brush);
 
+            /**
+             * Returns the brush whose geometry may be compacted. Callers that only need the faces, the bounds or the
+             * tests that work on the compacted geometry should use this, and it is safe to call on several threads at
+             * once.
+             */
+            const Brush& brushWithoutRestoringGeometry() const;
+
+            /**
+             * Restores the brush geometry if it was compacted, and marks it as used.
+             */
+            void restoreGeometry();
+
+            /**
+             * Compacts the brush geometry if it has not been used since the previous call. Transitively selected brushes
+             * and brushes with selected faces are not compacted.
+             *
+             * @return true if the geometry was compacted
+             */
+            bool compactGeometryIfUnused();
+
             bool hasSelectedFaces() const;
             void selectFace(size_t faceIndex);
             void deselectFace(size_t faceIndex);
@@ -85,6 +111,13 @@ namespace TrenchBroom {
 
             bool contains(const Node* node) const;
             bool intersects(const Node* node) const;
+
+            /**
+             * Same as contains(const Node*) and intersects(const Node*), but these use the given snapshot of this
+             * brush's geometry for the tests against other brushes, see Brush::convexSnapshot().
+             */
+            bool contains(const ConvexPolyhedronSnapshot& snapshot, const Node* node) const;
+            bool intersects(const ConvexPolyhedronSnapshot& snapshot, const Node* node) const;
         private:
             void clearSelectedFaces();
             void updateSelectedFaceCount();
@@ -0,0 +1,158 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CompactBrushGeometry.h"
+
+#include "Ensure.h"
+#include "Polyhedron.h"
+
+#include <vecmath/intersection.h>
+#include <vecmath/plane.h>
+#include <vecmath/ray.h>
+#include <vecmath/scalar.h>
+
+#include <tuple>
+#include <unordered_map>
+
+namespace TrenchBroom {
+    namespace Model {
+        CompactBrushGeometry::CompactBrushGeometry(const BrushGeometry& geometry) :
+        m_bounds(geometry.bounds()) {
+            std::unordered_map<const BrushVertex*, Index> vertexIndices;
+
+            m_vertices.reserve(geometry.vertexCount());
+            for (const BrushVertex* vertex : geometry.vertices()) {
+                vertexIndices.emplace(vertex, static_cast<Index>(m_vertices.size()));
+                m_vertices.push_back(vertex->position());
+            }
+
+            // collect the faces in the order of their brush faces
+            const auto faceCount = geometry.faceCount();
+            std::vector<const BrushFaceGeometry*> faces(faceCount, nullptr);
+            for (const BrushFaceGeometry* face : geometry.faces()) {
+                const auto faceIndex = face->payload();
+                ensure(faceIndex && *faceIndex < faceCount, "face has a valid brush face index");
+                faces[*faceIndex] = face;
+            }
+
+            m_facePlanes.reserve(faceCount);
+            m_faceOffsets.reserve(faceCount + 1u);
+            m_faceBoundaries.reserve(2u * geometry.edgeCount());
+            for (const BrushFaceGeometry* face : faces) {
+                m_facePlanes.push_back(face->plane());
+                m_faceOffsets.push_back(static_cast<Index>(m_faceBoundaries.size()));
+                for (const BrushHalfEdge* halfEdge : face->boundary()) {
+                    m_faceBoundaries.push_back(vertexIndices[halfEdge->origin()]);
+                }
+            }
+            m_faceOffsets.push_back(static_cast<Index>(m_faceBoundaries.size()));
+
+            m_edges.reserve(geometry.edgeCount());
+            for (const BrushEdge* edge : geometry.edges()) {
+                m_edges.push_back(Edge{
+                    vertexIndices[edge->firstVertex()],
+                    vertexIndices[edge->secondVertex()],
+                    static_cast<Index>(*edge->firstFace()->payload()),
+                    static_cast<Index>(*edge->secondFace()->payload())
+                });
+            }
+        }
+
+        BrushGeometry CompactBrushGeometry::restore() const {
+            std::vector<std::tuple<vm::plane3, std::vector<size_t>>> faces;
+            faces.reserve(faceCount());
+            for (size_t i = 0u; i < faceCount(); ++i) {
+                faces.emplace_back(m_facePlanes[i], std::vector<size_t>(faceBoundaryBegin(i), faceBoundaryEnd(i)));
+            }
+
+            std::vector<std::tuple<size_t, size_t>> edges;
+            edges.reserve(m_edges.size());
+            for (const auto& edge : m_edges) {
+                edges.emplace_back(edge.firstVertex, edge.secondVertex);
+            }
+
+            auto geometry = BrushGeometry(m_vertices, faces, edges);
+
+            size_t faceIndex = 0u;
+            for (BrushFaceGeometry* face : geometry.faces()) {
+                face->setPayload(faceIndex++);
+            }
+
+            return geometry;
+        }
+
+        const vm::bbox3& CompactBrushGeometry::bounds() const {
+            return m_bounds;
+        }
+
+        size_t CompactBrushGeometry::memoryUsage() const {
+            return sizeof(CompactBrushGeometry)
+                + m_vertices.capacity() * sizeof(vm::vec3)
+                + m_facePlanes.capacity() * sizeof(vm::plane3)
+                + m_faceBoundaries.capacity() * sizeof(Index)
+                + m_faceOffsets.capacity() * sizeof(Index)
+                + m_edges.capacity() * sizeof(Edge);
+        }
+
+        size_t CompactBrushGeometry::vertexCount() const {
+            return m_vertices.size();
+        }
+
+        const std::vector<vm::vec3>& CompactBrushGeometry::vertices() const {
+            return m_vertices;
+        }
+
+        size_t CompactBrushGeometry::faceCount() const {
+            return m_facePlanes.size();
+        }
+
+        const std::vector<vm::plane3>& CompactBrushGeometry::facePlanes() const {
+            return m_facePlanes;
+        }
+
+        std::vector<CompactBrushGeometry::Index>::const_iterator CompactBrushGeometry::faceBoundaryBegin(const size_t faceIndex) const {
+            assert(faceIndex < faceCount());
+            return std::next(std::begin(m_faceBoundaries), static_cast<std::ptrdiff_t>(m_faceOffsets[faceIndex]));
+        }
+
+        std::vector<CompactBrushGeometry::Index>::const_iterator CompactBrushGeometry::faceBoundaryEnd(const size_t faceIndex) const {
+            assert(faceIndex < faceCount());
+            return std::next(std::begin(m_faceBoundaries), static_cast<std::ptrdiff_t>(m_faceOffsets[faceIndex + 1u]));
+        }
+
+        size_t CompactBrushGeometry::faceVertexCount(const size_t faceIndex) const {
+            assert(faceIndex < faceCount());
+            return static_cast<size_t>(m_faceOffsets[faceIndex + 1u] - m_faceOffsets[faceIndex]);
+        }
+
+        const std::vector<CompactBrushGeometry::Edge>& CompactBrushGeometry::edges() const {
+            return m_edges;
+        }
+
+        FloatType CompactBrushGeometry::intersectFaceWithRay(const size_t faceIndex, const vm::plane3& boundary, const vm::ray3& ray) const {
+            const FloatType cos = dot(boundary.normal, ray.direction);
+            if (cos >= FloatType(0.0)) {
+                return vm::nan<FloatType>();
+            } else {
+                const auto getPosition = [&](const Index index) -> const vm::vec3& { return m_vertices[index]; };
+                return vm::intersect_ray_polygon(ray, boundary, faceBoundaryBegin(faceIndex), faceBoundaryEnd(faceIndex), getPosition);
+            }
+        }
+    }
+}
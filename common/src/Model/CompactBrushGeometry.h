@@ -0,0 +1,104 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "FloatType.h"
+#include "Model/BrushGeometry.h"
+
+#include <vecmath/bbox.h>
+#include <vecmath/forward.h>
+#include <vecmath/vec.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Model {
+        /**
+         * A compact representation of the geometry of a brush. It stores the vertex positions, the boundary of every
+         * face as a list of vertex indices and the edges as pairs of vertex indices. This is enough to render and pick
+         * the brush and to compute its bounds, but unlike the half edge representation, it cannot be modified.
+         *
+         * The faces are stored in the order of the brush faces, so the face with index i belongs to the brush face with
+         * index i. The half edge representation can be restored without loss.
+         */
+        class CompactBrushGeometry {
+        public:
+            using Index = uint32_t;
+
+            struct Edge {
+                Index firstVertex;
+                Index secondVertex;
+                Index firstFace;
+                Index secondFace;
+            };
+        private:
+            std::vector<vm::vec3> m_vertices;
+            std::vector<vm::plane3> m_facePlanes;
+            /**
+             * The vertex indices of all face boundaries, one face after another.
+             */
+            std::vector<Index> m_faceBoundaries;
+            /**
+             * The offset of each face's boundary in m_faceBoundaries, followed by the total number of indices.
+             */
+            std::vector<Index> m_faceOffsets;
+            std::vector<Edge> m_edges;
+            vm::bbox3 m_bounds;
+        public:
+            /**
+             * Creates a compact representation of the given geometry. Every face of the given geometry must have a
+             * payload, i.e., it must belong to a brush face.
+             */
+            explicit CompactBrushGeometry(const BrushGeometry& geometry);
+
+            /**
+             * Restores the half edge representation. The payload of every face is set to the index of its brush face.
+             */
+            BrushGeometry restore() const;
+
+            const vm::bbox3& bounds() const;
+
+            /**
+             * Returns the number of bytes allocated for this geometry.
+             */
+            size_t memoryUsage() const;
+
+            size_t vertexCount() const;
+            const std::vector<vm::vec3>& vertices() const;
+
+            size_t faceCount() const;
+            const std::vector<vm::plane3>& facePlanes() const;
+            std::vector<Index>::const_iterator faceBoundaryBegin(size_t faceIndex) const;
+            std::vector<Index>::const_iterator faceBoundaryEnd(size_t faceIndex) const;
+            size_t faceVertexCount(size_t faceIndex) const;
+
+            const std::vector<Edge>& edges() const;
+
+            /**
+             * Intersects the given ray with the polygon of the face with the given index. The given plane is used as the
+             * plane of the face.
+             *
+             * @return the distance to the intersection or NaN if the ray does not hit the face from above
+             */
+            FloatType intersectFaceWithRay(size_t faceIndex, const vm::plane3& boundary, const vm::ray3& ray) const;
+        };
+    }
+}
@@ -0,0 +1,203 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "ConvexPolyhedronSnapshot.h"
+
+#include "Model/CompactBrushGeometry.h"
+#include "Model/Polyhedron.h"
+
+#include <vecmath/constants.h>
+#include <vecmath/scalar.h>
+#include <vecmath/vec.h>
+#include <vecmath/vec_ext.h>
+
+#include <cassert>
+#include <limits>
+
+namespace TrenchBroom {
+    namespace Model {
+        /**
+         * Two edges are considered parallel if the sine of the angle between them is at most this value. The value is
+         * small enough for merged edges to yield practically the same cross product axes as the original edges.
+         */
+        static constexpr FloatType ParallelEpsilon = static_cast<FloatType>(1e-9);
+
+        ConvexPolyhedronSnapshot::ConvexPolyhedronSnapshot(const BrushGeometry& geometry) :
+        m_bounds(geometry.bounds()) {
+            assert(geometry.polyhedron());
+
+            m_vertices.reserve(geometry.vertexCount());
+            for (const BrushVertex* vertex : geometry.vertices()) {
+                m_vertices.push_back(vertex->position());
+            }
+
+            m_facePlanes.reserve(geometry.faceCount());
+            for (const BrushFaceGeometry* face : geometry.faces()) {
+                m_facePlanes.push_back(face->plane());
+            }
+
+            for (const BrushEdge* edge : geometry.edges()) {
+                addEdgeVector(edge->vector());
+            }
+        }
+
+        ConvexPolyhedronSnapshot::ConvexPolyhedronSnapshot(const CompactBrushGeometry& geometry) :
+        m_vertices(geometry.vertices()),
+        m_facePlanes(geometry.facePlanes()),
+        m_bounds(geometry.bounds()) {
+            for (const auto& edge : geometry.edges()) {
+                addEdgeVector(m_vertices[edge.secondVertex] - m_vertices[edge.firstVertex]);
+            }
+        }
+
+        const std::vector<vm::vec3>& ConvexPolyhedronSnapshot::vertices() const {
+            return m_vertices;
+        }
+
+        const std::vector<vm::plane3>& ConvexPolyhedronSnapshot::facePlanes() const {
+            return m_facePlanes;
+        }
+
+        const std::vector<vm::vec3>& ConvexPolyhedronSnapshot::edgeVectors() const {
+            return m_edgeVectors;
+        }
+
+        const vm::bbox3& ConvexPolyhedronSnapshot::bounds() const {
+            return m_bounds;
+        }
+
+        /**
+         * Checks whether the given face plane separates the given vertices from the polyhedron below it, that is,
+         * whether no vertex is below the plane and at least one vertex is above it.
+         */
+        static bool separates(const vm::plane3& plane, const std::vector<vm::vec3>& vertices) {
+            const auto epsilon = vm::constants<FloatType>::point_status_epsilon();
+
+            auto anyAbove = false;
+            for (const auto& vertex : vertices) {
+                const auto distance = plane.point_distance(vertex);
+                if (distance < -epsilon) {
+                    return false;
+                } else if (distance > epsilon) {
+                    anyAbove = true;
+                }
+            }
+            return anyAbove;
+        }
+
+        /**
+         * Checks whether the given axis separates the given sets of vertices. The axis separates them if the
+         * projections of the right hand vertices onto the axis lie on or beyond one end of the projections of the left
+         * hand vertices, and at least one of them lies beyond it.
+         */
+        static bool separates(const vm::vec3& axis, const std::vector<vm::vec3>& lhsVertices, const std::vector<vm::vec3>& rhsVertices) {
+            const auto epsilon = vm::constants<FloatType>::point_status_epsilon();
+
+            auto lhsMin = std::numeric_limits<FloatType>::max();
+            auto lhsMax = std::numeric_limits<FloatType>::lowest();
+            for (const auto& vertex : lhsVertices) {
+                const auto distance = vm::dot(axis, vertex);
+                lhsMin = vm::min(lhsMin, distance);
+                lhsMax = vm::max(lhsMax, distance);
+            }
+
+            auto allAbove = true, anyAbove = false;
+            auto allBelow = true, anyBelow = false;
+            for (const auto& vertex : rhsVertices) {
+                const auto distance = vm::dot(axis, vertex);
+                if (distance < lhsMax - epsilon) {
+                    allAbove = false;
+                } else if (distance > lhsMax + epsilon) {
+                    anyAbove = true;
+                }
+                if (distance > lhsMin + epsilon) {
+                    allBelow = false;
+                } else if (distance < lhsMin - epsilon) {
+                    anyBelow = true;
+                }
+                if (!allAbove && !allBelow) {
+                    return false;
+                }
+            }
+            return (allAbove && anyAbove) || (allBelow && anyBelow);
+        }
+
+        bool ConvexPolyhedronSnapshot::intersects(const ConvexPolyhedronSnapshot& other) const {
+            if (!m_bounds.intersects(other.m_bounds)) {
+                return false;
+            }
+
+            for (const auto& plane : m_facePlanes) {
+                if (separates(plane, other.m_vertices)) {
+                    return false;
+                }
+            }
+            for (const auto& plane : other.m_facePlanes) {
+                if (separates(plane, m_vertices)) {
+                    return false;
+                }
+            }
+
+            for (const auto& lhsEdgeVector : m_edgeVectors) {
+                for (const auto& rhsEdgeVector : other.m_edgeVectors) {
+                    const auto axis = vm::cross(lhsEdgeVector, rhsEdgeVector);
+                    if (!vm::is_zero(axis, vm::constants<FloatType>::almost_zero()) && separates(axis, m_vertices, other.m_vertices)) {
+                        return false;
+                    }
+                }
+            }
+
+            return true;
+        }
+
+        bool ConvexPolyhedronSnapshot::contains(const ConvexPolyhedronSnapshot& other) const {
+            if (!m_bounds.contains(other.m_bounds)) {
+                return false;
+            }
+
+            const auto epsilon = vm::constants<FloatType>::point_status_epsilon();
+            for (const auto& plane : m_facePlanes) {
+                for (const auto& vertex : other.m_vertices) {
+                    if (plane.point_status(vertex, epsilon) == vm::plane_status::above) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        void ConvexPolyhedronSnapshot::addEdgeVector(const vm::vec3& vector) {
+            const auto squaredLength = vm::squared_length(vector);
+            for (auto& edgeVector : m_edgeVectors) {
+                const auto edgeSquaredLength = vm::squared_length(edgeVector);
+                const auto crossSquaredLength = vm::squared_length(vm::cross(edgeVector, vector));
+                if (crossSquaredLength <= ParallelEpsilon * ParallelEpsilon * squaredLength * edgeSquaredLength) {
+                    // keep the shortest vector, which yields the shortest and thus most tolerant cross product axes,
+                    // just like testing every pair of edges would
+                    if (squaredLength < edgeSquaredLength) {
+                        edgeVector = vector;
+                    }
+                    return;
+                }
+            }
+            m_edgeVectors.push_back(vector);
+        }
+    }
+}
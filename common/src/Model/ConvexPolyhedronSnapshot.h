@@ -0,0 +1,85 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include "FloatType.h"
+#include "Model/BrushGeometry.h"
+
+#include <vecmath/bbox.h>
+#include <vecmath/plane.h>
+#include <vecmath/vec.h>
+
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Model {
+        class CompactBrushGeometry;
+
+        /**
+         * A flat copy of the vertices, face planes and edge directions of a convex polyhedron, used to test two convex
+         * polyhedra for intersection and containment.
+         *
+         * The tests use the separating axis theorem, see
+         * http://www.geometrictools.com/Documentation/MethodOfSeparatingAxes.pdf. Parallel edges are merged into a
+         * single edge direction, which reduces the number of cross product axes considerably for typical brushes.
+         *
+         * The results agree with Polyhedron::intersects and Polyhedron::contains for polyhedra: polyhedra which only
+         * touch do not intersect.
+         */
+        class ConvexPolyhedronSnapshot {
+        private:
+            std::vector<vm::vec3> m_vertices;
+            std::vector<vm::plane3> m_facePlanes;
+            /**
+             * The shortest edge vector of each set of parallel edges.
+             */
+            std::vector<vm::vec3> m_edgeVectors;
+            vm::bbox3 m_bounds;
+        public:
+            /**
+             * Creates a snapshot of the given geometry, which must be a polyhedron.
+             */
+            explicit ConvexPolyhedronSnapshot(const BrushGeometry& geometry);
+
+            /**
+             * Creates a snapshot of the given compacted geometry.
+             */
+            explicit ConvexPolyhedronSnapshot(const CompactBrushGeometry& geometry);
+
+            const std::vector<vm::vec3>& vertices() const;
+            const std::vector<vm::plane3>& facePlanes() const;
+            const std::vector<vm::vec3>& edgeVectors() const;
+            const vm::bbox3& bounds() const;
+
+            /**
+             * Indicates whether this polyhedron and the given polyhedron share any interior points.
+             */
+            bool intersects(const ConvexPolyhedronSnapshot& other) const;
+
+            /**
+             * Indicates whether every vertex of the given polyhedron is inside of or on the boundary of this polyhedron.
+             */
+            bool contains(const ConvexPolyhedronSnapshot& other) const;
+        private:
+            void addEdgeVector(const vm::vec3& vector);
+        };
+    }
+}
@@ -19,6 +19,8 @@
 
 #include "Entity.h"
 
+#include "MemoryReport.h"
+
 #include "Assets/EntityDefinition.h"
 #include "Assets/EntityModel.h"
 #include "Assets/ModelDefinition.h"
@@ -65,6 +67,20 @@ namespace TrenchBroom {
             updateCachedProperties(propertyConfig);
         }
 
+        size_t Entity::memoryUsage() const {
+            auto result = sizeof(Entity)
+                + m_properties.capacity() * sizeof(EntityProperty)
+                + m_protectedProperties.capacity() * sizeof(std::string)
+                + heapMemoryUsage(m_cachedProperties.classname);
+            for (const auto& property : m_properties) {
+                result += heapMemoryUsage(property.key()) + heapMemoryUsage(property.value());
+            }
+            for (const auto& key : m_protectedProperties) {
+                result += heapMemoryUsage(key);
+            }
+            return result;
+        }
+
         const std::vector<EntityProperty>& Entity::properties() const {
             return m_properties;
         }
@@ -101,6 +101,11 @@ namespace TrenchBroom {
 
             ~Entity();
 
+            /**
+             * Returns the number of bytes allocated for this entity and its properties.
+             */
+            size_t memoryUsage() const;
+
             const std::vector<EntityProperty>& properties() const;
             void setProperties(const EntityPropertyConfig& propertyConfig, std::vector<EntityProperty> properties);
 
@@ -20,6 +20,7 @@
 #include "EntityNodeIndex.h"
 
 #include "Macros.h"
+#include "MemoryReport.h"
 #include "Model/Entity.h"
 #include "Model/EntityNodeBase.h"
 #include "Model/EntityProperties.h"
@@ -27,8 +28,10 @@
 #include <kdl/compact_trie.h>
 #include <kdl/vector_utils.h>
 
+#include <algorithm>
 #include <iterator>
 #include <list>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -50,6 +53,14 @@ namespace TrenchBroom {
             return EntityNodeIndexQuery(Type_Any);
         }
 
+        EntityNodeIndexQuery::Type EntityNodeIndexQuery::type() const {
+            return m_type;
+        }
+
+        const std::string& EntityNodeIndexQuery::pattern() const {
+            return m_pattern;
+        }
+
         std::set<EntityNodeBase*> EntityNodeIndexQuery::execute(const EntityNodeStringIndex& index) const {
             std::set<EntityNodeBase*> result;
             switch (m_type) {
@@ -102,6 +113,22 @@ namespace TrenchBroom {
         m_type(type),
         m_pattern(pattern) {}
 
+        /**
+         * Returns the key under which the given property key is stored in the link index, or nothing if the property
+         * is not used for entity links. Numbered keys are normalized to their base key, e.g. "target2" -> "target".
+         */
+        static std::optional<std::string> normalizedLinkKey(const std::string& key) {
+            if (key == EntityPropertyKeys::Targetname) {
+                return EntityPropertyKeys::Targetname;
+            } else if (isNumberedProperty(EntityPropertyKeys::Target, key)) {
+                return EntityPropertyKeys::Target;
+            } else if (isNumberedProperty(EntityPropertyKeys::Killtarget, key)) {
+                return EntityPropertyKeys::Killtarget;
+            } else {
+                return std::nullopt;
+            }
+        }
+
         EntityNodeIndex::EntityNodeIndex() :
             m_keyIndex(std::make_unique<EntityNodeStringIndex>()),
             m_valueIndex(std::make_unique<EntityNodeStringIndex>()) {}
@@ -121,17 +148,23 @@ namespace TrenchBroom {
         void EntityNodeIndex::addProperty(EntityNodeBase* node, const std::string& key, const std::string& value) {
             m_keyIndex->insert(key, node);
             m_valueIndex->insert(value, node);
+            addLinkProperty(node, key, value);
         }
 
         void EntityNodeIndex::removeProperty(EntityNodeBase* node, const std::string& key, const std::string& value) {
             m_keyIndex->remove(key, node);
             m_valueIndex->remove(value, node);
+            removeLinkProperty(node, key, value);
         }
 
         std::vector<EntityNodeBase*> EntityNodeIndex::findEntityNodes(const EntityNodeIndexQuery& keyQuery, const std::string& value) const {
-            // first, find Nodes which have `value` as the value for any key
+            // first, find Nodes which have `value` as the value for any key, or for the queried key if it is a link key
             std::vector<EntityNodeBase*> result;
-            m_valueIndex->find_matches(value, std::back_inserter(result));
+            if (const auto* linkCandidates = findLinkCandidates(keyQuery, value)) {
+                result = *linkCandidates;
+            } else {
+                m_valueIndex->find_matches(value, std::back_inserter(result));
+            }
             if (result.empty()) {
                 return {};
             }
@@ -170,5 +203,79 @@ namespace TrenchBroom {
 
             return result;
         }
+
+        size_t EntityNodeIndex::memoryUsage() const {
+            auto result = sizeof(EntityNodeIndex) + m_keyIndex->memory_usage() + m_valueIndex->memory_usage();
+
+            // hash map elements are allocated individually together with a pointer to the next element
+            result += m_linkIndex.bucket_count() * sizeof(void*);
+            for (const auto& [key, valueIndex] : m_linkIndex) {
+                result += sizeof(std::pair<const std::string, LinkValueIndex>) + sizeof(void*) + heapMemoryUsage(key);
+                result += valueIndex.bucket_count() * sizeof(void*);
+                for (const auto& [value, nodes] : valueIndex) {
+                    result += sizeof(std::pair<const std::string, std::vector<EntityNodeBase*>>) + sizeof(void*);
+                    result += heapMemoryUsage(value) + nodes.capacity() * sizeof(EntityNodeBase*);
+                }
+            }
+            return result;
+        }
+
+        void EntityNodeIndex::addLinkProperty(EntityNodeBase* node, const std::string& key, const std::string& value) {
+            if (const auto linkKey = normalizedLinkKey(key)) {
+                m_linkIndex[*linkKey][value].push_back(node);
+            }
+        }
+
+        void EntityNodeIndex::removeLinkProperty(EntityNodeBase* node, const std::string& key, const std::string& value) {
+            const auto linkKey = normalizedLinkKey(key);
+            if (!linkKey) {
+                return;
+            }
+
+            auto keyIt = m_linkIndex.find(*linkKey);
+            if (keyIt == std::end(m_linkIndex)) {
+                return;
+            }
+
+            auto& valueIndex = keyIt->second;
+            auto valueIt = valueIndex.find(value);
+            if (valueIt == std::end(valueIndex)) {
+                return;
+            }
+
+            // a node can occur several times if it has multiple numbered keys with the same value, so only remove one
+            auto& nodes = valueIt->second;
+            auto nodeIt = std::find(std::begin(nodes), std::end(nodes), node);
+            if (nodeIt != std::end(nodes)) {
+                std::iter_swap(nodeIt, std::prev(std::end(nodes)));
+                nodes.pop_back();
+            }
+
+            if (nodes.empty()) {
+                valueIndex.erase(valueIt);
+            }
+        }
+
+        const std::vector<EntityNodeBase*>* EntityNodeIndex::findLinkCandidates(const EntityNodeIndexQuery& keyQuery, const std::string& value) const {
+            // exact queries for "target" must not match "target2", so only numbered queries can use the normalized keys
+            const auto& pattern = keyQuery.pattern();
+            const auto isLinkQuery =
+                (keyQuery.type() == EntityNodeIndexQuery::Type_Exact && pattern == EntityPropertyKeys::Targetname) ||
+                (keyQuery.type() == EntityNodeIndexQuery::Type_Numbered && (pattern == EntityPropertyKeys::Target || pattern == EntityPropertyKeys::Killtarget));
+            if (!isLinkQuery) {
+                return nullptr;
+            }
+
+            static const std::vector<EntityNodeBase*> noCandidates;
+
+            const auto keyIt = m_linkIndex.find(pattern);
+            if (keyIt == std::end(m_linkIndex)) {
+                return &noCandidates;
+            }
+
+            const auto& valueIndex = keyIt->second;
+            const auto valueIt = valueIndex.find(value);
+            return valueIt != std::end(valueIndex) ? &valueIt->second : &noCandidates;
+        }
     }
 }
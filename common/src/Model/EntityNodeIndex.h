@@ -24,6 +24,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom {
@@ -50,6 +51,9 @@ namespace TrenchBroom {
             static EntityNodeIndexQuery numbered(const std::string& pattern);
             static EntityNodeIndexQuery any();
 
+            Type type() const;
+            const std::string& pattern() const;
+
             std::set<EntityNodeBase*> execute(const EntityNodeStringIndex& index) const;
             bool execute(const EntityNodeBase* node, const std::string& value) const;
             std::vector<Model::EntityProperty> execute(const EntityNodeBase* node) const;
@@ -57,10 +61,21 @@ namespace TrenchBroom {
             explicit EntityNodeIndexQuery(Type type, const std::string& pattern = "");
         };
 
+        /**
+         * Indexes entity nodes by their property keys and values.
+         *
+         * In addition to the tries, which support prefix and numbered queries for arbitrary keys, the properties used
+         * for entity links (target, killtarget and targetname) are kept in a hash index mapping (key, value) pairs to
+         * nodes. Numbered link keys such as "target2" are normalized to their base key when they are inserted, so that
+         * link resolution does not need to run glob matches against the tries.
+         */
         class EntityNodeIndex {
         private:
+            using LinkValueIndex = std::unordered_map<std::string, std::vector<EntityNodeBase*>>;
+
             std::unique_ptr<EntityNodeStringIndex> m_keyIndex;
             std::unique_ptr<EntityNodeStringIndex> m_valueIndex;
+            std::unordered_map<std::string, LinkValueIndex> m_linkIndex;
         public:
             EntityNodeIndex();
             ~EntityNodeIndex();
@@ -74,6 +89,15 @@ namespace TrenchBroom {
             std::vector<EntityNodeBase*> findEntityNodes(const EntityNodeIndexQuery& keyQuery, const std::string& value) const;
             std::vector<std::string> allKeys() const;
             std::vector<std::string> allValuesForKeys(const EntityNodeIndexQuery& keyQuery) const;
+
+            /**
+             * Returns an estimate of the number of bytes allocated for the tries and the link index.
+             */
+            size_t memoryUsage() const;
+        private:
+            void addLinkProperty(EntityNodeBase* node, const std::string& key, const std::string& value);
+            void removeLinkProperty(EntityNodeBase* node, const std::string& key, const std::string& value);
+            const std::vector<EntityNodeBase*>* findLinkCandidates(const EntityNodeIndexQuery& keyQuery, const std::string& value) const;
         };
     }
 }
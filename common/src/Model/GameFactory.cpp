@@ -39,6 +39,7 @@
 #include "Model/GameImpl.h"
 
 #include <kdl/collection_utils.h>
+#include <kdl/parallel.h>
 #include <kdl/string_compare.h>
 #include <kdl/string_utils.h>
 #include <kdl/vector_utils.h>
@@ -46,6 +47,7 @@
 #include <iostream>
 #include <fstream>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -56,9 +58,9 @@ namespace TrenchBroom {
             return instance;
         }
 
-        void GameFactory::initialize(const GamePathConfig& gamePathConfig) {
+        void GameFactory::initialize(const GamePathConfig& gamePathConfig, Logger& logger) {
             initializeFileSystem(gamePathConfig);
-            loadGameConfigs();
+            loadGameConfigs(logger);
         }
 
         void GameFactory::saveGameEngineConfig(const std::string& gameName, const GameEngineConfig& gameEngineConfig) {
@@ -200,15 +202,36 @@ namespace TrenchBroom {
             m_userGameDir = userGameDir;
         }
 
-        void GameFactory::loadGameConfigs() {
+        void GameFactory::loadGameConfigs(Logger& logger) {
             auto errors = std::vector<std::string>{};
 
+            struct LoadResult {
+                std::optional<GameConfig> config;
+                std::vector<std::string> warnings;
+                std::string error;
+            };
+
+            // parsing the configuration files dominates the startup time, and the files are independent of each other
             const auto configFiles = m_configFS->findItemsRecursively(IO::Path(""), IO::FileNameMatcher("GameConfig.cfg"));
-            for (const auto& configFilePath : configFiles) {
+            auto results = kdl::vec_parallel_transform(configFiles, [&](const IO::Path& configFilePath) {
+                auto warnings = std::vector<std::string>{};
                 try {
-                    loadGameConfig(configFilePath);
+                    auto config = loadGameConfig(configFilePath, warnings);
+                    return LoadResult{std::move(config), std::move(warnings), ""};
                 } catch (const std::exception& e) {
-                    errors.push_back(kdl::str_to_string("Could not load game configuration file ", configFilePath, ": ", e.what()));
+                    return LoadResult{std::nullopt, std::move(warnings), kdl::str_to_string("Could not load game configuration file ", configFilePath, ": ", e.what())};
+                }
+            });
+
+            // register the configurations and log their warnings in the order in which the files were found
+            for (auto& result : results) {
+                for (const auto& warning : result.warnings) {
+                    logger.warn(warning);
+                }
+                if (result.config) {
+                    addGameConfig(std::move(*result.config));
+                } else {
+                    errors.push_back(std::move(result.error));
                 }
             }
 
@@ -219,16 +242,16 @@ namespace TrenchBroom {
             }
         }
 
-        void GameFactory::loadGameConfig(const IO::Path& path) {
+        GameConfig GameFactory::loadGameConfig(const IO::Path& path, std::vector<std::string>& warnings) const {
             try {
-                doLoadGameConfig(path);
+                return doLoadGameConfig(path, warnings);
             } catch (const RecoverableException& e) {
                 e.recover();
-                doLoadGameConfig(path);
+                return doLoadGameConfig(path, warnings);
             }
         }
 
-        void GameFactory::doLoadGameConfig(const IO::Path& path) {
+        GameConfig GameFactory::doLoadGameConfig(const IO::Path& path, std::vector<std::string>& warnings) const {
             const auto configFile = m_configFS->openFile(path);
             const auto absolutePath = m_configFS->makeAbsolute(path);
             
@@ -236,9 +259,13 @@ namespace TrenchBroom {
             auto parser = IO::GameConfigParser{reader.stringView(), absolutePath};
             auto config = parser.parse();
 
-            loadCompilationConfig(config);
-            loadGameEngineConfig(config);
+            loadCompilationConfig(config, warnings);
+            loadGameEngineConfig(config, warnings);
+
+            return config;
+        }
 
+        void GameFactory::addGameConfig(GameConfig config) {
             const auto configName = config.name;
             m_configs.emplace(configName, std::move(config));
             m_names.push_back(configName);
@@ -250,7 +277,7 @@ namespace TrenchBroom {
             m_defaultEngines.emplace(configName, Preference<IO::Path>{defaultEnginePrefPath, IO::Path{}});
         }
 
-        void GameFactory::loadCompilationConfig(GameConfig& gameConfig) {
+        void GameFactory::loadCompilationConfig(GameConfig& gameConfig, std::vector<std::string>& warnings) const {
             const auto path = IO::Path{gameConfig.name} + IO::Path{"CompilationProfiles.cfg"};
             try {
                 if (m_configFS->fileExists(path)) {
@@ -261,12 +288,12 @@ namespace TrenchBroom {
                     gameConfig.compilationConfigParseFailed = false;
                 }
             } catch (const Exception& e) {
-                std::cerr << "Could not load compilation configuration '" << path << "': " << e.what() << "\n";
+                warnings.push_back(kdl::str_to_string("Could not load compilation configuration '", path, "': ", e.what()));
                 gameConfig.compilationConfigParseFailed = true;
             }
         }
 
-        void GameFactory::loadGameEngineConfig(GameConfig& gameConfig) {
+        void GameFactory::loadGameEngineConfig(GameConfig& gameConfig, std::vector<std::string>& warnings) const {
             const auto path = IO::Path{gameConfig.name} + IO::Path{"GameEngineProfiles.cfg"};
             try {
                 if (m_configFS->fileExists(path)) {
@@ -277,7 +304,7 @@ namespace TrenchBroom {
                     gameConfig.gameEngineConfigParseFailed = false;
                 }
             } catch (const Exception& e) {
-                std::cerr << "Could not load game engine configuration '" << path << "': " << e.what() << "\n";
+                warnings.push_back(kdl::str_to_string("Could not load game engine configuration '", path, "': ", e.what()));
                 gameConfig.gameEngineConfigParseFailed = true;
             }
         }
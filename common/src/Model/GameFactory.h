@@ -74,12 +74,14 @@ namespace TrenchBroom {
              * but loading game configurations continues. The string list is then thrown and should be caught by the
              * caller to inform the user of any errors.
              *
-             * The given path config is used to build the file systems.
+             * The given path config is used to build the file systems. If the compilation or game engine profiles of
+             * a game cannot be loaded, a warning is logged to the given logger and the game configuration is loaded
+             * without them.
              *
              * @throw FileSystemException if the file system cannot be built.
              * @throw std::vector<std::string> if loading game configurations fails
              */
-            void initialize(const GamePathConfig& gamePathConfig);
+            void initialize(const GamePathConfig& gamePathConfig, Logger& logger);
             /**
              * Saves the game engine configurations for the game with the given name.
              *
@@ -137,11 +139,12 @@ namespace TrenchBroom {
         private:
             GameFactory();
             void initializeFileSystem(const GamePathConfig& gamePathConfig);
-            void loadGameConfigs();
-            void loadGameConfig(const IO::Path& path);
-            void doLoadGameConfig(const IO::Path& path);
-            void loadCompilationConfig(GameConfig& gameConfig);
-            void loadGameEngineConfig(GameConfig& gameConfig);
+            void loadGameConfigs(Logger& logger);
+            GameConfig loadGameConfig(const IO::Path& path, std::vector<std::string>& warnings) const;
+            GameConfig doLoadGameConfig(const IO::Path& path, std::vector<std::string>& warnings) const;
+            void loadCompilationConfig(GameConfig& gameConfig, std::vector<std::string>& warnings) const;
+            void loadGameEngineConfig(GameConfig& gameConfig, std::vector<std::string>& warnings) const;
+            void addGameConfig(GameConfig config);
 
             void writeCompilationConfig(GameConfig& gameConfig, const CompilationConfig& compilationConfig, Logger& logger);
             void writeGameEngineConfig(GameConfig& gameConfig, const GameEngineConfig& gameEngineConfig);
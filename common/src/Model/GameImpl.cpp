@@ -34,6 +34,7 @@
 #include "IO/DkmParser.h"
 #include "IO/DiskFileSystem.h"
 #include "IO/EntParser.h"
+#include "IO/EntityDefinitionCache.h"
 #include "IO/FgdParser.h"
 #include "IO/File.h"
 #include "IO/FileMatcher.h"
@@ -369,25 +370,35 @@ namespace TrenchBroom {
             }
         }
 
+        static IO::EntityDefinitionCache& entityDefinitionCache() {
+            // shared by all games so that opening another map with the same definition file doesn't parse it again
+            static auto cache = IO::EntityDefinitionCache{};
+            return cache;
+        }
+
         std::vector<Assets::EntityDefinition*> GameImpl::doLoadEntityDefinitions(IO::ParserStatus& status, const IO::Path& path) const {
             const auto extension = path.extension();
             const auto& defaultColor = m_config.entityConfig.defaultColor;
 
-            if (kdl::ci::str_is_equal("fgd", extension)) {
+            const auto loadDefinitions = [&](auto createParser) {
                 auto file = IO::Disk::openFile(IO::Disk::fixPath(path));
                 auto reader = file->reader().buffer();
-                IO::FgdParser parser(reader.stringView(), defaultColor, file->path());
-                return parser.parseDefinitions(status);
+                auto parser = createParser(reader.stringView(), file->path());
+                return entityDefinitionCache().loadDefinitions(parser, file->path(), reader.stringView(), status);
+            };
+
+            if (kdl::ci::str_is_equal("fgd", extension)) {
+                return loadDefinitions([&](const std::string_view str, const IO::Path& filePath) {
+                    return IO::FgdParser(str, defaultColor, filePath);
+                });
             } else if (kdl::ci::str_is_equal("def", extension)) {
-                auto file = IO::Disk::openFile(IO::Disk::fixPath(path));
-                auto reader = file->reader().buffer();
-                IO::DefParser parser(reader.stringView(), defaultColor);
-                return parser.parseDefinitions(status);
+                return loadDefinitions([&](const std::string_view str, const IO::Path& /* filePath */) {
+                    return IO::DefParser(str, defaultColor);
+                });
             } else if (kdl::ci::str_is_equal("ent", extension)) {
-                auto file = IO::Disk::openFile(IO::Disk::fixPath(path));
-                auto reader = file->reader().buffer();
-                IO::EntParser parser(reader.stringView(), defaultColor);
-                return parser.parseDefinitions(status);
+                return loadDefinitions([&](const std::string_view str, const IO::Path& /* filePath */) {
+                    return IO::EntParser(str, defaultColor);
+                });
             } else {
                 throw GameException("Unknown entity definition format: '" + path.asString() + "'");
             }
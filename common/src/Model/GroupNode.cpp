@@ -98,7 +98,9 @@ namespace TrenchBroom {
                         return std::make_pair(nodeToTransform, NodeContents{std::move(entity)});
                     },
                     [&](const BrushNode* brushNode) -> TransformResult {
-                        auto brush = brushNode->brush();
+                        // the geometry is needed to transform the texture of each face about its center
+                        auto brush = brushNode->brushWithoutRestoringGeometry();
+                        brush.restoreGeometry();
                         return brush.transform(worldBounds, transformation, true)
                             .and_then([&]() -> TransformResult {
                                 return std::make_pair(nodeToTransform, NodeContents{std::move(brush)});
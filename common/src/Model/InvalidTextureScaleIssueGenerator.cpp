@@ -86,7 +86,7 @@ namespace TrenchBroom {
         }
 
         void InvalidTextureScaleIssueGenerator::doGenerate(BrushNode* brushNode, IssueList& issues) const {
-            const Brush& brush = brushNode->brush();
+            const Brush& brush = brushNode->brushWithoutRestoringGeometry();
             for (size_t i = 0u; i < brush.faceCount(); ++i) {
                 const BrushFace& face = brush.face(i);
                 if (!face.attributes().valid()) {
@@ -32,6 +32,7 @@
 #include <kdl/overload.h>
 #include <kdl/vector_utils.h>
 
+#include <atomic>
 #include <string>
 
 namespace TrenchBroom {
@@ -96,7 +97,8 @@ namespace TrenchBroom {
         }
 
         size_t Issue::nextSeqId() {
-            static size_t seqId = 0;
+            // issues may be generated on several threads at once, e.g. when validating a map headlessly
+            static std::atomic<size_t> seqId{0};
             return seqId++;
         }
 
@@ -123,7 +125,7 @@ namespace TrenchBroom {
 
         const BrushFace& BrushFaceIssue::face() const {
             const BrushNode* brushNode = static_cast<const BrushNode*>(node());
-            const Brush& brush = brushNode->brush();
+            const Brush& brush = brushNode->brushWithoutRestoringGeometry();
             return brush.face(m_faceIndex);
         }
 
@@ -19,22 +19,34 @@
 
 #include "ModelUtils.h"
 
+#include "AABBTree.h"
 #include "Ensure.h"
+#include "MemoryReport.h"
 #include "Polyhedron.h"
+#include "Assets/TextureManager.h"
 #include "Model/Brush.h"
 #include "Model/BrushFace.h"
 #include "Model/BrushFaceHandle.h"
 #include "Model/BrushNode.h"
+#include "Model/ConvexPolyhedronSnapshot.h"
 #include "Model/EditorContext.h"
 #include "Model/EntityNode.h"
+#include "Model/EntityNodeIndex.h"
 #include "Model/GroupNode.h"
 #include "Model/LayerNode.h"
 #include "Model/PatchNode.h"
+#include "Model/TagManager.h"
 #include "Model/WorldNode.h"
+#include "Renderer/BrushRendererBrushCache.h"
 
 #include <kdl/overload.h>
+#include <kdl/parallel.h>
 #include <kdl/vector_utils.h>
 
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <utility>
 #include <vector>
 
 namespace TrenchBroom {
@@ -252,15 +264,20 @@ namespace TrenchBroom {
          * in the given vector of brushes such that the predicate evaluates to true for that pair of
          * node and brush.
          *
-         * The given predicate must be a function that maps a node and a brush to true or false.
+         * The given predicate must be a function that maps a node, a brush and a snapshot of that brush's geometry
+         * to true or false. The snapshots are taken once, so they aren't recreated for every node that is tested.
          */
         template <typename P>
         static std::vector<Node*> collectMatchingNodes(const std::vector<Node*>& nodes, const std::vector<BrushNode*>& brushes, const P& predicate) {
             auto result = std::vector<Model::Node*>{};
 
+            const auto snapshots = kdl::vec_transform(brushes, [](const auto* brush) {
+                return brush->brushWithoutRestoringGeometry().convexSnapshot();
+            });
+
             const auto collectIfMatching = [&](auto* node) {
-                for (const auto* brush : brushes) {
-                    if (predicate(node, brush)) {
+                for (size_t i = 0u; i < brushes.size(); ++i) {
+                    if (predicate(node, brushes[i], snapshots[i])) {
                         result.push_back(node);
                         return;
                     }
@@ -302,14 +319,14 @@ namespace TrenchBroom {
         }
 
         std::vector<Node*> collectTouchingNodes(const std::vector<Node*>& nodes, const std::vector<BrushNode*>& brushes) {
-            return collectMatchingNodes(nodes, brushes, [](const auto* node, const auto* brush) {
-                return brush->intersects(node);
+            return collectMatchingNodes(nodes, brushes, [](const auto* node, const auto* brush, const auto& snapshot) {
+                return brush->intersects(snapshot, node);
             });
         }
 
         std::vector<Node*> collectContainedNodes(const std::vector<Node*>& nodes, const std::vector<BrushNode*>& brushes) {
-            return collectMatchingNodes(nodes, brushes, [](const auto* node, const auto* brush) {
-                return brush->contains(node);
+            return collectMatchingNodes(nodes, brushes, [](const auto* node, const auto* brush, const auto& snapshot) {
+                return brush->contains(snapshot, node);
             });
         }
 
@@ -383,7 +400,7 @@ namespace TrenchBroom {
                     [] (auto&& thisLambda, GroupNode* group)   { group->visitChildren(thisLambda); },
                     [] (auto&& thisLambda, EntityNode* entity) { entity->visitChildren(thisLambda); },
                     [&](BrushNode* brushNode) {
-                        const auto& brush = brushNode->brush();
+                        const auto& brush = brushNode->brushWithoutRestoringGeometry();
                         for (size_t i = 0; i < brush.faceCount(); ++i) {
                             faces.emplace_back(brushNode, i);
                         }
@@ -403,7 +420,7 @@ namespace TrenchBroom {
                     [] (auto&& thisLambda, GroupNode* group)   { group->visitChildren(thisLambda); },
                     [] (auto&& thisLambda, EntityNode* entity) { entity->visitChildren(thisLambda); },
                     [&](BrushNode* brushNode) {
-                        const auto& brush = brushNode->brush();
+                        const auto& brush = brushNode->brushWithoutRestoringGeometry();
                         for (size_t i = 0; i < brush.faceCount(); ++i) {
                             const auto& face = brush.face(i);
                             if (editorContext.selectable(brushNode, face)) {
@@ -443,6 +460,141 @@ namespace TrenchBroom {
             return builder.initialized() ? builder.bounds() : defaultBounds;
         }
 
+        namespace {
+            struct NodeMemoryUsage {
+                size_t node = 0u;
+                size_t brushGeometry = 0u;
+                size_t brushRendererCache = 0u;
+
+                size_t total() const {
+                    return node + brushGeometry + brushRendererCache;
+                }
+            };
+        }
+
+        static NodeMemoryUsage computeNodeMemoryUsage(const Node& node) {
+            auto result = NodeMemoryUsage{};
+            result.node = node.children().capacity() * sizeof(Node*);
+
+            node.accept(kdl::overload(
+                [&](const WorldNode* world) {
+                    result.node += sizeof(WorldNode) + world->entity().memoryUsage();
+                },
+                [&](const LayerNode* layer) {
+                    result.node += sizeof(LayerNode) + heapMemoryUsage(layer->layer().name());
+                },
+                [&](const GroupNode* group) {
+                    result.node += sizeof(GroupNode) + heapMemoryUsage(group->group().name());
+                },
+                [&](const EntityNode* entity) {
+                    result.node += sizeof(EntityNode) + entity->entity().memoryUsage();
+                },
+                [&](const BrushNode* brush) {
+                    // don't restore compacted geometry just to measure it
+                    result.node += sizeof(BrushNode);
+                    result.brushGeometry += brush->brushWithoutRestoringGeometry().memoryUsage();
+                    result.brushRendererCache += brush->brushRendererBrushCache().memoryUsage();
+                },
+                [&](const PatchNode* patch) {
+                    result.node += sizeof(PatchNode) + patch->patch().memoryUsage() + patch->grid().points.capacity() * sizeof(PatchGrid::Point);
+                }
+            ));
+
+            return result;
+        }
+
+        size_t computeMemoryUsage(const Node& node) {
+            return computeNodeMemoryUsage(node).total();
+        }
+
+        static void computeMemoryUsageRecursively(const Node& node, size_t& result) {
+            result += computeMemoryUsage(node);
+            for (const auto* child : node.children()) {
+                computeMemoryUsageRecursively(*child, result);
+            }
+        }
+
+        size_t computeMemoryUsageRecursively(const std::vector<Node*>& nodes) {
+            auto result = size_t(0);
+            for (const auto* node : nodes) {
+                computeMemoryUsageRecursively(*node, result);
+            }
+            return result;
+        }
+
+        void reportMemoryUsage(const WorldNode& world, MemoryReport& report, const size_t maxNodes) {
+            auto total = NodeMemoryUsage{};
+            auto nodeCount = size_t(0);
+            auto brushCount = size_t(0);
+            auto nodes = std::vector<std::pair<const Node*, size_t>>{};
+
+            const auto visitNode = [&](const Node& node, const auto& recurse) -> void {
+                const auto usage = computeNodeMemoryUsage(node);
+                total.node += usage.node;
+                total.brushGeometry += usage.brushGeometry;
+                total.brushRendererCache += usage.brushRendererCache;
+
+                ++nodeCount;
+                if (usage.brushGeometry > 0u) {
+                    ++brushCount;
+                }
+
+                nodes.emplace_back(&node, usage.total());
+
+                for (const auto* child : node.children()) {
+                    recurse(*child, recurse);
+                }
+            };
+            visitNode(world, visitNode);
+
+            // only name the largest nodes, there can be millions of them
+            const auto largestCount = std::min(maxNodes, nodes.size());
+            std::partial_sort(std::begin(nodes), std::next(std::begin(nodes), static_cast<std::ptrdiff_t>(largestCount)), std::end(nodes),
+                [](const auto& lhs, const auto& rhs) { return lhs.second > rhs.second; });
+
+            auto largestNodes = std::vector<MemoryUsage>{};
+            largestNodes.reserve(largestCount);
+            for (size_t i = 0u; i < largestCount; ++i) {
+                const auto& [node, bytes] = nodes[i];
+                auto name = node->name();
+                if (node->lineNumber() > 0u) {
+                    name += " (line " + std::to_string(node->lineNumber()) + ")";
+                }
+                largestNodes.push_back(MemoryUsage{std::move(name), 1u, bytes});
+            }
+
+            report.addSubsystem("Nodes", nodeCount, total.node);
+            report.addSubsystem("Brush geometry", brushCount, total.brushGeometry);
+            report.addSubsystem("Brush renderer caches", brushCount, total.brushRendererCache);
+            report.addSubsystem("Node tree", nodeCount, world.nodeTree().memoryUsage());
+            report.addSubsystem("Entity node index", 1u, world.entityNodeIndex().memoryUsage());
+            report.addBreakdown("Largest nodes", std::move(largestNodes), maxNodes);
+        }
+
+        void initializeNodes(const std::vector<Node*>& nodes, Assets::TextureManager& textureManager, TagManager& tagManager) {
+            kdl::parallel_for(nodes.size(), [&](const size_t i) {
+                nodes[i]->accept(kdl::overload(
+                    [&](WorldNode* world)   { world->initializeTags(tagManager); },
+                    [&](LayerNode* layer)   { layer->initializeTags(tagManager); },
+                    [&](GroupNode* group)   { group->initializeTags(tagManager); },
+                    [&](EntityNode* entity) { entity->initializeTags(tagManager); },
+                    [&](BrushNode* brushNode) {
+                        const auto& brush = brushNode->brushWithoutRestoringGeometry();
+                        for (size_t j = 0u; j < brush.faceCount(); ++j) {
+                            auto* texture = textureManager.texture(brush.face(j).attributes().textureName());
+                            brushNode->setFaceTexture(j, texture);
+                        }
+                        brushNode->initializeTags(tagManager);
+                    },
+                    [&](PatchNode* patchNode) {
+                        auto* texture = textureManager.texture(patchNode->patch().textureName());
+                        patchNode->setTexture(texture);
+                        patchNode->initializeTags(tagManager);
+                    }
+                ));
+            });
+        }
+
         std::vector<BrushNode*> filterBrushNodes(const std::vector<Node*>& nodes) {
             auto result = std::vector<BrushNode*>{};
             result.reserve(nodes.size());
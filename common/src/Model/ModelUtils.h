@@ -31,11 +31,18 @@
 #include <vector>
 
 namespace TrenchBroom {
+    class MemoryReport;
+
+    namespace Assets {
+        class TextureManager;
+    }
+
     namespace Model {
         class BrushFaceHandle;
         class EditorContext;
         class LayerNode;
         class Node;
+        class TagManager;
 
         HitType::Type nodeHitType();
 
@@ -82,6 +89,34 @@ namespace TrenchBroom {
         vm::bbox3 computeLogicalBounds(const std::vector<Node*>& nodes, const vm::bbox3& defaultBounds = vm::bbox3());
         vm::bbox3 computePhysicalBounds(const std::vector<Node*>& nodes, const vm::bbox3& defaultBounds = vm::bbox3());
 
+        /**
+         * Returns the number of bytes allocated for the given node and its contents, including the brush geometry and
+         * the brush renderer cache, but not including the node's children.
+         */
+        size_t computeMemoryUsage(const Node& node);
+
+        /**
+         * Returns the number of bytes allocated for the given nodes and all of their descendants.
+         */
+        size_t computeMemoryUsageRecursively(const std::vector<Node*>& nodes);
+
+        /**
+         * Adds the memory used by the given world and its descendants to the given report. The nodes, the brush
+         * geometry, the brush renderer caches, the node tree and the entity node index are reported as separate
+         * subsystems, and the given maximum number of the largest nodes is added as a breakdown.
+         */
+        void reportMemoryUsage(const WorldNode& world, MemoryReport& report, size_t maxNodes);
+
+        /**
+         * Initializes freshly loaded nodes: assigns the textures of the given texture manager to the brush faces and
+         * patches, and initializes the tags of every node. Since every node only changes itself, the nodes are
+         * processed in parallel. A node's tags are initialized after its textures because smart tags may match texture
+         * properties.
+         *
+         * The descendants of the given nodes are not initialized, see collectNodes.
+         */
+        void initializeNodes(const std::vector<Node*>& nodes, Assets::TextureManager& textureManager, TagManager& tagManager);
+
         std::vector<BrushNode*> filterBrushNodes(const std::vector<Node*>& nodes);
         std::vector<EntityNode*> filterEntityNodes(const std::vector<Node*>& nodes);
 
@@ -29,8 +29,10 @@
 #include "Model/WorldNode.h"
 
 #include <kdl/overload.h>
+#include <kdl/vector_utils.h>
 
 #include <algorithm>
+#include <unordered_set>
 #include <vector>
 
 namespace TrenchBroom {
@@ -161,56 +163,64 @@ namespace TrenchBroom {
             ));
         }
 
-        static const auto doRemoveNodes = [](auto& nodes, auto& layers, auto& groups, auto& entities, auto& brushes, auto& patches, auto cur, auto end) {
-            auto nodeEnd = std::end(nodes);
-            auto layerEnd = std::end(layers);
-            auto groupEnd = std::end(groups);
-            auto entityEnd = std::end(entities);
-            auto brushEnd = std::end(brushes);
-            auto patchEnd = std::end(patches);
+        template <typename T>
+        static void eraseNodes(std::vector<T*>& nodes, const std::unordered_set<Node*>& nodesToRemove) {
+            nodes.erase(std::remove_if(std::begin(nodes), std::end(nodes), [&](T* node) {
+                return nodesToRemove.count(node) > 0u;
+            }), std::end(nodes));
+        }
+
+        void NodeCollection::removeNodes(const std::vector<Node*>& nodes) {
+            if (nodes.empty()) {
+                return;
+            }
 
-            while (cur != end) {
-                (*cur)->accept(kdl::overload(
+            // Removing the nodes one by one is quadratic, which is prohibitive when large selections change. Instead,
+            // we collect the nodes to remove in a hash set and erase them from each vector in a single pass, which
+            // retains the insertion order of the remaining nodes.
+            auto nodesToRemove = std::unordered_set<Node*>{};
+            nodesToRemove.reserve(nodes.size());
+
+            auto removeLayers = false, removeGroups = false, removeEntities = false, removeBrushes = false, removePatches = false;
+            for (auto* node : nodes) {
+                node->accept(kdl::overload(
                     [] (WorldNode*)         {},
-                    [&](LayerNode* layer)   { 
-                        nodeEnd = std::remove(std::begin(nodes), nodeEnd, layer);
-                        layerEnd = std::remove(std::begin(layers), layerEnd, layer);
-                    },
-                    [&](GroupNode* group)   {
-                        nodeEnd = std::remove(std::begin(nodes), nodeEnd, group);
-                        groupEnd = std::remove(std::begin(groups), groupEnd, group);
-                    },
-                    [&](EntityNode* entity) {
-                        nodeEnd = std::remove(std::begin(nodes), nodeEnd, entity);
-                        entityEnd = std::remove(std::begin(entities), entityEnd, entity);
-                    },
-                    [&](BrushNode* brush)   {
-                        nodeEnd = std::remove(std::begin(nodes), nodeEnd, brush);
-                        brushEnd = std::remove(std::begin(brushes), brushEnd, brush);
-                    },
-                    [&](PatchNode* patch)   {
-                        nodeEnd = std::remove(std::begin(nodes), nodeEnd, patch);
-                        patchEnd = std::remove(std::begin(patches), patchEnd, patch);
-                    }
+                    [&](LayerNode* layer)   { nodesToRemove.insert(layer); removeLayers = true; },
+                    [&](GroupNode* group)   { nodesToRemove.insert(group); removeGroups = true; },
+                    [&](EntityNode* entity) { nodesToRemove.insert(entity); removeEntities = true; },
+                    [&](BrushNode* brush)   { nodesToRemove.insert(brush); removeBrushes = true; },
+                    [&](PatchNode* patch)   { nodesToRemove.insert(patch); removePatches = true; }
                 ));
-                ++cur;
             }
 
-            nodes.erase(nodeEnd, std::end(nodes));
-            layers.erase(layerEnd, std::end(layers));
-            groups.erase(groupEnd, std::end(groups));
-            entities.erase(entityEnd, std::end(entities));
-            brushes.erase(brushEnd, std::end(brushes));
-            patches.erase(patchEnd, std::end(patches));
-        };
-
-        void NodeCollection::removeNodes(const std::vector<Node*>& nodes) {
-            doRemoveNodes(m_nodes, m_layers, m_groups, m_entities, m_brushes, m_patches, std::begin(nodes), std::end(nodes));
+            eraseNodes(m_nodes, nodesToRemove);
+            if (removeLayers) {
+                eraseNodes(m_layers, nodesToRemove);
+            }
+            if (removeGroups) {
+                eraseNodes(m_groups, nodesToRemove);
+            }
+            if (removeEntities) {
+                eraseNodes(m_entities, nodesToRemove);
+            }
+            if (removeBrushes) {
+                eraseNodes(m_brushes, nodesToRemove);
+            }
+            if (removePatches) {
+                eraseNodes(m_patches, nodesToRemove);
+            }
         }
 
         void NodeCollection::removeNode(Node* node) {
             ensure(node != nullptr, "node is null");
-            doRemoveNodes(m_nodes, m_layers, m_groups, m_entities, m_brushes, m_patches, &node, std::next(&node));
+            node->accept(kdl::overload(
+                [] (WorldNode*)         {},
+                [&](LayerNode* layer)   { m_nodes = kdl::vec_erase(std::move(m_nodes), layer); m_layers = kdl::vec_erase(std::move(m_layers), layer); },
+                [&](GroupNode* group)   { m_nodes = kdl::vec_erase(std::move(m_nodes), group); m_groups = kdl::vec_erase(std::move(m_groups), group); },
+                [&](EntityNode* entity) { m_nodes = kdl::vec_erase(std::move(m_nodes), entity); m_entities = kdl::vec_erase(std::move(m_entities), entity); },
+                [&](BrushNode* brush)   { m_nodes = kdl::vec_erase(std::move(m_nodes), brush); m_brushes = kdl::vec_erase(std::move(m_brushes), brush); },
+                [&](PatchNode* patch)   { m_nodes = kdl::vec_erase(std::move(m_nodes), patch); m_patches = kdl::vec_erase(std::move(m_patches), patch); }
+            ));
         }
 
         void NodeCollection::clear() {
@@ -19,6 +19,7 @@
 
 #include "NodeContents.h"
 
+#include "MemoryReport.h"
 #include "Model/BrushFace.h"
 
 #include <kdl/overload.h>
@@ -49,5 +50,15 @@ namespace TrenchBroom {
         std::variant<Layer, Group, Entity, Brush, BezierPatch>& NodeContents::get() {
             return m_contents;
         }
+
+        size_t NodeContents::memoryUsage() const {
+            return std::visit(kdl::overload(
+                [](const Layer& layer)        { return sizeof(Layer) + heapMemoryUsage(layer.name()); },
+                [](const Group& group)        { return sizeof(Group) + heapMemoryUsage(group.name()); },
+                [](const Entity& entity)      { return entity.memoryUsage(); },
+                [](const Brush& brush)        { return brush.memoryUsage(); },
+                [](const BezierPatch& patch)  { return patch.memoryUsage(); }
+            ), m_contents);
+        }
     }
 }
@@ -41,6 +41,11 @@ namespace TrenchBroom {
 
             const std::variant<Layer, Group, Entity, Brush, BezierPatch>& get() const;
             std::variant<Layer, Group, Entity, Brush, BezierPatch>& get();
+
+            /**
+             * Returns the number of bytes allocated for the contained object.
+             */
+            size_t memoryUsage() const;
         };
     }
 }
@@ -22,6 +22,7 @@
 #include "Polyhedron.h"
 #include "Model/BrushNode.h"
 #include "Model/BrushGeometry.h"
+#include "Model/CompactBrushGeometry.h"
 #include "Model/Issue.h"
 #include "Model/IssueQuickFix.h"
 #include "Model/MapFacade.h"
@@ -66,7 +67,17 @@ namespace TrenchBroom {
         }
 
         void NonIntegerVerticesIssueGenerator::doGenerate(BrushNode* brushNode, IssueList& issues) const {
-            const Brush& brush = brushNode->brush();
+            const Brush& brush = brushNode->brushWithoutRestoringGeometry();
+            if (const auto* compactGeometry = brush.compactedGeometry()) {
+                for (const auto& position : compactGeometry->vertices()) {
+                    if (!vm::is_integral(position)) {
+                        issues.push_back(new NonIntegerVerticesIssue(brushNode));
+                        return;
+                    }
+                }
+                return;
+            }
+
             for (const BrushVertex* vertex : brush.vertices()) {
                 if (!vm::is_integral(vertex->position())) {
                     issues.push_back(new NonIntegerVerticesIssue(brushNode));
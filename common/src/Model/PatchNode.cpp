@@ -255,7 +255,7 @@ namespace TrenchBroom {
 
         PatchNode::PatchNode(BezierPatch patch) :
         m_patch{std::move(patch)},
-        m_grid{makePatchGrid(m_patch, DefaultSubdivisionsPerSurface)} {}
+        m_grid{computeGrid(m_patch)} {}
 
         const EntityNodeBase* PatchNode::entity() const {
             return visitParent(kdl::overload(
@@ -277,14 +277,23 @@ namespace TrenchBroom {
         }
 
         BezierPatch PatchNode::setPatch(BezierPatch patch) {
+            auto grid = computeGrid(patch);
+            return setPatch(std::move(patch), std::move(grid));
+        }
+
+        BezierPatch PatchNode::setPatch(BezierPatch patch, PatchGrid grid) {
             const auto nodeChange = NotifyNodeChange{*this};
             const auto boundsChange = NotifyPhysicalBoundsChange{*this};
 
             auto previousPatch = std::exchange(m_patch, std::move(patch));
-            m_grid = makePatchGrid(m_patch, DefaultSubdivisionsPerSurface);
+            m_grid = std::move(grid);
             return previousPatch;
         }
 
+        PatchGrid PatchNode::computeGrid(const BezierPatch& patch) {
+            return makePatchGrid(patch, DefaultSubdivisionsPerSurface);
+        }
+
         void PatchNode::setTexture(Assets::Texture* texture) {
             m_patch.setTexture(texture);
         }
@@ -78,6 +78,17 @@ namespace TrenchBroom {
             const BezierPatch& patch() const;
             BezierPatch setPatch(BezierPatch patch);
 
+            /**
+             * Sets the given patch and its grid, which must have been computed by computeGrid for the given patch.
+             */
+            BezierPatch setPatch(BezierPatch patch, PatchGrid grid);
+
+            /**
+             * Computes the grid of the given patch at the subdivision level used by patch nodes. This does not depend on
+             * any node, so the grids of many patches can be computed in parallel before they are set.
+             */
+            static PatchGrid computeGrid(const BezierPatch& patch);
+
             void setTexture(Assets::Texture* texture);
 
             const PatchGrid& grid() const;
@@ -33,6 +33,7 @@
 #include <limits>
 #include <optional>
 #include <string>
+#include <tuple>
 #include <variant>
 #include <vector>
 #include <unordered_set>
@@ -1097,6 +1098,20 @@ namespace TrenchBroom {
              */
             explicit Polyhedron(std::vector<vm::vec<T,3>> positions);
 
+            /**
+             * Constructs a polyhedron from the given vertices, faces and edges. Each face is given by its plane and the
+             * indices of its boundary vertices in the order of its boundary, and each edge is given by the indices of its
+             * first and second vertex. The vertices, faces and edges are created in the given order.
+             *
+             * No geometric checks are performed, so the given data must describe a closed polyhedron, e.g. because it
+             * was obtained from another polyhedron.
+             *
+             * @param positions the vertex positions
+             * @param faces the plane and the boundary vertex indices of each face
+             * @param edges the first and second vertex index of each edge
+             */
+            Polyhedron(const std::vector<vm::vec<T,3>>& positions, const std::vector<std::tuple<vm::plane<T,3>, std::vector<size_t>>>& faces, const std::vector<std::tuple<size_t, size_t>>& edges);
+
             /**
              * Copy constructor.
              */
@@ -1217,6 +1232,12 @@ namespace TrenchBroom {
              */
             const vm::bbox<T,3>& bounds() const;
 
+            /**
+             * Returns the number of bytes allocated for this polyhedron, including its vertices, edges, faces and half
+             * edges.
+             */
+            size_t memoryUsage() const;
+
             /**
              * Indicates whether this polyhedron is empty.
              *
@@ -31,7 +31,9 @@
 #include <vecmath/scalar.h>
 #include <vecmath/util.h>
 
+#include <map>
 #include <sstream>
+#include <tuple>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -194,6 +196,41 @@ namespace TrenchBroom {
             addPoints(std::move(positions));
         }
 
+        template <typename T, typename FP, typename VP>
+        Polyhedron<T,FP,VP>::Polyhedron(const std::vector<vm::vec<T,3>>& positions, const std::vector<std::tuple<vm::plane<T,3>, std::vector<size_t>>>& faces, const std::vector<std::tuple<size_t, size_t>>& edges) {
+            std::vector<Vertex*> vertices;
+            vertices.reserve(positions.size());
+            for (const auto& position : positions) {
+                Vertex* vertex = new Vertex(position);
+                m_vertices.push_back(vertex);
+                vertices.push_back(vertex);
+            }
+
+            // maps the origin and destination indices of each half edge to the half edge
+            std::map<std::tuple<size_t, size_t>, HalfEdge*> halfEdges;
+            for (const auto& [plane, boundaryIndices] : faces) {
+                HalfEdgeList boundary;
+                for (size_t i = 0u; i < boundaryIndices.size(); ++i) {
+                    const auto origin = boundaryIndices[i];
+                    const auto destination = boundaryIndices[(i + 1u) % boundaryIndices.size()];
+                    HalfEdge* halfEdge = new HalfEdge(vertices[origin]);
+                    boundary.push_back(halfEdge);
+                    halfEdges.emplace(std::make_tuple(origin, destination), halfEdge);
+                }
+                m_faces.push_back(new Face(std::move(boundary), plane));
+            }
+
+            for (const auto& [first, second] : edges) {
+                HalfEdge* firstEdge = halfEdges[std::make_tuple(first, second)];
+                HalfEdge* secondEdge = halfEdges[std::make_tuple(second, first)];
+                assert(firstEdge != nullptr && secondEdge != nullptr);
+                m_edges.push_back(new Edge(firstEdge, secondEdge));
+            }
+
+            updateBounds();
+            assert(checkInvariant());
+        }
+
         template <typename T, typename FP, typename VP>
         Polyhedron<T,FP,VP>::Polyhedron(const Polyhedron<T,FP,VP>& other) {
             Copy copy(other.faces(), other.edges(), other.vertices(), *this, CopyCallback());
@@ -462,6 +499,20 @@ namespace TrenchBroom {
             return m_bounds;
         }
 
+        template <typename T, typename FP, typename VP>
+        size_t Polyhedron<T,FP,VP>::memoryUsage() const {
+            auto halfEdgeCount = size_t(0);
+            for (const Face* face : m_faces) {
+                halfEdgeCount += face->vertexCount();
+            }
+
+            return sizeof(Polyhedron)
+                + vertexCount() * sizeof(Vertex)
+                + edgeCount() * sizeof(Edge)
+                + faceCount() * sizeof(Face)
+                + halfEdgeCount * sizeof(HalfEdge);
+        }
+
         template <typename T, typename FP, typename VP>
         bool Polyhedron<T,FP,VP>::empty() const {
             return vertexCount() == 0;
@@ -0,0 +1,263 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "RedundantBrushIssueGenerator.h"
+
+#include "AABBTree.h"
+#include "Ensure.h"
+#include "FloatType.h"
+#include "Model/Brush.h"
+#include "Model/BrushFace.h"
+#include "Model/BrushNode.h"
+#include "Model/CompactBrushGeometry.h"
+#include "Model/Entity.h"
+#include "Model/EntityNode.h"
+#include "Model/EntityNodeBase.h"
+#include "Model/GroupNode.h"
+#include "Model/Issue.h"
+#include "Model/IssueQuickFix.h"
+#include "Model/LayerNode.h"
+#include "Model/MapFacade.h"
+#include "Model/PatchNode.h"
+#include "Model/TagAttribute.h"
+#include "Model/WorldNode.h"
+
+#include <kdl/overload.h>
+#include <kdl/string_compare.h>
+
+#include <vecmath/plane.h>
+#include <vecmath/vec.h>
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Model {
+        class RedundantBrushIssueGenerator::RedundantBrushIssue : public Issue {
+        public:
+            static const IssueType Type;
+        private:
+            bool m_duplicate;
+            std::vector<const BrushNode*> m_containingBrushes;
+        public:
+            RedundantBrushIssue(BrushNode* brushNode, const bool duplicate, std::vector<const BrushNode*> containingBrushes) :
+            Issue(brushNode),
+            m_duplicate(duplicate),
+            m_containingBrushes(std::move(containingBrushes)) {}
+
+            const std::vector<const BrushNode*>& containingBrushes() const {
+                return m_containingBrushes;
+            }
+        private:
+            IssueType doGetType() const override {
+                return Type;
+            }
+
+            std::string doGetDescription() const override {
+                return m_duplicate ? "Brush is a duplicate of another brush" : "Brush is contained in another brush";
+            }
+        };
+
+        const IssueType RedundantBrushIssueGenerator::RedundantBrushIssue::Type = Issue::freeType();
+
+        class RedundantBrushIssueGenerator::RedundantBrushIssueQuickFix : public IssueQuickFix {
+        public:
+            RedundantBrushIssueQuickFix() :
+            IssueQuickFix(RedundantBrushIssue::Type, "Delete redundant brushes") {}
+        private:
+            void doApply(MapFacade* facade, const IssueList& issues) const override {
+                // Duplicates contain each other, so every copy is reported. A brush is only deleted if one of the brushes
+                // containing it is kept, which leaves one copy of every set of duplicates in the map.
+                auto deletedBrushes = std::unordered_set<const Node*>{};
+                auto nodesToDelete = std::vector<Node*>{};
+                for (const auto* issue : issues) {
+                    if (issue->type() == RedundantBrushIssue::Type) {
+                        const auto* redundantBrushIssue = static_cast<const RedundantBrushIssue*>(issue);
+                        const auto& containingBrushes = redundantBrushIssue->containingBrushes();
+                        const auto isKept = [&](const BrushNode* brushNode) { return deletedBrushes.count(brushNode) == 0u; };
+                        if (std::any_of(std::begin(containingBrushes), std::end(containingBrushes), isKept)) {
+                            deletedBrushes.insert(issue->node());
+                            nodesToDelete.push_back(issue->node());
+                        }
+                    }
+                }
+
+                facade->deselectAll();
+                facade->select(nodesToDelete);
+                facade->deleteObjects();
+            }
+        };
+
+        RedundantBrushIssueGenerator::RedundantBrushIssueGenerator(const WorldNode* world) :
+        IssueGenerator(RedundantBrushIssue::Type, "Redundant brushes"),
+        m_world(world) {
+            addQuickFix(new RedundantBrushIssueQuickFix());
+        }
+
+        // Only the face boundaries and the vertex positions are used below because they are available without
+        // restoring the geometry of a compacted brush.
+
+        static std::vector<vm::vec3> vertexPositions(const Brush& brush) {
+            if (const auto* compactGeometry = brush.compactedGeometry()) {
+                return compactGeometry->vertices();
+            }
+            return brush.vertexPositions();
+        }
+
+        /**
+         * Returns the face boundaries of the given brush, sorted by their normals and distances. Two brushes are exact
+         * duplicates if their canonical planes are equal.
+         */
+        static std::vector<vm::plane3> canonicalPlanes(const Brush& brush) {
+            auto planes = std::vector<vm::plane3>{};
+            planes.reserve(brush.faceCount());
+            for (const auto& face : brush.faces()) {
+                planes.push_back(face.boundary());
+            }
+
+            // the planes are sorted by their exact values because an ordering with a tolerance is not a strict weak
+            // ordering, the tolerance is only applied when the sorted planes are compared
+            std::sort(std::begin(planes), std::end(planes), [](const auto& lhs, const auto& rhs) {
+                const auto cmp = vm::compare(lhs.normal, rhs.normal);
+                return cmp < 0 || (cmp == 0 && lhs.distance < rhs.distance);
+            });
+            return planes;
+        }
+
+        static bool equalPlanes(const std::vector<vm::plane3>& lhs, const std::vector<vm::plane3>& rhs) {
+            return lhs.size() == rhs.size() && std::equal(std::begin(lhs), std::end(lhs), std::begin(rhs), [](const auto& l, const auto& r) {
+                return vm::is_equal(l, r, vm::C::almost_zero());
+            });
+        }
+
+        static bool containsPoints(const Brush& brush, const std::vector<vm::vec3>& points) {
+            for (const auto& face : brush.faces()) {
+                const auto& boundary = face.boundary();
+                for (const auto& point : points) {
+                    if (boundary.point_status(point, vm::C::point_status_epsilon()) == vm::plane_status::above) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        /**
+         * Returns the content flags of the given brush, which are the combined content flags of its faces. Only brushes
+         * with the same content flags are compared.
+         */
+        static int brushContents(const Brush& brush) {
+            auto result = 0;
+            for (const auto& face : brush.faces()) {
+                result |= face.resolvedSurfaceContents();
+            }
+            return result;
+        }
+
+        static bool isNonSolidTextureName(const std::string& textureName) {
+            const auto separator = textureName.find_last_of('/');
+            const auto name = separator == std::string::npos ? std::string_view{textureName} : std::string_view{textureName}.substr(separator + 1u);
+            return kdl::ci::str_is_equal(name, "origin")
+                || kdl::ci::str_is_equal(name, "skip")
+                || kdl::ci::str_is_equal(name, "trigger")
+                || kdl::ci::str_is_prefix(name, "hint")
+                || kdl::ci::str_is_suffix(name, "clip");
+        }
+
+        /**
+         * Returns whether the given brush is solid. Origin, clip, hint, skip and trigger brushes are not solid and are
+         * never reported, because overlapping them with other brushes is intended.
+         */
+        static bool isSolid(const BrushNode& brushNode) {
+            // the origin content flag of Quake 2 based games
+            static const auto OriginContents = 1 << 24;
+
+            if (brushNode.hasAttribute(TagAttributes::Transparency)) {
+                return false;
+            }
+
+            const auto* entityNode = brushNode.entity();
+            if (entityNode != nullptr && kdl::ci::str_is_prefix(entityNode->entity().classname(), "trigger")) {
+                return false;
+            }
+
+            const auto& brush = brushNode.brushWithoutRestoringGeometry();
+            return std::none_of(std::begin(brush.faces()), std::end(brush.faces()), [](const auto& face) {
+                return face.hasAttribute(TagAttributes::Transparency)
+                    || (face.resolvedSurfaceContents() & OriginContents) != 0
+                    || isNonSolidTextureName(face.attributes().textureName());
+            });
+        }
+
+        static const BrushNode* toBrushNode(const Node* node) {
+            return node->accept(kdl::overload(
+                [](const WorldNode*)           -> const BrushNode* { return nullptr; },
+                [](const LayerNode*)           -> const BrushNode* { return nullptr; },
+                [](const GroupNode*)           -> const BrushNode* { return nullptr; },
+                [](const EntityNode*)          -> const BrushNode* { return nullptr; },
+                [](const BrushNode* brushNode) -> const BrushNode* { return brushNode; },
+                [](const PatchNode*)           -> const BrushNode* { return nullptr; }
+            ));
+        }
+
+        void RedundantBrushIssueGenerator::doGenerate(BrushNode* brushNode, IssueList& issues) const {
+            ensure(brushNode != nullptr, "brush is null");
+
+            if (!isSolid(*brushNode)) {
+                return;
+            }
+
+            const auto& nodeTree = m_world->nodeTree();
+            const auto& brush = brushNode->brushWithoutRestoringGeometry();
+            const auto* entity = brushNode->entity();
+            const auto contents = brushContents(brush);
+            const auto vertices = vertexPositions(brush);
+            const auto planes = canonicalPlanes(brush);
+
+            auto duplicate = false;
+            auto containingBrushes = std::vector<const BrushNode*>{};
+            for (const auto* candidate : nodeTree.findContainers(brushNode->physicalBounds())) {
+                const auto* otherNode = toBrushNode(candidate);
+                if (otherNode == nullptr || otherNode == brushNode || otherNode->entity() != entity) {
+                    continue;
+                }
+
+                const auto& otherBrush = otherNode->brushWithoutRestoringGeometry();
+                if (brushContents(otherBrush) != contents || !isSolid(*otherNode)) {
+                    continue;
+                }
+
+                if (equalPlanes(planes, canonicalPlanes(otherBrush))) {
+                    duplicate = true;
+                    containingBrushes.push_back(otherNode);
+                } else if (containsPoints(otherBrush, vertices)) {
+                    containingBrushes.push_back(otherNode);
+                }
+            }
+
+            if (!containingBrushes.empty()) {
+                issues.push_back(new RedundantBrushIssue(brushNode, duplicate, std::move(containingBrushes)));
+            }
+        }
+    }
+}
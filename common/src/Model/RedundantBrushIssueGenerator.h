@@ -0,0 +1,51 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Model/IssueGenerator.h"
+
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Model {
+        class WorldNode;
+
+        /**
+         * Finds brushes that are redundant because they are exact duplicates of another brush of the same entity, or
+         * because they are entirely contained in another brush of the same entity. Only brushes with the same content
+         * flags are compared, and non-solid brushes such as origin, clip, hint, skip and trigger brushes are ignored.
+         *
+         * The candidates for containing a brush are found using the node tree of the world, so every brush is only
+         * compared to the few brushes whose bounds contain its bounds. The generator does not restore compacted brush
+         * geometry and does not modify any node, so the issues of several brushes can be generated in parallel.
+         */
+        class RedundantBrushIssueGenerator : public IssueGenerator {
+        private:
+            class RedundantBrushIssue;
+            class RedundantBrushIssueQuickFix;
+        private:
+            const WorldNode* m_world;
+        public:
+            explicit RedundantBrushIssueGenerator(const WorldNode* world);
+        private:
+            void doGenerate(BrushNode* brushNode, IssueList& issues) const override;
+        };
+    }
+}
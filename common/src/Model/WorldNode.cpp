@@ -25,14 +25,17 @@
 #include "Model/BrushFace.h"
 #include "Model/EntityNode.h"
 #include "Model/EntityNodeIndex.h"
+#include "Model/EntityProperties.h"
 #include "Model/GroupNode.h"
 #include "Model/IssueGenerator.h"
 #include "Model/IssueGeneratorRegistry.h"
 #include "Model/LayerNode.h"
+#include "Model/MapFormat.h"
 #include "Model/PatchNode.h"
 #include "Model/TagVisitor.h"
 
 #include <kdl/overload.h>
+#include <kdl/parallel.h>
 #include <kdl/result.h>
 #include <kdl/vector_utils.h>
 
@@ -40,6 +43,7 @@
 
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace TrenchBroom {
@@ -67,6 +71,45 @@ namespace TrenchBroom {
             return m_mapFormat;
         }
 
+        void WorldNode::convertToMapFormat(const MapFormat mapFormat) {
+            const auto toParallel = isParallelTexCoordSystem(mapFormat);
+            if (toParallel != isParallelTexCoordSystem(m_mapFormat)) {
+                auto brushNodes = std::vector<BrushNode*>{};
+                accept(kdl::overload(
+                    [] (auto&& thisLambda, WorldNode* world)   { world->visitChildren(thisLambda); },
+                    [] (auto&& thisLambda, LayerNode* layer)   { layer->visitChildren(thisLambda); },
+                    [] (auto&& thisLambda, GroupNode* group)   { group->visitChildren(thisLambda); },
+                    [] (auto&& thisLambda, EntityNode* entity) { entity->visitChildren(thisLambda); },
+                    [&](BrushNode* brush)                      { brushNodes.push_back(brush); },
+                    [] (PatchNode*)                            {}
+                ));
+
+                auto brushes = kdl::vec_parallel_transform(brushNodes, [&](const BrushNode* brushNode) {
+                    const auto& brush = brushNode->brushWithoutRestoringGeometry();
+                    return toParallel ? brush.convertToParallel() : brush.convertToParaxial();
+                });
+
+                // converting the texture coordinate systems does not change the bounds of the brushes
+                const auto updateNodeTree = m_updateNodeTree;
+                m_updateNodeTree = false;
+                for (size_t i = 0u; i < brushNodes.size(); ++i) {
+                    brushNodes[i]->setBrush(std::move(brushes[i]));
+                }
+                m_updateNodeTree = updateNodeTree;
+
+                // Valve 220 maps are marked by a property of the worldspawn entity
+                auto worldEntity = entity();
+                if (toParallel) {
+                    worldEntity.addOrUpdateProperty(m_entityPropertyConfig, EntityPropertyKeys::ValveVersion, "220");
+                } else {
+                    worldEntity.removeProperty(m_entityPropertyConfig, EntityPropertyKeys::ValveVersion);
+                }
+                setEntity(std::move(worldEntity));
+            }
+
+            m_mapFormat = mapFormat;
+        }
+
         const WorldNode::NodeTree& WorldNode::nodeTree() const {
             return *m_nodeTree;
         }
@@ -163,6 +206,13 @@ namespace TrenchBroom {
             invalidateAllIssues();
         }
 
+        void WorldNode::registerIssueGenerators(const std::vector<IssueGenerator*>& issueGenerators) {
+            for (auto* issueGenerator : issueGenerators) {
+                m_issueGeneratorRegistry->registerGenerator(issueGenerator);
+            }
+            invalidateAllIssues();
+        }
+
         void WorldNode::unregisterAllIssueGenerators() {
             m_issueGeneratorRegistry->unregisterAllGenerators();
             invalidateAllIssues();
@@ -194,6 +244,42 @@ namespace TrenchBroom {
             ));
 
             m_nodeTree->clearAndBuild(nodes, [](const auto* node){ return node->physicalBounds(); });
+
+            // the issues of brushes depend on the node tree, see invalidateIssuesOfBrushesContainedIn
+            invalidateAllIssues();
+        }
+
+        WorldNode::NodeTreeUpdateBatch::NodeTreeUpdateBatch(WorldNode& world) :
+        m_world{world} {
+            m_world.beginNodeTreeUpdateBatch();
+        }
+
+        WorldNode::NodeTreeUpdateBatch::~NodeTreeUpdateBatch() {
+            m_world.endNodeTreeUpdateBatch();
+        }
+
+        void WorldNode::beginNodeTreeUpdateBatch() {
+            assert(!m_batchNodeTreeUpdates);
+            m_batchNodeTreeUpdates = true;
+        }
+
+        void WorldNode::endNodeTreeUpdateBatch() {
+            assert(m_batchNodeTreeUpdates);
+            m_batchNodeTreeUpdates = false;
+
+            const auto nodes = std::exchange(m_pendingNodeTreeUpdates, {});
+            m_nodeTree->updateAll(nodes, [](const auto* node){ return node->physicalBounds(); });
+
+            for (auto* node : nodes) {
+                node->accept(kdl::overload(
+                    [] (WorldNode*)       {},
+                    [] (LayerNode*)       {},
+                    [] (GroupNode*)       {},
+                    [] (EntityNode*)      {},
+                    [&](BrushNode* brush) { invalidateIssuesOfBrushesContainedIn(brush->physicalBounds()); },
+                    [] (PatchNode*)       {}
+                ));
+            }
         }
 
         void WorldNode::invalidateAllIssues() {
@@ -203,6 +289,24 @@ namespace TrenchBroom {
             });
         }
 
+        /**
+         * Some issues of a brush depend on the brushes that contain it, e.g. whether it is redundant. When a brush is
+         * added, removed or changed, the issues of every brush it may have contained or may contain now are
+         * invalidated.
+         */
+        void WorldNode::invalidateIssuesOfBrushesContainedIn(const vm::bbox3& bounds) {
+            for (auto* node : m_nodeTree->findContained(bounds)) {
+                node->accept(kdl::overload(
+                    [] (WorldNode*)         {},
+                    [] (LayerNode*)         {},
+                    [] (GroupNode*)         {},
+                    [] (EntityNode*)        {},
+                    [] (BrushNode* brush)   { brush->invalidateIssues(); },
+                    [] (PatchNode*)         {}
+                ));
+            }
+        }
+
         const vm::bbox3& WorldNode::doGetLogicalBounds() const {
             // TODO: this should probably return the world bounds, as it does in Layer::doGetLogicalBounds
             static const vm::bbox3 bounds;
@@ -280,7 +384,7 @@ namespace TrenchBroom {
                     [&](auto&& thisLambda, LayerNode* layer)   { layer->visitChildren(thisLambda); },
                     [&](auto&& thisLambda, GroupNode* group)   { group->visitChildren(thisLambda); },
                     [&](auto&& thisLambda, EntityNode* entity) { m_nodeTree->insert(entity->physicalBounds(), entity); entity->visitChildren(thisLambda); },
-                    [&](BrushNode* brush)                      { m_nodeTree->insert(brush->physicalBounds(), brush); },
+                    [&](BrushNode* brush)                      { m_nodeTree->insert(brush->physicalBounds(), brush); invalidateIssuesOfBrushesContainedIn(brush->physicalBounds()); },
                     [&](PatchNode* patch)                      { m_nodeTree->insert(patch->physicalBounds(), patch); }
                 ));
             }
@@ -312,6 +416,9 @@ namespace TrenchBroom {
                     str << "Node not found with bounds " << nodeToRemove->physicalBounds() << ": " << nodeToRemove;
                     throw NodeTreeException(str.str());
                 }
+                if (!m_pendingNodeTreeUpdates.empty()) {
+                    m_pendingNodeTreeUpdates = kdl::vec_erase(std::move(m_pendingNodeTreeUpdates), nodeToRemove);
+                }
                 };
 
                 node->accept(kdl::overload(
@@ -319,20 +426,41 @@ namespace TrenchBroom {
                     [&](auto&& thisLambda, LayerNode* layer)   { layer->visitChildren(thisLambda); },
                     [&](auto&& thisLambda, GroupNode* group)   { group->visitChildren(thisLambda); },
                     [&](auto&& thisLambda, EntityNode* entity) { doRemove(entity); entity->visitChildren(thisLambda); },
-                    [&](BrushNode* brush)                      { doRemove(brush); },
+                    [&](BrushNode* brush)                      { doRemove(brush); invalidateIssuesOfBrushesContainedIn(brush->physicalBounds()); },
                     [&](PatchNode* patch)                      { doRemove(patch); }
                 ));
             }
         }
 
         void WorldNode::doDescendantPhysicalBoundsDidChange(Node* node) {
-            if (m_updateNodeTree) {
+            if (m_updateNodeTree && m_batchNodeTreeUpdates) {
+                // the node tree still contains the old bounds, the new bounds are handled by endNodeTreeUpdateBatch
+                node->accept(kdl::overload(
+                    [] (WorldNode*) {},
+                    [] (LayerNode*) {},
+                    [] (GroupNode*) {},
+                    [&](EntityNode* entity) { m_pendingNodeTreeUpdates.push_back(entity); },
+                    [&](BrushNode* brush)   {
+                        if (const auto oldBounds = m_nodeTree->boundsOf(brush)) {
+                            invalidateIssuesOfBrushesContainedIn(*oldBounds);
+                        }
+                        m_pendingNodeTreeUpdates.push_back(brush);
+                    },
+                    [&](PatchNode* patch)   { m_pendingNodeTreeUpdates.push_back(patch); }
+                ));
+            } else if (m_updateNodeTree) {
                 node->accept(kdl::overload(
                     [] (WorldNode*) {},
                     [] (LayerNode*) {},
                     [] (GroupNode*) {},
                     [&](EntityNode* entity) { m_nodeTree->update(entity->physicalBounds(), entity); },
-                    [&](BrushNode* brush)   { m_nodeTree->update(brush->physicalBounds(), brush); },
+                    [&](BrushNode* brush)   {
+                        if (const auto oldBounds = m_nodeTree->boundsOf(brush)) {
+                            invalidateIssuesOfBrushesContainedIn(*oldBounds);
+                        }
+                        m_nodeTree->update(brush->physicalBounds(), brush);
+                        invalidateIssuesOfBrushesContainedIn(brush->physicalBounds());
+                    },
                     [&](PatchNode* patch)   { m_nodeTree->update(patch->physicalBounds(), patch); }
                 ));
             }
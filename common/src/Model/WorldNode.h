@@ -56,6 +56,8 @@ namespace TrenchBroom {
             using NodeTree = AABBTree<FloatType, 3, Node*>;
             std::unique_ptr<NodeTree> m_nodeTree;
             bool m_updateNodeTree;
+            bool m_batchNodeTreeUpdates = false;
+            std::vector<Node*> m_pendingNodeTreeUpdates;
 
             IdType m_nextPersistentId = 1;
         public:
@@ -65,6 +67,17 @@ namespace TrenchBroom {
 
             MapFormat mapFormat() const;
 
+            /**
+             * Converts this world to the given map format. If the given format uses a different kind of texture
+             * coordinate system than the current format, the texture coordinate systems of all brush faces are
+             * converted, and the brushes are converted in parallel. The "mapversion" property that marks Valve 220
+             * maps is added to or removed from the world entity accordingly.
+             *
+             * This does not notify any observers of the nodes and cannot be undone, so it is only meant to be used
+             * for worlds that do not belong to a document, e.g. when converting map files.
+             */
+            void convertToMapFormat(MapFormat mapFormat);
+
             const NodeTree& nodeTree() const;
         public: // layer management
             LayerNode* defaultLayer();
@@ -119,13 +132,32 @@ namespace TrenchBroom {
             const std::vector<IssueGenerator*>& registeredIssueGenerators() const;
             std::vector<IssueQuickFix*> quickFixes(IssueType issueTypes) const;
             void registerIssueGenerator(IssueGenerator* issueGenerator);
+            void registerIssueGenerators(const std::vector<IssueGenerator*>& issueGenerators);
             void unregisterAllIssueGenerators();
         public: // node tree bulk updating
             void disableNodeTreeUpdates();
             void enableNodeTreeUpdates();
             void rebuildNodeTree();
+
+            /**
+             * Defers the node tree updates caused by changes to the physical bounds of descendants while an instance
+             * of this class exists. When it is destroyed, all changed nodes are updated at once. Until then, the node
+             * tree contains the old bounds of the changed nodes.
+             */
+            class NodeTreeUpdateBatch {
+            private:
+                WorldNode& m_world;
+            public:
+                explicit NodeTreeUpdateBatch(WorldNode& world);
+                ~NodeTreeUpdateBatch();
+            };
         private:
+            // call these methods via the NodeTreeUpdateBatch class
+            void beginNodeTreeUpdateBatch();
+            void endNodeTreeUpdateBatch();
+
             void invalidateAllIssues();
+            void invalidateIssuesOfBrushesContainedIn(const vm::bbox3& bounds);
         private: // implement Node interface
             const vm::bbox3& doGetLogicalBounds() const override;
             const vm::bbox3& doGetPhysicalBounds() const override;
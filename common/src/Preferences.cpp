@@ -132,6 +132,7 @@ namespace TrenchBroom {
         Preference<int> TextureMinFilter(IO::Path("Renderer/Texture mode min filter"), 0x2700);
         Preference<int> TextureMagFilter(IO::Path("Renderer/Texture mode mag filter"), 0x2600);
         Preference<bool> EnableMSAA(IO::Path("Renderer/Enable multisampling"), true);
+        Preference<int> TextureMemoryBudget(IO::Path("Renderer/Texture memory budget"), 0);
 
         Preference<bool> TextureLock(IO::Path("Editor/Texture lock"), true);
         Preference<bool> UVLock(IO::Path("Editor/UV lock"), false);
@@ -296,6 +297,7 @@ namespace TrenchBroom {
                 &GridColor2D,
                 &TextureMinFilter,
                 &TextureMagFilter,
+                &TextureMemoryBudget,
                 &TextureLock,
                 &UVLock,
                 &RendererFontPath(),
@@ -125,6 +125,10 @@ namespace TrenchBroom {
         extern Preference<int> TextureMinFilter;
         extern Preference<int> TextureMagFilter;
         extern Preference<bool> EnableMSAA;
+        /**
+         * The maximum video memory in MiB that textures may occupy, 0 means unlimited.
+         */
+        extern Preference<int> TextureMemoryBudget;
 
         extern Preference<bool> TextureLock;
         extern Preference<bool> UVLock;
@@ -0,0 +1,252 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "BrushLodRenderer2D.h"
+
+#include "AABBTree.h"
+#include "Color.h"
+#include "PreferenceManager.h"
+#include "Preferences.h"
+#include "Assets/EntityDefinition.h"
+#include "Model/Brush.h"
+#include "Model/BrushGeometry.h"
+#include "Model/BrushNode.h"
+#include "Model/CompactBrushGeometry.h"
+#include "Model/EditorContext.h"
+#include "Model/EntityNode.h"
+#include "Model/GroupNode.h"
+#include "Model/LayerNode.h"
+#include "Model/PatchNode.h"
+#include "Model/WorldNode.h"
+#include "Renderer/GLVertexType.h"
+#include "Renderer/OrthographicCamera.h"
+#include "Renderer/PrimType.h"
+#include "Renderer/VertexArray.h"
+
+#include <kdl/overload.h>
+
+#include <vecmath/bbox.h>
+#include <vecmath/vec.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <utility>
+
+namespace TrenchBroom {
+    namespace Renderer {
+        const float BrushLodRenderer2D::MaxZoom = 0.25f;
+        const float BrushLodRenderer2D::MinBrushSize = 4.0f;
+
+        BrushLodRenderer2D::BrushLodRenderer2D(const Model::EditorContext& editorContext) :
+        m_editorContext(editorContext),
+        m_valid(false),
+        m_zoom(0.0f),
+        m_depthAxis(0u) {}
+
+        bool BrushLodRenderer2D::useLod(const OrthographicCamera& camera) {
+            return camera.zoom() < MaxZoom;
+        }
+
+        float BrushLodRenderer2D::lodZoom(const float zoom) {
+            assert(zoom > 0.0f);
+            if (zoom >= MaxZoom) {
+                return zoom;
+            }
+
+            auto result = MaxZoom;
+            while (result / 2.0f > zoom) {
+                result /= 2.0f;
+            }
+            return result;
+        }
+
+        vm::bbox3 BrushLodRenderer2D::visibleArea(const Model::WorldNode& world, const OrthographicCamera& camera) {
+            const auto& nodeTree = world.nodeTree();
+            assert(!nodeTree.empty());
+
+            // the visible area is unbounded along the view direction
+            const auto depthAxis = vm::find_abs_max_component(camera.direction());
+            const auto viewportVertices = camera.viewportVertices();
+            auto result = vm::bbox3::merge_all(std::begin(viewportVertices), std::end(viewportVertices));
+            result.min[depthAxis] = nodeTree.bounds().min[depthAxis];
+            result.max[depthAxis] = nodeTree.bounds().max[depthAxis];
+            return result;
+        }
+
+        BrushLodRenderer2D::Lod BrushLodRenderer2D::selectLod(const Model::WorldNode& world, const OrthographicCamera& camera, const std::function<bool(const Model::BrushNode*)>& filter) {
+            if (world.nodeTree().empty()) {
+                return {};
+            }
+            return selectLod(world, camera, visibleArea(world, camera), filter);
+        }
+
+        BrushLodRenderer2D::Lod BrushLodRenderer2D::selectLod(const Model::WorldNode& world, const OrthographicCamera& camera, const vm::bbox3& area, const std::function<bool(const Model::BrushNode*)>& filter) {
+            const auto& nodeTree = world.nodeTree();
+            if (nodeTree.empty()) {
+                return {};
+            }
+
+            const auto horizontalAxis = vm::find_abs_max_component(camera.right());
+            const auto verticalAxis = vm::find_abs_max_component(camera.up());
+
+            const auto zoom = static_cast<FloatType>(lodZoom(camera.zoom()));
+            const auto cellSize = static_cast<FloatType>(MinBrushSize) / zoom;
+            const auto cellIndex = [&](const FloatType value) {
+                return static_cast<int64_t>(std::floor(value / cellSize));
+            };
+
+            auto result = Lod{};
+            auto cells = std::map<std::pair<int64_t, int64_t>, vm::bbox3>{};
+
+            for (const auto* node : nodeTree.findIntersectors(area)) {
+                node->accept(kdl::overload(
+                    [] (const Model::WorldNode*)  {},
+                    [] (const Model::LayerNode*)  {},
+                    [] (const Model::GroupNode*)  {},
+                    [] (const Model::EntityNode*) {},
+                    [&](const Model::BrushNode* brushNode) {
+                        if (!filter(brushNode)) {
+                            return;
+                        }
+
+                        const auto& bounds = brushNode->logicalBounds();
+                        const auto size = bounds.size();
+                        if (std::max(size[horizontalAxis], size[verticalAxis]) * zoom >= static_cast<FloatType>(MinBrushSize)) {
+                            result.brushes.push_back(brushNode);
+                        } else {
+                            const auto center = bounds.center();
+                            const auto key = std::make_pair(cellIndex(center[horizontalAxis]), cellIndex(center[verticalAxis]));
+                            const auto [it, inserted] = cells.emplace(key, bounds);
+                            if (!inserted) {
+                                it->second = vm::merge(it->second, bounds);
+                            }
+                        }
+                    },
+                    [] (const Model::PatchNode*) {}
+                ));
+            }
+
+            result.outlines.reserve(cells.size());
+            for (const auto& [key, bounds] : cells) {
+                result.outlines.push_back(bounds);
+            }
+
+            return result;
+        }
+
+        using LodEdgeVertex = GLVertexTypes::P3C4::Vertex;
+
+        static void appendEdges(const Model::Brush& brush, const Color& color, std::vector<LodEdgeVertex>& vertices) {
+            if (const auto* geometry = brush.compactedGeometry()) {
+                const auto& positions = geometry->vertices();
+                for (const auto& edge : geometry->edges()) {
+                    vertices.emplace_back(vm::vec3f(positions[edge.firstVertex]), color);
+                    vertices.emplace_back(vm::vec3f(positions[edge.secondVertex]), color);
+                }
+            } else {
+                for (const auto* edge : brush.edges()) {
+                    vertices.emplace_back(vm::vec3f(edge->firstVertex()->position()), color);
+                    vertices.emplace_back(vm::vec3f(edge->secondVertex()->position()), color);
+                }
+            }
+        }
+
+        static void appendOutline(const vm::bbox3& bounds, const size_t horizontalAxis, const size_t verticalAxis, const Color& color, std::vector<LodEdgeVertex>& vertices) {
+            const auto corner = [&](const FloatType h, const FloatType v) {
+                auto position = bounds.min;
+                position[horizontalAxis] = h;
+                position[verticalAxis] = v;
+                return LodEdgeVertex(vm::vec3f(position), color);
+            };
+
+            const auto h1 = bounds.min[horizontalAxis], h2 = bounds.max[horizontalAxis];
+            const auto v1 = bounds.min[verticalAxis], v2 = bounds.max[verticalAxis];
+
+            vertices.push_back(corner(h1, v1)); vertices.push_back(corner(h2, v1));
+            vertices.push_back(corner(h2, v1)); vertices.push_back(corner(h2, v2));
+            vertices.push_back(corner(h2, v2)); vertices.push_back(corner(h1, v2));
+            vertices.push_back(corner(h1, v2)); vertices.push_back(corner(h1, v1));
+        }
+
+        /**
+         * Brushes that belong to an entity are drawn in the color of the entity's definition.
+         */
+        static Color edgeColor(const Model::BrushNode& brushNode, const Color& defaultColor) {
+            if (const auto* entityNode = dynamic_cast<const Model::EntityNode*>(brushNode.entity())) {
+                if (const auto* definition = entityNode->entity().definition()) {
+                    return definition->color();
+                }
+            }
+            return defaultColor;
+        }
+
+        void BrushLodRenderer2D::invalidate() {
+            m_valid = false;
+        }
+
+        void BrushLodRenderer2D::render(const Model::WorldNode& world, const OrthographicCamera& camera, RenderBatch& renderBatch) {
+            if (world.nodeTree().empty()) {
+                return;
+            }
+
+            const auto area = visibleArea(world, camera);
+            if (!m_valid ||
+                lodZoom(camera.zoom()) != m_zoom ||
+                vm::find_abs_max_component(camera.direction()) != m_depthAxis ||
+                !m_area.contains(area)) {
+                validate(world, camera, area);
+            }
+
+            m_edgeRenderer.render(renderBatch);
+        }
+
+        void BrushLodRenderer2D::validate(const Model::WorldNode& world, const OrthographicCamera& camera, const vm::bbox3& area) {
+            // cache the edges for the visible area and its surroundings so that panning doesn't rebuild them every frame
+            const auto margin = area.size();
+            m_area = vm::bbox3{area.min - margin, area.max + margin};
+            m_zoom = lodZoom(camera.zoom());
+            m_depthAxis = vm::find_abs_max_component(camera.direction());
+
+            // these are the brushes that MapRenderer's default renderer contains
+            const auto lod = selectLod(world, camera, m_area, [&](const Model::BrushNode* brushNode) {
+                return !brushNode->selected() && !brushNode->parentSelected() && !brushNode->locked() && m_editorContext.visible(brushNode);
+            });
+
+            const auto& defaultColor = pref(Preferences::EdgeColor);
+
+            auto vertices = std::vector<LodEdgeVertex>{};
+            for (const auto* brushNode : lod.brushes) {
+                appendEdges(brushNode->brushWithoutRestoringGeometry(), edgeColor(*brushNode, defaultColor), vertices);
+            }
+
+            const auto horizontalAxis = vm::find_abs_max_component(camera.right());
+            const auto verticalAxis = vm::find_abs_max_component(camera.up());
+            for (const auto& bounds : lod.outlines) {
+                appendOutline(bounds, horizontalAxis, verticalAxis, defaultColor, vertices);
+            }
+
+            m_edgeRenderer = DirectEdgeRenderer(VertexArray::move(std::move(vertices)), PrimType::Lines);
+            m_valid = true;
+        }
+    }
+}
@@ -0,0 +1,125 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include "FloatType.h"
+#include "Renderer/EdgeRenderer.h"
+
+#include <vecmath/bbox.h>
+
+#include <functional>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Model {
+        class BrushNode;
+        class EditorContext;
+        class WorldNode;
+    }
+
+    namespace Renderer {
+        class OrthographicCamera;
+        class RenderBatch;
+
+        /**
+         * Renders the unselected brushes of a 2D view at a lower level of detail when the view is zoomed far out.
+         *
+         * Only the brushes whose bounds intersect the visible area of the camera are considered. Brushes which are at
+         * least MinBrushSize pixels wide or high are rendered as edges without any faces. Smaller brushes are merged
+         * into square cells of MinBrushSize pixels, and every occupied cell is rendered as the outline of the bounds
+         * of its brushes.
+         *
+         * The zoom levels are divided into LOD levels that are a power of two apart. The edges are cached in a vertex
+         * array for an area around the visible area, and are only rebuilt if the zoom crosses into another LOD level,
+         * if the camera moves out of the cached area, or if the renderer is invalidated because the nodes changed.
+         */
+        class BrushLodRenderer2D {
+        public:
+            /**
+             * The camera zoom below which the level of detail is reduced.
+             */
+            static const float MaxZoom;
+
+            /**
+             * The size in pixels below which a brush is merged into an outline.
+             */
+            static const float MinBrushSize;
+
+            struct Lod {
+                /**
+                 * The brushes to render as edges.
+                 */
+                std::vector<const Model::BrushNode*> brushes;
+
+                /**
+                 * The bounds of the merged small brushes, one per occupied cell.
+                 */
+                std::vector<vm::bbox3> outlines;
+            };
+        private:
+            const Model::EditorContext& m_editorContext;
+
+            bool m_valid;
+            float m_zoom;
+            size_t m_depthAxis;
+            vm::bbox3 m_area;
+            DirectEdgeRenderer m_edgeRenderer;
+        public:
+            explicit BrushLodRenderer2D(const Model::EditorContext& editorContext);
+
+            /**
+             * Indicates whether the given camera is zoomed out far enough to reduce the level of detail.
+             */
+            static bool useLod(const OrthographicCamera& camera);
+
+            /**
+             * Returns the zoom of the LOD level that contains the given camera zoom. This is the largest zoom of the
+             * LOD level, so brushes are merged into cells of between MinBrushSize / 2 and MinBrushSize pixels. Returns
+             * the given zoom if it is not reduced.
+             */
+            static float lodZoom(float zoom);
+
+            /**
+             * Selects the brushes of the given world that pass the given filter and are visible to the given camera,
+             * and merges those that are smaller than MinBrushSize pixels at the camera's LOD level into outlines.
+             */
+            static Lod selectLod(const Model::WorldNode& world, const OrthographicCamera& camera, const std::function<bool(const Model::BrushNode*)>& filter);
+
+            /**
+             * Like the above, but selects the brushes that intersect the given area instead of the visible area.
+             */
+            static Lod selectLod(const Model::WorldNode& world, const OrthographicCamera& camera, const vm::bbox3& area, const std::function<bool(const Model::BrushNode*)>& filter);
+
+            /**
+             * Discards the cached edges, e.g. because the brushes, their selection or their visibility changed.
+             */
+            void invalidate();
+
+            /**
+             * Renders the brushes of the given world that the default renderer of the map renderer would render.
+             */
+            void render(const Model::WorldNode& world, const OrthographicCamera& camera, RenderBatch& renderBatch);
+        private:
+            static vm::bbox3 visibleArea(const Model::WorldNode& world, const OrthographicCamera& camera);
+            void validate(const Model::WorldNode& world, const OrthographicCamera& camera, const vm::bbox3& area);
+        };
+    }
+}
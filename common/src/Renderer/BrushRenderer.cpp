@@ -69,7 +69,7 @@ namespace TrenchBroom {
         }
 
         bool BrushRenderer::DefaultFilter::visible(const Model::BrushNode* brushNode, const Model::BrushEdge* edge) const {
-            const Model::Brush& brush = brushNode->brush();
+            const Model::Brush& brush = brushNode->brushWithoutRestoringGeometry();
             const auto firstFaceIndex = edge->firstFace()->payload();
             const auto secondFaceIndex = edge->secondFace()->payload();
             assert(firstFaceIndex && secondFaceIndex);
@@ -97,7 +97,7 @@ namespace TrenchBroom {
         }
 
         bool BrushRenderer::DefaultFilter::selected(const Model::BrushNode* brushNode, const Model::BrushEdge* edge) const {
-            const Model::Brush& brush = brushNode->brush();
+            const Model::Brush& brush = brushNode->brushWithoutRestoringGeometry();
             const auto firstFaceIndex = edge->firstFace()->payload();
             const auto secondFaceIndex = edge->secondFace()->payload();
             assert(firstFaceIndex && secondFaceIndex);
@@ -115,7 +115,7 @@ namespace TrenchBroom {
         // NoFilter
 
         BrushRenderer::Filter::RenderSettings BrushRenderer::NoFilter::markFaces(const Model::BrushNode* brushNode) const {
-            const Model::Brush& brush = brushNode->brush();
+            const Model::Brush& brush = brushNode->brushWithoutRestoringGeometry();
             for (const Model::BrushFace& face : brush.faces()) {
                 face.setMarked(true);
             }
@@ -22,17 +22,20 @@
 #include "Model/BrushNode.h"
 #include "Model/BrushFace.h"
 #include "Model/BrushGeometry.h"
+#include "Model/CompactBrushGeometry.h"
 #include "Model/Polyhedron.h"
 
 #include <algorithm>
+#include <iterator>
 
 namespace TrenchBroom {
     namespace Renderer {
         BrushRendererBrushCache::CachedFace::CachedFace(const Model::BrushFace* i_face,
+                                                        const size_t i_vertexCount,
                                                         const size_t i_indexOfFirstVertexRelativeToBrush)
                 : texture(i_face->texture()),
                   face(i_face),
-                  vertexCount(i_face->vertexCount()),
+                  vertexCount(i_vertexCount),
                   indexOfFirstVertexRelativeToBrush(i_indexOfFirstVertexRelativeToBrush) {}
 
         BrushRendererBrushCache::CachedEdge::CachedEdge(const Model::BrushFace* i_face1,
@@ -59,8 +62,18 @@ namespace TrenchBroom {
                 return;
             }
 
+            const Model::Brush& brush = brushNode->brushWithoutRestoringGeometry();
+            if (const auto* compactGeometry = brush.compactedGeometry()) {
+                validateVertexCache(brush, *compactGeometry);
+            } else {
+                validateVertexCache(brush);
+            }
+
+            m_rendererCacheValid = true;
+        }
+
+        void BrushRendererBrushCache::validateVertexCache(const Model::Brush& brush) {
             // build vertex cache and face cache
-            const Model::Brush& brush = brushNode->brush();
 
             m_cachedVertices.clear();
             m_cachedVertices.reserve(brush.vertexCount());
@@ -91,15 +104,10 @@ namespace TrenchBroom {
                 }
 
                 // face cache
-                m_cachedFacesSortedByTexture.emplace_back(&face, indexOfFirstVertexRelativeToBrush);
+                m_cachedFacesSortedByTexture.emplace_back(&face, face.vertexCount(), indexOfFirstVertexRelativeToBrush);
             }
 
-            // Sort by texture so BrushRenderer can efficiently step through the BrushFaces
-            // grouped by texture (via `BrushRendererBrushCache::cachedFacesSortedByTexture()`), without needing to build an std::map
-
-            std::sort(m_cachedFacesSortedByTexture.begin(),
-                      m_cachedFacesSortedByTexture.end(),
-                      [](const CachedFace& a, const CachedFace& b){ return a.texture < b.texture; });
+            sortCachedFacesByTexture();
 
             // Build edge index cache
 
@@ -119,8 +127,55 @@ namespace TrenchBroom {
 
                 m_cachedEdges.emplace_back(&face1, &face2, vertexIndex1RelativeToBrush, vertexIndex2RelativeToBrush);
             }
+        }
 
-            m_rendererCacheValid = true;
+        void BrushRendererBrushCache::validateVertexCache(const Model::Brush& brush, const Model::CompactBrushGeometry& geometry) {
+            // Same as above, but reads the vertices and edges from the compacted geometry so that unused brushes
+            // can be rendered without restoring their half edge geometry.
+
+            m_cachedVertices.clear();
+            m_cachedVertices.reserve(geometry.vertexCount());
+
+            m_cachedFacesSortedByTexture.clear();
+            m_cachedFacesSortedByTexture.reserve(geometry.faceCount());
+
+            // the index of the last cached vertex for each geometry vertex, used when building the edge cache
+            std::vector<size_t> cachedVertexIndices(geometry.vertexCount(), 0u);
+
+            for (size_t i = 0u; i < geometry.faceCount(); ++i) {
+                const auto& face = brush.face(i);
+                const auto indexOfFirstVertexRelativeToBrush = m_cachedVertices.size();
+
+                // The boundary is in CCW order, but the renderer expects CW order:
+                const auto begin = std::make_reverse_iterator(geometry.faceBoundaryEnd(i));
+                const auto end = std::make_reverse_iterator(geometry.faceBoundaryBegin(i));
+                for (auto it = begin; it != end; ++it) {
+                    cachedVertexIndices[*it] = m_cachedVertices.size();
+
+                    const auto& position = geometry.vertices()[*it];
+                    m_cachedVertices.emplace_back(vm::vec3f(position), vm::vec3f(face.boundary().normal), face.textureCoords(position));
+                }
+
+                m_cachedFacesSortedByTexture.emplace_back(&face, geometry.faceVertexCount(i), indexOfFirstVertexRelativeToBrush);
+            }
+
+            sortCachedFacesByTexture();
+
+            m_cachedEdges.clear();
+            m_cachedEdges.reserve(geometry.edges().size());
+
+            for (const auto& edge : geometry.edges()) {
+                m_cachedEdges.emplace_back(&brush.face(edge.firstFace), &brush.face(edge.secondFace), cachedVertexIndices[edge.firstVertex], cachedVertexIndices[edge.secondVertex]);
+            }
+        }
+
+        void BrushRendererBrushCache::sortCachedFacesByTexture() {
+            // Sort by texture so BrushRenderer can efficiently step through the BrushFaces
+            // grouped by texture (via `BrushRendererBrushCache::cachedFacesSortedByTexture()`), without needing to build an std::map
+
+            std::sort(m_cachedFacesSortedByTexture.begin(),
+                      m_cachedFacesSortedByTexture.end(),
+                      [](const CachedFace& a, const CachedFace& b){ return a.texture < b.texture; });
         }
 
         const std::vector<BrushRendererBrushCache::Vertex>& BrushRendererBrushCache::cachedVertices() const {
@@ -137,5 +192,12 @@ namespace TrenchBroom {
             assert(m_rendererCacheValid);
             return m_cachedEdges;
         }
+
+        size_t BrushRendererBrushCache::memoryUsage() const {
+            return sizeof(BrushRendererBrushCache)
+                + m_cachedVertices.capacity() * sizeof(Vertex)
+                + m_cachedEdges.capacity() * sizeof(CachedEdge)
+                + m_cachedFacesSortedByTexture.capacity() * sizeof(CachedFace);
+        }
     }
 }
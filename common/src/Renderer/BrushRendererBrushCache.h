@@ -29,8 +29,10 @@ namespace TrenchBroom {
     }
 
     namespace Model {
+        class Brush;
         class BrushNode;
         class BrushFace;
+        class CompactBrushGeometry;
     }
 
     namespace Renderer {
@@ -46,6 +48,7 @@ namespace TrenchBroom {
                 size_t indexOfFirstVertexRelativeToBrush;
 
                 CachedFace(const Model::BrushFace* i_face,
+                           size_t i_vertexCount,
                            size_t i_indexOfFirstVertexRelativeToBrush);
             };
 
@@ -90,6 +93,15 @@ namespace TrenchBroom {
             const std::vector<Vertex>& cachedVertices() const;
             const std::vector<CachedFace>& cachedFacesSortedByTexture() const;
             const std::vector<CachedEdge>& cachedEdges() const;
+
+            /**
+             * Returns the number of bytes allocated for the cached vertices, faces and edges.
+             */
+            size_t memoryUsage() const;
+        private:
+            void validateVertexCache(const Model::Brush& brush);
+            void validateVertexCache(const Model::Brush& brush, const Model::CompactBrushGeometry& geometry);
+            void sortCachedFacesByTexture();
         };
     }
 }
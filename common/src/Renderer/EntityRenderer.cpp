@@ -49,15 +49,17 @@ namespace TrenchBroom {
         class EntityRenderer::EntityClassnameAnchor : public TextAnchor3D {
         private:
             const Model::EntityNode* m_entity;
+            const vm::mat4x4f& m_transformation;
         public:
-            EntityClassnameAnchor(const Model::EntityNode* entity) :
-            m_entity(entity) {}
+            EntityClassnameAnchor(const Model::EntityNode* entity, const vm::mat4x4f& transformation) :
+            m_entity(entity),
+            m_transformation(transformation) {}
         private:
             vm::vec3f basePosition() const override {
                 auto position = vm::vec3f(m_entity->logicalBounds().center());
                 position[2] = float(m_entity->logicalBounds().max.z());
                 position[2] += 2.0f;
-                return position;
+                return m_transformation * position;
             }
 
             TextAlignment::Type alignment() const override {
@@ -72,6 +74,7 @@ namespace TrenchBroom {
         m_boundsValid(false),
         m_showOverlays(true),
         m_showOccludedOverlays(false),
+        m_overlayTransformation(vm::mat4x4f::identity()),
         m_tint(false),
         m_overrideBoundsColor(false),
         m_showOccludedBounds(false),
@@ -117,6 +120,10 @@ namespace TrenchBroom {
             m_showOccludedOverlays = showOccludedOverlays;
         }
 
+        void EntityRenderer::setOverlayTransformation(const vm::mat4x4f& overlayTransformation) {
+            m_overlayTransformation = overlayTransformation;
+        }
+
         void EntityRenderer::setTint(const bool tint) {
             m_tint = tint;
         }
@@ -210,23 +217,59 @@ namespace TrenchBroom {
         void EntityRenderer::renderClassnames(RenderContext& renderContext, RenderBatch& renderBatch) {
             if (m_showOverlays && renderContext.showEntityClassnames()) {
                 Renderer::RenderService renderService(renderContext, renderBatch);
+
+                // the text renderer hides all labels that are not rendered on top when a 2D view is zoomed out too far
+                if (!m_showOccludedOverlays && renderContext.render2D() && renderContext.camera().zoom() < renderService.textMinZoomFactor()) {
+                    return;
+                }
+
                 renderService.setForegroundColor(m_overlayTextColor);
                 renderService.setBackgroundColor(m_overlayBackgroundColor);
 
+                if (m_showOccludedOverlays)
+                    renderService.setShowOccludedObjects();
+                else
+                    renderService.setHideOccludedObjects();
+
                 for (const Model::EntityNode* entity : m_entities) {
                     if (m_showHiddenEntities || m_editorContext.visible(entity)) {
                         if (entity->containingGroup() == nullptr || entity->containingGroup() == m_editorContext.currentGroup()) {
-                            if (m_showOccludedOverlays)
-                                renderService.setShowOccludedObjects();
-                            else
-                                renderService.setHideOccludedObjects();
-                            renderService.renderString(entityString(entity), EntityClassnameAnchor(entity));
+                            const auto anchor = EntityClassnameAnchor(entity, m_overlayTransformation);
+                            if (isClassnameVisible(renderContext, anchor, renderService.textMaxViewDistance())) {
+                                renderService.renderString(entityString(entity), anchor);
+                            }
                         }
                     }
                 }
             }
         }
 
+        bool EntityRenderer::isClassnameVisible(const RenderContext& renderContext, const EntityClassnameAnchor& anchor, const float maxViewDistance) const {
+            // Culls classnames before their strings are built. The text renderer performs exact culling against the
+            // measured label size later on, so we only need to be conservative here.
+            static const auto ViewportMargin = 256.0f;
+
+            const auto& camera = renderContext.camera();
+            const auto position = anchor.position(camera);
+
+            if (camera.perspectiveProjection()) {
+                const auto distance = camera.perpendicularDistanceTo(position);
+                if (distance <= 0.0f) {
+                    return false;
+                }
+                if (!m_showOccludedOverlays && distance > maxViewDistance) {
+                    return false;
+                }
+            }
+
+            const auto& viewport = camera.viewport();
+            const auto projected = camera.project(position);
+            return projected.x() >= float(viewport.x) - ViewportMargin
+                && projected.x() <= float(viewport.x + viewport.width) + ViewportMargin
+                && projected.y() >= float(viewport.y) - ViewportMargin
+                && projected.y() <= float(viewport.y + viewport.height) + ViewportMargin;
+        }
+
         void EntityRenderer::renderAngles(RenderContext& renderContext, RenderBatch& renderBatch) {
             if (!m_showAngles) {
                 return;
@@ -26,6 +26,7 @@
 #include "Renderer/TriangleRenderer.h"
 
 #include <vecmath/forward.h>
+#include <vecmath/mat.h>
 
 #include <vector>
 
@@ -63,6 +64,7 @@ namespace TrenchBroom {
             Color m_overlayTextColor;
             Color m_overlayBackgroundColor;
             bool m_showOccludedOverlays;
+            vm::mat4x4f m_overlayTransformation;
             bool m_tint;
             Color m_tintColor;
             bool m_overrideBoundsColor;
@@ -85,6 +87,13 @@ namespace TrenchBroom {
             void setOverlayBackgroundColor(const Color& overlayBackgroundColor);
             void setShowOccludedOverlays(bool showOccludedOverlays);
 
+            /**
+             * Sets the transformation that is applied to the classname overlays. The overlays are projected when they
+             * are added to the render batch, so they are not affected by the model matrix that the geometry is
+             * rendered with.
+             */
+            void setOverlayTransformation(const vm::mat4x4f& overlayTransformation);
+
             void setTint(bool tint);
             void setTintColor(const Color& tintColor);
 
@@ -107,6 +116,7 @@ namespace TrenchBroom {
             void renderSolidBounds(RenderBatch& renderBatch);
             void renderModels(RenderContext& renderContext, RenderBatch& renderBatch);
             void renderClassnames(RenderContext& renderContext, RenderBatch& renderBatch);
+            bool isClassnameVisible(const RenderContext& renderContext, const EntityClassnameAnchor& anchor, float maxViewDistance) const;
             void renderAngles(RenderContext& renderContext, RenderBatch& renderBatch);
             std::vector<vm::vec3f> arrowHead(float length, float width) const;
 
@@ -32,6 +32,12 @@
 #include "Renderer/Shaders.h"
 #include "Renderer/ShaderManager.h"
 
+#include <vecmath/vec.h>
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
 namespace TrenchBroom {
     namespace Renderer {
         struct FaceRenderer::RenderFunc : public TextureRenderFunc {
@@ -73,7 +79,8 @@ namespace TrenchBroom {
         m_faceColor(faceColor),
         m_grayscale(false),
         m_tint(false),
-        m_alpha(1.0f) {}
+        m_alpha(1.0f),
+        m_batches(buildBatches(*m_indexArrayMap)) {}
 
         FaceRenderer::FaceRenderer(const FaceRenderer& other) :
         IndexedRenderable(other),
@@ -83,7 +90,8 @@ namespace TrenchBroom {
         m_grayscale(other.m_grayscale),
         m_tint(other.m_tint),
         m_tintColor(other.m_tintColor),
-        m_alpha(other.m_alpha) {}
+        m_alpha(other.m_alpha),
+        m_batches(other.m_batches) {}
 
         FaceRenderer& FaceRenderer::operator=(FaceRenderer other) {
             using std::swap;
@@ -100,6 +108,7 @@ namespace TrenchBroom {
             swap(left.m_tint, right.m_tint);
             swap(left.m_tintColor, right.m_tintColor);
             swap(left.m_alpha, right.m_alpha);
+            swap(left.m_batches, right.m_batches);
         }
 
         void FaceRenderer::setGrayscale(const bool grayscale) {
@@ -122,6 +131,31 @@ namespace TrenchBroom {
             renderBatch.add(this);
         }
 
+        std::vector<FaceRenderer::Batch> FaceRenderer::buildBatches(const TextureToBrushIndicesMap& indexArrayMap) {
+            auto result = std::vector<Batch>{};
+            result.reserve(indexArrayMap.size());
+
+            for (const auto& [texture, brushIndexHolderPtr] : indexArrayMap) {
+                if (brushIndexHolderPtr->hasValidIndices()) {
+                    const bool masked = texture != nullptr && texture->masked();
+                    result.push_back(Batch{texture, brushIndexHolderPtr, masked, gridColorForTexture(texture)});
+                }
+            }
+
+            // The order of the map is arbitrary, so we sort by render state and then by texture for a stable order.
+            std::sort(std::begin(result), std::end(result), [](const Batch& lhs, const Batch& rhs) {
+                if (lhs.masked != rhs.masked) {
+                    return !lhs.masked;
+                }
+                if (lhs.gridColor != rhs.gridColor) {
+                    return lhs.gridColor < rhs.gridColor;
+                }
+                return std::less<const Assets::Texture*>{}(lhs.texture, rhs.texture);
+            });
+
+            return result;
+        }
+
         void FaceRenderer::prepareVerticesAndIndices(VboManager& vboManager) {
             m_vertexArray->prepare(vboManager);
 
@@ -131,7 +165,7 @@ namespace TrenchBroom {
         }
 
         void FaceRenderer::doRender(RenderContext& context) {
-            if (m_indexArrayMap->empty())
+            if (m_batches.empty())
                 return;
 
             if (m_vertexArray->setupVertices()) {
@@ -172,22 +206,27 @@ namespace TrenchBroom {
                 if (m_alpha < 1.0f) {
                     glAssert(glDepthMask(GL_FALSE));
                 }
-                for (const auto& [texture, brushIndexHolderPtr] : *m_indexArrayMap) {
-                    if (!brushIndexHolderPtr->hasValidIndices()) {
+                const Batch* previous = nullptr;
+                for (const auto& batch : m_batches) {
+                    // removing brushes can leave an index array without any valid indices until the next validation
+                    if (!batch.indices->hasValidIndices()) {
                         continue;
                     }
 
-                    const bool enableMasked = texture != nullptr && texture->masked();
-                    
-                    // set any per-texture uniforms
-                    shader.set("GridColor", gridColorForTexture(texture));
-                    shader.set("EnableMasked", enableMasked);
-
-                    func.before(texture);
-                    brushIndexHolderPtr->setupIndices();
-                    brushIndexHolderPtr->render(PrimType::Triangles);
-                    brushIndexHolderPtr->cleanupIndices();
-                    func.after(texture);
+                    // set any per-texture uniforms only if they differ from the previous batch
+                    if (previous == nullptr || batch.gridColor != previous->gridColor) {
+                        shader.set("GridColor", batch.gridColor);
+                    }
+                    if (previous == nullptr || batch.masked != previous->masked) {
+                        shader.set("EnableMasked", batch.masked);
+                    }
+
+                    func.before(batch.texture);
+                    batch.indices->setupIndices();
+                    batch.indices->render(PrimType::Triangles);
+                    batch.indices->cleanupIndices();
+                    func.after(batch.texture);
+                    previous = &batch;
                 }
                 if (m_alpha < 1.0f) {
                     glAssert(glDepthMask(GL_TRUE));
@@ -27,6 +27,7 @@
 
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 namespace TrenchBroom {
     namespace Assets {
@@ -39,11 +40,23 @@ namespace TrenchBroom {
         class RenderBatch;
 
         class FaceRenderer : public IndexedRenderable {
+        public:
+            using TextureToBrushIndicesMap = const std::unordered_map<const Assets::Texture*, std::shared_ptr<BrushIndexArray>>;
+
+            /**
+             * The faces that are rendered with one texture. Each batch is drawn with one draw call. Batching faces with
+             * different textures into a single draw call would require texture arrays or an atlas, which the GLSL 1.20
+             * face shader cannot sample, and a per-vertex texture layer in the brush vertex format.
+             */
+            struct Batch {
+                const Assets::Texture* texture;
+                std::shared_ptr<BrushIndexArray> indices;
+                bool masked;
+                vm::vec3f gridColor;
+            };
         private:
             struct RenderFunc;
 
-            using TextureToBrushIndicesMap = const std::unordered_map<const Assets::Texture*, std::shared_ptr<BrushIndexArray>>;
-
             std::shared_ptr<BrushVertexArray> m_vertexArray;
             std::shared_ptr<TextureToBrushIndicesMap> m_indexArrayMap;
             Color m_faceColor;
@@ -51,6 +64,10 @@ namespace TrenchBroom {
             bool m_tint;
             Color m_tintColor;
             float m_alpha;
+
+            // built once per face renderer, BrushRenderer creates a new face renderer whenever brushes are validated
+            // the batches share ownership of the index arrays because removing a brush may erase them from the map
+            std::vector<Batch> m_batches;
         public:
             FaceRenderer();
             FaceRenderer(std::shared_ptr<BrushVertexArray> vertexArray, std::shared_ptr<TextureToBrushIndicesMap> indexArrayMap, const Color& faceColor);
@@ -65,6 +82,13 @@ namespace TrenchBroom {
             void setAlpha(float alpha);
 
             void render(RenderBatch& renderBatch);
+
+            /**
+             * Returns the batches to render for the given index arrays. Batches without any valid indices are omitted,
+             * and the remaining batches are ordered such that batches that share render state are adjacent, which
+             * minimizes the number of state changes between draw calls.
+             */
+            static std::vector<Batch> buildBatches(const TextureToBrushIndicesMap& indexArrayMap);
         private:
             void prepareVerticesAndIndices(VboManager& vboManager) override;
             void doRender(RenderContext& context) override;
@@ -30,6 +30,9 @@
 #include "Renderer/RenderService.h"
 #include "Renderer/TextAnchor.h"
 
+#include <vecmath/mat.h>
+#include <vecmath/vec.h>
+
 #include <vector>
 
 #include <vector>
@@ -39,15 +42,17 @@ namespace TrenchBroom {
         class GroupRenderer::GroupNameAnchor : public TextAnchor3D {
         private:
             const Model::GroupNode* m_group;
+            const vm::mat4x4f& m_transformation;
         public:
-            GroupNameAnchor(const Model::GroupNode* group) :
-            m_group(group) {}
+            GroupNameAnchor(const Model::GroupNode* group, const vm::mat4x4f& transformation) :
+            m_group(group),
+            m_transformation(transformation) {}
         private:
             vm::vec3f basePosition() const override {
                 auto position = vm::vec3f(m_group->logicalBounds().center());
                 position[2] = float(m_group->logicalBounds().max.z());
                 position[2] += 2.0f;
-                return position;
+                return m_transformation * position;
             }
 
             TextAlignment::Type alignment() const override {
@@ -61,6 +66,7 @@ namespace TrenchBroom {
         m_overrideColors(false),
         m_showOverlays(true),
         m_showOccludedOverlays(false),
+        m_overlayTransformation(vm::mat4x4f::identity()),
         m_showOccludedBounds(false) {}
 
         void GroupRenderer::setGroups(const std::vector<Model::GroupNode*>& groups) {
@@ -97,6 +103,10 @@ namespace TrenchBroom {
             m_showOccludedOverlays = showOccludedOverlays;
         }
 
+        void GroupRenderer::setOverlayTransformation(const vm::mat4x4f& overlayTransformation) {
+            m_overlayTransformation = overlayTransformation;
+        }
+
         void GroupRenderer::setBoundsColor(const Color& boundsColor) {
             m_boundsColor = boundsColor;
         }
@@ -145,7 +155,7 @@ namespace TrenchBroom {
                             renderService.setForegroundColor(groupColor(group));
                         }
 
-                        const GroupNameAnchor anchor(group);
+                        const GroupNameAnchor anchor(group, m_overlayTransformation);
                         if (m_showOccludedOverlays) {
                             renderService.setShowOccludedObjects();
                         } else {
@@ -23,6 +23,8 @@
 #include "Color.h"
 #include "Renderer/EdgeRenderer.h"
 
+#include <vecmath/mat.h>
+
 #include <vector>
 
 namespace TrenchBroom {
@@ -50,6 +52,7 @@ namespace TrenchBroom {
             Color m_overlayTextColor;
             Color m_overlayBackgroundColor;
             bool m_showOccludedOverlays;
+            vm::mat4x4f m_overlayTransformation;
             Color m_boundsColor;
             bool m_showOccludedBounds;
             Color m_occludedBoundsColor;
@@ -90,6 +93,12 @@ namespace TrenchBroom {
             void setOverlayBackgroundColor(const Color& overlayBackgroundColor);
             void setShowOccludedOverlays(bool showOccludedOverlays);
 
+            /**
+             * Sets the transformation that is applied to the group name overlays, see
+             * EntityRenderer::setOverlayTransformation.
+             */
+            void setOverlayTransformation(const vm::mat4x4f& overlayTransformation);
+
             void setBoundsColor(const Color& boundsColor);
 
             void setShowOccludedBounds(bool showOccludedBounds);
@@ -39,6 +39,7 @@
 #include "Renderer/RenderBatch.h"
 #include "Renderer/RenderContext.h"
 #include "Renderer/RenderUtils.h"
+#include "Renderer/Transformation.h"
 #include "View/Selection.h"
 #include "View/MapDocument.h"
 
@@ -46,6 +47,8 @@
 #include <kdl/overload.h>
 #include <kdl/vector_set.h>
 
+#include <vecmath/mat.h>
+
 #include <set>
 #include <vector>
 
@@ -62,7 +65,7 @@ namespace TrenchBroom {
                 }
 
                 const bool brushSelected = selected(brushNode);
-                const Model::Brush& brush = brushNode->brush();
+                const Model::Brush& brush = brushNode->brushWithoutRestoringGeometry();
                 for (const Model::BrushFace& face : brush.faces()) {
                     face.setMarked(brushSelected || selected(brushNode, face));
                 }
@@ -80,7 +83,7 @@ namespace TrenchBroom {
                     return renderNothing();
                 }
 
-                const Model::Brush& brush = brushNode->brush();
+                const Model::Brush& brush = brushNode->brushWithoutRestoringGeometry();
                 for (const Model::BrushFace& face : brush.faces()) {
                     face.setMarked(true);
                 }
@@ -106,7 +109,7 @@ namespace TrenchBroom {
                     return renderNothing();
                 }
 
-                const Model::Brush& brush = brushNode->brush();
+                const Model::Brush& brush = brushNode->brushWithoutRestoringGeometry();
                 
                 bool anyFaceVisible = false;
                 for (const Model::BrushFace& face : brush.faces()) {
@@ -189,6 +192,12 @@ namespace TrenchBroom {
             setupSelectionRenderer(*m_selectionRenderer);
         }
 
+        void MapRenderer::prepareFrame() {
+            m_defaultRenderer->validateBrushes();
+            m_selectionRenderer->validateBrushes();
+            m_lockedRenderer->validateBrushes();
+        }
+
         void MapRenderer::render(RenderContext& renderContext, RenderBatch& renderBatch) {
             commitPendingChanges();
             setupGL(renderBatch);
@@ -226,23 +235,66 @@ namespace TrenchBroom {
 
         void MapRenderer::renderDefaultOpaque(RenderContext& renderContext, RenderBatch& renderBatch) {
             m_defaultRenderer->setShowOverlays(renderContext.render3D());
-            m_defaultRenderer->renderOpaque(renderContext, renderBatch);
+            m_defaultRenderer->renderOpaque(renderContext, renderBatch, !renderContext.hideUnselectedBrushes());
         }
 
         void MapRenderer::renderDefaultTransparent(RenderContext& renderContext, RenderBatch& renderBatch) {
-            m_defaultRenderer->setShowOverlays(renderContext.render3D());
-            m_defaultRenderer->renderTransparent(renderContext, renderBatch);
+            if (!renderContext.hideUnselectedBrushes()) {
+                m_defaultRenderer->setShowOverlays(renderContext.render3D());
+                m_defaultRenderer->renderTransparent(renderContext, renderBatch);
+            }
         }
 
+        class PushModelMatrix : public Renderable {
+        private:
+            vm::mat4x4f m_matrix;
+        public:
+            explicit PushModelMatrix(const vm::mat4x4f& matrix) :
+            m_matrix(matrix) {}
+        private:
+            void doRender(RenderContext& renderContext) override {
+                renderContext.transformation().pushModelMatrix(m_matrix);
+            }
+        };
+
+        class PopModelMatrix : public Renderable {
+        private:
+            void doRender(RenderContext& renderContext) override {
+                renderContext.transformation().popModelMatrix();
+            }
+        };
+
         void MapRenderer::renderSelectionOpaque(RenderContext& renderContext, RenderBatch& renderBatch) {
             if (!renderContext.hideSelection()) {
+                pushSelectionPreviewTransformation(renderBatch);
                 m_selectionRenderer->renderOpaque(renderContext, renderBatch);
+                popSelectionPreviewTransformation(renderBatch);
             }
         }
 
         void MapRenderer::renderSelectionTransparent(RenderContext& renderContext, RenderBatch& renderBatch) {
             if (!renderContext.hideSelection()) {
+                pushSelectionPreviewTransformation(renderBatch);
                 m_selectionRenderer->renderTransparent(renderContext, renderBatch);
+                popSelectionPreviewTransformation(renderBatch);
+            }
+        }
+
+        void MapRenderer::pushSelectionPreviewTransformation(RenderBatch& renderBatch) {
+            auto document = kdl::mem_lock(m_document);
+            const auto& transformation = document->selectionPreviewTransformation();
+
+            // overlays are projected when they are added to the batch, so the model matrix does not apply to them
+            m_selectionRenderer->setOverlayTransformation(transformation ? vm::mat4x4f(*transformation) : vm::mat4x4f::identity());
+            if (transformation) {
+                renderBatch.addOneShot(new PushModelMatrix(vm::mat4x4f(*transformation)));
+            }
+        }
+
+        void MapRenderer::popSelectionPreviewTransformation(RenderBatch& renderBatch) {
+            auto document = kdl::mem_lock(m_document);
+            if (document->selectionPreviewTransformation()) {
+                renderBatch.addOneShot(new PopModelMatrix());
             }
         }
 
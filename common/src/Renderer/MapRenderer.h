@@ -85,6 +85,11 @@ namespace TrenchBroom {
             void overrideSelectionColors(const Color& color, float mix);
             void restoreSelectionColors();
         public: // rendering
+            /**
+             * Performs the view independent work that is needed before the map can be rendered, so that it is done
+             * once per frame and not by each map view. This does not require an OpenGL context.
+             */
+            void prepareFrame();
             void render(RenderContext& renderContext, RenderBatch& renderBatch);
         private:
             void commitPendingChanges();
@@ -93,6 +98,8 @@ namespace TrenchBroom {
             void renderDefaultTransparent(RenderContext& renderContext, RenderBatch& renderBatch);
             void renderSelectionOpaque(RenderContext& renderContext, RenderBatch& renderBatch);
             void renderSelectionTransparent(RenderContext& renderContext, RenderBatch& renderBatch);
+            void pushSelectionPreviewTransformation(RenderBatch& renderBatch);
+            void popSelectionPreviewTransformation(RenderBatch& renderBatch);
             void renderLockedOpaque(RenderContext& renderContext, RenderBatch& renderBatch);
             void renderLockedTransparent(RenderContext& renderContext, RenderBatch& renderBatch);
             void renderEntityLinks(RenderContext& renderContext, RenderBatch& renderBatch);
@@ -37,6 +37,12 @@ namespace TrenchBroom {
             m_patchRenderer.invalidate();
         }
 
+        void ObjectRenderer::validateBrushes() {
+            if (!m_brushRenderer.valid()) {
+                m_brushRenderer.validate();
+            }
+        }
+
         void ObjectRenderer::invalidateBrushes(const std::vector<Model::BrushNode*>& brushes) {
             m_brushRenderer.invalidateBrushes(brushes);
         }
@@ -57,6 +63,11 @@ namespace TrenchBroom {
             m_entityRenderer.setShowOverlays(showOverlays);
         }
 
+        void ObjectRenderer::setOverlayTransformation(const vm::mat4x4f& overlayTransformation) {
+            m_groupRenderer.setOverlayTransformation(overlayTransformation);
+            m_entityRenderer.setOverlayTransformation(overlayTransformation);
+        }
+
         void ObjectRenderer::setEntityOverlayTextColor(const Color &overlayTextColor) {
             m_entityRenderer.setOverlayTextColor(overlayTextColor);
         }
@@ -147,8 +158,10 @@ namespace TrenchBroom {
             m_brushRenderer.setShowHiddenBrushes(showHiddenObjects);
         }
 
-        void ObjectRenderer::renderOpaque(RenderContext& renderContext, RenderBatch& renderBatch) {
-            m_brushRenderer.renderOpaque(renderContext, renderBatch);
+        void ObjectRenderer::renderOpaque(RenderContext& renderContext, RenderBatch& renderBatch, const bool renderBrushes) {
+            if (renderBrushes) {
+                m_brushRenderer.renderOpaque(renderContext, renderBatch);
+            }
             m_patchRenderer.render(renderContext, renderBatch);
             m_entityRenderer.render(renderContext, renderBatch);
             m_groupRenderer.render(renderContext, renderBatch);
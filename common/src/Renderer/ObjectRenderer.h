@@ -24,6 +24,8 @@
 #include "Renderer/GroupRenderer.h"
 #include "Renderer/PatchRenderer.h"
 
+#include <vecmath/forward.h>
+
 #include <vector>
 
 namespace TrenchBroom {
@@ -63,10 +65,20 @@ namespace TrenchBroom {
             void setObjects(const std::vector<Model::GroupNode*>& groups, const std::vector<Model::EntityNode*>& entities, const std::vector<Model::BrushNode*>& brushes, const std::vector<Model::PatchNode*>& patches);
             void invalidate();
             void invalidateBrushes(const std::vector<Model::BrushNode*>& brushes);
+
+            /**
+             * Rebuilds the vertex caches of any invalidated brushes. This does not require an OpenGL context.
+             */
+            void validateBrushes();
             void clear();
             void reloadModels();
         public: // configuration
             void setShowOverlays(bool showOverlays);
+
+            /**
+             * Sets the transformation that is applied to the entity classname and group name overlays.
+             */
+            void setOverlayTransformation(const vm::mat4x4f& overlayTransformation);
             void setEntityOverlayTextColor(const Color& overlayTextColor);
             void setGroupOverlayTextColor(const Color& overlayTextColor);
             void setOverlayBackgroundColor(const Color& overlayBackgroundColor);
@@ -94,7 +106,11 @@ namespace TrenchBroom {
 
             void setShowHiddenObjects(bool showHiddenObjects);
         public: // rendering
-            void renderOpaque(RenderContext& renderContext, RenderBatch& renderBatch);
+            /**
+             * Renders the opaque parts of the objects. If renderBrushes is false, the brushes are skipped, e.g. because
+             * they are rendered at a lower level of detail by another renderer.
+             */
+            void renderOpaque(RenderContext& renderContext, RenderBatch& renderBatch, bool renderBrushes = true);
             void renderTransparent(RenderContext& renderContext, RenderBatch& renderBatch);
         private:
             ObjectRenderer(const ObjectRenderer&);
@@ -37,11 +37,15 @@
 #include "Renderer/TexturedIndexArrayRenderer.h"
 #include "Renderer/VertexArray.h"
 
+#include <kdl/parallel.h>
 #include <kdl/vector_utils.h>
 
 #include <vecmath/forward.h>
+#include <vecmath/bbox.h>
 #include <vecmath/vec.h>
 
+#include <iterator>
+
 namespace TrenchBroom {
     namespace Renderer {
         PatchRenderer::PatchRenderer() :
@@ -104,6 +108,11 @@ namespace TrenchBroom {
                 validate();
             }
 
+            m_renderLod = renderContext.render3D();
+            if (m_renderLod) {
+                validateLod(renderContext.camera());
+            }
+
             if (renderContext.showFaces()) {
                 renderBatch.add(this);
             }
@@ -116,41 +125,71 @@ namespace TrenchBroom {
             }
         }
 
-        static TexturedIndexArrayRenderer buildMeshRenderer(const std::vector<Model::PatchNode*>& patchNodes) {
-                size_t vertexCount = 0u;
+        /**
+         * Distant patches are rendered with fewer grid points. Whenever the distance of a patch to the camera doubles
+         * beyond this distance, only every other row and column of its grid is used, until the grid is as coarse as
+         * the patch surfaces themselves.
+         */
+        static constexpr float LodDistance = 1024.0f;
+
+        using PatchVertex = GLVertexTypes::P3NT2::Vertex;
+
+        static VertexArray buildVertexArray(const std::vector<Model::PatchNode*>& patchNodes, std::vector<size_t>& vertexOffsets) {
+            vertexOffsets.clear();
+            vertexOffsets.reserve(patchNodes.size());
+
+            size_t vertexCount = 0u;
+            for (const auto* patchNode : patchNodes) {
+                vertexOffsets.push_back(vertexCount);
+                vertexCount += patchNode->grid().points.size();
+            }
+
+            // every patch writes its vertices to its own range, so the conversion can run in parallel
+            auto vertices = std::vector<PatchVertex>(vertexCount);
+            kdl::parallel_for(patchNodes.size(), [&](const size_t i) {
+                const auto& grid = patchNodes[i]->grid();
+                auto it = std::next(std::begin(vertices), static_cast<std::ptrdiff_t>(vertexOffsets[i]));
+                for (const auto& p : grid.points) {
+                    *it++ = PatchVertex{vm::vec3f{p.position}, vm::vec3f{p.normal}, vm::vec2f{p.texCoords}};
+                }
+            });
+
+            return VertexArray::move(std::move(vertices));
+        }
+
+        /**
+         * Builds the triangles of the given patches, using only every stride-th row and column of each patch grid.
+         */
+        static TexturedIndexArrayRenderer buildMeshRenderer(const std::vector<Model::PatchNode*>& patchNodes, const VertexArray& vertexArray, const std::vector<size_t>& vertexOffsets, const std::vector<size_t>& strides) {
                 auto indexArrayMapSize = TexturedIndexArrayMap::Size{};
                 
-                for (const auto* patchNode : patchNodes) {
-                    vertexCount += patchNode->grid().pointRowCount * patchNode->grid().pointColumnCount;
+                for (size_t i = 0u; i < patchNodes.size(); ++i) {
+                    const auto* patchNode = patchNodes[i];
+                    const auto stride = strides[i];
 
                     const auto* texture = patchNode->patch().texture();
-                    const auto quadCount = patchNode->grid().quadRowCount() * patchNode->grid().quadColumnCount();
+                    const auto quadCount = (patchNode->grid().quadRowCount() / stride) * (patchNode->grid().quadColumnCount() / stride);
                     indexArrayMapSize.inc(texture, PrimType::Triangles, 6u * quadCount);
                 }
 
-                using Vertex = GLVertexTypes::P3NT2::Vertex;
-                auto vertices = std::vector<Vertex>{};
-                vertices.reserve(vertexCount);
-
                 auto indexArrayMapBuilder = TexturedIndexArrayMapBuilder{indexArrayMapSize};
                 using Index = TexturedIndexArrayMapBuilder::Index;
 
-                for (const auto* patchNode : patchNodes) {
-                    const auto vertexOffset = vertices.size();
+                for (size_t i = 0u; i < patchNodes.size(); ++i) {
+                    const auto* patchNode = patchNodes[i];
+                    const auto vertexOffset = vertexOffsets[i];
+                    const auto stride = strides[i];
 
                     const auto& grid = patchNode->grid();
-                    auto gridVertices = kdl::vec_transform(grid.points, [](const auto& p) { return Vertex{vm::vec3f{p.position}, vm::vec3f{p.normal}, vm::vec2f{p.texCoords}}; });
-                    vertices = kdl::vec_concat(std::move(vertices), std::move(gridVertices));
-
                     const auto* texture = patchNode->patch().texture();
 
                     const auto pointsPerRow = grid.pointColumnCount;
-                    for (size_t row = 0u; row < grid.quadRowCount(); ++row) {
-                        for (size_t col = 0u; col < grid.quadColumnCount(); ++col) {
+                    for (size_t row = 0u; row < grid.quadRowCount(); row += stride) {
+                        for (size_t col = 0u; col < grid.quadColumnCount(); col += stride) {
                             const auto i0 = vertexOffset + row * pointsPerRow + col;
-                            const auto i1 = vertexOffset + row * pointsPerRow + col + 1u;
-                            const auto i2 = vertexOffset + (row + 1u) * pointsPerRow + col + 1u;
-                            const auto i3 = vertexOffset + (row + 1u) * pointsPerRow + col;
+                            const auto i1 = vertexOffset + row * pointsPerRow + col + stride;
+                            const auto i2 = vertexOffset + (row + stride) * pointsPerRow + col + stride;
+                            const auto i3 = vertexOffset + (row + stride) * pointsPerRow + col;
 
                             indexArrayMapBuilder.addTriangle(texture, static_cast<Index>(i0), static_cast<Index>(i1), static_cast<Index>(i2));
                             indexArrayMapBuilder.addTriangle(texture, static_cast<Index>(i2), static_cast<Index>(i3), static_cast<Index>(i0));
@@ -158,9 +197,33 @@ namespace TrenchBroom {
                     }
                 }
 
-                auto vertexArray = VertexArray::move(std::move(vertices));
                 auto indexArray = IndexArray::move(std::move(indexArrayMapBuilder.indices()));
-                return TexturedIndexArrayRenderer{std::move(vertexArray), std::move(indexArray), std::move(indexArrayMapBuilder.ranges())};
+                return TexturedIndexArrayRenderer{vertexArray, std::move(indexArray), std::move(indexArrayMapBuilder.ranges())};
+        }
+
+        static size_t lodStride(const Model::PatchNode& patchNode, const vm::vec3f& cameraPosition) {
+            const auto& grid = patchNode.grid();
+            const auto surfaceRowCount = patchNode.patch().surfaceRowCount();
+            const auto surfaceColumnCount = patchNode.patch().surfaceColumnCount();
+            if (surfaceRowCount == 0u || surfaceColumnCount == 0u) {
+                return 1u;
+            }
+
+            // the grid has the same number of subdivisions per surface in both directions
+            const auto maxStride = grid.quadRowCount() / surfaceRowCount;
+
+            const auto& bounds = grid.bounds;
+            const auto position = vm::vec3{cameraPosition};
+            const auto closestPoint = vm::max(bounds.min, vm::min(bounds.max, position));
+            const auto distance = static_cast<float>(vm::distance(position, closestPoint));
+
+            auto stride = size_t(1);
+            auto strideDistance = LodDistance;
+            while (distance > strideDistance && stride < maxStride) {
+                stride *= 2u;
+                strideDistance *= 2.0f;
+            }
+            return stride;
         }
 
         static DirectEdgeRenderer buildEdgeRenderer(const std::vector<Model::PatchNode*>& patchNodes) {
@@ -169,7 +232,7 @@ namespace TrenchBroom {
 
                 for (const auto* patchNode : patchNodes) {
                     vertexCount += (patchNode->grid().pointRowCount + patchNode->grid().pointColumnCount - 2u) * 2u;
-                    indexRangeMapSize.inc(PrimType::LineLoop, vertexCount);
+                    indexRangeMapSize.inc(PrimType::LineLoop);
                 }
 
                 auto indexRangeMapBuilder = IndexRangeMapBuilder<GLVertexTypes::P3>{vertexCount, indexRangeMapSize};
@@ -221,15 +284,40 @@ namespace TrenchBroom {
 
         void PatchRenderer::validate() {
             if (!m_valid) {
-                m_patchMeshRenderer = buildMeshRenderer(m_patchNodes);
+                m_vertexArray = buildVertexArray(m_patchNodes, m_vertexOffsets);
+
+                const auto fullDetailStrides = std::vector<size_t>(m_patchNodes.size(), 1u);
+                m_patchMeshRenderer = buildMeshRenderer(m_patchNodes, m_vertexArray, m_vertexOffsets, fullDetailStrides);
                 m_edgeRenderer = buildEdgeRenderer(m_patchNodes);
 
+                m_lodStrides = fullDetailStrides;
+                m_lodPatchMeshRenderer = m_patchMeshRenderer;
+
                 m_valid = true;
             }
         }
 
+        void PatchRenderer::validateLod(const Camera& camera) {
+            auto lodChanged = false;
+            for (size_t i = 0u; i < m_patchNodes.size(); ++i) {
+                const auto stride = lodStride(*m_patchNodes[i], camera.position());
+                if (stride != m_lodStrides[i]) {
+                    m_lodStrides[i] = stride;
+                    lodChanged = true;
+                }
+            }
+
+            if (lodChanged) {
+                m_lodPatchMeshRenderer = buildMeshRenderer(m_patchNodes, m_vertexArray, m_vertexOffsets, m_lodStrides);
+            }
+        }
+
         void PatchRenderer::prepareVerticesAndIndices(VboManager& vboManager) {
-            m_patchMeshRenderer.prepare(vboManager);
+            if (m_renderLod) {
+                m_lodPatchMeshRenderer.prepare(vboManager);
+            } else {
+                m_patchMeshRenderer.prepare(vboManager);
+            }
         }
 
         namespace {
@@ -305,7 +393,11 @@ namespace TrenchBroom {
             }
             */
 
-            m_patchMeshRenderer.render(func);
+            if (m_renderLod) {
+                m_lodPatchMeshRenderer.render(func);
+            } else {
+                m_patchMeshRenderer.render(func);
+            }
 
             /*
             if (m_alpha < 1.0f) {
@@ -23,6 +23,7 @@
 #include "Renderer/EdgeRenderer.h"
 #include "Renderer/Renderable.h"
 #include "Renderer/TexturedIndexArrayRenderer.h"
+#include "Renderer/VertexArray.h"
 
 #include <vector>
 
@@ -32,6 +33,7 @@ namespace TrenchBroom {
     }
 
     namespace Renderer {
+        class Camera;
         class RenderBatch;
         class RenderContext;
         class VboManager;
@@ -41,7 +43,19 @@ namespace TrenchBroom {
             bool m_valid = true;
             std::vector<Model::PatchNode*> m_patchNodes;
 
+            /*
+             * The vertices of all patch grids are shared by the full detail mesh, which is rendered in 2D views, and
+             * the LOD mesh, which is rendered in 3D views. The LOD mesh skips grid points of distant patches and is
+             * rebuilt whenever the level of detail of any patch changes. Since it only contains new indices, the
+             * vertices don't have to be uploaded again.
+             */
+            VertexArray m_vertexArray;
+            std::vector<size_t> m_vertexOffsets;
+            std::vector<size_t> m_lodStrides;
+            bool m_renderLod = false;
+
             TexturedIndexArrayRenderer m_patchMeshRenderer;
+            TexturedIndexArrayRenderer m_lodPatchMeshRenderer;
             DirectEdgeRenderer m_edgeRenderer;
 
             Color m_defaultColor;
@@ -90,6 +104,7 @@ namespace TrenchBroom {
             void render(RenderContext& renderContext, RenderBatch& renderBatch);
         private:
             void validate();
+            void validateLod(const Camera& camera);
         private: // implement IndexedRenderable interface
             void prepareVerticesAndIndices(VboManager& vboManager) override;
             void doRender(RenderContext& renderContext) override;
@@ -42,6 +42,7 @@ namespace TrenchBroom {
         m_showGrid(true),
         m_gridSize(4),
         m_hideSelection(false),
+        m_hideUnselectedBrushes(false),
         m_tintSelection(true),
         m_showSelectionGuide(ShowSelectionGuide::Hide) {}
 
@@ -189,6 +190,14 @@ namespace TrenchBroom {
             m_hideSelection = true;
         }
 
+        bool RenderContext::hideUnselectedBrushes() const {
+            return m_hideUnselectedBrushes;
+        }
+
+        void RenderContext::setHideUnselectedBrushes() {
+            m_hideUnselectedBrushes = true;
+        }
+
         bool RenderContext::tintSelection() const {
             return m_tintSelection;
         }
@@ -72,6 +72,7 @@ namespace TrenchBroom {
             FloatType m_gridSize;
 
             bool m_hideSelection;
+            bool m_hideUnselectedBrushes;
             bool m_tintSelection;
 
             ShowSelectionGuide m_showSelectionGuide;
@@ -132,6 +133,13 @@ namespace TrenchBroom {
             bool hideSelection() const;
             void setHideSelection();
 
+            /**
+             * Whether the map renderer should skip the unselected brushes because they are rendered by a level of
+             * detail renderer instead.
+             */
+            bool hideUnselectedBrushes() const;
+            void setHideUnselectedBrushes();
+
             bool tintSelection() const;
             void clearTintSelection();
 
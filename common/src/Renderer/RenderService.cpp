@@ -113,6 +113,14 @@ namespace TrenchBroom {
             m_cullingPolicy = PrimitiveRendererCullingPolicy::CullBackfaces;
         }
 
+        float RenderService::textMaxViewDistance() const {
+            return m_textRenderer->maxViewDistance();
+        }
+
+        float RenderService::textMinZoomFactor() const {
+            return m_textRenderer->minZoomFactor();
+        }
+
         void RenderService::renderString(const AttrString& string, const vm::vec3f& position) {
             renderString(string, SimpleTextAnchor(position, TextAlignment::Bottom, vm::vec2f(0.0f, 16.0f)));
         }
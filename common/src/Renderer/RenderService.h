@@ -75,6 +75,12 @@ namespace TrenchBroom {
             void setShowBackfaces();
             void setCullBackfaces();
 
+            /**
+             * The distance and zoom limits beyond which strings are not rendered unless they are rendered on top.
+             */
+            float textMaxViewDistance() const;
+            float textMinZoomFactor() const;
+
             void renderString(const AttrString& string, const vm::vec3f& position);
             void renderString(const AttrString& string, const TextAnchor& position);
             void renderHeadsUp(const AttrString& string);
@@ -62,6 +62,14 @@ namespace TrenchBroom {
         m_minZoomFactor(minZoomFactor),
         m_inset(inset) {}
 
+        float TextRenderer::maxViewDistance() const {
+            return m_maxViewDistance;
+        }
+
+        float TextRenderer::minZoomFactor() const {
+            return m_minZoomFactor;
+        }
+
         void TextRenderer::renderString(RenderContext& renderContext, const Color& textColor, const Color& backgroundColor, const AttrString& string, const TextAnchor& position) {
             renderString(renderContext, textColor, backgroundColor, string, position, false);
         }
@@ -83,9 +91,10 @@ namespace TrenchBroom {
             FontManager& fontManager = renderContext.fontManager();
             TextureFont& font = fontManager.font(m_fontDescriptor);
 
-            std::vector<vm::vec2f> vertices = font.quads(string, true);
+            const TextureFont::GlyphRun& glyphRun = font.glyphRun(string);
+            std::vector<vm::vec2f> vertices = glyphRun.vertices;
             const float alphaFactor = computeAlphaFactor(renderContext, distance, onTop);
-            const vm::vec2f size = font.measure(string);
+            const vm::vec2f& size = glyphRun.size;
             const vm::vec3f offset = position.offset(camera, size);
 
             if (onTop)
@@ -143,7 +152,7 @@ namespace TrenchBroom {
         vm::vec2f TextRenderer::stringSize(RenderContext& renderContext, const AttrString& string) const {
             FontManager& fontManager = renderContext.fontManager();
             TextureFont& font = fontManager.font(m_fontDescriptor);
-            return round(font.measure(string));
+            return round(font.glyphRun(string).size);
         }
 
         void TextRenderer::doPrepareVertices(VboManager& vboManager) {
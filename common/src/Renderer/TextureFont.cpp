@@ -32,6 +32,8 @@
 
 namespace TrenchBroom {
     namespace Renderer {
+        const size_t TextureFont::MaxCachedGlyphRuns = 4096;
+
         TextureFont::TextureFont(std::unique_ptr<FontTexture> texture, const std::vector<FontGlyph>& glyphs, const int lineHeight, const unsigned char firstChar, const unsigned char charCount) :
         m_texture(std::move(texture)),
         m_glyphs(glyphs),
@@ -172,6 +174,25 @@ namespace TrenchBroom {
             return measureString.size();
         }
 
+        const TextureFont::GlyphRun& TextureFont::glyphRun(const AttrString& string) const {
+            auto it = m_glyphRunCache.find(string);
+            if (it != std::end(m_glyphRunCache)) {
+                // move to the front of the LRU list
+                m_glyphRunLru.splice(std::begin(m_glyphRunLru), m_glyphRunLru, it->second.lruPosition);
+                return it->second.glyphRun;
+            }
+
+            if (m_glyphRunCache.size() >= MaxCachedGlyphRuns) {
+                m_glyphRunCache.erase(m_glyphRunCache.find(*m_glyphRunLru.back()));
+                m_glyphRunLru.pop_back();
+            }
+
+            it = m_glyphRunCache.emplace(string, CachedGlyphRun{GlyphRun{quads(string, true), measure(string)}, {}}).first;
+            m_glyphRunLru.push_front(&it->first);
+            it->second.lruPosition = std::begin(m_glyphRunLru);
+            return it->second.glyphRun;
+        }
+
         std::vector<vm::vec2f> TextureFont::quads(const std::string& string, const bool clockwise, const vm::vec2f& offset) const {
             std::vector<vm::vec2f> result;
             result.reserve(string.length() * 4 * 2);
@@ -20,28 +20,51 @@
 #pragma once
 
 #include "Macros.h"
+#include "Renderer/AttrString.h"
 
 #include <vecmath/forward.h>
 #include <vecmath/vec.h>
 
+#include <list>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
 
 namespace TrenchBroom {
     namespace Renderer {
-        class AttrString;
         class FontGlyph;
         class FontTexture;
 
         class TextureFont {
+        public:
+            /**
+             * The clockwise glyph quads of a string at the origin together with the string's size.
+             */
+            struct GlyphRun {
+                std::vector<vm::vec2f> vertices;
+                vm::vec2f size;
+            };
         private:
+            static const size_t MaxCachedGlyphRuns;
+
+            using GlyphRunLruList = std::list<const AttrString*>;
+
+            struct CachedGlyphRun {
+                GlyphRun glyphRun;
+                GlyphRunLruList::iterator lruPosition;
+            };
+
             std::unique_ptr<FontTexture> m_texture;
             std::vector<FontGlyph> m_glyphs;
             int m_lineHeight;
 
             unsigned char m_firstChar;
             unsigned char m_charCount;
+
+            mutable std::map<AttrString, CachedGlyphRun> m_glyphRunCache;
+            // the most recently used glyph run is at the front
+            mutable GlyphRunLruList m_glyphRunLru;
         public:
             TextureFont(std::unique_ptr<FontTexture> texture, const std::vector<FontGlyph>& glyphs, int lineHeight, unsigned char firstChar, unsigned char charCount);
             ~TextureFont();
@@ -51,6 +74,13 @@ namespace TrenchBroom {
             std::vector<vm::vec2f> quads(const AttrString& string, bool clockwise, const vm::vec2f& offset = vm::vec2f::zero()) const;
             vm::vec2f measure(const AttrString& string) const;
 
+            /**
+             * Returns the glyph run for the given string. Glyph runs are cached by their string, so that labels which
+             * are rendered every frame, such as entity classnames, are only laid out once. If the cache is full, the
+             * least recently used glyph run is evicted.
+             */
+            const GlyphRun& glyphRun(const AttrString& string) const;
+
             std::vector<vm::vec2f> quads(const std::string& string, bool clockwise, const vm::vec2f& offset = vm::vec2f::zero()) const;
             vm::vec2f measure(const std::string& string) const;
 
@@ -19,6 +19,7 @@
 
 #include "TrenchBroomApp.h"
 
+#include "FileLogger.h"
 #include "PreferenceManager.h"
 #include "Preferences.h"
 #include "RecoverableExceptions.h"
@@ -385,7 +386,7 @@ namespace TrenchBroom {
                     IO::SystemPaths::userDataDirectory() + IO::Path{"games"},
                 };
                 auto& gameFactory = Model::GameFactory::instance();
-                gameFactory.initialize(gamePathConfig);
+                gameFactory.initialize(gamePathConfig, FileLogger::instance());
             } catch (const std::exception& e) {
                 qCritical() << e.what();
                 return false;
@@ -504,7 +505,8 @@ namespace TrenchBroom {
                 mapPath = IO::Path();
             }
 
-            // Copy the log file
+            // Copy the log file after writing any queued messages
+            FileLogger::instance().flush();
             if (!QFile::copy(IO::pathAsQString(IO::SystemPaths::logFilePath()), QString::fromStdString(logPath.asString()))) {
                 logPath = IO::Path();
             }
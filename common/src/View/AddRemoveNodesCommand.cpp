@@ -21,6 +21,7 @@
 
 #include "Ensure.h"
 #include "Macros.h"
+#include "Model/ModelUtils.h"
 #include "Model/Node.h"
 #include "Model/UpdateLinkedGroupsError.h"
 #include "View/MapDocumentCommandFacade.h"
@@ -130,5 +131,17 @@ namespace TrenchBroom {
         bool AddRemoveNodesCommand::doCollateWith(UndoableCommand*) {
             return false;
         }
+
+        size_t AddRemoveNodesCommand::doGetMemoryUsage() const {
+            // the nodes to add are owned by this command, the nodes to remove are still part of the document
+            auto result = sizeof(AddRemoveNodesCommand);
+            for (const auto& [parent, children] : m_nodesToAdd) {
+                result += children.capacity() * sizeof(Model::Node*) + Model::computeMemoryUsageRecursively(children);
+            }
+            for (const auto& [parent, children] : m_nodesToRemove) {
+                result += children.capacity() * sizeof(Model::Node*);
+            }
+            return result + m_updateLinkedGroupsHelper.memoryUsage();
+        }
     }
 }
@@ -64,6 +64,7 @@ namespace TrenchBroom {
             void undoAction(MapDocumentCommandFacade* document);
 
             bool doCollateWith(UndoableCommand* command) override;
+            size_t doGetMemoryUsage() const override;
 
             deleteCopyAndMove(AddRemoveNodesCommand)
         };
@@ -31,10 +31,11 @@ namespace TrenchBroom {
         m_logger(nullptr) {}
 
         void CachingLogger::setParentLogger(Logger* logger) {
+            const auto lock = std::lock_guard<std::mutex>{m_mutex};
             m_logger = logger;
             if (m_logger != nullptr) {
                 for (const Message& message : m_cachedMessages) {
-                    log(message.level, message.str);
+                    m_logger->log(message.level, message.str);
                 }
                 m_cachedMessages.clear();
             }
@@ -45,6 +46,7 @@ namespace TrenchBroom {
         }
 
         void CachingLogger::doLog(const LogLevel level, const QString& message) {
+            const auto lock = std::lock_guard<std::mutex>{m_mutex};
             if (m_logger == nullptr) {
                 m_cachedMessages.push_back(Message(level, message));
             } else {
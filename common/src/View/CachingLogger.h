@@ -21,6 +21,7 @@
 
 #include "Logger.h"
 
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -28,6 +29,10 @@
 
 namespace TrenchBroom {
     namespace View {
+        /**
+         * Caches log messages until a parent logger is set and forwards them to the parent logger afterwards. This
+         * logger can be used from any thread if the parent logger can.
+         */
         class CachingLogger : public Logger {
         private:
             struct Message {
@@ -40,6 +45,7 @@ namespace TrenchBroom {
 
             using MessageList = std::vector<Message>;
 
+            std::mutex m_mutex;
             MessageList m_cachedMessages;
             Logger* m_logger;
         public:
@@ -23,6 +23,7 @@
 #include "PreferenceManager.h"
 #include "Preferences.h"
 #include "FloatType.h"
+#include "Model/Brush.h"
 #include "Model/BrushNode.h"
 #include "Model/BrushError.h"
 #include "Model/BrushFace.h"
@@ -41,17 +42,23 @@
 #include <kdl/map_utils.h>
 #include <kdl/memory_utils.h>
 #include <kdl/overload.h>
+#include <kdl/parallel.h>
+#include <kdl/result.h>
 #include <kdl/set_temp.h>
 #include <kdl/string_utils.h>
 #include <kdl/vector_utils.h>
 
+#include <vecmath/plane.h>
 #include <vecmath/ray.h>
 #include <vecmath/vec.h>
 #include <vecmath/vec_io.h>
 
 #include <algorithm>
+#include <exception>
 #include <map>
 #include <optional>
+#include <string>
+#include <utility>
 #include <vector>
 
 namespace TrenchBroom {
@@ -750,34 +757,121 @@ namespace TrenchBroom {
             kdl::map_clear_and_delete(m_backBrushes);
         }
 
+        namespace {
+            struct ClipResult {
+                std::optional<Model::Brush> frontBrush;
+                std::optional<Model::Brush> backBrush;
+                std::vector<Model::BrushError> errors;
+                /** The message of an exception thrown while clipping, exceptions must not escape the worker threads. */
+                std::optional<std::string> exception;
+            };
+
+            /**
+             * Determines on which sides of the given plane the vertices of the given brush lie.
+             */
+            std::pair<bool, bool> classifyBrush(const Model::Brush& brush, const vm::plane3& plane) {
+                auto hasVerticesAbove = false;
+                auto hasVerticesBelow = false;
+                for (const auto* vertex : brush.vertices()) {
+                    switch (plane.point_status(vertex->position())) {
+                        case vm::plane_status::above:
+                            hasVerticesAbove = true;
+                            break;
+                        case vm::plane_status::below:
+                            hasVerticesBelow = true;
+                            break;
+                        case vm::plane_status::inside:
+                            break;
+                    }
+                }
+                return {hasVerticesAbove, hasVerticesBelow};
+            }
+        }
+
         void ClipTool::updateBrushes() {
             auto document = kdl::mem_lock(m_document);
 
             const auto& brushNodes = document->selectedNodes().brushes();
             const auto& worldBounds = document->worldBounds();
 
-            const auto clip = [&](auto* node, const auto& p1, const auto& p2, const auto& p3, auto& brushMap) {
-                auto brush = node->brush();
-                Model::BrushFace::create(p1, p2, p3, Model::BrushFaceAttributes(document->currentTextureName()), document->world()->mapFormat())
-                    .and_then([&](Model::BrushFace&& clipFace) {
-                            setFaceAttributes(brush.faces(), clipFace);
-                            return brush.clip(worldBounds, std::move(clipFace));
-                    }).and_then([&]() {
-                            brushMap[node->parent()].push_back(new Model::BrushNode(std::move(brush)));
-                    }).handle_errors([&](const Model::BrushError e) {
-                            document->error() << "Could not clip brush: " << e;
-                    });
-            };
-
             if (canClip()) {
                 vm::vec3 point1, point2, point3;
                 const auto numPoints = m_strategy->getPoints(point1, point2, point3);
                 ensure(numPoints == 3, "invalid number of points");
 
-                for (auto* brushNode : brushNodes) {
-                    clip(brushNode, point1, point2, point3, m_frontBrushes);
-                    clip(brushNode, point1, point3, point2, m_backBrushes);
-               }
+                const auto mapFormat = document->world()->mapFormat();
+                const auto attributes = Model::BrushFaceAttributes(document->currentTextureName());
+
+                // the front brushes keep the part below the front clip face, the back brushes keep the part above it
+                auto frontClipFace = Model::BrushFace::create(point1, point2, point3, attributes, mapFormat);
+                auto backClipFace = Model::BrushFace::create(point1, point3, point2, attributes, mapFormat);
+                if (!frontClipFace.is_success() || !backClipFace.is_success()) {
+                    document->error() << "Could not clip brushes: invalid clip points";
+                    return;
+                }
+
+                const auto& frontFace = frontClipFace.value();
+                const auto& backFace = backClipFace.value();
+                const auto& plane = frontFace.boundary();
+
+                const auto clip = [&](const Model::Brush& original, const Model::BrushFace& clipFace, ClipResult& result) -> std::optional<Model::Brush> {
+                    auto brush = original;
+                    auto face = clipFace;
+                    setFaceAttributes(brush.faces(), face);
+                    return brush.clip(worldBounds, std::move(face))
+                        .visit(kdl::overload(
+                            [&]() -> std::optional<Model::Brush> {
+                                return std::move(brush);
+                            },
+                            [&](const Model::BrushError e) -> std::optional<Model::Brush> {
+                                result.errors.push_back(e);
+                                return std::nullopt;
+                            }
+                        ));
+                };
+
+                // brushes which lie on one side of the clip plane are passed through unchanged, only the brushes
+                // which are split by the plane are clipped, and this is done in parallel
+                auto results = kdl::vec_parallel_transform(brushNodes, [&](const Model::BrushNode* brushNode) {
+                    auto result = ClipResult{};
+                    try {
+                        const auto& brush = brushNode->brush();
+                        const auto [hasVerticesAbove, hasVerticesBelow] = classifyBrush(brush, plane);
+
+                        if (!hasVerticesAbove) {
+                            result.frontBrush = brush;
+                        } else if (!hasVerticesBelow) {
+                            result.backBrush = brush;
+                        } else {
+                            result.frontBrush = clip(brush, frontFace, result);
+                            result.backBrush = clip(brush, backFace, result);
+                        }
+                    } catch (const std::exception& e) {
+                        result = ClipResult{};
+                        result.exception = e.what();
+                    } catch (...) {
+                        result = ClipResult{};
+                        result.exception = "unknown error";
+                    }
+                    return result;
+                });
+
+                for (size_t i = 0u; i < brushNodes.size(); ++i) {
+                    auto* parent = brushNodes[i]->parent();
+                    auto& result = results[i];
+                    if (result.frontBrush) {
+                        m_frontBrushes[parent].push_back(new Model::BrushNode(std::move(*result.frontBrush)));
+                    }
+                    if (result.backBrush) {
+                        m_backBrushes[parent].push_back(new Model::BrushNode(std::move(*result.backBrush)));
+                    }
+                    for (const auto e : result.errors) {
+                        document->error() << "Could not clip brush: " << e;
+                    }
+                    if (result.exception) {
+                        document->error() << "Could not clip brush: " << *result.exception;
+                    }
+                }
             } else {
                 for (auto* brushNode : brushNodes) {
                     auto* parent = brushNode->parent();
@@ -20,6 +20,7 @@
 #include "CommandProcessor.h"
 
 #include "Exceptions.h"
+#include "MemoryReport.h"
 #include "Notifier.h"
 #include "View/Command.h"
 #include "View/UndoableCommand.h"
@@ -108,6 +109,14 @@ namespace TrenchBroom {
             bool doCollateWith(UndoableCommand*) override {
                 return false;
             }
+
+            size_t doGetMemoryUsage() const override {
+                auto result = sizeof(TransactionCommand) + m_commands.capacity() * sizeof(std::unique_ptr<UndoableCommand>);
+                for (const auto& command : m_commands) {
+                    result += command->memoryUsage();
+                }
+                return result;
+            }
         };
 
         const Command::CommandType CommandProcessor::TransactionCommand::Type = Command::freeType();
@@ -220,6 +229,24 @@ namespace TrenchBroom {
             m_lastCommandTimestamp = std::chrono::time_point<std::chrono::system_clock>();
         }
 
+        void CommandProcessor::reportMemoryUsage(MemoryReport& report, const size_t maxCommands) const {
+            auto commands = std::vector<MemoryUsage>{};
+
+            const auto reportStack = [&](const std::string& name, const auto& stack) {
+                auto bytes = stack.capacity() * sizeof(std::unique_ptr<UndoableCommand>);
+                for (const auto& command : stack) {
+                    const auto commandBytes = command->memoryUsage();
+                    commands.push_back(MemoryUsage{name + ": " + command->name(), 1u, commandBytes});
+                    bytes += commandBytes;
+                }
+                report.addSubsystem(name, stack.size(), bytes);
+            };
+
+            reportStack("Undo stack", m_undoStack);
+            reportStack("Redo stack", m_redoStack);
+            report.addBreakdown("Largest commands", std::move(commands), maxCommands);
+        }
+
         CommandProcessor::SubmitAndStoreResult CommandProcessor::executeAndStoreCommand(std::unique_ptr<UndoableCommand> command, const bool collate) {
             auto commandResult = executeCommand(command.get());
             if (!commandResult->success()) {
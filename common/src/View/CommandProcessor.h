@@ -27,6 +27,8 @@
 #include <vector>
 
 namespace TrenchBroom {
+    class MemoryReport;
+
     namespace View {
         class Command;
         class CommandResult;
@@ -245,6 +247,12 @@ namespace TrenchBroom {
              * commands are deleted as well.
              */
             void clear();
+
+            /**
+             * Adds the memory used by the commands on the undo and redo stacks to the given report. The given maximum
+             * number of the largest commands on both stacks is added as a breakdown.
+             */
+            void reportMemoryUsage(MemoryReport& report, size_t maxCommands) const;
         private:
             /**
              * Executes and stores the given command. The command will only be stored if it was executed successfully
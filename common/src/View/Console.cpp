@@ -22,17 +22,25 @@
 #include "FileLogger.h"
 #include "View/ViewConstants.h"
 
+#include <iterator>
 #include <string>
 
 #include <QDebug>
+#include <QMetaObject>
 #include <QScrollBar>
 #include <QTextEdit>
 #include <QVBoxLayout>
 
 namespace TrenchBroom {
     namespace View {
+        /**
+         * The maximum number of messages that are appended to the console in one batch.
+         */
+        static const size_t MaxMessagesPerBatch = 500u;
+
         Console::Console(QWidget* parent) :
-        TabBookPage(parent) {
+        TabBookPage(parent),
+        m_flushPending(false) {
             m_textView = new QTextEdit();
             m_textView->setReadOnly(true);
             m_textView->setWordWrapMode(QTextOption::NoWrap);
@@ -50,8 +58,19 @@ namespace TrenchBroom {
         void Console::doLog(const LogLevel level, const QString& message) {
             if (!message.isEmpty()) {
                 logToDebugOut(level, message);
-                logToConsole(level, message);
                 FileLogger::instance().log(level, message);
+
+                const auto lock = std::lock_guard<std::mutex>{m_pendingMutex};
+                if (!m_pendingMessages.empty() && m_pendingMessages.back().level == level && m_pendingMessages.back().str == message) {
+                    ++m_pendingMessages.back().count;
+                } else {
+                    m_pendingMessages.push_back(Message{level, message, 1u});
+                }
+
+                if (!m_flushPending) {
+                    m_flushPending = true;
+                    QMetaObject::invokeMethod(this, "flushPendingMessages", Qt::QueuedConnection);
+                }
             }
         }
 
@@ -59,29 +78,63 @@ namespace TrenchBroom {
             qDebug("%s", message.toStdString().c_str());
         }
 
-        void Console::logToConsole(const LogLevel level, const QString& message) {
+        void Console::flushPendingMessages() {
+            auto messages = std::vector<Message>{};
+            {
+                const auto lock = std::lock_guard<std::mutex>{m_pendingMutex};
+                std::swap(messages, m_pendingMessages);
+                m_flushPending = false;
+            }
+
+            auto omittedCount = size_t(0);
+            if (messages.size() > MaxMessagesPerBatch) {
+                for (auto it = std::next(std::begin(messages), MaxMessagesPerBatch); it != std::end(messages); ++it) {
+                    omittedCount += it->count;
+                }
+                messages.resize(MaxMessagesPerBatch);
+            }
+
+            logToConsole(messages, omittedCount);
+        }
+
+        void Console::logToConsole(const std::vector<Message>& messages, const size_t omittedCount) {
             // NOTE: QPalette::Text is the correct color role for contrast against QPalette::Base
             // which is the background of text entry widgets 
-            QTextCharFormat format;
-            switch (level) {
-                case LogLevel::Debug:
-                    format.setForeground(QBrush(m_textView->palette().color(QPalette::Disabled, QPalette::Text)));
-                    break;
-                case LogLevel::Info:
-                    break;
-                case LogLevel::Warn:
-                    format.setForeground(QBrush(m_textView->palette().color(QPalette::Active, QPalette::Text)));
-                    break;
-                case LogLevel::Error:
-                    format.setForeground(QBrush(QColor(250, 30, 60)));
-                    break;
-            }
-            format.setFont(Fonts::fixedWidthFont());
+            const auto formatForLevel = [&](const LogLevel level) {
+                QTextCharFormat format;
+                switch (level) {
+                    case LogLevel::Debug:
+                        format.setForeground(QBrush(m_textView->palette().color(QPalette::Disabled, QPalette::Text)));
+                        break;
+                    case LogLevel::Info:
+                        break;
+                    case LogLevel::Warn:
+                        format.setForeground(QBrush(m_textView->palette().color(QPalette::Active, QPalette::Text)));
+                        break;
+                    case LogLevel::Error:
+                        format.setForeground(QBrush(QColor(250, 30, 60)));
+                        break;
+                }
+                format.setFont(Fonts::fixedWidthFont());
+                return format;
+            };
 
             QTextCursor cursor(m_textView->document());
+            cursor.beginEditBlock();
             cursor.movePosition(QTextCursor::MoveOperation::End);
-            cursor.insertText(message, format);
-            cursor.insertText("\n");
+            for (const auto& message : messages) {
+                const auto format = formatForLevel(message.level);
+                cursor.insertText(message.str, format);
+                if (message.count > 1u) {
+                    cursor.insertText(QObject::tr(" (repeated %1 times)").arg(message.count), format);
+                }
+                cursor.insertText("\n");
+            }
+            if (omittedCount > 0u) {
+                cursor.insertText(QObject::tr("%1 more messages were omitted, see the log file for details").arg(omittedCount), formatForLevel(LogLevel::Warn));
+                cursor.insertText("\n");
+            }
+            cursor.endEditBlock();
 
             m_textView->moveCursor(QTextCursor::MoveOperation::End);
         }
@@ -22,24 +22,45 @@
 #include "Logger.h"
 #include "View/TabBook.h"
 
+#include <mutex>
 #include <string>
+#include <vector>
+
+#include <QString>
 
 class QTextEdit;
-class QString;
 class QWidget;
 
 namespace TrenchBroom {
     namespace View {
+        /**
+         * Displays log messages. Messages can be logged from any thread; they are collected and appended to the text
+         * view in batches on the main thread. Repeated messages are collapsed, and if too many messages are logged at
+         * once, the excess messages are only written to the log file.
+         */
         class Console : public TabBookPage, public Logger {
+            Q_OBJECT
         private:
+            struct Message {
+                LogLevel level;
+                QString str;
+                size_t count;
+            };
+
             QTextEdit* m_textView;
+
+            std::mutex m_pendingMutex;
+            std::vector<Message> m_pendingMessages;
+            bool m_flushPending;
         public:
             explicit Console(QWidget* parent = nullptr);
         private:
             void doLog(LogLevel level, const std::string& message) override;
             void doLog(LogLevel level, const QString& message) override;
             void logToDebugOut(LogLevel level, const QString& message);
-            void logToConsole(LogLevel level, const QString& message);
+            void logToConsole(const std::vector<Message>& messages, size_t omittedCount);
+        private slots:
+            void flushPendingMessages();
         };
     }
 }
@@ -138,6 +138,12 @@ namespace TrenchBroom {
             }
         }
 
+        void CyclingMapView::doInstallFrameScheduler(FrameScheduler& frameScheduler) {
+            for (auto* mapView : m_mapViews) {
+                mapView->installFrameScheduler(frameScheduler);
+            }
+        }
+
         MapView* CyclingMapView::doGetCurrentMapView() const {
             return m_currentMapView;
         }
@@ -87,6 +87,7 @@ namespace TrenchBroom {
             void doRefreshViews() override;
         private: // implement MapViewContainer interface
             void doInstallActivationTracker(MapViewActivationTracker& activationTracker) override;
+            void doInstallFrameScheduler(FrameScheduler& frameScheduler) override;
             MapView* doGetCurrentMapView() const override;
             MapViewBase* doGetFirstMapViewBase() override;
         public:
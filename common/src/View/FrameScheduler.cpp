@@ -0,0 +1,118 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "FrameScheduler.h"
+
+#include <kdl/vector_utils.h>
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+namespace TrenchBroom {
+    namespace View {
+        FrameScheduler::Client::~Client() = default;
+
+        FrameScheduler::FrameScheduler(std::function<void()> requestFrame) :
+        m_requestFrame{std::move(requestFrame)},
+        m_frameRequested{false} {}
+
+        void FrameScheduler::addClient(Client* client) {
+            assert(findClient(client) == nullptr);
+            m_clients.push_back({client, Invalidation::None, std::nullopt});
+            invalidate(m_clients.back(), Invalidation::Always);
+        }
+
+        void FrameScheduler::removeClient(Client* client) {
+            m_clients = kdl::vec_erase_if(std::move(m_clients), [&](const ClientInfo& clientInfo) {
+                return clientInfo.client == client;
+            });
+        }
+
+        void FrameScheduler::addPreparation(std::function<void()> preparation) {
+            m_preparations.push_back(std::move(preparation));
+        }
+
+        void FrameScheduler::invalidate(Client* client) {
+            if (auto* clientInfo = findClient(client)) {
+                invalidate(*clientInfo, Invalidation::Always);
+            }
+        }
+
+        void FrameScheduler::invalidateAll() {
+            for (auto& clientInfo : m_clients) {
+                invalidate(clientInfo, Invalidation::Always);
+            }
+        }
+
+        void FrameScheduler::invalidateIfChanged(Client* client) {
+            if (auto* clientInfo = findClient(client)) {
+                invalidate(*clientInfo, Invalidation::IfChanged);
+            }
+        }
+
+        bool FrameScheduler::frameRequested() const {
+            return m_frameRequested;
+        }
+
+        void FrameScheduler::frame() {
+            m_frameRequested = false;
+
+            auto clientsToRender = std::vector<Client*>{};
+            for (auto& clientInfo : m_clients) {
+                if (clientInfo.invalidation == Invalidation::Always ||
+                    (clientInfo.invalidation == Invalidation::IfChanged && clientInfo.renderedState != clientInfo.client->frameState())) {
+                    clientsToRender.push_back(clientInfo.client);
+                }
+                clientInfo.invalidation = Invalidation::None;
+            }
+
+            if (!clientsToRender.empty()) {
+                for (const auto& preparation : m_preparations) {
+                    preparation();
+                }
+                for (auto* client : clientsToRender) {
+                    client->renderFrame();
+                }
+            }
+        }
+
+        void FrameScheduler::clientRendered(Client* client) {
+            if (auto* clientInfo = findClient(client)) {
+                clientInfo->renderedState = client->frameState();
+            }
+        }
+
+        FrameScheduler::ClientInfo* FrameScheduler::findClient(const Client* client) {
+            auto it = std::find_if(std::begin(m_clients), std::end(m_clients), [&](const ClientInfo& clientInfo) {
+                return clientInfo.client == client;
+            });
+            return it != std::end(m_clients) ? &*it : nullptr;
+        }
+
+        void FrameScheduler::invalidate(ClientInfo& clientInfo, const Invalidation invalidation) {
+            clientInfo.invalidation = std::max(clientInfo.invalidation, invalidation);
+            if (!m_frameRequested) {
+                m_frameRequested = true;
+                m_requestFrame();
+            }
+        }
+    }
+}
@@ -0,0 +1,133 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include <functional>
+#include <optional>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace View {
+        /**
+         * Coalesces the invalidations of a group of views that show the same document into frames.
+         *
+         * Views are invalidated by document notifications, tools and camera changes, often many times in a row. The
+         * scheduler records these invalidations and requests a single frame from its host, which calls frame() once
+         * per display refresh. A frame runs the shared preparations once and then asks every invalidated view to
+         * render itself, so no view renders more than once per frame.
+         *
+         * A view that was only invalidated because its camera or inputs may have changed is skipped if its frame state
+         * is the same as when it was last rendered.
+         *
+         * The scheduler does not depend on Qt or OpenGL; the host supplies the function that requests a frame.
+         */
+        class FrameScheduler {
+        public:
+            /**
+             * The state that the image of a client depends on apart from the document, e.g. its camera matrices.
+             */
+            using FrameState = std::vector<float>;
+
+            class Client {
+            public:
+                virtual ~Client();
+
+                /**
+                 * Returns the current frame state of this client.
+                 */
+                virtual FrameState frameState() = 0;
+
+                /**
+                 * Asks this client to render itself. The client must call FrameScheduler::clientRendered() once it
+                 * has actually rendered.
+                 */
+                virtual void renderFrame() = 0;
+            };
+        private:
+            enum class Invalidation {
+                None,
+                IfChanged,
+                Always
+            };
+
+            struct ClientInfo {
+                Client* client;
+                Invalidation invalidation;
+                std::optional<FrameState> renderedState;
+            };
+
+            std::function<void()> m_requestFrame;
+            std::vector<ClientInfo> m_clients;
+            std::vector<std::function<void()>> m_preparations;
+            bool m_frameRequested;
+        public:
+            /**
+             * Creates a new scheduler. The given function is called when a frame is needed, and the host must call
+             * frame() in response, e.g. at the next display refresh.
+             */
+            explicit FrameScheduler(std::function<void()> requestFrame);
+
+            void addClient(Client* client);
+            void removeClient(Client* client);
+
+            /**
+             * Adds a preparation which is run once per frame before any client renders, but only if at least one
+             * client renders in that frame.
+             */
+            void addPreparation(std::function<void()> preparation);
+
+            /**
+             * Requests that the given client renders in the next frame.
+             */
+            void invalidate(Client* client);
+
+            /**
+             * Requests that every client renders in the next frame, e.g. because the document has changed.
+             */
+            void invalidateAll();
+
+            /**
+             * Requests that the given client renders in the next frame if its frame state differs from the state
+             * it was last rendered with.
+             */
+            void invalidateIfChanged(Client* client);
+
+            /**
+             * Indicates whether a frame was requested from the host and has not been run yet.
+             */
+            bool frameRequested() const;
+
+            /**
+             * Runs a frame: runs the preparations and asks every invalidated client to render.
+             */
+            void frame();
+
+            /**
+             * Records that the given client has rendered with its current frame state. Clients must call this
+             * whenever they render, including renders which were not requested by this scheduler.
+             */
+            void clientRendered(Client* client);
+        private:
+            ClientInfo* findClient(const Client* client);
+            void invalidate(ClientInfo& clientInfo, Invalidation invalidation);
+        };
+    }
+}
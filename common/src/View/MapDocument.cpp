@@ -20,6 +20,7 @@
 #include "View/MapDocument.h"
 
 #include "Exceptions.h"
+#include "MemoryReport.h"
 #include "Uuid.h"
 #include "Model/EntityProperties.h"
 #include "PreferenceManager.h"
@@ -31,11 +32,13 @@
 #include "Assets/EntityDefinitionManager.h"
 #include "Assets/EntityModelManager.h"
 #include "Assets/Texture.h"
+#include "Assets/TextureCollection.h"
 #include "Assets/TextureManager.h"
 #include "EL/ELExceptions.h"
 #include "IO/DiskFileSystem.h"
 #include "IO/DiskIO.h"
 #include "IO/GameConfigParser.h"
+#include "IO/RecordingParserStatus.h"
 #include "IO/SimpleParserStatus.h"
 #include "IO/SystemPaths.h"
 #include "Model/BezierPatch.h"
@@ -56,6 +59,8 @@
 #include "Model/Game.h"
 #include "Model/GameFactory.h"
 #include "Model/GroupNode.h"
+#include "Model/HitAdapter.h"
+#include "Model/HitFilter.h"
 #include "Model/InvalidTextureScaleIssueGenerator.h"
 #include "Model/LayerNode.h"
 #include "Model/LinkSourceIssueGenerator.h"
@@ -72,8 +77,10 @@
 #include "Model/NodeContents.h"
 #include "Model/NonIntegerVerticesIssueGenerator.h"
 #include "Model/PatchNode.h"
+#include "Model/PickResult.h"
 #include "Model/PropertyKeyWithDoubleQuotationMarksIssueGenerator.h"
 #include "Model/PropertyValueWithDoubleQuotationMarksIssueGenerator.h"
+#include "Model/RedundantBrushIssueGenerator.h"
 #include "Model/WorldBoundsIssueGenerator.h"
 #include "Model/PointEntityWithBrushesIssueGenerator.h"
 #include "Model/PointFile.h"
@@ -120,8 +127,10 @@
 #include <algorithm>
 #include <cassert>
 #include <cstdlib> // for std::abs
+#include <future>
 #include <map>
 #include <mutex>
+#include <optional>
 #include <sstream>
 #include <string>
 #include <type_traits>
@@ -257,6 +266,9 @@ namespace TrenchBroom {
          *
          * The given node contents should be modified in place and the lambda should return true if it was applied successfully and false otherwise.
          *
+         * The faces are grouped by their brushes, and the lambda is applied to the faces of different brushes in parallel. It must therefore not
+         * modify any state that is shared between faces.
+         *
          * For each linked group in the given list of linked groups, its changes are distributed to the connected members of its link set.
          *
          * Returns true if the given lambda could be applied successfully to each face and false otherwise. If the lambda fails, then no
@@ -268,33 +280,42 @@ namespace TrenchBroom {
                 return true;
             }
 
-            auto brushes = std::unordered_map<Model::BrushNode*, Model::Brush>{};
-
-            bool success = true;
-            std::for_each(std::begin(faces), std::end(faces), [&](const auto& faceHandle) {
+            auto brushNodes = std::vector<Model::BrushNode*>{};
+            auto faceIndices = std::vector<std::vector<size_t>>{};
+            auto brushNodeIndices = std::unordered_map<Model::BrushNode*, size_t>{};
+            for (const auto& faceHandle : faces) {
                 auto* brushNode = faceHandle.node();
-                auto it = brushes.find(brushNode);
-                if (it == std::end(brushes)) {
-                    it = brushes.emplace(brushNode, brushNode->brush()).first;
+                const auto [it, inserted] = brushNodeIndices.emplace(brushNode, brushNodes.size());
+                if (inserted) {
+                    brushNodes.push_back(brushNode);
+                    faceIndices.emplace_back();
                 }
+                faceIndices[it->second].push_back(faceHandle.faceIndex());
+            }
 
-                auto& brush = it->second;
-                success = success && lambda(brush.face(faceHandle.faceIndex()));
+            auto brushes = std::vector<std::optional<Model::Brush>>(brushNodes.size());
+            kdl::parallel_for(brushNodes.size(), [&](const size_t i) {
+                auto brush = brushNodes[i]->brush();
+                const auto& indices = faceIndices[i];
+                if (std::all_of(std::begin(indices), std::end(indices), [&](const size_t faceIndex) { return lambda(brush.face(faceIndex)); })) {
+                    brushes[i] = std::move(brush);
+                }
             });
 
-            if (success) {
-                auto newNodes = std::vector<std::pair<Model::Node*, Model::NodeContents>>{};
-                newNodes.reserve(brushes.size());
+            if (!std::all_of(std::begin(brushes), std::end(brushes), [](const auto& brush) { return brush.has_value(); })) {
+                return false;
+            }
 
-                for (auto& [brushNode, brush] : brushes) {
-                    newNodes.emplace_back(brushNode, Model::NodeContents(std::move(brush)));
-                }
+            auto newNodes = std::vector<std::pair<Model::Node*, Model::NodeContents>>{};
+            newNodes.reserve(brushNodes.size());
 
-                auto linkedGroupsToUpdate = findContainingLinkedGroupsToUpdate(*document.world(), kdl::vec_transform(newNodes, [](const auto& p) { return p.first; }));
-                document.swapNodeContents(commandName, std::move(newNodes), std::move(linkedGroupsToUpdate));
+            for (size_t i = 0u; i < brushNodes.size(); ++i) {
+                newNodes.emplace_back(brushNodes[i], Model::NodeContents(std::move(*brushes[i])));
             }
 
-            return success;
+            auto linkedGroupsToUpdate = findContainingLinkedGroupsToUpdate(*document.world(), brushNodes);
+            document.swapNodeContents(commandName, std::move(newNodes), std::move(linkedGroupsToUpdate));
+            return true;
         }
 
         const vm::bbox3 MapDocument::DefaultWorldBounds(-32768.0, 32768.0);
@@ -325,6 +346,7 @@ namespace TrenchBroom {
         m_selectionBoundsValid(true),
         m_viewEffectsService(nullptr),
         m_repeatStack(std::make_unique<RepeatStack>()) {
+            updateTextureMemoryBudget();
             connectObservers();
         }
 
@@ -487,6 +509,7 @@ namespace TrenchBroom {
             registerIssueGenerators();
             registerSmartTags();
             createTagActions();
+            initializeWorld();
 
             clearModificationCount();
 
@@ -505,6 +528,7 @@ namespace TrenchBroom {
             registerIssueGenerators();
             registerSmartTags();
             createTagActions();
+            initializeWorld();
 
             documentWasLoadedNotifier(this);
         }
@@ -909,6 +933,29 @@ namespace TrenchBroom {
             return m_selectionBounds;
         }
 
+        vm::bbox3 MapDocument::previewSelectionBounds() const {
+            if (m_selectionPreviewTransformation) {
+                return selectionBounds().transform(*m_selectionPreviewTransformation);
+            }
+            return selectionBounds();
+        }
+
+        const std::optional<vm::mat4x4>& MapDocument::selectionPreviewTransformation() const {
+            return m_selectionPreviewTransformation;
+        }
+
+        void MapDocument::setSelectionPreviewTransformation(const vm::mat4x4& transformation) {
+            m_selectionPreviewTransformation = transformation;
+            selectionPreviewTransformationDidChangeNotifier();
+        }
+
+        void MapDocument::clearSelectionPreviewTransformation() {
+            if (m_selectionPreviewTransformation) {
+                m_selectionPreviewTransformation = std::nullopt;
+                selectionPreviewTransformationDidChangeNotifier();
+            }
+        }
+
         const std::string& MapDocument::currentTextureName() const {
             return m_currentTextureName;
         }
@@ -3009,8 +3056,15 @@ namespace TrenchBroom {
         }
 
         void MapDocument::pick(const vm::ray3& pickRay, Model::PickResult& pickResult) const {
-            if (m_world != nullptr)
+            if (m_world != nullptr) {
                 m_world->pick(*m_editorContext, pickRay, pickResult);
+
+                // tools inspect the geometry of the nearest brush face that was hit, so only that brush is restored
+                using namespace Model::HitFilters;
+                if (const auto faceHandle = Model::hitToFaceHandle(pickResult.first(type(Model::BrushNode::BrushHitType)))) {
+                    faceHandle->node()->restoreGeometry();
+                }
+            }
         }
 
         std::vector<Model::Node*> MapDocument::findNodesContaining(const vm::vec3& point) const {
@@ -3021,6 +3075,42 @@ namespace TrenchBroom {
             return result;
         }
 
+        void MapDocument::compactUnusedBrushGeometry() {
+            if (m_world == nullptr) {
+                return;
+            }
+
+            m_world->accept(kdl::overload(
+                [](auto&& thisLambda, Model::WorldNode* world)   { world->visitChildren(thisLambda); },
+                [](auto&& thisLambda, Model::LayerNode* layer)   { layer->visitChildren(thisLambda); },
+                [](auto&& thisLambda, Model::GroupNode* group)   { group->visitChildren(thisLambda); },
+                [](auto&& thisLambda, Model::EntityNode* entity) { entity->visitChildren(thisLambda); },
+                [](Model::BrushNode* brush)                      { brush->compactGeometryIfUnused(); },
+                [](Model::PatchNode*)                            {}
+            ));
+        }
+
+        MemoryReport MapDocument::memoryReport(const size_t maxItems) const {
+            auto report = MemoryReport{};
+            if (m_world != nullptr) {
+                Model::reportMemoryUsage(*m_world, report, maxItems);
+            }
+
+            auto textureCount = size_t(0);
+            auto textureBytes = size_t(0);
+            for (const auto& collection : m_textureManager->collections()) {
+                for (const auto& texture : collection.textures()) {
+                    ++textureCount;
+                    textureBytes += sizeof(Assets::Texture) + texture.bufferSize();
+                }
+            }
+            report.addSubsystem("Textures", textureCount, textureBytes);
+            report.addSubsystem("Entity models", m_entityModelManager->modelCount(), m_entityModelManager->memoryUsage());
+
+            doReportCommandMemoryUsage(report, maxItems);
+            return report;
+        }
+
         void MapDocument::createWorld(const Model::MapFormat mapFormat, const vm::bbox3& worldBounds, std::shared_ptr<Model::Game> game) {
             m_worldBounds = worldBounds;
             m_game = game;
@@ -3093,7 +3183,7 @@ namespace TrenchBroom {
             info("Reloading texture collections");
             reloadTextures();
             setTextures();
-            initializeAllNodeTags(this);
+            initializeAllNodeTags();
         }
 
         void MapDocument::reloadEntityDefinitions() {
@@ -3104,12 +3194,44 @@ namespace TrenchBroom {
             info("Reloading entity definitions");
         }
 
+        /**
+         * The result of loading the entity definition file on a worker thread. The messages that were logged while
+         * parsing the file are recorded and logged on the main thread.
+         */
+        struct MapDocument::LoadedEntityDefinitions {
+            Assets::EntityDefinitionFileSpec spec;
+            IO::Path path;
+            std::vector<Assets::EntityDefinition*> definitions;
+            std::vector<IO::RecordingParserStatus::Message> messages;
+            std::optional<std::string> error;
+        };
+
         void MapDocument::loadAssets() {
-            loadEntityDefinitions();
-            setEntityDefinitions();
+            // the entity definitions are parsed while the textures are loaded
+            auto entityDefinitions = loadEntityDefinitionsAsync();
             loadEntityModels();
             loadTextures();
-            setTextures();
+            setLoadedEntityDefinitions(entityDefinitions.get());
+        }
+
+        /**
+         * Applies the loaded assets and the registered smart tags to a new or loaded world.
+         *
+         * Assigning entity definitions and models changes the bounds of the entities and notifies their ancestors, so
+         * this is done serially, and the node tree is refitted once for all changed entities afterwards. Assigning
+         * textures and initializing tags only changes the node they are applied to, so these passes are combined into
+         * one pass that processes the nodes in parallel. Tags are initialized last because smart tags may match
+         * textures.
+         */
+        void MapDocument::initializeWorld() {
+            {
+                const auto nodeTreeUpdateBatch = Model::WorldNode::NodeTreeUpdateBatch{*m_world};
+                setEntityDefinitions();
+                setEntityModels();
+            }
+
+            Model::initializeNodes(Model::collectNodes({m_world.get()}), *m_textureManager, *m_tagManager);
+            textureUsageCountsDidChangeNotifier();
         }
 
         void MapDocument::unloadAssets() {
@@ -3119,21 +3241,53 @@ namespace TrenchBroom {
         }
 
         void MapDocument::loadEntityDefinitions() {
-            const Assets::EntityDefinitionFileSpec spec = entityDefinitionFile();
-            try {
-                const IO::Path path = m_game->findEntityDefinitionFile(spec, externalSearchPaths());
-                IO::SimpleParserStatus status(logger());
-                m_entityDefinitionManager->loadDefinitions(path, *m_game, status);
-                info("Loaded entity definition file " + path.lastComponent().asString());
+            setLoadedEntityDefinitions(loadEntityDefinitionsAsync().get());
+        }
 
-                createEntityDefinitionActions();
+        /**
+         * Resolves the entity definition file and parses it on a worker thread. The worker only uses the game and the
+         * entity definition cache, which do not share any state with the texture manager or the logger.
+         */
+        std::future<MapDocument::LoadedEntityDefinitions> MapDocument::loadEntityDefinitionsAsync() const {
+            auto spec = entityDefinitionFile();
+            auto path = IO::Path();
+            try {
+                path = m_game->findEntityDefinitionFile(spec, externalSearchPaths());
             } catch (const Exception& e) {
+                auto result = std::promise<LoadedEntityDefinitions>();
+                result.set_value(LoadedEntityDefinitions{std::move(spec), std::move(path), {}, {}, e.what()});
+                return result.get_future();
+            }
+
+            return std::async(std::launch::async, [game = m_game, spec = std::move(spec), path = std::move(path)]() {
+                auto status = IO::RecordingParserStatus();
+                try {
+                    auto definitions = game->loadEntityDefinitions(status, path);
+                    return LoadedEntityDefinitions{spec, path, std::move(definitions), status.releaseMessages(), std::nullopt};
+                } catch (const Exception& e) {
+                    return LoadedEntityDefinitions{spec, path, {}, status.releaseMessages(), e.what()};
+                }
+            });
+        }
+
+        void MapDocument::setLoadedEntityDefinitions(LoadedEntityDefinitions loadedDefinitions) {
+            IO::SimpleParserStatus status(logger());
+            IO::RecordingParserStatus::replay(loadedDefinitions.messages, status);
+
+            if (loadedDefinitions.error) {
+                const auto& spec = loadedDefinitions.spec;
                 if (spec.builtin()) {
-                    error() << "Could not load builtin entity definition file '" << spec.path() << "': " << e.what();
+                    error() << "Could not load builtin entity definition file '" << spec.path() << "': " << *loadedDefinitions.error;
                 } else {
-                    error() << "Could not load external entity definition file '" << spec.path() << "': " << e.what();
+                    error() << "Could not load external entity definition file '" << spec.path() << "': " << *loadedDefinitions.error;
                 }
+                return;
             }
+
+            m_entityDefinitionManager->setDefinitions(loadedDefinitions.definitions);
+            info("Loaded entity definition file " + loadedDefinitions.path.lastComponent().asString());
+
+            createEntityDefinitionActions();
         }
 
         void MapDocument::unloadEntityDefinitions() {
@@ -3144,7 +3298,6 @@ namespace TrenchBroom {
 
         void MapDocument::loadEntityModels() {
             m_entityModelManager->setLoader(m_game.get());
-            setEntityModels();
         }
 
         void MapDocument::unloadEntityModels() {
@@ -3158,6 +3311,11 @@ namespace TrenchBroom {
             loadTextures();
         }
 
+        void MapDocument::updateTextureMemoryBudget() {
+            const auto budgetInMiB = std::max(0, pref(Preferences::TextureMemoryBudget));
+            m_textureManager->setResidencyBudget(static_cast<size_t>(budgetInMiB) * 1024u * 1024u);
+        }
+
         void MapDocument::loadTextures() {
             try {
                 const IO::Path docDir = m_path.isEmpty() ? IO::Path() : m_path.deleteLastComponent();
@@ -3172,25 +3330,39 @@ namespace TrenchBroom {
             m_textureManager->clear();
         }
 
-        static auto makeSetTexturesVisitor(Assets::TextureManager& manager) {
-            return kdl::overload(
+        static void setBrushFaceTextures(Assets::TextureManager& manager, Model::BrushNode& brushNode) {
+            const Model::Brush& brush = brushNode.brushWithoutRestoringGeometry();
+            for (size_t i = 0u; i < brush.faceCount(); ++i) {
+                const Model::BrushFace& face = brush.face(i);
+                Assets::Texture* texture = manager.texture(face.attributes().textureName());
+                brushNode.setFaceTexture(i, texture);
+            }
+        }
+
+        /**
+         * Sets the textures of the given nodes and their descendants. Looking up the textures of the brush faces is
+         * the expensive part, and since it only reads from the texture manager and every brush node only changes
+         * itself, the brushes are processed in parallel.
+         */
+        static void setTextures(Assets::TextureManager& manager, const std::vector<Model::Node*>& nodes) {
+            auto brushNodes = std::vector<Model::BrushNode*>{};
+            Model::Node::visitAll(nodes, kdl::overload(
                 [] (auto&& thisLambda, Model::WorldNode* world) { world->visitChildren(thisLambda); },
                 [] (auto&& thisLambda, Model::LayerNode* layer) { layer->visitChildren(thisLambda); },
                 [] (auto&& thisLambda, Model::GroupNode* group) { group->visitChildren(thisLambda); },
                 [] (auto&& thisLambda, Model::EntityNode* entity) { entity->visitChildren(thisLambda); },
-                [&](Model::BrushNode* brushNode) { 
-                    const Model::Brush& brush = brushNode->brush();
-                    for (size_t i = 0u; i < brush.faceCount(); ++i) {
-                        const Model::BrushFace& face = brush.face(i);
-                        Assets::Texture* texture = manager.texture(face.attributes().textureName());
-                        brushNode->setFaceTexture(i, texture);
-                    }
+                [&](Model::BrushNode* brushNode) {
+                    brushNodes.push_back(brushNode);
                 },
                 [&](Model::PatchNode* patchNode) { 
                     auto* texture = manager.texture(patchNode->patch().textureName());
                     patchNode->setTexture(texture);
                 }
-            );
+            ));
+
+            kdl::parallel_for(brushNodes.size(), [&](const size_t i) {
+                setBrushFaceTextures(manager, *brushNodes[i]);
+            });
         }
 
         static auto makeUnsetTexturesVisitor() {
@@ -3200,7 +3372,7 @@ namespace TrenchBroom {
                 [](auto&& thisLambda, Model::GroupNode* group) { group->visitChildren(thisLambda); },
                 [](auto&& thisLambda, Model::EntityNode* entity) { entity->visitChildren(thisLambda); },
                 [](Model::BrushNode* brushNode) { 
-                    const Model::Brush& brush = brushNode->brush();
+                    const Model::Brush& brush = brushNode->brushWithoutRestoringGeometry();
                     for (size_t i = 0u; i < brush.faceCount(); ++i) {
                         brushNode->setFaceTexture(i, nullptr);
                     }
@@ -3212,12 +3384,12 @@ namespace TrenchBroom {
         }
 
         void MapDocument::setTextures() {
-            m_world->accept(makeSetTexturesVisitor(*m_textureManager));
+            View::setTextures(*m_textureManager, std::vector<Model::Node*>{m_world.get()});
             textureUsageCountsDidChangeNotifier();
         }
 
         void MapDocument::setTextures(const std::vector<Model::Node*>& nodes) {
-            Model::Node::visitAll(nodes, makeSetTexturesVisitor(*m_textureManager));
+            View::setTextures(*m_textureManager, nodes);
             textureUsageCountsDidChangeNotifier();
         }
 
@@ -3420,25 +3592,29 @@ namespace TrenchBroom {
             ensure(m_world != nullptr, "world is null");
             ensure(m_game.get() != nullptr, "game is null");
 
-            m_world->registerIssueGenerator(new Model::MissingClassnameIssueGenerator());
-            m_world->registerIssueGenerator(new Model::MissingDefinitionIssueGenerator());
-            m_world->registerIssueGenerator(new Model::MissingModIssueGenerator(m_game));
-            m_world->registerIssueGenerator(new Model::EmptyGroupIssueGenerator());
-            m_world->registerIssueGenerator(new Model::EmptyBrushEntityIssueGenerator());
-            m_world->registerIssueGenerator(new Model::PointEntityWithBrushesIssueGenerator());
-            m_world->registerIssueGenerator(new Model::LinkSourceIssueGenerator());
-            m_world->registerIssueGenerator(new Model::LinkTargetIssueGenerator());
-            m_world->registerIssueGenerator(new Model::NonIntegerVerticesIssueGenerator());
-            m_world->registerIssueGenerator(new Model::MixedBrushContentsIssueGenerator());
-            m_world->registerIssueGenerator(new Model::WorldBoundsIssueGenerator(worldBounds()));
-            m_world->registerIssueGenerator(new Model::SoftMapBoundsIssueGenerator(m_game, m_world.get()));
-            m_world->registerIssueGenerator(new Model::EmptyPropertyKeyIssueGenerator());
-            m_world->registerIssueGenerator(new Model::EmptyPropertyValueIssueGenerator());
-            m_world->registerIssueGenerator(new Model::LongPropertyKeyIssueGenerator(m_game->maxPropertyLength()));
-            m_world->registerIssueGenerator(new Model::LongPropertyValueIssueGenerator(m_game->maxPropertyLength()));
-            m_world->registerIssueGenerator(new Model::PropertyKeyWithDoubleQuotationMarksIssueGenerator());
-            m_world->registerIssueGenerator(new Model::PropertyValueWithDoubleQuotationMarksIssueGenerator());
-            m_world->registerIssueGenerator(new Model::InvalidTextureScaleIssueGenerator());
+            // registering the generators at once invalidates the issues of all nodes only once
+            m_world->registerIssueGenerators({
+                new Model::MissingClassnameIssueGenerator(),
+                new Model::MissingDefinitionIssueGenerator(),
+                new Model::MissingModIssueGenerator(m_game),
+                new Model::EmptyGroupIssueGenerator(),
+                new Model::EmptyBrushEntityIssueGenerator(),
+                new Model::PointEntityWithBrushesIssueGenerator(),
+                new Model::LinkSourceIssueGenerator(),
+                new Model::LinkTargetIssueGenerator(),
+                new Model::NonIntegerVerticesIssueGenerator(),
+                new Model::MixedBrushContentsIssueGenerator(),
+                new Model::WorldBoundsIssueGenerator(worldBounds()),
+                new Model::SoftMapBoundsIssueGenerator(m_game, m_world.get()),
+                new Model::EmptyPropertyKeyIssueGenerator(),
+                new Model::EmptyPropertyValueIssueGenerator(),
+                new Model::LongPropertyKeyIssueGenerator(m_game->maxPropertyLength()),
+                new Model::LongPropertyValueIssueGenerator(m_game->maxPropertyLength()),
+                new Model::PropertyKeyWithDoubleQuotationMarksIssueGenerator(),
+                new Model::PropertyValueWithDoubleQuotationMarksIssueGenerator(),
+                new Model::InvalidTextureScaleIssueGenerator(),
+                new Model::RedundantBrushIssueGenerator(m_world.get())
+            });
         }
 
         void MapDocument::registerSmartTags() {
@@ -3490,10 +3666,12 @@ namespace TrenchBroom {
             );
         }
 
-        void MapDocument::initializeAllNodeTags(MapDocument* document) {
-            assert(document == this);
-            unused(document);
-            m_world->accept(makeInitializeNodeTagsVisitor(*m_tagManager));
+        void MapDocument::initializeAllNodeTags() {
+            // the tag matchers only read the nodes, and every node only updates its own tags
+            const auto nodes = Model::collectNodes({m_world.get()});
+            kdl::parallel_for(nodes.size(), [&](const size_t i) {
+                nodes[i]->initializeTags(*m_tagManager);
+            });
         }
 
         void MapDocument::initializeNodeTags(const std::vector<Model::Node*>& nodes) {
@@ -3505,9 +3683,10 @@ namespace TrenchBroom {
         }
 
         void MapDocument::updateNodeTags(const std::vector<Model::Node*>& nodes) {
-            for (auto* node : nodes) {
-                node->updateTags(*m_tagManager);
-            }
+            // the tag matchers only read the nodes, and every node only updates its own tags
+            kdl::parallel_for(nodes.size(), [&](const size_t i) {
+                nodes[i]->updateTags(*m_tagManager);
+            });
         }
 
         void MapDocument::updateFaceTags(const std::vector<Model::BrushFaceHandle>& faceHandles) {
@@ -3584,8 +3763,6 @@ namespace TrenchBroom {
             m_notifierConnection += transactionUndoneNotifier.connect(this, &MapDocument::transactionUndone);
 
             // tag management
-            m_notifierConnection += documentWasNewedNotifier.connect(this, &MapDocument::initializeAllNodeTags);
-            m_notifierConnection += documentWasLoadedNotifier.connect(this, &MapDocument::initializeAllNodeTags);
             m_notifierConnection += nodesWereAddedNotifier.connect(this, &MapDocument::initializeNodeTags);
             m_notifierConnection += nodesWillBeRemovedNotifier.connect(this, &MapDocument::clearNodeTags);
             m_notifierConnection += nodesDidChangeNotifier.connect(this, &MapDocument::updateNodeTags);
@@ -3641,6 +3818,8 @@ namespace TrenchBroom {
                        path == Preferences::TextureMagFilter.path()) {
                 m_entityModelManager->setTextureMode(pref(Preferences::TextureMinFilter), pref(Preferences::TextureMagFilter));
                 m_textureManager->setTextureMode(pref(Preferences::TextureMinFilter), pref(Preferences::TextureMagFilter));
+            } else if (path == Preferences::TextureMemoryBudget.path()) {
+                updateTextureMemoryBudget();
             }
         }
 
@@ -31,8 +31,10 @@
 
 #include <vecmath/forward.h>
 #include <vecmath/bbox.h>
+#include <vecmath/mat.h>
 #include <vecmath/util.h>
 
+#include <future>
 #include <map>
 #include <memory>
 #include <optional>
@@ -42,6 +44,7 @@
 
 namespace TrenchBroom {
     class Color;
+    class MemoryReport;
 
     namespace Assets {
         class EntityDefinition;
@@ -124,6 +127,13 @@ namespace TrenchBroom {
             mutable vm::bbox3 m_selectionBounds;
             mutable bool m_selectionBoundsValid;
 
+            /*
+             * A transformation that is applied to the selected objects when they are rendered, but not to the objects
+             * themselves. Tools set this while the user drags the selection and transform the objects when the drag
+             * ends.
+             */
+            std::optional<vm::mat4x4> m_selectionPreviewTransformation;
+
             ViewEffectsService* m_viewEffectsService;
 
             /*
@@ -157,6 +167,7 @@ namespace TrenchBroom {
 
             Notifier<> selectionWillChangeNotifier;
             Notifier<const Selection&> selectionDidChangeNotifier;
+            Notifier<> selectionPreviewTransformationDidChangeNotifier;
 
             Notifier<const std::vector<Model::Node*>&> nodesWereAddedNotifier;
             Notifier<const std::vector<Model::Node*>&> nodesWillBeRemovedNotifier;
@@ -336,6 +347,16 @@ namespace TrenchBroom {
             const vm::bbox3& referenceBounds() const override;
             const vm::bbox3& lastSelectionBounds() const override;
             const vm::bbox3& selectionBounds() const override;
+
+            /**
+             * Returns the selection bounds with the selection preview transformation applied, if any.
+             */
+            vm::bbox3 previewSelectionBounds() const;
+
+            const std::optional<vm::mat4x4>& selectionPreviewTransformation() const;
+            void setSelectionPreviewTransformation(const vm::mat4x4& transformation);
+            void clearSelectionPreviewTransformation();
+
             const std::string& currentTextureName() const override;
             void setCurrentTextureName(const std::string& currentTextureName);
 
@@ -542,11 +563,26 @@ namespace TrenchBroom {
 
             virtual std::unique_ptr<CommandResult> doExecute(std::unique_ptr<Command>&& command) = 0;
             virtual std::unique_ptr<CommandResult> doExecuteAndStore(std::unique_ptr<UndoableCommand>&& command) = 0;
+
+            virtual void doReportCommandMemoryUsage(MemoryReport& report, size_t maxCommands) const = 0;
         public: // asset state management
             void commitPendingAssets();
         public: // picking
             void pick(const vm::ray3& pickRay, Model::PickResult& pickResult) const;
             std::vector<Model::Node*> findNodesContaining(const vm::vec3& point) const;
+        public: // brush geometry compaction
+            /**
+             * Compacts the geometry of every brush that has not been used since the previous call, see
+             * Model::BrushNode::compactGeometryIfUnused. Should be called periodically while the editor is idle.
+             */
+            void compactUnusedBrushGeometry();
+        public: // memory accounting
+            /**
+             * Returns a report of the memory used by the world, the brush geometry and renderer caches, the textures,
+             * the entity models and the undo and redo stacks. The given maximum number of the largest nodes and
+             * commands are listed individually.
+             */
+            MemoryReport memoryReport(size_t maxItems = 20u) const;
         private: // world management
             void createWorld(Model::MapFormat mapFormat, const vm::bbox3& worldBounds, std::shared_ptr<Model::Game> game);
             void loadWorld(Model::MapFormat mapFormat, const vm::bbox3& worldBounds, std::shared_ptr<Model::Game> game, const IO::Path& path);
@@ -568,8 +604,12 @@ namespace TrenchBroom {
         private:
             void loadAssets();
             void unloadAssets();
+            void initializeWorld();
 
+            struct LoadedEntityDefinitions;
             void loadEntityDefinitions();
+            std::future<LoadedEntityDefinitions> loadEntityDefinitionsAsync() const;
+            void setLoadedEntityDefinitions(LoadedEntityDefinitions loadedDefinitions);
             void unloadEntityDefinitions();
 
             void loadEntityModels();
@@ -577,6 +617,7 @@ namespace TrenchBroom {
         protected:
             void reloadTextures();
             void loadTextures();
+            void updateTextureMemoryBudget();
             void unloadTextures();
 
             void setTextures();
@@ -621,7 +662,7 @@ namespace TrenchBroom {
             bool isRegisteredSmartTag(size_t index) const;
             const Model::SmartTag& smartTag(size_t index) const;
         private:
-            void initializeAllNodeTags(MapDocument* document);
+            void initializeAllNodeTags();
             void initializeNodeTags(const std::vector<Model::Node*>& nodes);
             void clearNodeTags(const std::vector<Model::Node*>& nodes);
             void updateNodeTags(const std::vector<Model::Node*>& nodes);
@@ -45,6 +45,7 @@
 
 #include <kdl/map_utils.h>
 #include <kdl/overload.h>
+#include <kdl/parallel.h>
 #include <kdl/result.h>
 #include <kdl/string_format.h>
 #include <kdl/string_utils.h>
@@ -56,7 +57,9 @@
 
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
+#include <variant>
 #include <vector>
 
 namespace TrenchBroom {
@@ -73,6 +76,21 @@ namespace TrenchBroom {
 
         MapDocumentCommandFacade::~MapDocumentCommandFacade() = default;
 
+        /**
+         * Tools expect the geometry of all selected brushes, including the brushes of selected groups and entities, so
+         * it is restored when they are selected. Selected brushes are never compacted.
+         */
+        static void restoreBrushGeometry(const std::vector<Model::Node*>& nodes) {
+            Model::Node::visitAll(nodes, kdl::overload(
+                [](auto&& thisLambda, Model::WorldNode* world)   { world->visitChildren(thisLambda); },
+                [](auto&& thisLambda, Model::LayerNode* layer)   { layer->visitChildren(thisLambda); },
+                [](auto&& thisLambda, Model::GroupNode* group)   { group->visitChildren(thisLambda); },
+                [](auto&& thisLambda, Model::EntityNode* entity) { entity->visitChildren(thisLambda); },
+                [](Model::BrushNode* brush)                      { brush->restoreGeometry(); },
+                [](Model::PatchNode*)                            {}
+            ));
+        }
+
         void MapDocumentCommandFacade::performSelect(const std::vector<Model::Node*>& nodes) {
             selectionWillChangeNotifier();
             updateLastSelectionBounds();
@@ -92,6 +110,7 @@ namespace TrenchBroom {
             }
 
             m_selectedNodes.addNodes(selected);
+            restoreBrushGeometry(selected);
 
             Selection selection;
             selection.addSelectedNodes(selected);
@@ -117,6 +136,7 @@ namespace TrenchBroom {
                 Model::BrushNode* node = handle.node();
                 const Model::BrushFace& face = handle.face();
                 if (!face.selected() && m_editorContext->selectable(node, face)) {
+                    node->restoreGeometry();
                     node->selectFace(handle.faceIndex());
                     selected.push_back(handle);
                 }
@@ -188,7 +208,8 @@ namespace TrenchBroom {
                 }
             }
 
-            m_selectedBrushFaces = kdl::vec_erase_all(std::move(m_selectedBrushFaces), deselected);
+            // the deselected faces are no longer marked as selected, so they can be removed in a single pass
+            m_selectedBrushFaces = kdl::vec_erase_if(std::move(m_selectedBrushFaces), [](const auto& handle) { return !handle.face().selected(); });
 
             Selection selection;
             selection.addDeselectedBrushFaces(deselected);
@@ -334,18 +355,38 @@ namespace TrenchBroom {
             NotifyBeforeAndAfter notifyEntityDefinitions(notifyEntityDefinitionsChange, entityDefinitionsWillChangeNotifier, entityDefinitionsDidChangeNotifier);
             NotifyBeforeAndAfter notifyMods(notifyModsChange, modsWillChangeNotifier, modsDidChangeNotifier);
 
-            for (auto& pair : nodesToSwap) {
-                auto* node = pair.first;
-                auto& contents = pair.second.get();
-
-                pair.second = node->accept(kdl::overload(
-                    [&](Model::WorldNode* worldNode)   -> Model::NodeContents { return Model::NodeContents(worldNode->setEntity(std::get<Model::Entity>(std::move(contents)))); },
-                    [&](Model::LayerNode* layerNode)   -> Model::NodeContents { return Model::NodeContents(layerNode->setLayer(std::get<Model::Layer>(std::move(contents)))); },
-                    [&](Model::GroupNode* groupNode)   -> Model::NodeContents { return Model::NodeContents(groupNode->setGroup(std::get<Model::Group>(std::move(contents)))); },
-                    [&](Model::EntityNode* entityNode) -> Model::NodeContents { return Model::NodeContents(entityNode->setEntity(std::get<Model::Entity>(std::move(contents)))); },
-                    [&](Model::BrushNode* brushNode)   -> Model::NodeContents { return Model::NodeContents(brushNode->setBrush(std::get<Model::Brush>(std::move(contents)))); },
-                    [&](Model::PatchNode* patchNode)   -> Model::NodeContents { return Model::NodeContents(patchNode->setPatch(std::get<Model::BezierPatch>(std::move(contents)))); }
-                ));
+            // tessellating the new patches only depends on the patches themselves, so their grids are computed in
+            // parallel before the contents are swapped; a grid that was not computed is computed when it is set
+            auto patchGrids = std::vector<std::optional<Model::PatchGrid>>(nodesToSwap.size());
+            kdl::parallel_for(nodesToSwap.size(), [&](const size_t i) {
+                if (const auto* patch = std::get_if<Model::BezierPatch>(&nodesToSwap[i].second.get())) {
+                    patchGrids[i] = Model::PatchNode::computeGrid(*patch);
+                }
+            });
+
+            {
+                // moving many nodes at once refits the node tree once instead of updating it node by node
+                const auto nodeTreeUpdateBatch = Model::WorldNode::NodeTreeUpdateBatch{*m_world};
+                for (size_t i = 0u; i < nodesToSwap.size(); ++i) {
+                    auto& pair = nodesToSwap[i];
+                    auto* node = pair.first;
+                    auto& contents = pair.second.get();
+
+                    pair.second = node->accept(kdl::overload(
+                        [&](Model::WorldNode* worldNode)   -> Model::NodeContents { return Model::NodeContents(worldNode->setEntity(std::get<Model::Entity>(std::move(contents)))); },
+                        [&](Model::LayerNode* layerNode)   -> Model::NodeContents { return Model::NodeContents(layerNode->setLayer(std::get<Model::Layer>(std::move(contents)))); },
+                        [&](Model::GroupNode* groupNode)   -> Model::NodeContents { return Model::NodeContents(groupNode->setGroup(std::get<Model::Group>(std::move(contents)))); },
+                        [&](Model::EntityNode* entityNode) -> Model::NodeContents { return Model::NodeContents(entityNode->setEntity(std::get<Model::Entity>(std::move(contents)))); },
+                        [&](Model::BrushNode* brushNode)   -> Model::NodeContents { return Model::NodeContents(brushNode->setBrush(std::get<Model::Brush>(std::move(contents)))); },
+                        [&](Model::PatchNode* patchNode)   -> Model::NodeContents {
+                            auto& patch = std::get<Model::BezierPatch>(contents);
+                            if (patchGrids[i]) {
+                                return Model::NodeContents(patchNode->setPatch(std::move(patch), std::move(*patchGrids[i])));
+                            }
+                            return Model::NodeContents(patchNode->setPatch(std::move(patch)));
+                        }
+                    ));
+                }
             }
 
             if (!notifyEntityDefinitionsChange && !notifyModsChange) {
@@ -524,5 +565,9 @@ namespace TrenchBroom {
         std::unique_ptr<CommandResult> MapDocumentCommandFacade::doExecuteAndStore(std::unique_ptr<UndoableCommand>&& command) {
             return m_commandProcessor->executeAndStore(std::move(command));
         }
+
+        void MapDocumentCommandFacade::doReportCommandMemoryUsage(MemoryReport& report, const size_t maxCommands) const {
+            m_commandProcessor->reportMemoryUsage(report, maxCommands);
+        }
     }
 }
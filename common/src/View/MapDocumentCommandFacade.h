@@ -121,6 +121,8 @@ namespace TrenchBroom {
 
             std::unique_ptr<CommandResult> doExecute(std::unique_ptr<Command>&& command) override;
             std::unique_ptr<CommandResult> doExecuteAndStore(std::unique_ptr<UndoableCommand>&& command) override;
+
+            void doReportCommandMemoryUsage(MemoryReport& report, size_t maxCommands) const override;
         };
     }
 }
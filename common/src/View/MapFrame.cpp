@@ -22,10 +22,12 @@
 #include "Console.h"
 #include "Exceptions.h"
 #include "FileLogger.h"
+#include "MemoryReport.h"
 #include "Preferences.h"
 #include "PreferenceManager.h"
 #include "TrenchBroomApp.h"
 #include "IO/PathQt.h"
+#include "Renderer/VboManager.h"
 #include "Model/BrushNode.h"
 #include "Model/EditorContext.h"
 #include "Model/Entity.h"
@@ -113,6 +115,7 @@ namespace TrenchBroom {
         m_lastInputTime(std::chrono::system_clock::now()),
         m_autosaver(std::make_unique<Autosaver>(m_document)),
         m_autosaveTimer(nullptr),
+        m_compactBrushGeometryTimer(nullptr),
         m_toolBar(nullptr),
         m_hSplitter(nullptr),
         m_vSplitter(nullptr),
@@ -155,6 +158,9 @@ namespace TrenchBroom {
             m_autosaveTimer = new QTimer(this);
             m_autosaveTimer->start(1000);
 
+            m_compactBrushGeometryTimer = new QTimer(this);
+            m_compactBrushGeometryTimer->start(30000);
+
             connectObservers();
             bindEvents();
 
@@ -769,6 +775,7 @@ namespace TrenchBroom {
 
         void MapFrame::bindEvents() {
             connect(m_autosaveTimer, &QTimer::timeout, this, &MapFrame::triggerAutosave);
+            connect(m_compactBrushGeometryTimer, &QTimer::timeout, this, &MapFrame::compactUnusedBrushGeometry);
             connect(qApp, &QApplication::focusChanged, this, &MapFrame::focusChange);
             connect(m_gridChoice, QOverload<int>::of(&QComboBox::activated), this, [this](const int index) { setGridSize(index + Grid::MinSize); });
             connect(QApplication::clipboard(), &QClipboard::dataChanged, this, [this]() {
@@ -1723,6 +1730,14 @@ namespace TrenchBroom {
             m_document->printVertices();
         }
 
+        void MapFrame::debugPrintMemoryUsage() {
+            logger().info() << m_document->memoryReport();
+
+            // video memory is reported on its own so that it is not added to the total of the main memory
+            const auto& vboManager = m_contextManager->vboManager();
+            logger().info() << "Video memory usage: " << formatMemorySize(vboManager.currentVboSize()) << " (" << vboManager.currentVboCount() << " VBOs)";
+        }
+
         void MapFrame::debugCreateBrush() {
             bool ok = false;
             const QString str = QInputDialog::getText(this, "Create Brush", "Enter a list of at least 4 points (x y z) (x y z) ...", QLineEdit::Normal, "", &ok);
@@ -1894,6 +1909,13 @@ namespace TrenchBroom {
             }
         }
 
+        void MapFrame::compactUnusedBrushGeometry() {
+            // don't interfere with tools that are in the middle of an interaction
+            if (QGuiApplication::mouseButtons() == Qt::NoButton) {
+                m_document->compactUnusedBrushGeometry();
+            }
+        }
+
         // DebugPaletteWindow
 
         DebugPaletteWindow::DebugPaletteWindow(QWidget *parent)
@@ -85,6 +85,7 @@ namespace TrenchBroom {
             std::chrono::time_point<std::chrono::system_clock> m_lastInputTime;
             std::unique_ptr<Autosaver> m_autosaver;
             QTimer* m_autosaveTimer;
+            QTimer* m_compactBrushGeometryTimer;
 
             QToolBar* m_toolBar;
 
@@ -366,6 +367,7 @@ namespace TrenchBroom {
             void revealTexture(const Assets::Texture* texture);
 
             void debugPrintVertices();
+            void debugPrintMemoryUsage();
             void debugCreateBrush();
             void debugCreateCube();
             void debugClipBrush();
@@ -387,6 +389,7 @@ namespace TrenchBroom {
             bool eventFilter(QObject* target, QEvent* event) override;
         private:
             void triggerAutosave();
+            void compactUnusedBrushGeometry();
         };
 
         class DebugPaletteWindow : public QDialog {
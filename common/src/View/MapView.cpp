@@ -39,6 +39,10 @@ namespace TrenchBroom {
             doInstallActivationTracker(activationTracker);
         }
 
+        void MapView::installFrameScheduler(FrameScheduler& frameScheduler) {
+            doInstallFrameScheduler(frameScheduler);
+        }
+
         bool MapView::isCurrent() const {
             return doGetIsCurrent();
         }
@@ -26,6 +26,7 @@
 
 namespace TrenchBroom {
     namespace View {
+        class FrameScheduler;
         class MapViewActivationTracker;
         class MapViewBase;
         class MapViewContainer;
@@ -39,6 +40,7 @@ namespace TrenchBroom {
 
             void setContainer(MapViewContainer* container);
             void installActivationTracker(MapViewActivationTracker& activationTracker);
+            void installFrameScheduler(FrameScheduler& frameScheduler);
 
             bool isCurrent() const;
             MapViewBase* firstMapViewBase();
@@ -67,6 +69,7 @@ namespace TrenchBroom {
             void refreshViews();
         private:
             virtual void doInstallActivationTracker(MapViewActivationTracker& activationTracker) = 0;
+            virtual void doInstallFrameScheduler(FrameScheduler& frameScheduler) = 0;
 
             virtual bool doGetIsCurrent() const = 0;
             virtual MapViewBase* doGetFirstMapViewBase() = 0;
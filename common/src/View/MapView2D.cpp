@@ -22,7 +22,10 @@
 #include "Exceptions.h"
 #include "Logger.h"
 #include "Macros.h"
+#include "PreferenceManager.h"
+#include "Preferences.h"
 #include "Assets/EntityDefinitionManager.h"
+#include "IO/Path.h"
 #include "Model/BrushBuilder.h"
 #include "Model/BrushError.h"
 #include "Model/BrushNode.h"
@@ -33,6 +36,8 @@
 #include "Model/ModelUtils.h"
 #include "Model/PickResult.h"
 #include "Model/PointFile.h"
+#include "Model/WorldNode.h"
+#include "Renderer/BrushLodRenderer2D.h"
 #include "Renderer/Compass2D.h"
 #include "Renderer/GridRenderer.h"
 #include "Renderer/MapRenderer.h"
@@ -75,7 +80,8 @@ namespace TrenchBroom {
         MapView2D::MapView2D(std::weak_ptr<MapDocument> document, MapViewToolBox& toolBox, Renderer::MapRenderer& renderer,
                              GLContextManager& contextManager, ViewPlane viewPlane, Logger* logger) :
         MapViewBase(logger, document, toolBox, renderer, contextManager),
-        m_camera(std::make_unique<Renderer::OrthographicCamera>()) {
+        m_camera(std::make_unique<Renderer::OrthographicCamera>()),
+        m_brushLodRenderer(std::make_unique<Renderer::BrushLodRenderer2D>(kdl::mem_lock(document)->editorContext())) {
             connectObservers();
             initializeCamera(viewPlane);
             initializeToolChain(toolBox);
@@ -96,6 +102,12 @@ namespace TrenchBroom {
             mapViewBaseVirtualInit();
         }
 
+        MapView2D::~MapView2D() {
+            // Deleting m_brushLodRenderer will access its VBO so we need to be current
+            // see: http://doc.qt.io/qt-5/qopenglwidget.html#resource-initialization-and-cleanup
+            makeCurrent();
+        }
+
         void MapView2D::initializeCamera(const ViewPlane viewPlane) {
             auto document = kdl::mem_lock(m_document);
             const auto worldBounds = vm::bbox3f(document->worldBounds());
@@ -138,12 +150,50 @@ namespace TrenchBroom {
 
         void MapView2D::connectObservers() {
             m_notifierConnection += m_camera->cameraDidChangeNotifier.connect(this, &MapView2D::cameraDidChange);
+
+            auto document = kdl::mem_lock(m_document);
+            m_notifierConnection += document->nodesWereAddedNotifier.connect(this, &MapView2D::brushLodNodesDidChange);
+            m_notifierConnection += document->nodesWereRemovedNotifier.connect(this, &MapView2D::brushLodNodesDidChange);
+            m_notifierConnection += document->nodesDidChangeNotifier.connect(this, &MapView2D::brushLodNodesDidChange);
+            m_notifierConnection += document->nodeVisibilityDidChangeNotifier.connect(this, &MapView2D::brushLodNodesDidChange);
+            m_notifierConnection += document->nodeLockingDidChangeNotifier.connect(this, &MapView2D::brushLodNodesDidChange);
+            m_notifierConnection += document->selectionDidChangeNotifier.connect(this, &MapView2D::brushLodSelectionDidChange);
+            m_notifierConnection += document->editorContextDidChangeNotifier.connect(this, &MapView2D::brushLodContextDidChange);
+            m_notifierConnection += document->entityDefinitionsDidChangeNotifier.connect(this, &MapView2D::brushLodContextDidChange);
+            m_notifierConnection += document->documentWasNewedNotifier.connect(this, &MapView2D::brushLodDocumentDidChange);
+            m_notifierConnection += document->documentWasClearedNotifier.connect(this, &MapView2D::brushLodDocumentDidChange);
+            m_notifierConnection += document->documentWasLoadedNotifier.connect(this, &MapView2D::brushLodDocumentDidChange);
+
+            auto& prefs = PreferenceManager::instance();
+            m_notifierConnection += prefs.preferenceDidChangeNotifier.connect(this, &MapView2D::brushLodPreferenceDidChange);
         }
 
         void MapView2D::cameraDidChange(const Renderer::Camera*) {
             update();
         }
 
+        void MapView2D::brushLodNodesDidChange(const std::vector<Model::Node*>&) {
+            m_brushLodRenderer->invalidate();
+        }
+
+        void MapView2D::brushLodSelectionDidChange(const Selection&) {
+            m_brushLodRenderer->invalidate();
+        }
+
+        void MapView2D::brushLodContextDidChange() {
+            m_brushLodRenderer->invalidate();
+        }
+
+        void MapView2D::brushLodDocumentDidChange(MapDocument*) {
+            m_brushLodRenderer->invalidate();
+        }
+
+        void MapView2D::brushLodPreferenceDidChange(const IO::Path& path) {
+            if (path == Preferences::EdgeColor.path()) {
+                m_brushLodRenderer->invalidate();
+            }
+        }
+
         PickRequest MapView2D::doGetPickRequest(const float x, const float y) const {
             return PickRequest(vm::ray3(m_camera->pickRay(x, y)), *m_camera);
         }
@@ -323,11 +373,17 @@ namespace TrenchBroom {
         }
 
         void MapView2D::doRenderMap(Renderer::MapRenderer& renderer, Renderer::RenderContext& renderContext, Renderer::RenderBatch& renderBatch) {
+            auto document = kdl::mem_lock(m_document);
+            if (Renderer::BrushLodRenderer2D::useLod(*m_camera)) {
+                renderContext.setHideUnselectedBrushes();
+
+                m_brushLodRenderer->render(*document->world(), *m_camera, renderBatch);
+            }
+
             renderer.render(renderContext, renderBatch);
 
-            auto document = kdl::mem_lock(m_document);
             if (renderContext.showSelectionGuide() && document->hasSelectedNodes()) {
-                const vm::bbox3& bounds = document->selectionBounds();
+                const vm::bbox3 bounds = document->previewSelectionBounds();
                 Renderer::SelectionBoundsRenderer boundsRenderer(bounds);
                 boundsRenderer.render(renderContext, renderBatch);
             }
@@ -25,15 +25,22 @@
 #include <vecmath/forward.h>
 
 #include <memory>
+#include <vector>
 
 namespace TrenchBroom {
     class Logger;
 
+    namespace IO {
+        class Path;
+    }
+
     namespace Model {
+        class Node;
         class PickResult;
     }
 
     namespace Renderer {
+        class BrushLodRenderer2D;
         class MapRenderer;
         class OrthographicCamera;
         class RenderBatch;
@@ -52,17 +59,24 @@ namespace TrenchBroom {
             } ViewPlane;
         private:
             std::unique_ptr<Renderer::OrthographicCamera> m_camera;
+            std::unique_ptr<Renderer::BrushLodRenderer2D> m_brushLodRenderer;
 
             NotifierConnection m_notifierConnection;
         public:
             MapView2D(std::weak_ptr<MapDocument> document, MapViewToolBox& toolBox, Renderer::MapRenderer& renderer,
                       GLContextManager& contextManager, ViewPlane viewPlane, Logger* logger);
+            ~MapView2D() override;
         private:
             void initializeCamera(ViewPlane viewPlane);
             void initializeToolChain(MapViewToolBox& toolBox);
         private: // notification
             void connectObservers();
             void cameraDidChange(const Renderer::Camera* camera);
+            void brushLodNodesDidChange(const std::vector<Model::Node*>& nodes);
+            void brushLodSelectionDidChange(const Selection& selection);
+            void brushLodContextDidChange();
+            void brushLodDocumentDidChange(MapDocument* document);
+            void brushLodPreferenceDidChange(const IO::Path& path);
         private: // implement ToolBoxConnector interface
             PickRequest doGetPickRequest(float x, float y) const override;
             Model::PickResult doPick(const vm::ray3& pickRay) const override;
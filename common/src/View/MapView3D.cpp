@@ -127,14 +127,14 @@ namespace TrenchBroom {
         void MapView3D::cameraDidChange(const Renderer::Camera* /* camera */) {
             if (!m_ignoreCameraChangeEvents) {
                 // Don't refresh if the camera was changed in doPreRender!
-                update();
+                scheduleRenderIfChanged();
             }
         }
 
         void MapView3D::preferenceDidChange(const IO::Path& path) {
             if (path == Preferences::CameraFov.path()) {
                 m_camera->setFov(pref(Preferences::CameraFov));
-                update();
+                scheduleRender();
             }
         }
 
@@ -453,7 +453,7 @@ namespace TrenchBroom {
 
             auto document = kdl::mem_lock(m_document);
             if (renderContext.showSelectionGuide() && document->hasSelectedNodes()) {
-                const vm::bbox3& bounds = document->selectionBounds();
+                const vm::bbox3 bounds = document->previewSelectionBounds();
                 Renderer::SelectionBoundsRenderer boundsRenderer(bounds);
                 boundsRenderer.render(renderContext, renderBatch);
 
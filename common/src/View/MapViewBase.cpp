@@ -98,6 +98,7 @@ namespace TrenchBroom {
         m_compass(nullptr),
         m_portalFileRenderer(nullptr),
         m_isCurrent(false),
+        m_frameScheduler(nullptr),
         m_updateActionStatesSignalDelayer{new SignalDelayer{this}} {
             setToolBox(toolBox);
             bindEvents();
@@ -118,12 +119,32 @@ namespace TrenchBroom {
             // Deleting m_compass will access the VBO so we need to be current
             // see: http://doc.qt.io/qt-5/qopenglwidget.html#resource-initialization-and-cleanup
             makeCurrent();
+
+            if (m_frameScheduler) {
+                m_frameScheduler->removeClient(this);
+            }
         }
 
         void MapViewBase::setIsCurrent(const bool isCurrent) {
             m_isCurrent = isCurrent;
         }
 
+        void MapViewBase::scheduleRender() {
+            if (m_frameScheduler) {
+                m_frameScheduler->invalidate(this);
+            } else {
+                update();
+            }
+        }
+
+        void MapViewBase::scheduleRenderIfChanged() {
+            if (m_frameScheduler) {
+                m_frameScheduler->invalidateIfChanged(this);
+            } else {
+                update();
+            }
+        }
+
         void MapViewBase::bindEvents() {
             connect(m_updateActionStatesSignalDelayer, &SignalDelayer::processSignal, this, &MapViewBase::updateActionStates);
         }
@@ -138,6 +159,7 @@ namespace TrenchBroom {
             m_notifierConnection += document->commandDoneNotifier.connect(this, &MapViewBase::commandDone);
             m_notifierConnection += document->commandUndoneNotifier.connect(this, &MapViewBase::commandUndone);
             m_notifierConnection += document->selectionDidChangeNotifier.connect(this, &MapViewBase::selectionDidChange);
+            m_notifierConnection += document->selectionPreviewTransformationDidChangeNotifier.connect(this, &MapViewBase::selectionPreviewTransformationDidChange);
             m_notifierConnection += document->textureCollectionsDidChangeNotifier.connect(this, &MapViewBase::textureCollectionsDidChange);
             m_notifierConnection += document->entityDefinitionsDidChangeNotifier.connect(this, &MapViewBase::entityDefinitionsDidChange);
             m_notifierConnection += document->modsDidChangeNotifier.connect(this, &MapViewBase::modsDidChange);
@@ -171,60 +193,64 @@ namespace TrenchBroom {
 
         void MapViewBase::nodesDidChange(const std::vector<Model::Node*>&) {
             updatePickResult();
-            update();
+            scheduleRender();
         }
 
         void MapViewBase::toolChanged(Tool&) {
             updatePickResult();
             updateActionStates();
-            update();
+            scheduleRender();
         }
 
         void MapViewBase::commandDone(Command*) {
             updateActionStatesDelayed();
             updatePickResult();
-            update();
+            scheduleRender();
         }
 
         void MapViewBase::commandUndone(UndoableCommand*) {
             updateActionStatesDelayed();
             updatePickResult();
-            update();
+            scheduleRender();
         }
 
         void MapViewBase::selectionDidChange(const Selection&) {
             updateActionStatesDelayed();
         }
 
+        void MapViewBase::selectionPreviewTransformationDidChange() {
+            scheduleRender();
+        }
+
         void MapViewBase::textureCollectionsDidChange() {
-            update();
+            scheduleRender();
         }
 
         void MapViewBase::entityDefinitionsDidChange() {
             createActions();
             updateActionStates();
-            update();
+            scheduleRender();
         }
 
         void MapViewBase::modsDidChange() {
-            update();
+            scheduleRender();
         }
 
         void MapViewBase::editorContextDidChange() {
-            update();
+            scheduleRender();
         }
 
         void MapViewBase::gridDidChange() {
-            update();
+            scheduleRender();
         }
 
         void MapViewBase::pointFileDidChange() {
-            update();
+            scheduleRender();
         }
 
         void MapViewBase::portalFileDidChange() {
             invalidatePortalFileRenderer();
-            update();
+            scheduleRender();
         }
 
         void MapViewBase::preferenceDidChange(const IO::Path& path) {
@@ -233,12 +259,12 @@ namespace TrenchBroom {
             }
 
             updateActionBindings();
-            update();
+            scheduleRender();
         }
 
         void MapViewBase::documentDidChange(MapDocument*) {
             createActionsAndUpdatePicking();
-            update();
+            scheduleRender();
         }
 
         void MapViewBase::createActions() {
@@ -776,6 +802,12 @@ namespace TrenchBroom {
             activationTracker.addWindow(this);
         }
 
+        void MapViewBase::doInstallFrameScheduler(FrameScheduler& frameScheduler) {
+            assert(m_frameScheduler == nullptr);
+            m_frameScheduler = &frameScheduler;
+            m_frameScheduler->addClient(this);
+        }
+
         bool MapViewBase::doGetIsCurrent() const {
             return m_isCurrent;
         }
@@ -789,6 +821,30 @@ namespace TrenchBroom {
         }
 
         void MapViewBase::doRefreshViews() {
+            scheduleRender();
+        }
+
+        FrameScheduler::FrameState MapViewBase::frameState() {
+            const auto& camera = doGetCamera();
+            const auto& viewport = camera.viewport();
+
+            auto state = FrameScheduler::FrameState{};
+            state.reserve(2u * 16u + 4u);
+            for (const auto* matrix : { &camera.projectionMatrix(), &camera.viewMatrix() }) {
+                for (size_t c = 0u; c < 4u; ++c) {
+                    for (size_t r = 0u; r < 4u; ++r) {
+                        state.push_back((*matrix)[c][r]);
+                    }
+                }
+            }
+            state.push_back(static_cast<float>(viewport.x));
+            state.push_back(static_cast<float>(viewport.y));
+            state.push_back(static_cast<float>(viewport.width));
+            state.push_back(static_cast<float>(viewport.height));
+            return state;
+        }
+
+        void MapViewBase::renderFrame() {
             update();
         }
 
@@ -850,6 +906,10 @@ namespace TrenchBroom {
             renderFPS(renderContext, renderBatch);
 
             renderBatch.render(renderContext);
+
+            if (m_frameScheduler) {
+                m_frameScheduler->clientRendered(this);
+            }
         }
 
         void MapViewBase::setupGL(Renderer::RenderContext& context) {
@@ -22,6 +22,7 @@
 #include "NotifierConnection.h"
 #include "View/ActionContext.h"
 #include "View/CameraLinkHelper.h"
+#include "View/FrameScheduler.h"
 #include "View/MapView.h"
 #include "View/RenderView.h"
 #include "View/ToolBoxConnector.h"
@@ -77,7 +78,7 @@ namespace TrenchBroom {
         class Tool;
         class UndoableCommand;
 
-        class MapViewBase : public RenderView, public MapView, public ToolBoxConnector, public CameraLinkableView {
+        class MapViewBase : public RenderView, public MapView, public ToolBoxConnector, public CameraLinkableView, public FrameScheduler::Client {
             Q_OBJECT
         public:
             static const int DefaultCameraAnimationDuration;
@@ -99,6 +100,12 @@ namespace TrenchBroom {
              */
             bool m_isCurrent;
 
+            /**
+             * The scheduler that coalesces the render requests of all map views of the same document, or null if this
+             * view renders whenever it is updated.
+             */
+            FrameScheduler* m_frameScheduler;
+
             SignalDelayer* m_updateActionStatesSignalDelayer;
 
             NotifierConnection m_notifierConnection;
@@ -124,6 +131,17 @@ namespace TrenchBroom {
             ~MapViewBase() override;
         public:
             void setIsCurrent(bool isCurrent);
+        protected:
+            /**
+             * Requests that this view is rendered in the next frame.
+             */
+            void scheduleRender();
+
+            /**
+             * Requests that this view is rendered in the next frame if its camera has changed since it was last
+             * rendered.
+             */
+            void scheduleRenderIfChanged();
         private:
             void bindEvents();
             void connectObservers();
@@ -135,6 +153,7 @@ namespace TrenchBroom {
             void commandDone(Command* command);
             void commandUndone(UndoableCommand* command);
             void selectionDidChange(const Selection& selection);
+            void selectionPreviewTransformationDidChange();
             void textureCollectionsDidChange();
             void entityDefinitionsDidChange();
             void modsDidChange();
@@ -268,10 +287,14 @@ namespace TrenchBroom {
             void doFlashSelection() override;
         private: // implement MapView interface
             void doInstallActivationTracker(MapViewActivationTracker& activationTracker) override;
+            void doInstallFrameScheduler(FrameScheduler& frameScheduler) override;
             bool doGetIsCurrent() const override;
             MapViewBase* doGetFirstMapViewBase() override;
             bool doCancelMouseDrag() override;
             void doRefreshViews() override;
+        private: // implement FrameScheduler::Client interface
+            FrameScheduler::FrameState frameState() override;
+            void renderFrame() override;
         protected: // RenderView overrides
             void initializeGL() override;
         private: // implement RenderView interface
@@ -29,6 +29,9 @@
 #include <kdl/memory_utils.h>
 
 #include <vecmath/bbox.h>
+#include <vecmath/mat.h>
+#include <vecmath/mat_ext.h>
+#include <vecmath/vec.h>
 
 #include <cassert>
 
@@ -37,7 +40,8 @@ namespace TrenchBroom {
         MoveObjectsTool::MoveObjectsTool(std::weak_ptr<MapDocument> document) :
         Tool(true),
         m_document(document),
-        m_duplicateObjects(false) {}
+        m_duplicateObjects(false),
+        m_pendingDelta(vm::vec3::zero()) {}
 
         const Grid& MoveObjectsTool::grid() const {
             return kdl::mem_lock(m_document)->grid();
@@ -52,6 +56,7 @@ namespace TrenchBroom {
 
             document->startTransaction(duplicateObjects(inputState) ? "Duplicate Objects" : "Move Objects");
             m_duplicateObjects = duplicateObjects(inputState);
+            m_pendingDelta = vm::vec3::zero();
             return true;
         }
 
@@ -59,7 +64,7 @@ namespace TrenchBroom {
             auto document = kdl::mem_lock(m_document);
             const auto& worldBounds = document->worldBounds();
             const auto bounds = document->selectionBounds();
-            if (!worldBounds.contains(bounds.translate(delta))) {
+            if (!worldBounds.contains(bounds.translate(m_pendingDelta + delta))) {
                 return MR_Deny;
             }
 
@@ -68,21 +73,29 @@ namespace TrenchBroom {
                 document->duplicateObjects();
             }
 
-            if (!document->translateObjects(delta)) {
-                return MR_Deny;
-            } else {
-                return MR_Continue;
-            }
+            m_pendingDelta = m_pendingDelta + delta;
+            document->setSelectionPreviewTransformation(vm::translation_matrix(m_pendingDelta));
+            return MR_Continue;
         }
 
         void MoveObjectsTool::endMove(const InputState&) {
             auto document = kdl::mem_lock(m_document);
-            document->commitTransaction();
+            document->clearSelectionPreviewTransformation();
+
+            // the transaction may contain the duplicated objects, so discard it if they cannot be moved
+            if (m_pendingDelta != vm::vec3::zero() && !document->translateObjects(m_pendingDelta)) {
+                document->cancelTransaction();
+            } else {
+                document->commitTransaction();
+            }
+            m_pendingDelta = vm::vec3::zero();
         }
 
         void MoveObjectsTool::cancelMove() {
             auto document = kdl::mem_lock(m_document);
+            document->clearSelectionPreviewTransformation();
             document->cancelTransaction();
+            m_pendingDelta = vm::vec3::zero();
         }
 
         bool MoveObjectsTool::duplicateObjects(const InputState& inputState) const {
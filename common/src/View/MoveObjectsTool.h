@@ -22,6 +22,8 @@
 #include "FloatType.h"
 #include "View/Tool.h"
 
+#include <vecmath/vec.h>
+
 #include <memory>
 
 namespace TrenchBroom {
@@ -40,6 +42,12 @@ namespace TrenchBroom {
         private:
             std::weak_ptr<MapDocument> m_document;
             bool m_duplicateObjects;
+
+            /*
+             * The objects are only translated when the move ends. Until then, the accumulated delta is shown as a
+             * preview transformation of the selection.
+             */
+            vm::vec3 m_pendingDelta;
         public:
             explicit MoveObjectsTool(std::weak_ptr<MapDocument> document);
         public:
@@ -47,6 +47,12 @@ namespace TrenchBroom {
             }
         }
 
+        void MultiMapView::doInstallFrameScheduler(FrameScheduler& frameScheduler) {
+            for (auto* mapView : m_mapViews) {
+                mapView->installFrameScheduler(frameScheduler);
+            }
+        }
+
         bool MultiMapView::doGetIsCurrent() const {
             for (MapView* mapView : m_mapViews) {
                 if (mapView->isCurrent())
@@ -43,6 +43,7 @@ namespace TrenchBroom {
             void doFlashSelection() override;
         private: // implement MapView interface
             void doInstallActivationTracker(MapViewActivationTracker& activationTracker) override;
+            void doInstallFrameScheduler(FrameScheduler& frameScheduler) override;
             bool doGetIsCurrent() const override;
             MapViewBase* doGetFirstMapViewBase() override;
             bool doCanSelectTall() override;
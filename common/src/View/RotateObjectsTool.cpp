@@ -28,8 +28,12 @@
 #include <kdl/memory_utils.h>
 #include <kdl/vector_utils.h>
 
+#include <vecmath/mat.h>
+#include <vecmath/mat_ext.h>
 #include <vecmath/scalar.h>
 
+#include <utility>
+
 namespace TrenchBroom {
     namespace View {
         RotateObjectsTool::RotateObjectsTool(std::weak_ptr<MapDocument> document) :
@@ -94,17 +98,26 @@ namespace TrenchBroom {
         void RotateObjectsTool::beginRotation() {
             auto document = kdl::mem_lock(m_document);
             document->startTransaction("Rotate Objects");
+            m_pendingRotation = std::nullopt;
         }
 
         void RotateObjectsTool::commitRotation() {
             auto document = kdl::mem_lock(m_document);
+            document->clearSelectionPreviewTransformation();
+            const auto pendingRotation = std::exchange(m_pendingRotation, std::nullopt);
+            if (pendingRotation && !document->rotateObjects(pendingRotation->center, pendingRotation->axis, pendingRotation->angle)) {
+                document->cancelTransaction();
+                return;
+            }
             document->commitTransaction();
             updateRecentlyUsedCenters(rotationCenter());
         }
 
         void RotateObjectsTool::cancelRotation() {
             auto document = kdl::mem_lock(m_document);
+            document->clearSelectionPreviewTransformation();
             document->cancelTransaction();
+            m_pendingRotation = std::nullopt;
         }
 
         FloatType RotateObjectsTool::snapRotationAngle(const FloatType angle) const {
@@ -114,8 +127,10 @@ namespace TrenchBroom {
 
         void RotateObjectsTool::applyRotation(const vm::vec3& center, const vm::vec3& axis, const FloatType angle) {
             auto document = kdl::mem_lock(m_document);
-            document->rollbackTransaction();
-            document->rotateObjects(center, axis, angle);
+            m_pendingRotation = PendingRotation{center, axis, angle};
+
+            const auto transformation = vm::translation_matrix(center) * vm::rotation_matrix(axis, angle) * vm::translation_matrix(-center);
+            document->setSelectionPreviewTransformation(transformation);
         }
 
         Model::Hit RotateObjectsTool::pick2D(const vm::ray3& pickRay, const Renderer::Camera& camera) {
@@ -24,8 +24,10 @@
 #include "View/RotateObjectsHandle.h"
 
 #include <vecmath/forward.h>
+#include <vecmath/vec.h>
 
 #include <memory>
+#include <optional>
 #include <vector>
 
 namespace TrenchBroom {
@@ -47,6 +49,18 @@ namespace TrenchBroom {
             RotateObjectsHandle m_handle;
             double m_angle;
             std::vector<vm::vec3> m_recentlyUsedCenters;
+
+            struct PendingRotation {
+                vm::vec3 center;
+                vm::vec3 axis;
+                FloatType angle;
+            };
+
+            /*
+             * The objects are only rotated when the rotation is committed. Until then, the rotation is shown as a
+             * preview transformation of the selection.
+             */
+            std::optional<PendingRotation> m_pendingRotation;
         public:
             explicit RotateObjectsTool(std::weak_ptr<MapDocument> document);
 
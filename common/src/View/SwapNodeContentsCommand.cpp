@@ -73,5 +73,13 @@ namespace TrenchBroom {
 
             return false;
         }
+
+        size_t SwapNodeContentsCommand::doGetMemoryUsage() const {
+            auto result = sizeof(SwapNodeContentsCommand) + m_nodes.capacity() * sizeof(std::pair<Model::Node*, Model::NodeContents>);
+            for (const auto& [node, contents] : m_nodes) {
+                result += contents.memoryUsage();
+            }
+            return result + m_updateLinkedGroupsHelper.memoryUsage();
+        }
     }
 }
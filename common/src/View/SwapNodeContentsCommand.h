@@ -52,6 +52,7 @@ namespace TrenchBroom {
             std::unique_ptr<CommandResult> doPerformUndo(MapDocumentCommandFacade* document) override;
 
             bool doCollateWith(UndoableCommand* command) override;
+            size_t doGetMemoryUsage() const override;
 
             deleteCopyAndMove(SwapNodeContentsCommand)
         };
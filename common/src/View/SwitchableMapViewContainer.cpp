@@ -25,6 +25,7 @@
 #include "Model/PointFile.h"
 #include "Renderer/MapRenderer.h"
 #include "View/CyclingMapView.h"
+#include "View/FrameScheduler.h"
 #include "View/FourPaneMapView.h"
 #include "View/GLContextManager.h"
 #include "View/Inspector.h"
@@ -41,6 +42,12 @@
 #include <kdl/memory_utils.h>
 
 #include <QGridLayout>
+#include <QGuiApplication>
+#include <QScreen>
+#include <QTimer>
+
+#include <algorithm>
+#include <cmath>
 
 namespace TrenchBroom {
     namespace View {
@@ -53,8 +60,15 @@ namespace TrenchBroom {
         m_toolBox(std::make_unique<MapViewToolBox>(m_document, m_mapViewBar->toolBook())),
         m_mapRenderer(std::make_unique<Renderer::MapRenderer>(m_document)),
         m_mapView(nullptr),
-        m_activationTracker(std::make_unique<MapViewActivationTracker>()) {
+        m_activationTracker(std::make_unique<MapViewActivationTracker>()),
+        m_frameScheduler(std::make_unique<FrameScheduler>([this]() { requestFrame(); })),
+        m_frameTimer(new QTimer(this)) {
             setObjectName("SwitchableMapViewContainer");
+
+            m_frameTimer->setSingleShot(true);
+            connect(m_frameTimer, &QTimer::timeout, this, &SwitchableMapViewContainer::runFrame);
+            m_frameScheduler->addPreparation([this]() { m_mapRenderer->prepareFrame(); });
+
             switchToMapView(static_cast<MapViewLayout>(pref(Preferences::MapViewLayout)));
             connectObservers();
         }
@@ -103,6 +117,7 @@ namespace TrenchBroom {
             }
 
             installActivationTracker(*m_activationTracker);
+            installFrameScheduler(*m_frameScheduler);
 
             auto* layout = new QVBoxLayout();
             layout->setContentsMargins(0, 0, 0, 0);
@@ -115,6 +130,29 @@ namespace TrenchBroom {
             m_mapView->setFocus();
         }
 
+        /**
+         * Paces the frames to the refresh rate of the primary screen. If the last frame is longer ago than one refresh
+         * interval, the next frame runs as soon as control returns to the event loop, which still coalesces all
+         * invalidations caused by the current event.
+         */
+        void SwitchableMapViewContainer::requestFrame() {
+            if (m_frameTimer->isActive()) {
+                return;
+            }
+
+            const auto* screen = QGuiApplication::primaryScreen();
+            const auto refreshRate = screen != nullptr && screen->refreshRate() > 0.0 ? screen->refreshRate() : 60.0;
+            const auto frameInterval = static_cast<qint64>(std::ceil(1000.0 / refreshRate));
+            const auto elapsed = m_lastFrameTime.isValid() ? m_lastFrameTime.elapsed() : frameInterval;
+
+            m_frameTimer->start(static_cast<int>(std::max(qint64(0), frameInterval - elapsed)));
+        }
+
+        void SwitchableMapViewContainer::runFrame() {
+            m_lastFrameTime.start();
+            m_frameScheduler->frame();
+        }
+
         bool SwitchableMapViewContainer::anyToolActive() const {
             return createComplexBrushToolActive() || clipToolActive() || rotateObjectsToolActive() || scaleObjectsToolActive() || shearObjectsToolActive() || anyVertexToolActive();
         }
@@ -307,6 +345,10 @@ namespace TrenchBroom {
             m_mapView->installActivationTracker(activationTracker);
         }
 
+        void SwitchableMapViewContainer::doInstallFrameScheduler(FrameScheduler& frameScheduler) {
+            m_mapView->installFrameScheduler(frameScheduler);
+        }
+
         bool SwitchableMapViewContainer::doGetIsCurrent() const {
             return m_mapView->isCurrent();
         }
@@ -27,8 +27,11 @@
 
 #include <memory>
 
+#include <QElapsedTimer>
 #include <QWidget>
 
+class QTimer;
+
 namespace TrenchBroom {
     class Logger;
 
@@ -40,6 +43,7 @@ namespace TrenchBroom {
         class ClipTool;
         class EdgeTool;
         class FaceTool;
+        class FrameScheduler;
         class GLContextManager;
         class Inspector;
         class MapDocument;
@@ -64,6 +68,10 @@ namespace TrenchBroom {
             MapViewContainer* m_mapView;
             std::unique_ptr<MapViewActivationTracker> m_activationTracker;
 
+            std::unique_ptr<FrameScheduler> m_frameScheduler;
+            QTimer* m_frameTimer;
+            QElapsedTimer m_lastFrameTime;
+
             NotifierConnection m_notifierConnection;
         public:
             SwitchableMapViewContainer(Logger* logger, std::weak_ptr<MapDocument> document, GLContextManager& contextManager, QWidget* parent = nullptr);
@@ -122,10 +130,14 @@ namespace TrenchBroom {
             bool currentViewMaximized() const;
             void toggleMaximizeCurrentView();
         private:
+            void requestFrame();
+            void runFrame();
+
             void connectObservers();
             void refreshViews(Tool& tool);
         private: // implement MapView interface
             void doInstallActivationTracker(MapViewActivationTracker& activationTracker) override;
+            void doInstallFrameScheduler(FrameScheduler& frameScheduler) override;
             bool doGetIsCurrent() const override;
             MapViewBase* doGetFirstMapViewBase() override;
             bool doCanSelectTall() override;
@@ -190,19 +190,27 @@ namespace TrenchBroom {
         }
 
         void TextureBrowser::nodesWereAdded(const std::vector<Model::Node*>&) {
-            reload();
+            if (m_view != nullptr) {
+                m_view->usageCountDidChange();
+            }
         }
 
         void TextureBrowser::nodesWereRemoved(const std::vector<Model::Node*>&) {
-            reload();
+            if (m_view != nullptr) {
+                m_view->usageCountDidChange();
+            }
         }
 
         void TextureBrowser::nodesDidChange(const std::vector<Model::Node*>&) {
-            reload();
+            if (m_view != nullptr) {
+                m_view->usageCountDidChange();
+            }
         }
 
         void TextureBrowser::brushFacesDidChange(const std::vector<Model::BrushFaceHandle>&) {
-            reload();
+            if (m_view != nullptr) {
+                m_view->usageCountDidChange();
+            }
         }
 
         void TextureBrowser::textureCollectionsDidChange() {
@@ -216,6 +224,7 @@ namespace TrenchBroom {
         void TextureBrowser::preferenceDidChange(const IO::Path& path) {
             auto document = kdl::mem_lock(m_document);
             if (path == Preferences::TextureBrowserIconSize.path() ||
+                path == Preferences::BrowserFontSize.path() ||
                 document->isGamePathPreference(path)) {
                 reload();
             } else {
@@ -226,7 +235,7 @@ namespace TrenchBroom {
         void TextureBrowser::reload() {
             if (m_view != nullptr) {
                 updateSelectedTexture();
-                m_view->invalidate();
+                m_view->invalidateTextures();
                 m_view->update();
             }
         }
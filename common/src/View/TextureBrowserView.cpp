@@ -38,6 +38,7 @@
 #include <kdl/memory_utils.h>
 #include <kdl/skip_iterator.h>
 #include <kdl/string_compare.h>
+#include <kdl/string_format.h>
 #include <kdl/vector_utils.h>
 
 #include <vecmath/vec.h>
@@ -66,6 +67,10 @@ namespace TrenchBroom {
         }
 
         TextureBrowserView::~TextureBrowserView() {
+            // Deleting the thumbnails requires a current context
+            // see: http://doc.qt.io/qt-5/qopenglwidget.html#resource-initialization-and-cleanup
+            makeCurrent();
+            m_thumbnails.deleteTextures();
             clear();
         }
 
@@ -83,6 +88,8 @@ namespace TrenchBroom {
                 return;
             }
             m_group = group;
+            // the cell subtitles show the group names
+            m_layoutItems.clear();
             invalidate();
             update();
         }
@@ -124,11 +131,26 @@ namespace TrenchBroom {
             });
         }
 
-        void TextureBrowserView::usageCountDidChange() {
+        void TextureBrowserView::invalidateTextures() {
+            m_foldedNames.clear();
+            m_layoutItems.clear();
+            m_thumbnails.clear();
             invalidate();
+        }
+
+        void TextureBrowserView::usageCountDidChange() {
+            // the cell colors are determined when rendering, so only relayout if the set or the order of the cells
+            // depends on the usage counts
+            if (layoutDependsOnUsageCounts()) {
+                invalidate();
+            }
             update();
         }
 
+        bool TextureBrowserView::layoutDependsOnUsageCounts() const {
+            return m_hideUnused || m_sortOrder == TextureSortOrder::Usage;
+        }
+
         void TextureBrowserView::doInitLayout(Layout& layout) {
             const float scaleFactor = pref(Preferences::TextureBrowserIconSize);
 
@@ -139,6 +161,9 @@ namespace TrenchBroom {
             layout.setTitleMargin(2.0f);
             layout.setCellWidth(scaleFactor * 64.0f, scaleFactor * 64.0f);
             layout.setCellHeight(scaleFactor * 64.0f, scaleFactor * 128.0f);
+
+            // thumbnails are at most as large as the cells, plus some room for high DPI displays
+            m_thumbnails.setMaxSize(static_cast<size_t>(vm::round(scaleFactor * 128.0f)));
         }
 
         void TextureBrowserView::doReloadLayout(Layout& layout) {
@@ -161,6 +186,20 @@ namespace TrenchBroom {
         }
 
         void TextureBrowserView::addTextureToLayout(Layout& layout, const Assets::Texture* texture, const std::string& groupName, const Renderer::FontDescriptor& font) {
+            auto it = m_layoutItems.find(texture);
+            if (it == std::end(m_layoutItems)) {
+                it = m_layoutItems.emplace(texture, createLayoutItem(layout, texture, groupName, font)).first;
+            }
+
+            const auto& item = it->second;
+            layout.addItem(item.cellData,
+                item.itemWidth,
+                item.itemHeight,
+                item.titleWidth,
+                item.titleHeight);
+        }
+
+        TextureLayoutItem TextureBrowserView::createLayoutItem(const Layout& layout, const Assets::Texture* texture, const std::string& groupName, const Renderer::FontDescriptor& font) {
             const float maxCellWidth = layout.maxCellWidth();
 
             const auto  textureName = IO::Path(texture->name()).lastComponent().asString();
@@ -188,11 +227,21 @@ namespace TrenchBroom {
                 groupFont
             };
 
-            layout.addItem(std::move(cellData),
+            return TextureLayoutItem{
+                std::move(cellData),
                 scaledTextureWidth,
                 scaledTextureHeight,
                 maxCellWidth,
-                totalSize.y());
+                totalSize.y()
+            };
+        }
+
+        const std::string& TextureBrowserView::foldedName(const Assets::Texture* texture) const {
+            auto it = m_foldedNames.find(texture);
+            if (it == std::end(m_foldedNames)) {
+                it = m_foldedNames.emplace(texture, kdl::str_to_lower(texture->name())).first;
+            }
+            return it->second;
         }
 
         struct TextureBrowserView::CompareByUsageCount {
@@ -226,12 +275,15 @@ namespace TrenchBroom {
         };
 
         struct TextureBrowserView::MatchName {
-            std::string pattern;
+            const TextureBrowserView& view;
+            std::string foldedPattern;
 
-            explicit MatchName(const std::string& i_pattern) : pattern(i_pattern) {}
+            MatchName(const TextureBrowserView& i_view, const std::string& i_pattern) :
+            view(i_view),
+            foldedPattern(kdl::str_to_lower(i_pattern)) {}
 
             bool operator()(const Assets::Texture* texture) const {
-                return !kdl::ci::str_contains(texture->name(), pattern);
+                return view.foldedName(texture).find(foldedPattern) == std::string::npos;
             }
         };
 
@@ -259,7 +311,7 @@ namespace TrenchBroom {
             if (m_hideUnused)
                 textures = kdl::vec_erase_if(std::move(textures), MatchUsageCount());
             if (!m_filterText.empty())
-                textures = kdl::vec_erase_if(std::move(textures), MatchName(m_filterText));
+                textures = kdl::vec_erase_if(std::move(textures), MatchName(*this, m_filterText));
         }
 
         void TextureBrowserView::sortTextures(std::vector<const Assets::Texture*>& textures) const {
@@ -273,7 +325,11 @@ namespace TrenchBroom {
             }
         }
 
-        void TextureBrowserView::doClear() {}
+        void TextureBrowserView::doClear() {
+            m_foldedNames.clear();
+            m_layoutItems.clear();
+            m_thumbnails.clear();
+        }
 
         void TextureBrowserView::doRender(Layout& layout, const float y, const float height) {
             auto doc = kdl::mem_lock(m_document);
@@ -349,35 +405,49 @@ namespace TrenchBroom {
             shader.set("Texture", 0);
             shader.set("Brightness", pref(Preferences::Brightness));
 
-            size_t num = 0;
-
+            auto visibleCells = std::vector<const Cell*>{};
             for (const auto& group : layout.groups()) {
                 if (group.intersectsY(y, height)) {
                     for (const auto& row : group.rows()) {
                         if (row.intersectsY(y, height)) {
                             for (const auto& cell : row.cells()) {
-                                const LayoutBounds& bounds = cell.itemBounds();
-                                const Assets::Texture* texture = cellData(cell).texture;
+                                visibleCells.push_back(&cell);
+                            }
+                        }
+                    }
+                }
+            }
 
-                                Renderer::VertexArray vertexArray = Renderer::VertexArray::move(std::vector<TextureVertex>({
-                                    TextureVertex(vm::vec2f(bounds.left(),  height - (bounds.top() - y)),    vm::vec2f(0.0f, 0.0f)),
-                                    TextureVertex(vm::vec2f(bounds.left(),  height - (bounds.bottom() - y)), vm::vec2f(0.0f, 1.0f)),
-                                    TextureVertex(vm::vec2f(bounds.right(), height - (bounds.bottom() - y)), vm::vec2f(1.0f, 1.0f)),
-                                    TextureVertex(vm::vec2f(bounds.right(), height - (bounds.top() - y)),    vm::vec2f(1.0f, 0.0f))
-                                }));
+            m_thumbnails.prepare(kdl::vec_transform(visibleCells, [&](const Cell* cell) {
+                return cellData(*cell).texture;
+            }));
 
-                                shader.set("GrayScale", texture->overridden());
-                                texture->activate();
+            for (const auto* cell : visibleCells) {
+                const LayoutBounds& bounds = cell->itemBounds();
+                const Assets::Texture* texture = cellData(*cell).texture;
 
-                                vertexArray.prepare(vboManager());
-                                vertexArray.render(Renderer::PrimType::Quads);
+                Renderer::VertexArray vertexArray = Renderer::VertexArray::move(std::vector<TextureVertex>({
+                    TextureVertex(vm::vec2f(bounds.left(),  height - (bounds.top() - y)),    vm::vec2f(0.0f, 0.0f)),
+                    TextureVertex(vm::vec2f(bounds.left(),  height - (bounds.bottom() - y)), vm::vec2f(0.0f, 1.0f)),
+                    TextureVertex(vm::vec2f(bounds.right(), height - (bounds.bottom() - y)), vm::vec2f(1.0f, 1.0f)),
+                    TextureVertex(vm::vec2f(bounds.right(), height - (bounds.top() - y)),    vm::vec2f(1.0f, 0.0f))
+                }));
 
-                                texture->deactivate();
+                shader.set("GrayScale", texture->overridden());
 
-                                ++num;
-                            }
-                        }
-                    }
+                // fall back to the texture itself if its data was uploaded already
+                const auto useThumbnail = m_thumbnails.activate(*texture);
+                if (!useThumbnail) {
+                    texture->activate();
+                }
+
+                vertexArray.prepare(vboManager());
+                vertexArray.render(Renderer::PrimType::Quads);
+
+                if (useThumbnail) {
+                    m_thumbnails.deactivate();
+                } else {
+                    texture->deactivate();
                 }
             }
         }
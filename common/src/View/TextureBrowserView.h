@@ -20,6 +20,7 @@
 #pragma once
 
 #include "NotifierConnection.h"
+#include "Assets/TextureThumbnailCache.h"
 #include "Renderer/FontDescriptor.h"
 #include "Renderer/GLVertexType.h"
 #include "View/CellView.h"
@@ -27,6 +28,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 class QScrollBar;
@@ -52,6 +54,14 @@ namespace TrenchBroom {
             Renderer::FontDescriptor subTitleFont;
         };
 
+        struct TextureLayoutItem {
+            TextureCellData cellData;
+            float itemWidth;
+            float itemHeight;
+            float titleWidth;
+            float titleHeight;
+        };
+
         enum class TextureSortOrder {
             Name,
             Usage
@@ -71,6 +81,13 @@ namespace TrenchBroom {
 
             const Assets::Texture* m_selectedTexture;
 
+            // Per texture data that does not depend on the filter, sort order or usage counts. Measuring the cell titles
+            // is the most expensive part of a layout, so it is only done once per texture, and the filter runs on
+            // case folded names.
+            mutable std::unordered_map<const Assets::Texture*, std::string> m_foldedNames;
+            std::unordered_map<const Assets::Texture*, TextureLayoutItem> m_layoutItems;
+            Assets::TextureThumbnailCache m_thumbnails;
+
             NotifierConnection m_notifierConnection;
         public:
             TextureBrowserView(QScrollBar* scrollBar,
@@ -87,12 +104,21 @@ namespace TrenchBroom {
             void setSelectedTexture(const Assets::Texture* selectedTexture);
 
             void revealTexture(const Assets::Texture* texture);
-        private:
+
+            /**
+             * Discards all cached per texture data and invalidates the layout. Must be called whenever the textures
+             * are reloaded or the preferences that affect the size of the cells change.
+             */
+            void invalidateTextures();
             void usageCountDidChange();
+        private:
+            bool layoutDependsOnUsageCounts() const;
 
             void doInitLayout(Layout& layout) override;
             void doReloadLayout(Layout& layout) override;
             void addTextureToLayout(Layout& layout, const Assets::Texture* texture, const std::string& groupName, const Renderer::FontDescriptor& font);
+            TextureLayoutItem createLayoutItem(const Layout& layout, const Assets::Texture* texture, const std::string& groupName, const Renderer::FontDescriptor& font);
+            const std::string& foldedName(const Assets::Texture* texture) const;
 
             struct CompareByUsageCount;
             struct CompareByName;
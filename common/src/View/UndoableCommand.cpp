@@ -20,6 +20,7 @@
 #include "UndoableCommand.h"
 
 #include "Exceptions.h"
+#include "MemoryReport.h"
 #include "View/MapDocumentCommandFacade.h"
 
 #include <string>
@@ -64,5 +65,13 @@ namespace TrenchBroom {
             }
             return false;
         }
+
+        size_t UndoableCommand::memoryUsage() const {
+            return heapMemoryUsage(name()) + doGetMemoryUsage();
+        }
+
+        size_t UndoableCommand::doGetMemoryUsage() const {
+            return sizeof(UndoableCommand);
+        }
     }
 }
@@ -41,11 +41,23 @@ namespace TrenchBroom {
             virtual std::unique_ptr<CommandResult> performUndo(MapDocumentCommandFacade* document);
 
             virtual bool collateWith(UndoableCommand* command);
+
+            /**
+             * Returns the number of bytes allocated for this command and the data it keeps in order to be undone or
+             * redone, such as snapshots of node contents or removed nodes.
+             */
+            size_t memoryUsage() const;
         private:
             virtual std::unique_ptr<CommandResult> doPerformUndo(MapDocumentCommandFacade* document) = 0;
 
             virtual bool doCollateWith(UndoableCommand* command) = 0;
 
+            /**
+             * Returns the number of bytes allocated for the undo data of this command. Commands which only keep a few
+             * pointers or flags don't need to override this.
+             */
+            virtual size_t doGetMemoryUsage() const;
+
             deleteCopyAndMove(UndoableCommand)
         };
     }
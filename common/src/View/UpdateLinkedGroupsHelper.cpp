@@ -102,6 +102,22 @@ namespace TrenchBroom {
             }
         }
 
+        size_t UpdateLinkedGroupsHelper::memoryUsage() const {
+            return std::visit(kdl::overload(
+                [](const LinkedGroupsToUpdate& linkedGroupsToUpdate) {
+                    return linkedGroupsToUpdate.capacity() * sizeof(LinkedGroupsToUpdate::value_type);
+                },
+                [](const LinkedGroupUpdates& linkedGroupUpdates) {
+                    auto result = linkedGroupUpdates.capacity() * sizeof(LinkedGroupUpdates::value_type);
+                    for (const auto& [groupNode, nodes] : linkedGroupUpdates) {
+                        result += nodes.capacity() * sizeof(std::unique_ptr<Model::Node>);
+                        result += Model::computeMemoryUsageRecursively(kdl::vec_transform(nodes, [](const auto& node) { return node.get(); }));
+                    }
+                    return result;
+                }
+            ), m_state);
+        }
+
         kdl::result<void, Model::UpdateLinkedGroupsError> UpdateLinkedGroupsHelper::computeLinkedGroupUpdates(MapDocumentCommandFacade& document) {
             return std::visit(kdl::overload(
                 [&](const LinkedGroupsToUpdate& linkedGroups) {
@@ -67,6 +67,12 @@ namespace TrenchBroom {
             kdl::result<void, Model::UpdateLinkedGroupsError> applyLinkedGroupUpdates(MapDocumentCommandFacade& document);
             void undoLinkedGroupUpdates(MapDocumentCommandFacade& document);
             void collateWith(UpdateLinkedGroupsHelper& other);
+
+            /**
+             * Returns the number of bytes allocated for the nodes that are kept by this helper in order to undo or redo
+             * the linked group updates.
+             */
+            size_t memoryUsage() const;
         private:
             kdl::result<void, Model::UpdateLinkedGroupsError> computeLinkedGroupUpdates(MapDocumentCommandFacade& document);
             static kdl::result<LinkedGroupUpdates, Model::UpdateLinkedGroupsError> computeLinkedGroupUpdates(const LinkedGroupsToUpdate& linkedGroupsToUpdate, const vm::bbox3& worldBounds);
@@ -22,8 +22,10 @@
 #include <vecmath/vec.h>
 #include <vecmath/ray.h>
 
+#include <random>
 #include <set>
 #include <sstream>
+#include <vector>
 
 #include "Catch2.h"
 
@@ -137,6 +139,19 @@ O [ ( -1 -1 -1 ) ( 2 1 1 ) ]
         assertTreeContains(tree, bounds2, 2u);
     }
 
+    TEST_CASE("AABBTreeTest.memoryUsage", "[AABBTreeTest]") {
+        AABB tree;
+        const auto emptySize = tree.memoryUsage();
+        CHECK(emptySize >= sizeof(AABB));
+
+        tree.insert(BOX(VEC(0.0, 0.0, 0.0), VEC(2.0, 1.0, 1.0)), 1u);
+        const auto oneNodeSize = tree.memoryUsage();
+        CHECK(oneNodeSize > emptySize);
+
+        tree.insert(BOX(VEC(-1.0, -1.0, -1.0), VEC(1.0, 1.0, 1.0)), 2u);
+        CHECK(tree.memoryUsage() > oneNodeSize);
+    }
+
     TEST_CASE("AABBTreeTest.insertThreeNodes", "[AABBTreeTest]") {
         const BOX bounds1(VEC(0.0, 0.0, 0.0), VEC(2.0, 1.0, 1.0));
         const BOX bounds2(VEC(-1.0, -1.0, -1.0), VEC(1.0, 1.0, 1.0));
@@ -529,6 +544,65 @@ L [ ( -1 -1 -1 ) ( 1 1 1 ) ]: 1
         assertIntersectors(tree, RAY(VEC(0.0,  0.0,  0.0), VEC::pos_x()), { 2u });
     }
 
+    TEST_CASE("AABBTreeTest.findContainersOfBox", "[AABBTreeTest]") {
+        AABB tree;
+        CHECK(tree.findContainers(BOX(VEC(0.0, 0.0, 0.0), VEC(1.0, 1.0, 1.0))).empty());
+
+        tree.insert(BOX(VEC(-4.0, -4.0, -4.0), VEC(+4.0, +4.0, +4.0)), 1u);
+        tree.insert(BOX(VEC(-1.0, -1.0, -1.0), VEC(+1.0, +1.0, +1.0)), 2u);
+        tree.insert(BOX(VEC(-1.0, -1.0, -1.0), VEC(+1.0, +1.0, +1.0)), 3u);
+        tree.insert(BOX(VEC(+2.0, +2.0, +2.0), VEC(+3.0, +3.0, +3.0)), 4u);
+
+        CHECK_THAT(tree.findContainers(BOX(VEC(-1.0, -1.0, -1.0), VEC(+1.0, +1.0, +1.0))), Catch::UnorderedEquals(std::vector<size_t>{ 1u, 2u, 3u }));
+        CHECK_THAT(tree.findContainers(BOX(VEC(0.0, 0.0, 0.0), VEC(2.0, 2.0, 2.0))), Catch::UnorderedEquals(std::vector<size_t>{ 1u }));
+        CHECK_THAT(tree.findContainers(BOX(VEC(2.5, 2.5, 2.5), VEC(3.0, 3.0, 3.0))), Catch::UnorderedEquals(std::vector<size_t>{ 1u, 4u }));
+        CHECK(tree.findContainers(BOX(VEC(0.0, 0.0, 0.0), VEC(5.0, 5.0, 5.0))).empty());
+    }
+
+    TEST_CASE("AABBTreeTest.findContained", "[AABBTreeTest]") {
+        AABB tree;
+        CHECK(tree.findContained(BOX(VEC(0.0, 0.0, 0.0), VEC(1.0, 1.0, 1.0))).empty());
+
+        tree.insert(BOX(VEC(-4.0, -4.0, -4.0), VEC(+4.0, +4.0, +4.0)), 1u);
+        tree.insert(BOX(VEC(-1.0, -1.0, -1.0), VEC(+1.0, +1.0, +1.0)), 2u);
+        tree.insert(BOX(VEC(-1.0, -1.0, -1.0), VEC(+1.0, +1.0, +1.0)), 3u);
+        tree.insert(BOX(VEC(+2.0, +2.0, +2.0), VEC(+3.0, +3.0, +3.0)), 4u);
+
+        CHECK_THAT(tree.findContained(BOX(VEC(-1.0, -1.0, -1.0), VEC(+1.0, +1.0, +1.0))), Catch::UnorderedEquals(std::vector<size_t>{ 2u, 3u }));
+        CHECK_THAT(tree.findContained(BOX(VEC(-2.0, -2.0, -2.0), VEC(+3.0, +3.0, +3.0))), Catch::UnorderedEquals(std::vector<size_t>{ 2u, 3u, 4u }));
+        CHECK_THAT(tree.findContained(BOX(VEC(-4.0, -4.0, -4.0), VEC(+4.0, +4.0, +4.0))), Catch::UnorderedEquals(std::vector<size_t>{ 1u, 2u, 3u, 4u }));
+        CHECK(tree.findContained(BOX(VEC(0.0, 0.0, 0.0), VEC(2.0, 2.0, 2.0))).empty());
+    }
+
+    TEST_CASE("AABBTreeTest.findIntersectorsOfBox", "[AABBTreeTest]") {
+        AABB tree;
+        CHECK(tree.findIntersectors(BOX(VEC(0.0, 0.0, 0.0), VEC(1.0, 1.0, 1.0))).empty());
+
+        tree.insert(BOX(VEC(-4.0, -4.0, -4.0), VEC(-2.0, -2.0, -2.0)), 1u);
+        tree.insert(BOX(VEC(-1.0, -1.0, -1.0), VEC(+1.0, +1.0, +1.0)), 2u);
+        tree.insert(BOX(VEC(+2.0, +2.0, +2.0), VEC(+3.0, +3.0, +3.0)), 3u);
+
+        CHECK_THAT(tree.findIntersectors(BOX(VEC(0.0, 0.0, 0.0), VEC(2.0, 2.0, 2.0))), Catch::UnorderedEquals(std::vector<size_t>{ 2u, 3u }));
+        CHECK_THAT(tree.findIntersectors(BOX(VEC(-5.0, -5.0, -5.0), VEC(5.0, 5.0, 5.0))), Catch::UnorderedEquals(std::vector<size_t>{ 1u, 2u, 3u }));
+        CHECK_THAT(tree.findIntersectors(BOX(VEC(-3.0, -3.0, -3.0), VEC(-2.5, -2.5, -2.5))), Catch::UnorderedEquals(std::vector<size_t>{ 1u }));
+        CHECK(tree.findIntersectors(BOX(VEC(4.0, 4.0, 4.0), VEC(5.0, 5.0, 5.0))).empty());
+    }
+
+    TEST_CASE("AABBTreeTest.boundsOf", "[AABBTreeTest]") {
+        const BOX bounds(VEC(-1.0, -1.0, -1.0), VEC(+1.0, +1.0, +1.0));
+
+        AABB tree;
+        CHECK(tree.boundsOf(1u) == std::nullopt);
+
+        tree.insert(bounds, 1u);
+        CHECK(tree.boundsOf(1u) == bounds);
+        CHECK(tree.boundsOf(2u) == std::nullopt);
+
+        const BOX newBounds(VEC(0.0, -1.0, -1.0), VEC(2.0, 1.0, 1.0));
+        tree.update(newBounds, 1u);
+        CHECK(tree.boundsOf(1u) == newBounds);
+    }
+
     TEST_CASE("AABBTreeTest.clear", "[AABBTreeTest]") {
         const BOX bounds1(VEC(0.0, 0.0, 0.0), VEC(2.0, 1.0, 1.0));
         const BOX bounds2(VEC(-1.0, -1.0, -1.0), VEC(1.0, 1.0, 1.0));
@@ -550,4 +624,89 @@ L [ ( -1 -1 -1 ) ( 1 1 1 ) ]: 1
         CHECK_FALSE(tree.contains(2u));
         REQUIRE_THAT(tree.findContainers(vm::vec3d{0.5, 0.5, 0.5}), Catch::UnorderedEquals(std::vector<size_t>{}));
     }
+
+    static BOX randomBox(std::mt19937& rng, const double extent) {
+        auto position = std::uniform_real_distribution<double>(-extent, extent);
+        auto size = std::uniform_real_distribution<double>(1.0, 32.0);
+
+        const auto min = VEC(position(rng), position(rng), position(rng));
+        return BOX(min, min + VEC(size(rng), size(rng), size(rng)));
+    }
+
+    static BOX randomMove(std::mt19937& rng, const BOX& bounds) {
+        // mostly small moves that keep nodes in place, but sometimes a node is moved far away
+        auto jump = std::uniform_int_distribution<int>(0, 9);
+        auto offset = std::uniform_real_distribution<double>(-8.0, 8.0);
+        if (jump(rng) == 0) {
+            return randomBox(rng, 1024.0);
+        }
+        const auto delta = VEC(offset(rng), offset(rng), offset(rng));
+        return BOX(bounds.min + delta, bounds.max + delta);
+    }
+
+    static void assertSameQueryResults(std::mt19937& rng, const AABB& tree, const std::vector<BOX>& bounds) {
+        auto expected = AABB{};
+        for (size_t i = 0; i < bounds.size(); ++i) {
+            expected.insert(bounds[i], i);
+        }
+
+        REQUIRE(tree.bounds() == expected.bounds());
+        for (size_t i = 0; i < bounds.size(); ++i) {
+            REQUIRE(tree.boundsOf(i) == bounds[i]);
+        }
+
+        for (size_t i = 0; i < 50; ++i) {
+            const auto query = randomBox(rng, 1024.0);
+            CHECK_THAT(tree.findIntersectors(query), Catch::UnorderedEquals(expected.findIntersectors(query)));
+            CHECK_THAT(tree.findContainers(query.center()), Catch::UnorderedEquals(expected.findContainers(query.center())));
+            CHECK_THAT(tree.findContained(query), Catch::UnorderedEquals(expected.findContained(query)));
+        }
+    }
+
+    TEST_CASE("AABBTreeTest.updateRandomMoves", "[AABBTreeTest]") {
+        auto rng = std::mt19937(42u);
+
+        auto bounds = std::vector<BOX>{};
+        auto tree = AABB{};
+        for (size_t i = 0; i < 500; ++i) {
+            bounds.push_back(randomBox(rng, 1024.0));
+            tree.insert(bounds.back(), i);
+        }
+
+        SECTION("update") {
+            for (size_t round = 0; round < 10; ++round) {
+                for (size_t j = 0; j < 100; ++j) {
+                    const auto i = std::uniform_int_distribution<size_t>(0, bounds.size() - 1)(rng);
+                    bounds[i] = randomMove(rng, bounds[i]);
+                    tree.update(bounds[i], i);
+                }
+                assertSameQueryResults(rng, tree, bounds);
+            }
+        }
+
+        SECTION("updateAll") {
+            for (size_t round = 0; round < 10; ++round) {
+                auto moved = std::vector<size_t>{};
+                for (size_t j = 0; j < 100; ++j) {
+                    const auto i = std::uniform_int_distribution<size_t>(0, bounds.size() - 1)(rng);
+                    bounds[i] = randomMove(rng, bounds[i]);
+                    // duplicates are allowed
+                    moved.push_back(i);
+                }
+                tree.updateAll(moved, [&](const size_t i) { return bounds[i]; });
+                assertSameQueryResults(rng, tree, bounds);
+            }
+        }
+    }
+
+    TEST_CASE("AABBTreeTest.updateAllWithUnknownData", "[AABBTreeTest]") {
+        const BOX bounds(VEC(-1.0, -1.0, -1.0), VEC(+1.0, +1.0, +1.0));
+        const BOX newBounds(VEC(0.0, -1.0, -1.0), VEC(2.0, 1.0, 1.0));
+
+        AABB tree;
+        tree.insert(bounds, 1u);
+
+        CHECK_THROWS_AS(tree.updateAll(std::vector<size_t>{ 1u, 2u }, [&](const size_t) { return newBounds; }), NodeTreeException);
+        CHECK(tree.boundsOf(1u) == bounds);
+    }
 }
@@ -0,0 +1,172 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Color.h"
+#include "Assets/Texture.h"
+#include "Assets/TextureBuffer.h"
+#include "Assets/TextureResidency.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom {
+    namespace Assets {
+        class MockBackend : public TextureResidency::Backend {
+        private:
+            std::vector<std::string>& m_log;
+        public:
+            explicit MockBackend(std::vector<std::string>& log) :
+            m_log{log} {}
+
+            void upload(const Texture& texture) override {
+                m_log.push_back("upload " + texture.name());
+            }
+
+            void evict(const Texture& texture) override {
+                m_log.push_back("evict " + texture.name());
+            }
+        };
+
+        static Texture makeMaskedTexture(const std::string& name) {
+            // masked textures have no mipmaps, so each of these textures occupies 16 * 16 * 4 = 1024 bytes
+            return Texture{name, 16, 16, Color{}, TextureBuffer{16 * 16 * 4}, GL_RGBA, TextureType::Masked};
+        }
+
+        TEST_CASE("TextureResidencyTest.residentSize") {
+            CHECK(makeMaskedTexture("masked").residentSize() == 1024u);
+            CHECK(Texture{"opaque", 16, 16, Color{}, TextureBuffer{16 * 16 * 4}, GL_RGBA, TextureType::Opaque}.residentSize() == 4u * (256u + 64u + 16u + 4u + 1u));
+            CHECK(Texture{"empty", 16, 16}.residentSize() == 0u);
+        }
+
+        TEST_CASE("TextureResidencyTest.uploadOnFirstUse") {
+            auto log = std::vector<std::string>{};
+            auto residency = TextureResidency{std::make_unique<MockBackend>(log), 0u};
+
+            const auto t1 = makeMaskedTexture("t1");
+            const auto t2 = makeMaskedTexture("t2");
+
+            CHECK_FALSE(residency.resident(t1));
+            CHECK(log.empty());
+
+            residency.use(t1);
+            residency.use(t1);
+            residency.use(t2);
+
+            CHECK(residency.resident(t1));
+            CHECK(residency.resident(t2));
+            CHECK(log == std::vector<std::string>{"upload t1", "upload t2"});
+
+            const auto& stats = residency.stats();
+            CHECK(stats.residentCount == 2u);
+            CHECK(stats.residentBytes == 2048u);
+            CHECK(stats.peakResidentBytes == 2048u);
+            CHECK(stats.uploadCount == 2u);
+            CHECK(stats.evictionCount == 0u);
+        }
+
+        TEST_CASE("TextureResidencyTest.evictLeastRecentlyUsed") {
+            auto log = std::vector<std::string>{};
+            auto residency = TextureResidency{std::make_unique<MockBackend>(log), 2048u};
+
+            const auto t1 = makeMaskedTexture("t1");
+            const auto t2 = makeMaskedTexture("t2");
+            const auto t3 = makeMaskedTexture("t3");
+
+            residency.use(t1);
+            residency.use(t2);
+            residency.use(t1);
+            residency.use(t3);
+
+            CHECK(residency.resident(t1));
+            CHECK_FALSE(residency.resident(t2));
+            CHECK(residency.resident(t3));
+            CHECK(log == std::vector<std::string>{"upload t1", "upload t2", "upload t3", "evict t2"});
+
+            residency.use(t2);
+            CHECK(log == std::vector<std::string>{"upload t1", "upload t2", "upload t3", "evict t2", "upload t2", "evict t1"});
+
+            const auto& stats = residency.stats();
+            CHECK(stats.residentCount == 2u);
+            CHECK(stats.residentBytes == 2048u);
+            CHECK(stats.peakResidentBytes == 3072u);
+            CHECK(stats.uploadCount == 4u);
+            CHECK(stats.evictionCount == 2u);
+        }
+
+        TEST_CASE("TextureResidencyTest.neverEvictMostRecentlyUsed") {
+            auto log = std::vector<std::string>{};
+            auto residency = TextureResidency{std::make_unique<MockBackend>(log), 512u};
+
+            const auto t1 = makeMaskedTexture("t1");
+            const auto t2 = makeMaskedTexture("t2");
+
+            residency.use(t1);
+            CHECK(residency.resident(t1));
+
+            residency.use(t2);
+            CHECK_FALSE(residency.resident(t1));
+            CHECK(residency.resident(t2));
+            CHECK(log == std::vector<std::string>{"upload t1", "upload t2", "evict t1"});
+        }
+
+        TEST_CASE("TextureResidencyTest.setBudget") {
+            auto log = std::vector<std::string>{};
+            auto residency = TextureResidency{std::make_unique<MockBackend>(log), 0u};
+
+            const auto t1 = makeMaskedTexture("t1");
+            const auto t2 = makeMaskedTexture("t2");
+            const auto t3 = makeMaskedTexture("t3");
+
+            residency.use(t1);
+            residency.use(t2);
+            residency.use(t3);
+
+            residency.setBudget(1024u);
+            CHECK(residency.stats().budget == 1024u);
+            CHECK(log == std::vector<std::string>{"upload t1", "upload t2", "upload t3"});
+
+            residency.use(t3);
+            CHECK(log == std::vector<std::string>{"upload t1", "upload t2", "upload t3", "evict t1", "evict t2"});
+            CHECK(residency.stats().residentBytes == 1024u);
+        }
+
+        TEST_CASE("TextureResidencyTest.release") {
+            auto log = std::vector<std::string>{};
+            auto residency = TextureResidency{std::make_unique<MockBackend>(log), 0u};
+
+            const auto t1 = makeMaskedTexture("t1");
+            const auto t2 = makeMaskedTexture("t2");
+
+            residency.use(t1);
+            residency.release(t1);
+            residency.release(t2);
+
+            CHECK_FALSE(residency.resident(t1));
+            CHECK(log == std::vector<std::string>{"upload t1", "evict t1"});
+
+            const auto& stats = residency.stats();
+            CHECK(stats.residentCount == 0u);
+            CHECK(stats.residentBytes == 0u);
+            CHECK(stats.evictionCount == 0u);
+        }
+    }
+}
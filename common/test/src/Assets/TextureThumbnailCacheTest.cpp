@@ -0,0 +1,78 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Color.h"
+#include "Assets/Texture.h"
+#include "Assets/TextureBuffer.h"
+#include "Assets/TextureThumbnailCache.h"
+
+#include <algorithm>
+#include <optional>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom {
+    namespace Assets {
+        static TextureBuffer makeBuffer(const size_t width, const size_t height, const unsigned char value) {
+            auto buffer = TextureBuffer{width * height * 4u};
+            std::fill_n(buffer.data(), buffer.size(), value);
+            return buffer;
+        }
+
+        TEST_CASE("TextureThumbnailCacheTest.makeTextureThumbnail") {
+            SECTION("Texture without data") {
+                CHECK(makeTextureThumbnail(Texture{"empty", 16, 16}, 8u) == std::nullopt);
+            }
+
+            SECTION("Texture smaller than the thumbnail size") {
+                const auto texture = Texture{"small", 4, 4, Color{}, makeBuffer(4, 4, 1), GL_RGBA, TextureType::Masked};
+                const auto thumbnail = makeTextureThumbnail(texture, 8u);
+                REQUIRE(thumbnail != std::nullopt);
+                CHECK(thumbnail->width == 4u);
+                CHECK(thumbnail->height == 4u);
+                CHECK(thumbnail->format == GLenum(GL_RGBA));
+                CHECK(thumbnail->pixels == std::vector<unsigned char>(4u * 4u * 4u, 1));
+            }
+
+            SECTION("Uses the largest mip level that fits") {
+                auto buffers = Texture::BufferList{};
+                buffers.push_back(makeBuffer(16, 16, 1));
+                buffers.push_back(makeBuffer(8, 8, 2));
+                buffers.push_back(makeBuffer(4, 4, 3));
+                const auto texture = Texture{"mipmapped", 16, 16, Color{}, std::move(buffers), GL_RGBA, TextureType::Opaque};
+
+                const auto thumbnail = makeTextureThumbnail(texture, 8u);
+                REQUIRE(thumbnail != std::nullopt);
+                CHECK(thumbnail->width == 8u);
+                CHECK(thumbnail->height == 8u);
+                CHECK(thumbnail->pixels == std::vector<unsigned char>(8u * 8u * 4u, 2));
+            }
+
+            SECTION("Downsamples if no mip level fits") {
+                const auto texture = Texture{"wide", 32, 8, Color{}, makeBuffer(32, 8, 1), GL_RGBA, TextureType::Masked};
+                const auto thumbnail = makeTextureThumbnail(texture, 8u);
+                REQUIRE(thumbnail != std::nullopt);
+                CHECK(thumbnail->width == 8u);
+                CHECK(thumbnail->height == 2u);
+                CHECK(thumbnail->pixels == std::vector<unsigned char>(8u * 2u * 4u, 1));
+            }
+        }
+    }
+}
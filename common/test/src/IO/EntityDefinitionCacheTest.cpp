@@ -0,0 +1,93 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Logger.h"
+#include "Assets/EntityDefinition.h"
+#include "IO/EntityDefinitionCache.h"
+#include "IO/EntityDefinitionClassInfo.h"
+#include "IO/EntityDefinitionParser.h"
+#include "IO/Path.h"
+#include "IO/TestParserStatus.h"
+
+#include <kdl/vector_utils.h>
+
+#include <string>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom {
+    namespace IO {
+        class CountingEntityDefinitionParser : public EntityDefinitionParser {
+        private:
+            size_t& m_parseCount;
+        public:
+            explicit CountingEntityDefinitionParser(size_t& parseCount) :
+            EntityDefinitionParser(Color()),
+            m_parseCount(parseCount) {}
+
+            std::vector<EntityDefinitionClassInfo> parseClassInfos(ParserStatus& status) override {
+                ++m_parseCount;
+                status.warn(1, "some warning");
+                return {
+                    { EntityDefinitionClassType::PointClass, 0, 0, "point", std::nullopt, std::nullopt, std::nullopt, std::nullopt, {}, {} }
+                };
+            }
+        };
+
+        static std::vector<std::string> loadDefinitionNames(EntityDefinitionCache& cache, size_t& parseCount, const std::string& contents, ParserStatus& status) {
+            auto parser = CountingEntityDefinitionParser(parseCount);
+            auto definitions = cache.loadDefinitions(parser, Path("/some/file.def"), contents, status);
+            auto names = kdl::vec_transform(definitions, [](const auto* definition) { return definition->name(); });
+            kdl::vec_clear_and_delete(definitions);
+            return names;
+        }
+
+        TEST_CASE("EntityDefinitionCache.loadDefinitions", "[EntityDefinitionCache]") {
+            auto cache = EntityDefinitionCache();
+            auto parseCount = size_t(0);
+
+            auto status = TestParserStatus();
+            CHECK(loadDefinitionNames(cache, parseCount, "contents", status) == std::vector<std::string>{"point"});
+            CHECK(parseCount == 1u);
+            CHECK(status.countStatus(LogLevel::Warn) == 1u);
+            CHECK(cache.size() == 1u);
+
+            SECTION("Unchanged contents use the cached class infos and replay the messages") {
+                auto otherStatus = TestParserStatus();
+                CHECK(loadDefinitionNames(cache, parseCount, "contents", otherStatus) == std::vector<std::string>{"point"});
+                CHECK(parseCount == 1u);
+                CHECK(otherStatus.countStatus(LogLevel::Warn) == 1u);
+            }
+
+            SECTION("Changed contents are parsed again") {
+                CHECK(loadDefinitionNames(cache, parseCount, "other contents", status) == std::vector<std::string>{"point"});
+                CHECK(parseCount == 2u);
+                CHECK(cache.size() == 1u);
+            }
+
+            SECTION("Clearing the cache") {
+                cache.clear();
+                CHECK(cache.size() == 0u);
+                loadDefinitionNames(cache, parseCount, "contents", status);
+                CHECK(parseCount == 2u);
+            }
+        }
+    }
+}
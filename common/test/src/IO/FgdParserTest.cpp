@@ -21,6 +21,7 @@
 #include "Assets/EntityDefinitionTestUtils.h"
 #include "Assets/PropertyDefinition.h"
 #include "IO/DiskIO.h"
+#include "IO/EntityDefinitionClassInfo.h"
 #include "IO/FgdParser.h"
 #include "IO/File.h"
 #include "IO/FileMatcher.h"
@@ -32,6 +33,7 @@
 
 #include <algorithm>
 #include <string>
+#include <vector>
 
 #include "Catch2.h"
 
@@ -880,6 +882,38 @@ model({"path"
             kdl::vec_clear_and_delete(defs);
         }
 
+        TEST_CASE("FgdParserTest.parseMultipleIncludes", "[FgdParserTest]") {
+            const Path path = Disk::getCurrentWorkingDir() + Path("fixture/test/IO/Fgd/parseMultipleIncludes/host.fgd");
+            auto file = Disk::openFile(path);
+            auto reader = file->reader().buffer();
+
+            const Color defaultColor(1.0f, 1.0f, 1.0f, 1.0f);
+            FgdParser parser(reader.stringView(), defaultColor, file->path());
+            EntityDefinitionParser& entityDefinitionParser = parser;
+
+            // the included files are parsed in parallel, but their class infos must be in include order
+            TestParserStatus status;
+            const auto classInfos = entityDefinitionParser.parseClassInfos(status);
+            const auto classnames = kdl::vec_transform(classInfos, [](const auto& classInfo) { return classInfo.name; });
+            CHECK(classnames == std::vector<std::string>{
+                "worldspawn",
+                "info_player_start",
+                "info_player_deathmatch",
+                "info_player_coop",
+                "info_null",
+                "info_teleport_destination",
+                "light"
+            });
+            CHECK(status.countStatus(LogLevel::Error) == 0u);
+
+            const auto basePath = file->path().deleteLastComponent();
+            CHECK(parser.includedFiles() == std::vector<Path>{
+                basePath + Path("first.fgd"),
+                basePath + Path("nested/third.fgd"),
+                basePath + Path("second.fgd")
+            });
+        }
+
         TEST_CASE("FgdParserTest.parseRecursiveInclude", "[FgdParserTest]") {
             const Path path = Disk::getCurrentWorkingDir() + Path("fixture/test/IO/Fgd/parseRecursiveInclude/host.fgd");
             auto file = Disk::openFile(path);
@@ -0,0 +1,195 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "IO/MapStreamConverter.h"
+#include "IO/TestParserStatus.h"
+#include "IO/WorldReader.h"
+#include "Model/BrushNode.h"
+#include "Model/EntityNode.h"
+#include "Model/EntityProperties.h"
+#include "Model/LayerNode.h"
+#include "Model/MapFormat.h"
+#include "Model/WorldNode.h"
+
+#include <vecmath/bbox.h>
+
+#include <sstream>
+#include <string>
+
+#include "TestUtils.h"
+#include "Catch2.h"
+
+namespace TrenchBroom {
+    namespace IO {
+        static const std::string StandardMap = R"(
+{
+"classname" "worldspawn"
+{
+( -0 -0 -16 ) ( -0 -0  -0 ) ( 64 -0 -16 ) none 0 0 0 1 1
+( -0 -0 -16 ) ( -0 64 -16 ) ( -0 -0  -0 ) none 0 0 0 1 1
+( -0 -0 -16 ) ( 64 -0 -16 ) ( -0 64 -16 ) none 0 0 0 1 1
+( 64 64  -0 ) ( -0 64  -0 ) ( 64 64 -16 ) none 0 0 0 1 1
+( 64 64  -0 ) ( 64 64 -16 ) ( 64 -0  -0 ) none 0 0 0 1 1
+( 64 64  -0 ) ( 64 -0  -0 ) ( -0 64  -0 ) none 0 0 0 1 1
+}
+{
+( -0 -0 -16 ) ( -0 -0  -0 ) ( 64 -0 -16 ) none 0 0 0 1 1
+( -0 -0 -16 ) ( -0 64 -16 ) ( -0 -0  -0 ) none 0 0 0 1 1
+( -0 -0 -16 ) ( 64 -0 -16 ) ( -0 64 -16 ) none 0 0 0 1 1
+( 64 64  -0 ) ( -0 64  -0 ) ( 64 64 -16 ) none 0 0 0 1 1
+( 64 64  -0 ) ( 64 64 -16 ) ( 64 -0  -0 ) none 0 0 0 1 1
+( 64 64  -0 ) ( 64 -0  -0 ) ( -0 64  -0 ) none 0 0 0 1 1
+}
+{
+( -0 -0 -16 ) ( -0 -0  -0 ) ( 64 -0 -16 ) none 0 0 0 1 1
+( -0 -0 -16 ) ( -0 64 -16 ) ( -0 -0  -0 ) none 0 0 0 1 1
+( -0 -0 -16 ) ( 64 -0 -16 ) ( -0 64 -16 ) none 0 0 0 1 1
+( 64 64  -0 ) ( -0 64  -0 ) ( 64 64 -16 ) none 0 0 0 1 1
+( 64 64  -0 ) ( 64 64 -16 ) ( 64 -0  -0 ) none 0 0 0 1 1
+( 64 64  -0 ) ( 64 -0  -0 ) ( -0 64  -0 ) none 0 0 0 1 1
+}
+}
+{
+"classname" "func_door"
+"speed" "100"
+{
+( -0 -0 -16 ) ( -0 -0  -0 ) ( 64 -0 -16 ) none 0 0 0 1 1
+( -0 -0 -16 ) ( -0 64 -16 ) ( -0 -0  -0 ) none 0 0 0 1 1
+( -0 -0 -16 ) ( 64 -0 -16 ) ( -0 64 -16 ) none 0 0 0 1 1
+( 64 64  -0 ) ( -0 64  -0 ) ( 64 64 -16 ) none 0 0 0 1 1
+( 64 64  -0 ) ( 64 64 -16 ) ( 64 -0  -0 ) none 0 0 0 1 1
+( 64 64  -0 ) ( 64 -0  -0 ) ( -0 64  -0 ) none 0 0 0 1 1
+}
+}
+)";
+
+        TEST_CASE("MapStreamConverterTest.convertStandardToValve", "[MapStreamConverterTest]") {
+            const auto worldBounds = vm::bbox3{8192.0};
+
+            // a chunk size of 1 forces the worldspawn brushes to be written in several chunks
+            const auto chunkSize = GENERATE(size_t(1), size_t(2), MapStreamConverter::DefaultChunkSize);
+            CAPTURE(chunkSize);
+
+            auto stream = std::stringstream{};
+            auto convertStatus = TestParserStatus{};
+            auto converter = MapStreamConverter{StandardMap, Model::MapFormat::Standard, Model::MapFormat::Valve, stream, chunkSize};
+            converter.convert(worldBounds, convertStatus);
+            CHECK(convertStatus.countStatus(LogLevel::Error) == 0u);
+
+            const auto output = stream.str();
+            auto readStatus = TestParserStatus{};
+            auto reader = WorldReader{output, Model::MapFormat::Valve, {}};
+            auto world = reader.read(worldBounds, readStatus);
+            REQUIRE(world != nullptr);
+
+            const auto* valveVersion = world->entity().property(Model::EntityPropertyKeys::ValveVersion);
+            REQUIRE(valveVersion != nullptr);
+            CHECK(*valveVersion == "220");
+
+            const auto* defaultLayer = world->defaultLayer();
+            REQUIRE(defaultLayer->childCount() == 4u);
+            for (size_t i = 0u; i < 3u; ++i) {
+                const auto* brushNode = dynamic_cast<const Model::BrushNode*>(defaultLayer->children()[i]);
+                REQUIRE(brushNode != nullptr);
+                checkBrushTexCoordSystem(brushNode, true);
+            }
+
+            const auto* entityNode = dynamic_cast<const Model::EntityNode*>(defaultLayer->children()[3]);
+            REQUIRE(entityNode != nullptr);
+            CHECK(entityNode->entity().classname() == "func_door");
+            const auto* speed = entityNode->entity().property("speed");
+            REQUIRE(speed != nullptr);
+            CHECK(*speed == "100");
+            REQUIRE(entityNode->childCount() == 1u);
+
+            const auto* brushNode = dynamic_cast<const Model::BrushNode*>(entityNode->children().front());
+            REQUIRE(brushNode != nullptr);
+            checkBrushTexCoordSystem(brushNode, true);
+        }
+
+        TEST_CASE("MapStreamConverterTest.convertValveToStandard", "[MapStreamConverterTest]") {
+            const auto worldBounds = vm::bbox3{8192.0};
+
+            auto valveStream = std::stringstream{};
+            auto toValveStatus = TestParserStatus{};
+            auto toValve = MapStreamConverter{StandardMap, Model::MapFormat::Standard, Model::MapFormat::Valve, valveStream};
+            toValve.convert(worldBounds, toValveStatus);
+            REQUIRE(toValveStatus.countStatus(LogLevel::Error) == 0u);
+
+            const auto valveMap = valveStream.str();
+            auto standardStream = std::stringstream{};
+            auto toStandardStatus = TestParserStatus{};
+            auto toStandard = MapStreamConverter{valveMap, Model::MapFormat::Valve, Model::MapFormat::Standard, standardStream};
+            toStandard.convert(worldBounds, toStandardStatus);
+            CHECK(toStandardStatus.countStatus(LogLevel::Error) == 0u);
+
+            const auto output = standardStream.str();
+            auto readStatus = TestParserStatus{};
+            auto reader = WorldReader{output, Model::MapFormat::Standard, {}};
+            auto world = reader.read(worldBounds, readStatus);
+            REQUIRE(world != nullptr);
+
+            CHECK(world->entity().property(Model::EntityPropertyKeys::ValveVersion) == nullptr);
+
+            const auto* defaultLayer = world->defaultLayer();
+            REQUIRE(defaultLayer->childCount() == 4u);
+            for (size_t i = 0u; i < 3u; ++i) {
+                const auto* brushNode = dynamic_cast<const Model::BrushNode*>(defaultLayer->children()[i]);
+                REQUIRE(brushNode != nullptr);
+                checkBrushTexCoordSystem(brushNode, false);
+            }
+        }
+
+        TEST_CASE("MapStreamConverterTest.skipInvalidBrush", "[MapStreamConverterTest]") {
+            const auto data = R"(
+{
+"classname" "worldspawn"
+{
+( -0 -0 -16 ) ( -0 -0  -0 ) ( 64 -0 -16 ) none 0 0 0 1 1
+( -0 -0 -16 ) ( -0 64 -16 ) ( -0 -0  -0 ) none 0 0 0 1 1
+}
+{
+( -0 -0 -16 ) ( -0 -0  -0 ) ( 64 -0 -16 ) none 0 0 0 1 1
+( -0 -0 -16 ) ( -0 64 -16 ) ( -0 -0  -0 ) none 0 0 0 1 1
+( -0 -0 -16 ) ( 64 -0 -16 ) ( -0 64 -16 ) none 0 0 0 1 1
+( 64 64  -0 ) ( -0 64  -0 ) ( 64 64 -16 ) none 0 0 0 1 1
+( 64 64  -0 ) ( 64 64 -16 ) ( 64 -0  -0 ) none 0 0 0 1 1
+( 64 64  -0 ) ( 64 -0  -0 ) ( -0 64  -0 ) none 0 0 0 1 1
+}
+}
+)";
+
+            const auto worldBounds = vm::bbox3{8192.0};
+
+            auto stream = std::stringstream{};
+            auto convertStatus = TestParserStatus{};
+            auto converter = MapStreamConverter{data, Model::MapFormat::Standard, Model::MapFormat::Valve, stream};
+            converter.convert(worldBounds, convertStatus);
+            CHECK(convertStatus.countStatus(LogLevel::Error) == 1u);
+
+            const auto output = stream.str();
+            auto readStatus = TestParserStatus{};
+            auto reader = WorldReader{output, Model::MapFormat::Valve, {}};
+            auto world = reader.read(worldBounds, readStatus);
+            REQUIRE(world != nullptr);
+            CHECK(world->defaultLayer()->childCount() == 1u);
+        }
+    }
+}
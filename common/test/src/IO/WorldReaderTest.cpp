@@ -1604,5 +1604,33 @@ common/caulk
             REQUIRE(world != nullptr);
             CHECK(world->mapFormat() == Model::MapFormat::Standard);
         }
+
+        TEST_CASE("WorldReaderTest.tryReadConvertsToTargetFormat", "[WorldReaderTest]") {
+            const auto data = R"(
+{
+"classname" "worldspawn"
+{
+( -0 -0 -16 ) ( -0 -0  -0 ) ( 64 -0 -16 ) none 0 0 0 1 1
+( -0 -0 -16 ) ( -0 64 -16 ) ( -0 -0  -0 ) none 0 0 0 1 1
+( -0 -0 -16 ) ( 64 -0 -16 ) ( -0 64 -16 ) none 0 0 0 1 1
+( 64 64  -0 ) ( -0 64  -0 ) ( 64 64 -16 ) none 0 0 0 1 1
+( 64 64  -0 ) ( 64 64 -16 ) ( 64 -0  -0 ) none 0 0 0 1 1
+( 64 64  -0 ) ( 64 -0  -0 ) ( -0 64  -0 ) none 0 0 0 1 1
+}
+}
+            )";
+
+            const vm::bbox3 worldBounds(8192.0);
+
+            IO::TestParserStatus status;
+            auto world = WorldReader::tryRead(data, { Model::MapFormat::Standard }, Model::MapFormat::Valve, worldBounds, {}, status);
+            REQUIRE(world != nullptr);
+            CHECK(world->mapFormat() == Model::MapFormat::Valve);
+
+            REQUIRE(world->defaultLayer()->childCount() == 1u);
+            const auto* brushNode = dynamic_cast<Model::BrushNode*>(world->defaultLayer()->children().front());
+            REQUIRE(brushNode != nullptr);
+            checkBrushTexCoordSystem(brushNode, true);
+        }
     }
 }
@@ -0,0 +1,89 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MemoryReport.h"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom {
+    TEST_CASE("MemoryReportTest.totalBytes", "[MemoryReportTest]") {
+        auto report = MemoryReport{};
+        CHECK(report.totalBytes() == 0u);
+
+        report.addSubsystem("Brushes", 2u, 1024u);
+        report.addSubsystem("Entities", 1u, 256u);
+        CHECK(report.totalBytes() == 1280u);
+        CHECK(report.subsystems().size() == 2u);
+        CHECK(report.subsystems().front().name == "Brushes");
+        CHECK(report.subsystems().front().count == 2u);
+    }
+
+    TEST_CASE("MemoryReportTest.addBreakdown", "[MemoryReportTest]") {
+        auto report = MemoryReport{};
+        report.addBreakdown("Largest", {
+            MemoryUsage{"a", 1u, 10u},
+            MemoryUsage{"b", 1u, 30u},
+            MemoryUsage{"c", 1u, 20u},
+            MemoryUsage{"d", 1u, 5u},
+        }, 2u);
+
+        REQUIRE(report.breakdowns().size() == 1u);
+        const auto& [name, items] = report.breakdowns().front();
+        CHECK(name == "Largest");
+        REQUIRE(items.size() == 2u);
+        CHECK(items[0].name == "b");
+        CHECK(items[1].name == "c");
+
+        // breakdowns don't count towards the total
+        CHECK(report.totalBytes() == 0u);
+    }
+
+    TEST_CASE("MemoryReportTest.heapMemoryUsage", "[MemoryReportTest]") {
+        CHECK(heapMemoryUsage(std::string{}) == 0u);
+
+        const auto longString = std::string(256u, 'x');
+        CHECK(heapMemoryUsage(longString) > 256u);
+    }
+
+    TEST_CASE("MemoryReportTest.formatMemorySize", "[MemoryReportTest]") {
+        CHECK(formatMemorySize(0u) == "0 B");
+        CHECK(formatMemorySize(1023u) == "1023 B");
+        CHECK(formatMemorySize(1024u) == "1.0 KiB");
+        CHECK(formatMemorySize(1536u) == "1.5 KiB");
+        CHECK(formatMemorySize(3u * 1024u * 1024u) == "3.0 MiB");
+    }
+
+    TEST_CASE("MemoryReportTest.print", "[MemoryReportTest]") {
+        auto report = MemoryReport{};
+        report.addSubsystem("Brushes", 2u, 2048u);
+        report.addBreakdown("Largest nodes", { MemoryUsage{"brush (line 3)", 1u, 1024u} }, 10u);
+
+        auto str = std::stringstream{};
+        str << report;
+        CHECK(str.str() == R"(Memory usage: 2.0 KiB
+  Brushes: 2.0 KiB (2 objects)
+Largest nodes:
+  brush (line 3): 1.0 KiB
+)");
+    }
+}
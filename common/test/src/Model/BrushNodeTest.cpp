@@ -281,6 +281,59 @@ namespace TrenchBroom {
             CHECK(hits2.empty());
         }
 
+        TEST_CASE("BrushNodeTest.compactGeometryIfUnused", "[BrushNodeTest]") {
+            const vm::bbox3 worldBounds(4096.0);
+            const auto editorContext = EditorContext{};
+            const BrushBuilder builder(MapFormat::Standard, worldBounds);
+
+            BrushNode brushNode(builder.createCuboid(vm::bbox3(vm::vec3(0, 0, 0), vm::vec3(16, 16, 16)), "texture").value());
+
+            // a new brush counts as used, so it is only compacted on the second attempt
+            CHECK_FALSE(brushNode.compactGeometryIfUnused());
+            CHECK(brushNode.compactGeometryIfUnused());
+            CHECK(brushNode.brushWithoutRestoringGeometry().geometryCompacted());
+            CHECK(brushNode.logicalBounds() == vm::bbox3(vm::vec3(0, 0, 0), vm::vec3(16, 16, 16)));
+
+            SECTION("Picking does not restore the geometry") {
+                PickResult misses;
+                brushNode.pick(editorContext, vm::ray3(vm::vec3(8.0, -8.0, 8.0), vm::vec3::neg_y()), misses);
+                CHECK(misses.empty());
+                CHECK(brushNode.brushWithoutRestoringGeometry().geometryCompacted());
+
+                PickResult hits;
+                brushNode.pick(editorContext, vm::ray3(vm::vec3(8.0, -8.0, 8.0), vm::vec3::pos_y()), hits);
+                REQUIRE(hits.size() == 1u);
+
+                const auto hit = hits.all().front();
+                CHECK(hit.distance() == vm::approx(8.0));
+                CHECK(hitToFaceHandle(hit)->face().boundary().normal == vm::vec3::neg_y());
+                CHECK(brushNode.brushWithoutRestoringGeometry().geometryCompacted());
+            }
+
+            SECTION("Reading the brush does not restore the geometry") {
+                CHECK(brushNode.brushWithoutRestoringGeometry().faceCount() == 6u);
+                CHECK(brushNode.brushWithoutRestoringGeometry().containsPoint(vm::vec3(8, 8, 8)));
+                CHECK(brushNode.brushWithoutRestoringGeometry().geometryCompacted());
+            }
+
+            SECTION("Restoring the geometry") {
+                brushNode.restoreGeometry();
+                CHECK(brushNode.brush().vertexCount() == 8u);
+                CHECK_FALSE(brushNode.brushWithoutRestoringGeometry().geometryCompacted());
+
+                // the brush was used, so it is not compacted again right away
+                CHECK_FALSE(brushNode.compactGeometryIfUnused());
+            }
+
+            SECTION("Selected brushes are not compacted") {
+                brushNode.restoreGeometry();
+                brushNode.select();
+                CHECK_FALSE(brushNode.compactGeometryIfUnused());
+                CHECK_FALSE(brushNode.compactGeometryIfUnused());
+                CHECK_FALSE(brushNode.brushWithoutRestoringGeometry().geometryCompacted());
+            }
+        }
+
         TEST_CASE("BrushNodeTest.clone", "[BrushNodeTest]") {
             const vm::bbox3 worldBounds(4096.0);
 
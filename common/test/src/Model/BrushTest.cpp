@@ -39,6 +39,8 @@
 #include <kdl/vector_utils.h>
 
 #include <vecmath/approx.h>
+#include <vecmath/mat.h>
+#include <vecmath/mat_ext.h>
 #include <vecmath/polygon.h>
 #include <vecmath/ray.h>
 #include <vecmath/segment.h>
@@ -222,6 +224,47 @@ namespace TrenchBroom {
             CHECK(!canMoveBoundary(brush1, worldBounds, *rightFaceIndex, vm::vec3(8000, 0, 0)));
         }
 
+        TEST_CASE("BrushTest.compactAndRestoreGeometry", "[BrushTest]") {
+            const vm::bbox3 worldBounds(8192.0);
+            const BrushBuilder builder(MapFormat::Standard, worldBounds);
+
+            const Brush original = builder.createBrush(std::vector<vm::vec3>{vm::vec3(64, -64, 16), vm::vec3(64, 64, 16), vm::vec3(64, -64, -16), vm::vec3(64, 64, -16), vm::vec3(48, 64, 16), vm::vec3(48, 64, -16)}, "texture").value();
+
+            Brush brush = original;
+            brush.compactGeometry();
+            CHECK(brush.geometryCompacted());
+            REQUIRE(brush.compactedGeometry() != nullptr);
+            CHECK(brush.memoryUsage() < original.memoryUsage());
+            CHECK(brush.bounds() == original.bounds());
+            CHECK(brush.faceCount() == original.faceCount());
+            CHECK(brush.containsPoint(vm::vec3(60, 0, 0)));
+            CHECK_FALSE(brush.containsPoint(vm::vec3(40, 0, 0)));
+
+            const Brush copy = brush;
+            CHECK(copy.geometryCompacted());
+
+            // transforming a compacted brush rebuilds its geometry from the faces
+            Brush translated = copy;
+            REQUIRE(translated.transform(worldBounds, vm::translation_matrix(vm::vec3(16, 0, 0)), false).is_success());
+            CHECK_FALSE(translated.geometryCompacted());
+            CHECK(translated.bounds() == vm::bbox3(original.bounds().min + vm::vec3(16, 0, 0), original.bounds().max + vm::vec3(16, 0, 0)));
+
+            brush.restoreGeometry();
+            CHECK_FALSE(brush.geometryCompacted());
+            CHECK(brush.compactedGeometry() == nullptr);
+            CHECK(brush == original);
+            CHECK(brush.vertexCount() == original.vertexCount());
+            CHECK(brush.edgeCount() == original.edgeCount());
+            CHECK_THAT(brush.vertexPositions(), Catch::UnorderedEquals(original.vertexPositions()));
+            for (size_t i = 0u; i < brush.faceCount(); ++i) {
+                CHECK_THAT(brush.face(i).vertexPositions(), Catch::Equals(original.face(i).vertexPositions()));
+            }
+
+            // the restored geometry can be modified
+            CHECK(brush.moveVertices(worldBounds, {vm::vec3(48, 64, 16), vm::vec3(48, 64, -16)}, vm::vec3(-16, 0, 0)).is_success());
+            CHECK(brush.hasVertex(vm::vec3(32, 64, 16)));
+        }
+
         TEST_CASE("BrushTest.expand", "[BrushTest]") {
             const vm::bbox3 worldBounds(8192.0);
             const BrushBuilder builder(MapFormat::Standard, worldBounds);
@@ -0,0 +1,191 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "FloatType.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushGeometry.h"
+#include "Model/ConvexPolyhedronSnapshot.h"
+#include "Model/MapFormat.h"
+#include "Model/Polyhedron.h"
+
+#include <kdl/result.h>
+
+#include <vecmath/bbox.h>
+#include <vecmath/vec.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom {
+    namespace Model {
+        static ConvexPolyhedronSnapshot makeSnapshot(const vm::bbox3& bounds) {
+            return ConvexPolyhedronSnapshot(BrushGeometry(bounds));
+        }
+
+        TEST_CASE("ConvexPolyhedronSnapshotTest.constructor", "[ConvexPolyhedronSnapshotTest]") {
+            const auto snapshot = makeSnapshot(vm::bbox3(vm::vec3(0, 0, 0), vm::vec3(16, 16, 16)));
+
+            CHECK(snapshot.vertices().size() == 8u);
+            CHECK(snapshot.facePlanes().size() == 6u);
+            // the twelve edges of a cuboid have three directions
+            CHECK(snapshot.edgeVectors().size() == 3u);
+            CHECK(snapshot.bounds() == vm::bbox3(vm::vec3(0, 0, 0), vm::vec3(16, 16, 16)));
+        }
+
+        TEST_CASE("ConvexPolyhedronSnapshotTest.intersects", "[ConvexPolyhedronSnapshotTest]") {
+            const auto cube = makeSnapshot(vm::bbox3(vm::vec3(0, 0, 0), vm::vec3(16, 16, 16)));
+
+            CHECK(cube.intersects(cube));
+            CHECK(cube.intersects(makeSnapshot(vm::bbox3(vm::vec3(8, 8, 8), vm::vec3(24, 24, 24)))));
+            CHECK(cube.intersects(makeSnapshot(vm::bbox3(vm::vec3(4, 4, 4), vm::vec3(12, 12, 12)))));
+
+            // touching faces, edges and vertices, just like Polyhedron::intersects
+            CHECK_FALSE(BrushGeometry(vm::bbox3(vm::vec3(0, 0, 0), vm::vec3(16, 16, 16))).intersects(BrushGeometry(vm::bbox3(vm::vec3(16, 0, 0), vm::vec3(32, 16, 16)))));
+            CHECK_FALSE(cube.intersects(makeSnapshot(vm::bbox3(vm::vec3(16, 0, 0), vm::vec3(32, 16, 16)))));
+            CHECK_FALSE(cube.intersects(makeSnapshot(vm::bbox3(vm::vec3(16, 16, 0), vm::vec3(32, 32, 16)))));
+            CHECK_FALSE(cube.intersects(makeSnapshot(vm::bbox3(vm::vec3(16, 16, 16), vm::vec3(32, 32, 32)))));
+
+            // disjoint bounds
+            CHECK_FALSE(cube.intersects(makeSnapshot(vm::bbox3(vm::vec3(32, 0, 0), vm::vec3(48, 16, 16)))));
+
+            // the bounds intersect, but the tetrahedron is separated by the diagonal face of the wedge
+            const auto wedge = ConvexPolyhedronSnapshot(BrushGeometry({
+                vm::vec3(0, 0, 0), vm::vec3(16, 0, 0), vm::vec3(0, 16, 0),
+                vm::vec3(0, 0, 16), vm::vec3(16, 0, 16), vm::vec3(0, 16, 16)}));
+            const auto tetrahedron = ConvexPolyhedronSnapshot(BrushGeometry({
+                vm::vec3(16, 16, 0), vm::vec3(10, 16, 0), vm::vec3(16, 10, 0), vm::vec3(16, 16, 8)}));
+            CHECK_FALSE(wedge.intersects(tetrahedron));
+            CHECK_FALSE(tetrahedron.intersects(wedge));
+        }
+
+        TEST_CASE("ConvexPolyhedronSnapshotTest.contains", "[ConvexPolyhedronSnapshotTest]") {
+            const auto cube = makeSnapshot(vm::bbox3(vm::vec3(0, 0, 0), vm::vec3(16, 16, 16)));
+
+            CHECK(cube.contains(cube));
+            CHECK(cube.contains(makeSnapshot(vm::bbox3(vm::vec3(4, 4, 4), vm::vec3(12, 12, 12)))));
+            CHECK(cube.contains(makeSnapshot(vm::bbox3(vm::vec3(0, 0, 0), vm::vec3(8, 8, 8)))));
+            CHECK_FALSE(cube.contains(makeSnapshot(vm::bbox3(vm::vec3(8, 8, 8), vm::vec3(24, 24, 24)))));
+            CHECK_FALSE(makeSnapshot(vm::bbox3(vm::vec3(4, 4, 4), vm::vec3(12, 12, 12))).contains(cube));
+        }
+
+        static BrushGeometry makeRandomPolyhedron(std::mt19937& random) {
+            // the points are offset from a random center by up to a random extent of 1 to 8 units on each axis; the
+            // centers and extents are chosen so that intersecting, disjoint and nested pairs are all common
+            const auto randomCoord = [&](const std::uint32_t range) {
+                return static_cast<FloatType>(random() % (2u * range + 1u)) - static_cast<FloatType>(range);
+            };
+
+            while (true) {
+                const auto center = vm::vec3(randomCoord(8u), randomCoord(8u), randomCoord(8u));
+                const auto extent = 1u + random() % 8u;
+                const auto pointCount = 4u + random() % 5u;
+
+                auto points = std::vector<vm::vec3>{};
+                for (size_t i = 0u; i < pointCount; ++i) {
+                    points.push_back(center + vm::vec3(randomCoord(extent), randomCoord(extent), randomCoord(extent)));
+                }
+
+                auto geometry = BrushGeometry(std::move(points));
+                if (geometry.polyhedron()) {
+                    return geometry;
+                }
+            }
+        }
+
+        TEST_CASE("ConvexPolyhedronSnapshotTest.agreesWithPolyhedron", "[ConvexPolyhedronSnapshotTest]") {
+            auto random = std::mt19937{};
+
+            auto intersectionCount = size_t(0);
+            auto containmentCount = size_t(0);
+            for (size_t i = 0u; i < 2000u; ++i) {
+                const auto lhs = makeRandomPolyhedron(random);
+                const auto rhs = makeRandomPolyhedron(random);
+                const auto lhsSnapshot = ConvexPolyhedronSnapshot(lhs);
+                const auto rhsSnapshot = ConvexPolyhedronSnapshot(rhs);
+
+                const auto intersects = lhs.intersects(rhs);
+                CHECK(lhsSnapshot.intersects(rhsSnapshot) == intersects);
+                CHECK(rhsSnapshot.intersects(lhsSnapshot) == intersects);
+                CHECK(lhsSnapshot.contains(rhsSnapshot) == lhs.contains(rhs));
+                CHECK(rhsSnapshot.contains(lhsSnapshot) == rhs.contains(lhs));
+
+                if (intersects) {
+                    ++intersectionCount;
+                }
+                if (lhs.contains(rhs) || rhs.contains(lhs)) {
+                    ++containmentCount;
+                }
+            }
+
+            // make sure that the corpus covers all cases
+            CHECK(intersectionCount > 0u);
+            CHECK(intersectionCount < 2000u);
+            CHECK(containmentCount > 0u);
+        }
+
+        TEST_CASE("ConvexPolyhedronSnapshotTest.touchingAgreesWithPolyhedron", "[ConvexPolyhedronSnapshotTest]") {
+            auto random = std::mt19937{};
+
+            for (size_t i = 0u; i < 500u; ++i) {
+                // mirror a random polyhedron at one of its face planes to obtain a polyhedron which touches it in that face
+                const auto lhs = makeRandomPolyhedron(random);
+                const auto& plane = lhs.faces().front()->plane();
+
+                auto points = std::vector<vm::vec3>{};
+                for (const BrushVertex* vertex : lhs.vertices()) {
+                    const auto& position = vertex->position();
+                    points.push_back(position - 2.0 * plane.point_distance(position) * plane.normal);
+                }
+                const auto rhs = BrushGeometry(std::move(points));
+                REQUIRE(rhs.polyhedron());
+
+                // touching polyhedra do not intersect, neither for the polyhedron nor for the snapshot
+                CHECK_FALSE(lhs.intersects(rhs));
+                CHECK_FALSE(ConvexPolyhedronSnapshot(lhs).intersects(ConvexPolyhedronSnapshot(rhs)));
+                CHECK_FALSE(ConvexPolyhedronSnapshot(rhs).intersects(ConvexPolyhedronSnapshot(lhs)));
+            }
+        }
+
+        TEST_CASE("ConvexPolyhedronSnapshotTest.compactedBrushes", "[ConvexPolyhedronSnapshotTest]") {
+            const auto worldBounds = vm::bbox3(8192.0);
+            const auto builder = BrushBuilder(MapFormat::Standard, worldBounds);
+
+            auto outer = builder.createCuboid(vm::bbox3(vm::vec3(0, 0, 0), vm::vec3(32, 32, 32)), "texture").value();
+            auto inner = builder.createCuboid(vm::bbox3(vm::vec3(8, 8, 8), vm::vec3(16, 16, 16)), "texture").value();
+            auto touching = builder.createCuboid(vm::bbox3(vm::vec3(32, 0, 0), vm::vec3(64, 32, 32)), "texture").value();
+
+            outer.compactGeometry();
+            inner.compactGeometry();
+
+            CHECK(outer.intersects(inner));
+            CHECK(outer.contains(inner));
+            CHECK_FALSE(inner.contains(outer));
+            CHECK_FALSE(outer.intersects(touching));
+            CHECK_FALSE(touching.intersects(outer));
+
+            CHECK(outer.geometryCompacted());
+            CHECK(inner.geometryCompacted());
+        }
+    }
+}
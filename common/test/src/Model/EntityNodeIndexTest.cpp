@@ -176,6 +176,53 @@ namespace TrenchBroom {
         }
 
 
+        TEST_CASE("EntityNodeIndexTest.linkProperties", "[EntityNodeIndexTest]") {
+            EntityNodeIndex index;
+
+            EntityNode* source = new EntityNode({}, {
+                {"target", "door"},
+                {"target2", "door"},
+                {"killtarget3", "light"}
+            });
+
+            EntityNode* target = new EntityNode({}, {
+                {"targetname", "door"}
+            });
+
+            index.addEntityNode(source);
+            index.addEntityNode(target);
+
+            CHECK_THAT(findNumberedExact(index, "target", "door"), Catch::Equals(std::vector<EntityNodeBase*>{ source }));
+            CHECK_THAT(findNumberedExact(index, "killtarget", "light"), Catch::Equals(std::vector<EntityNodeBase*>{ source }));
+            CHECK_THAT(findExactExact(index, "targetname", "door"), Catch::Equals(std::vector<EntityNodeBase*>{ target }));
+
+            // exact queries must not match numbered keys
+            CHECK(findExactExact(index, "killtarget", "light").empty());
+            CHECK(findNumberedExact(index, "targetname", "door").empty());
+            CHECK(findNumberedExact(index, "target", "light").empty());
+
+            SECTION("Removing one of several numbered keys with the same value keeps the node") {
+                index.removeProperty(source, "target", "door");
+                source->setEntity(Entity({}, {
+                    {"target2", "door"},
+                    {"killtarget3", "light"}
+                }));
+                CHECK_THAT(findNumberedExact(index, "target", "door"), Catch::Equals(std::vector<EntityNodeBase*>{ source }));
+
+                index.removeProperty(source, "target2", "door");
+                CHECK(findNumberedExact(index, "target", "door").empty());
+            }
+
+            SECTION("Removing a node removes its link properties") {
+                index.removeEntityNode(target);
+                CHECK(findExactExact(index, "targetname", "door").empty());
+            }
+
+            delete source;
+            delete target;
+        }
+
+
         TEST_CASE("EntityNodeIndexTest.addRemoveFloatProperty", "[EntityNodeIndexTest]") {
             EntityNodeIndex index;
 
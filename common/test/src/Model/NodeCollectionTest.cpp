@@ -386,6 +386,53 @@ namespace TrenchBroom {
             }
         }
 
+        TEST_CASE("NodeCollection.removeNodes") {
+            const auto mapFormat = MapFormat::Quake3;
+            const auto worldBounds = vm::bbox3{8192.0};
+
+            auto layerNode = LayerNode{Layer{"layer"}};
+            auto groupNode = GroupNode{Group{"group"}};
+            auto entityNode = EntityNode{Entity{}};
+            auto brushNode1 = BrushNode{BrushBuilder{mapFormat, worldBounds}.createCube(64.0, "texture").value()};
+            auto brushNode2 = BrushNode{BrushBuilder{mapFormat, worldBounds}.createCube(64.0, "texture").value()};
+            auto brushNode3 = BrushNode{BrushBuilder{mapFormat, worldBounds}.createCube(64.0, "texture").value()};
+            auto patchNode = PatchNode{BezierPatch{3, 3, {
+                {0, 0, 0}, {1, 0, 1}, {2, 0, 0},
+                {0, 1, 1}, {1, 1, 2}, {2, 1, 1},
+                {0, 2, 0}, {1, 2, 1}, {2, 2, 0} }, "texture"}};
+
+            auto nodeCollection = NodeCollection{};
+            nodeCollection.addNodes({&layerNode, &brushNode1, &groupNode, &brushNode2, &entityNode, &brushNode3, &patchNode});
+
+            SECTION("Remove nothing") {
+                nodeCollection.removeNodes({});
+                CHECK(nodeCollection.nodes() == std::vector<Node*>{&layerNode, &brushNode1, &groupNode, &brushNode2, &entityNode, &brushNode3, &patchNode});
+            }
+
+            SECTION("Remaining nodes retain their order") {
+                nodeCollection.removeNodes({&brushNode2, &layerNode, &patchNode});
+                CHECK(nodeCollection.nodes() == std::vector<Node*>{&brushNode1, &groupNode, &entityNode, &brushNode3});
+                CHECK(nodeCollection.layers() == std::vector<LayerNode*>{});
+                CHECK(nodeCollection.groups() == std::vector<GroupNode*>{&groupNode});
+                CHECK(nodeCollection.entities() == std::vector<EntityNode*>{&entityNode});
+                CHECK(nodeCollection.brushes() == std::vector<BrushNode*>{&brushNode1, &brushNode3});
+                CHECK(nodeCollection.patches() == std::vector<PatchNode*>{});
+            }
+
+            SECTION("Nodes not in the collection are ignored") {
+                auto otherBrushNode = BrushNode{BrushBuilder{mapFormat, worldBounds}.createCube(64.0, "texture").value()};
+                nodeCollection.removeNodes({&otherBrushNode, &brushNode1, &brushNode1});
+                CHECK(nodeCollection.nodes() == std::vector<Node*>{&layerNode, &groupNode, &brushNode2, &entityNode, &brushNode3, &patchNode});
+                CHECK(nodeCollection.brushes() == std::vector<BrushNode*>{&brushNode2, &brushNode3});
+            }
+
+            SECTION("Remove all nodes") {
+                nodeCollection.removeNodes({&patchNode, &brushNode3, &entityNode, &brushNode2, &groupNode, &brushNode1, &layerNode});
+                CHECK(nodeCollection.empty());
+                CHECK(nodeCollection.brushes() == std::vector<BrushNode*>{});
+            }
+        }
+
         TEST_CASE("NodeCollection.clear") {
             const auto mapFormat = MapFormat::Quake3;
             const auto worldBounds = vm::bbox3{8192.0};
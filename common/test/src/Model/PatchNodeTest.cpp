@@ -145,6 +145,30 @@ namespace TrenchBroom {
             CHECK(makePatchGrid(BezierPatch{r, c, controlPoints, "texture"}, sd).points == kdl::vec_transform(expectedPoints, [](const auto& p) { return vm::approx{p}; }));
         }
 
+        TEST_CASE("PatchNode.setPatchWithPrecomputedGrid") {
+            using P = BezierPatch::Point;
+            const auto flatPatch = BezierPatch{3, 3, {
+                P{0, 2, 0}, P{1, 2, 0}, P{2, 2, 0},
+                P{0, 1, 0}, P{1, 1, 0}, P{2, 1, 0},
+                P{0, 0, 0}, P{1, 0, 0}, P{2, 0, 0},
+            }, "texture"};
+            const auto curvedPatch = BezierPatch{3, 3, {
+                P{0, 2, 0}, P{1, 2, 1}, P{2, 2, 0},
+                P{0, 1, 1}, P{1, 1, 2}, P{2, 1, 1},
+                P{0, 0, 0}, P{1, 0, 1}, P{2, 0, 0},
+            }, "texture"};
+
+            auto patchNode = PatchNode{flatPatch};
+            const auto previousPatch = patchNode.setPatch(curvedPatch, PatchNode::computeGrid(curvedPatch));
+
+            const auto expectedNode = PatchNode{curvedPatch};
+            CHECK(previousPatch == flatPatch);
+            CHECK(patchNode.patch() == curvedPatch);
+            CHECK(patchNode.grid().points == expectedNode.grid().points);
+            CHECK(patchNode.grid().bounds == expectedNode.grid().bounds);
+            CHECK(patchNode.physicalBounds() == expectedNode.physicalBounds());
+        }
+
         TEST_CASE("PatchNode.pickFlatPatch") {
             using P = BezierPatch::Point;
             auto patchNode = PatchNode{BezierPatch{5, 5, {
@@ -23,6 +23,7 @@
 #include "Model/BrushBuilder.h"
 #include "Model/Entity.h"
 #include "Model/EntityNode.h"
+#include "Model/EntityProperties.h"
 #include "Model/Group.h"
 #include "Model/GroupNode.h"
 #include "Model/Layer.h"
@@ -210,6 +211,26 @@ namespace TrenchBroom {
                     entityNode, brushNode, patchNode
                 }));
             }
+
+            SECTION("Batched updates are applied to node tree when the batch ends") {
+                worldNode.defaultLayer()->addChild(brushNode);
+                REQUIRE_THAT(nodeTree.findContainers(vm::vec3d{64, 0, 0}), Catch::UnorderedEquals(std::vector<Node*>{}));
+
+                {
+                    const auto nodeTreeUpdateBatch = WorldNode::NodeTreeUpdateBatch{worldNode};
+                    transformNode(*brushNode, vm::translation_matrix(vm::vec3d(64, 0, 0)), worldBounds);
+
+                    // the node tree still contains the old bounds
+                    CHECK_THAT(nodeTree.findContainers(vm::vec3d::zero()), Catch::UnorderedEquals(std::vector<Node*>{
+                        brushNode
+                    }));
+                }
+
+                CHECK_THAT(nodeTree.findContainers(vm::vec3d::zero()), Catch::UnorderedEquals(std::vector<Node*>{}));
+                CHECK_THAT(nodeTree.findContainers(vm::vec3d{64, 0, 0}), Catch::UnorderedEquals(std::vector<Node*>{
+                    brushNode
+                }));
+            }
         }
 
         TEST_CASE("WorldNodeTest.rebuildNodeTree") {
@@ -280,6 +301,42 @@ namespace TrenchBroom {
             CHECK(nodeTree.contains(patchNode));
         }
 
+        TEST_CASE("WorldNodeTest.convertToMapFormat", "[WorldNodeTest]") {
+            constexpr auto worldBounds = vm::bbox3d{8192.0};
+
+            auto worldNode = WorldNode{{}, {}, MapFormat::Standard};
+            auto* entityNode = new EntityNode{Entity{}};
+            auto* worldBrushNode = new BrushNode{BrushBuilder{MapFormat::Standard, worldBounds}.createCube(64.0, "texture").value()};
+            auto* entityBrushNode = new BrushNode{BrushBuilder{MapFormat::Standard, worldBounds}.createCube(32.0, "texture").value()};
+
+            worldNode.defaultLayer()->addChild(worldBrushNode);
+            worldNode.defaultLayer()->addChild(entityNode);
+            entityNode->addChild(entityBrushNode);
+
+            checkBrushTexCoordSystem(worldBrushNode, false);
+            checkBrushTexCoordSystem(entityBrushNode, false);
+            CHECK(worldNode.entity().property(EntityPropertyKeys::ValveVersion) == nullptr);
+
+            worldNode.convertToMapFormat(MapFormat::Valve);
+            CHECK(worldNode.mapFormat() == MapFormat::Valve);
+            checkBrushTexCoordSystem(worldBrushNode, true);
+            checkBrushTexCoordSystem(entityBrushNode, true);
+
+            const auto* valveVersion = worldNode.entity().property(EntityPropertyKeys::ValveVersion);
+            REQUIRE(valveVersion != nullptr);
+            CHECK(*valveVersion == "220");
+
+            // the bounds did not change, so the node tree is still valid
+            CHECK(worldNode.nodeTree().contains(worldBrushNode));
+            CHECK(worldNode.nodeTree().contains(entityBrushNode));
+
+            worldNode.convertToMapFormat(MapFormat::Quake2);
+            CHECK(worldNode.mapFormat() == MapFormat::Quake2);
+            checkBrushTexCoordSystem(worldBrushNode, false);
+            checkBrushTexCoordSystem(entityBrushNode, false);
+            CHECK(worldNode.entity().property(EntityPropertyKeys::ValveVersion) == nullptr);
+        }
+
         TEST_CASE("WorldNodeTest.persistentIdOfDefaultLayer", "[WorldNodeTest]") {
             auto worldNode = WorldNode{{}, {}, MapFormat::Standard};
             CHECK(worldNode.defaultLayer()->persistentId() == std::nullopt);
@@ -0,0 +1,127 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "Model/BrushBuilder.h"
+#include "Model/BrushNode.h"
+#include "Model/LayerNode.h"
+#include "Model/MapFormat.h"
+#include "Model/WorldNode.h"
+#include "Renderer/BrushLodRenderer2D.h"
+#include "Renderer/OrthographicCamera.h"
+
+#include <kdl/result.h>
+
+#include <vecmath/bbox.h>
+#include <vecmath/bbox_io.h>
+#include <vecmath/vec.h>
+
+#include <vector>
+
+#include "Catch2.h"
+
+namespace TrenchBroom {
+    namespace Renderer {
+        TEST_CASE("BrushLodRenderer2DTest.selectLod", "[BrushLodRenderer2DTest]") {
+            constexpr auto worldBounds = vm::bbox3{8192.0};
+            constexpr auto mapFormat = Model::MapFormat::Standard;
+
+            const auto builder = Model::BrushBuilder{mapFormat, worldBounds};
+            const auto createBrushNode = [&](const vm::bbox3& bounds) {
+                return new Model::BrushNode{builder.createCuboid(bounds, "texture").value()};
+            };
+
+            auto world = Model::WorldNode{{}, {}, mapFormat};
+            auto* largeBrush = createBrushNode(vm::bbox3{{-128, -128, -128}, {128, 128, 128}});
+            auto* smallBrush1 = createBrushNode(vm::bbox3{{100, 100, 0}, {108, 108, 8}});
+            auto* smallBrush2 = createBrushNode(vm::bbox3{{110, 100, 0}, {118, 108, 8}});
+            auto* smallBrush3 = createBrushNode(vm::bbox3{{-500, -500, 0}, {-492, -492, 8}});
+            auto* farBrush = createBrushNode(vm::bbox3{{5000, 5000, 0}, {5008, 5008, 8}});
+            world.defaultLayer()->addChildren({largeBrush, smallBrush1, smallBrush2, smallBrush3, farBrush});
+
+            // looking down the z axis with a viewport of 400x400 pixels
+            auto camera = OrthographicCamera{1.0f, 32768.0f, Camera::Viewport{0, 0, 400, 400}, vm::vec3f{0, 0, 16384}, vm::vec3f{0, 0, -1}, vm::vec3f{0, 1, 0}};
+
+            const auto acceptAll = [](const Model::BrushNode*) { return true; };
+
+            SECTION("Close zoom renders every visible brush") {
+                camera.setZoom(1.0f);
+                CHECK_FALSE(BrushLodRenderer2D::useLod(camera));
+
+                const auto lod = BrushLodRenderer2D::selectLod(world, camera, acceptAll);
+                CHECK_THAT(lod.brushes, Catch::UnorderedEquals(std::vector<const Model::BrushNode*>{largeBrush, smallBrush1, smallBrush2}));
+                CHECK(lod.outlines.empty());
+            }
+
+            SECTION("Far zoom merges small brushes in the same cell") {
+                camera.setZoom(0.1f);
+                CHECK(BrushLodRenderer2D::useLod(camera));
+
+                // the LOD level of this zoom uses a zoom of 0.125, so the cells are 32 units wide
+                const auto lod = BrushLodRenderer2D::selectLod(world, camera, acceptAll);
+                CHECK_THAT(lod.brushes, Catch::UnorderedEquals(std::vector<const Model::BrushNode*>{largeBrush}));
+                CHECK_THAT(lod.outlines, Catch::UnorderedEquals(std::vector<vm::bbox3>{
+                    vm::bbox3{{100, 100, 0}, {118, 108, 8}},
+                    vm::bbox3{{-500, -500, 0}, {-492, -492, 8}},
+                }));
+            }
+
+            SECTION("Zoom levels are grouped into LOD levels") {
+                CHECK(BrushLodRenderer2D::lodZoom(1.0f) == 1.0f);
+                CHECK(BrushLodRenderer2D::lodZoom(0.25f) == 0.25f);
+                CHECK(BrushLodRenderer2D::lodZoom(0.2f) == 0.25f);
+                CHECK(BrushLodRenderer2D::lodZoom(0.125f) == 0.25f);
+                CHECK(BrushLodRenderer2D::lodZoom(0.1f) == 0.125f);
+                CHECK(BrushLodRenderer2D::lodZoom(0.02f) == 0.03125f);
+            }
+
+            SECTION("Brushes outside of the visible area are selected for a given area") {
+                camera.setZoom(0.1f);
+
+                const auto lod = BrushLodRenderer2D::selectLod(world, camera, vm::bbox3{{-600, -600, -128}, {0, 0, 128}}, acceptAll);
+                CHECK_THAT(lod.brushes, Catch::UnorderedEquals(std::vector<const Model::BrushNode*>{largeBrush}));
+                CHECK_THAT(lod.outlines, Catch::UnorderedEquals(std::vector<vm::bbox3>{
+                    vm::bbox3{{-500, -500, 0}, {-492, -492, 8}},
+                }));
+            }
+
+            SECTION("Farthest zoom merges every small brush") {
+                camera.setZoom(0.02f);
+                CHECK(BrushLodRenderer2D::useLod(camera));
+
+                const auto lod = BrushLodRenderer2D::selectLod(world, camera, acceptAll);
+                CHECK_THAT(lod.brushes, Catch::UnorderedEquals(std::vector<const Model::BrushNode*>{largeBrush}));
+                CHECK(lod.outlines.size() == 3u);
+            }
+
+            SECTION("Filtered brushes are skipped") {
+                camera.setZoom(0.1f);
+
+                const auto lod = BrushLodRenderer2D::selectLod(world, camera, [&](const Model::BrushNode* brushNode) {
+                    return brushNode != largeBrush && brushNode != smallBrush1;
+                });
+                CHECK(lod.brushes.empty());
+                CHECK_THAT(lod.outlines, Catch::UnorderedEquals(std::vector<vm::bbox3>{
+                    vm::bbox3{{110, 100, 0}, {118, 108, 8}},
+                    vm::bbox3{{-500, -500, 0}, {-492, -492, 8}},
+                }));
+            }
+        }
+    }
+}
@@ -32,6 +32,8 @@
 
 #include "TestUtils.h"
 
+#include <kdl/vector_utils.h>
+
 #include "Catch2.h"
 
 namespace TrenchBroom {
@@ -111,6 +113,42 @@ namespace TrenchBroom {
             checkTexture("texture2");
         }
 
+        TEST_CASE_METHOD(ValveMapDocumentTest, "ChangeBrushFaceAttributesTest.facesOfManyBrushes") {
+            auto brushNodes = std::vector<Model::BrushNode*>{};
+            for (size_t i = 0u; i < 64u; ++i) {
+                brushNodes.push_back(createBrushNode("original"));
+            }
+            document->addNodes({{document->parentForNodes(), kdl::vec_element_cast<Model::Node*>(brushNodes)}});
+
+            // select the first two faces of every brush
+            auto faceHandles = std::vector<Model::BrushFaceHandle>{};
+            for (auto* brushNode : brushNodes) {
+                faceHandles.emplace_back(brushNode, 0u);
+                faceHandles.emplace_back(brushNode, 1u);
+            }
+            document->select(faceHandles);
+
+            const auto checkTextures = [&](const std::string& selectedTextureName) {
+                for (const auto* brushNode : brushNodes) {
+                    const auto& faces = brushNode->brush().faces();
+                    for (size_t i = 0u; i < faces.size(); ++i) {
+                        CHECK(faces[i].attributes().textureName() == (i < 2u ? selectedTextureName : "original"));
+                    }
+                }
+            };
+
+            Model::ChangeBrushFaceAttributesRequest setTexture;
+            setTexture.setTextureName("texture1");
+            document->setFaceAttributes(setTexture);
+            checkTextures("texture1");
+
+            document->undoCommand();
+            checkTextures("original");
+
+            document->redoCommand();
+            checkTextures("texture1");
+        }
+
         TEST_CASE_METHOD(ValveMapDocumentTest, "ChangeBrushFaceAttributesTest.setAll") {
             Model::BrushNode* brushNode = createBrushNode();
             addNode(*document, document->parentForNodes(), brushNode);
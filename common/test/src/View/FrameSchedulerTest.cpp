@@ -0,0 +1,172 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "View/FrameScheduler.h"
+
+#include "Catch2.h"
+
+namespace TrenchBroom {
+    namespace View {
+        class StubClient : public FrameScheduler::Client {
+        private:
+            FrameScheduler& m_scheduler;
+        public:
+            FrameScheduler::FrameState state;
+            size_t renderCount;
+
+            explicit StubClient(FrameScheduler& scheduler) :
+            m_scheduler(scheduler),
+            state{0.0f},
+            renderCount(0u) {}
+
+            FrameScheduler::FrameState frameState() override {
+                return state;
+            }
+
+            void renderFrame() override {
+                ++renderCount;
+                m_scheduler.clientRendered(this);
+            }
+        };
+
+        TEST_CASE("FrameSchedulerTest.coalesceInvalidations", "[FrameSchedulerTest]") {
+            size_t requestCount = 0u;
+            size_t preparationCount = 0u;
+
+            auto scheduler = FrameScheduler{[&]() { ++requestCount; }};
+            scheduler.addPreparation([&]() { ++preparationCount; });
+
+            auto client1 = StubClient{scheduler};
+            auto client2 = StubClient{scheduler};
+            scheduler.addClient(&client1);
+            scheduler.addClient(&client2);
+
+            CHECK(requestCount == 1u);
+            CHECK(scheduler.frameRequested());
+
+            scheduler.frame();
+            CHECK_FALSE(scheduler.frameRequested());
+            CHECK(preparationCount == 1u);
+            CHECK(client1.renderCount == 1u);
+            CHECK(client2.renderCount == 1u);
+
+            scheduler.invalidateAll();
+            scheduler.invalidate(&client1);
+            scheduler.invalidateIfChanged(&client2);
+            scheduler.invalidateAll();
+
+            CHECK(requestCount == 2u);
+
+            scheduler.frame();
+            CHECK(preparationCount == 2u);
+            CHECK(client1.renderCount == 2u);
+            CHECK(client2.renderCount == 2u);
+
+            // nothing was invalidated
+            scheduler.frame();
+            CHECK(preparationCount == 2u);
+            CHECK(client1.renderCount == 2u);
+            CHECK(client2.renderCount == 2u);
+        }
+
+        TEST_CASE("FrameSchedulerTest.invalidateSingleClient", "[FrameSchedulerTest]") {
+            auto scheduler = FrameScheduler{[]() {}};
+
+            auto client1 = StubClient{scheduler};
+            auto client2 = StubClient{scheduler};
+            scheduler.addClient(&client1);
+            scheduler.addClient(&client2);
+            scheduler.frame();
+
+            scheduler.invalidate(&client2);
+            scheduler.frame();
+
+            CHECK(client1.renderCount == 1u);
+            CHECK(client2.renderCount == 2u);
+        }
+
+        TEST_CASE("FrameSchedulerTest.invalidateIfChanged", "[FrameSchedulerTest]") {
+            size_t preparationCount = 0u;
+
+            auto scheduler = FrameScheduler{[]() {}};
+            scheduler.addPreparation([&]() { ++preparationCount; });
+
+            auto client1 = StubClient{scheduler};
+            auto client2 = StubClient{scheduler};
+            scheduler.addClient(&client1);
+            scheduler.addClient(&client2);
+            scheduler.frame();
+            REQUIRE(preparationCount == 1u);
+
+            SECTION("Unchanged clients are skipped") {
+                scheduler.invalidateIfChanged(&client1);
+                scheduler.invalidateIfChanged(&client2);
+                scheduler.frame();
+
+                CHECK(preparationCount == 1u);
+                CHECK(client1.renderCount == 1u);
+                CHECK(client2.renderCount == 1u);
+            }
+
+            SECTION("Changed clients are rendered") {
+                client1.state = {1.0f};
+                scheduler.invalidateIfChanged(&client1);
+                scheduler.invalidateIfChanged(&client2);
+                scheduler.frame();
+
+                CHECK(preparationCount == 2u);
+                CHECK(client1.renderCount == 2u);
+                CHECK(client2.renderCount == 1u);
+            }
+
+            SECTION("Renders outside of frames are recorded") {
+                client1.state = {1.0f};
+                scheduler.clientRendered(&client1);
+
+                scheduler.invalidateIfChanged(&client1);
+                scheduler.frame();
+
+                CHECK(client1.renderCount == 1u);
+            }
+        }
+
+        TEST_CASE("FrameSchedulerTest.removeClient", "[FrameSchedulerTest]") {
+            auto scheduler = FrameScheduler{[]() {}};
+
+            auto client1 = StubClient{scheduler};
+            auto client2 = StubClient{scheduler};
+            scheduler.addClient(&client1);
+            scheduler.addClient(&client2);
+
+            scheduler.removeClient(&client1);
+            scheduler.frame();
+
+            CHECK(client1.renderCount == 0u);
+            CHECK(client2.renderCount == 1u);
+
+            // invalidating a removed client is ignored
+            scheduler.invalidate(&client1);
+            scheduler.frame();
+
+            CHECK(client1.renderCount == 0u);
+            CHECK(client2.renderCount == 1u);
+        }
+    }
+}
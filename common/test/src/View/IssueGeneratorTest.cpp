@@ -20,7 +20,12 @@
 
 #include "MapDocumentTest.h"
 
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushFace.h"
+#include "Model/BrushFaceAttributes.h"
 #include "Model/BrushNode.h"
+#include "Model/Entity.h"
 #include "Model/EntityNode.h"
 #include "Model/EmptyPropertyKeyIssueGenerator.h"
 #include "Model/EmptyPropertyValueIssueGenerator.h"
@@ -29,11 +34,14 @@
 #include "Model/IssueQuickFix.h"
 #include "Model/LayerNode.h"
 #include "Model/PatchNode.h"
+#include "Model/RedundantBrushIssueGenerator.h"
 #include "Model/WorldNode.h"
 
 #include <kdl/overload.h>
 #include <kdl/vector_utils.h>
 
+#include <string>
+
 #include "Catch2.h"
 
 namespace TrenchBroom {
@@ -88,5 +96,113 @@ namespace TrenchBroom {
 
             kdl::vec_clear_and_delete(issueGenerators);
         }
+
+        TEST_CASE_METHOD(MapDocumentTest, "IssueGeneratorTest.redundantBrushes") {
+            const auto builder = Model::BrushBuilder{document->world()->mapFormat(), document->worldBounds()};
+            const auto createBrushNode = [&](const vm::bbox3& bounds) {
+                return new Model::BrushNode{builder.createCuboid(bounds, "texture").value()};
+            };
+
+            auto* original = createBrushNode(vm::bbox3{vm::vec3{0, 0, 0}, vm::vec3{64, 64, 64}});
+            auto* duplicate = createBrushNode(vm::bbox3{vm::vec3{0, 0, 0}, vm::vec3{64, 64, 64}});
+            auto* contained = createBrushNode(vm::bbox3{vm::vec3{16, 16, 16}, vm::vec3{32, 32, 32}});
+            auto* overlapping = createBrushNode(vm::bbox3{vm::vec3{32, 32, 32}, vm::vec3{96, 96, 96}});
+            auto* inEntity = createBrushNode(vm::bbox3{vm::vec3{16, 16, 16}, vm::vec3{48, 48, 48}});
+            auto* entityNode = new Model::EntityNode{Model::Entity{}};
+
+            document->addNodes({{document->parentForNodes(), {original, duplicate, contained, overlapping, entityNode}}});
+            document->addNodes({{entityNode, {inEntity}}});
+
+            auto issueGenerators = std::vector<Model::IssueGenerator*>{
+                new Model::RedundantBrushIssueGenerator{document->world()}
+            };
+
+            const auto findRedundantBrushes = [&]() {
+                auto issues = std::vector<Model::Issue*>{};
+                document->world()->accept(kdl::overload(
+                    [&](auto&& thisLambda, Model::WorldNode* w)  { w->visitChildren(thisLambda); },
+                    [&](auto&& thisLambda, Model::LayerNode* l)  { l->visitChildren(thisLambda); },
+                    [&](auto&& thisLambda, Model::GroupNode* g)  { g->visitChildren(thisLambda); },
+                    [&](auto&& thisLambda, Model::EntityNode* e) { e->visitChildren(thisLambda); },
+                    [&](Model::BrushNode* b)                     { issues = kdl::vec_concat(std::move(issues), b->issues(issueGenerators)); },
+                    [&](Model::PatchNode*)                       {}
+                ));
+                return issues;
+            };
+
+            // the brush in the entity is not compared to the brushes of the world
+            auto issues = findRedundantBrushes();
+            CHECK_THAT(kdl::vec_transform(issues, [](const auto* issue) { return issue->node(); }), Catch::UnorderedEquals(std::vector<Model::Node*>{
+                original, duplicate, contained
+            }));
+
+            // moving the duplicate away invalidates the issue of the brush it duplicated
+            document->deselectAll();
+            document->select(duplicate);
+            REQUIRE(document->translateObjects(vm::vec3{128, 0, 0}));
+
+            issues = findRedundantBrushes();
+            CHECK_THAT(kdl::vec_transform(issues, [](const auto* issue) { return issue->node(); }), Catch::UnorderedEquals(std::vector<Model::Node*>{
+                contained
+            }));
+
+            REQUIRE(document->translateObjects(vm::vec3{-128, 0, 0}));
+            issues = findRedundantBrushes();
+            REQUIRE(issues.size() == 3u);
+
+            // the quick fix keeps one copy of the duplicates
+            const auto fixes = document->world()->quickFixes(issueGenerators.front()->type());
+            REQUIRE(fixes.size() == 1u);
+            fixes.front()->apply(document.get(), issues);
+
+            CHECK(contained->parent() == nullptr);
+            CHECK((original->parent() == nullptr) != (duplicate->parent() == nullptr));
+            CHECK(overlapping->parent() != nullptr);
+            CHECK(inEntity->parent() != nullptr);
+            CHECK(findRedundantBrushes().empty());
+
+            kdl::vec_clear_and_delete(issueGenerators);
+        }
+
+        TEST_CASE_METHOD(MapDocumentTest, "IssueGeneratorTest.redundantBrushesWithDifferentContents") {
+            const auto builder = Model::BrushBuilder{document->world()->mapFormat(), document->worldBounds()};
+            const auto createBrushNode = [&](const vm::bbox3& bounds, const std::string& textureName, const int contents) {
+                auto brush = builder.createCuboid(bounds, textureName).value();
+                for (auto& face : brush.faces()) {
+                    auto attributes = face.attributes();
+                    attributes.setSurfaceContents(contents);
+                    face.setAttributes(attributes);
+                }
+                return new Model::BrushNode{std::move(brush)};
+            };
+
+            auto* original = createBrushNode(vm::bbox3{vm::vec3{0, 0, 0}, vm::vec3{64, 64, 64}}, "texture", 0);
+            auto* water = createBrushNode(vm::bbox3{vm::vec3{16, 16, 16}, vm::vec3{32, 32, 32}}, "texture", 32);
+            auto* clip = createBrushNode(vm::bbox3{vm::vec3{0, 0, 0}, vm::vec3{64, 64, 64}}, "clip", 0);
+            auto* hint = createBrushNode(vm::bbox3{vm::vec3{16, 16, 16}, vm::vec3{32, 32, 32}}, "hint", 0);
+            auto* origin = createBrushNode(vm::bbox3{vm::vec3{16, 16, 16}, vm::vec3{32, 32, 32}}, "texture", 1 << 24);
+
+            document->addNodes({{document->parentForNodes(), {original, water, clip, hint, origin}}});
+
+            auto issueGenerators = std::vector<Model::IssueGenerator*>{
+                new Model::RedundantBrushIssueGenerator{document->world()}
+            };
+
+            auto issues = std::vector<Model::Issue*>{};
+            document->world()->accept(kdl::overload(
+                [&](auto&& thisLambda, Model::WorldNode* w)  { w->visitChildren(thisLambda); },
+                [&](auto&& thisLambda, Model::LayerNode* l)  { l->visitChildren(thisLambda); },
+                [&](auto&& thisLambda, Model::GroupNode* g)  { g->visitChildren(thisLambda); },
+                [&](auto&& thisLambda, Model::EntityNode* e) { e->visitChildren(thisLambda); },
+                [&](Model::BrushNode* b)                     { issues = kdl::vec_concat(std::move(issues), b->issues(issueGenerators)); },
+                [&](Model::PatchNode*)                       {}
+            ));
+
+            // brushes with other content flags and non-solid brushes are neither reported nor do they make other brushes
+            // redundant
+            CHECK(issues.empty());
+
+            kdl::vec_clear_and_delete(issueGenerators);
+        }
     }
 }
@@ -22,22 +22,32 @@
 
 #include "Exceptions.h"
 #include "Assets/EntityDefinition.h"
+#include "Assets/EntityDefinitionManager.h"
+#include "Assets/Texture.h"
+#include "Assets/TextureManager.h"
 #include "IO/WorldReader.h"
 #include "Model/BrushBuilder.h"
+#include "Model/BrushFace.h"
 #include "Model/BrushNode.h"
 #include "Model/Entity.h"
 #include "Model/EntityNode.h"
 #include "Model/Group.h"
 #include "Model/GroupNode.h"
 #include "Model/LayerNode.h"
+#include "Model/ModelUtils.h"
 #include "Model/PatchNode.h"
+#include "Model/TagManager.h"
 #include "Model/TestGame.h"
 #include "Model/WorldNode.h"
 #include "View/MapDocumentCommandFacade.h"
 
+#include <kdl/overload.h>
 #include <kdl/result.h>
 #include <kdl/vector_utils.h>
 
+#include <algorithm>
+#include <vector>
+
 #include "Catch2.h"
 
 namespace TrenchBroom {
@@ -116,6 +126,128 @@ namespace TrenchBroom {
             CHECK(document->world()->defaultLayer()->childCount() == 0);
         }
 
+        static std::vector<Model::TagType::Type> collectFaceTagMasks(const std::vector<Model::Node*>& nodes) {
+            auto result = std::vector<Model::TagType::Type>{};
+            for (const auto* brushNode : Model::filterBrushNodes(nodes)) {
+                for (const auto& face : brushNode->brush().faces()) {
+                    result.push_back(face.tagMask());
+                }
+            }
+            return result;
+        }
+
+        static std::vector<const Assets::Texture*> collectTextures(const std::vector<Model::Node*>& nodes) {
+            auto result = std::vector<const Assets::Texture*>{};
+            for (const auto* node : nodes) {
+                node->accept(kdl::overload(
+                    [] (const Model::WorldNode*) {},
+                    [] (const Model::LayerNode*) {},
+                    [] (const Model::GroupNode*) {},
+                    [] (const Model::EntityNode*) {},
+                    [&](const Model::BrushNode* brushNode) {
+                        for (const auto& face : brushNode->brush().faces()) {
+                            result.push_back(face.texture());
+                        }
+                    },
+                    [&](const Model::PatchNode* patchNode) { result.push_back(patchNode->patch().texture()); }
+                ));
+            }
+            return result;
+        }
+
+        /**
+         * Assigns the textures and initializes the tags with one whole map traversal per pass, as MapDocument did
+         * before the nodes were initialized in parallel.
+         */
+        static void initializeNodesSerially(const std::vector<Model::Node*>& nodes, Assets::TextureManager& textureManager, Model::TagManager& tagManager) {
+            for (auto* node : nodes) {
+                node->accept(kdl::overload(
+                    [] (Model::WorldNode*) {},
+                    [] (Model::LayerNode*) {},
+                    [] (Model::GroupNode*) {},
+                    [] (Model::EntityNode*) {},
+                    [&](Model::BrushNode* brushNode) {
+                        for (size_t i = 0u; i < brushNode->brush().faceCount(); ++i) {
+                            brushNode->setFaceTexture(i, textureManager.texture(brushNode->brush().face(i).attributes().textureName()));
+                        }
+                    },
+                    [&](Model::PatchNode* patchNode) { patchNode->setTexture(textureManager.texture(patchNode->patch().textureName())); }
+                ));
+            }
+            for (auto* node : nodes) {
+                node->initializeTags(tagManager);
+            }
+        }
+
+        static void clearTexturesAndTags(const std::vector<Model::Node*>& nodes) {
+            for (auto* node : nodes) {
+                node->accept(kdl::overload(
+                    [] (Model::WorldNode*) {},
+                    [] (Model::LayerNode*) {},
+                    [] (Model::GroupNode*) {},
+                    [] (Model::EntityNode*) {},
+                    [&](Model::BrushNode* brushNode) {
+                        for (size_t i = 0u; i < brushNode->brush().faceCount(); ++i) {
+                            brushNode->setFaceTexture(i, nullptr);
+                        }
+                    },
+                    [&](Model::PatchNode* patchNode) { patchNode->setTexture(nullptr); }
+                ));
+                node->clearTags();
+            }
+        }
+
+        TEST_CASE("MapDocumentTest.loadDocumentInitializesNodes", "[MapDocumentTest]") {
+            // the liquid tag of these brushes depends on the content flags of their textures
+            auto [document, game, gameConfig] = View::loadMapDocument(IO::Path("fixture/test/View/ChangeBrushFaceAttributesTest/lavaAndWater.map"),
+                                                                      "Quake2", Model::MapFormat::Unknown);
+
+            const auto nodes = Model::collectNodes({document->world()});
+            REQUIRE(Model::filterBrushNodes(nodes).size() == 2u);
+
+            auto& textureManager = document->textureManager();
+            auto& entityDefinitionManager = document->entityDefinitionManager();
+            const auto& nodeTree = document->world()->nodeTree();
+            for (auto* node : nodes) {
+                node->accept(kdl::overload(
+                    [] (Model::WorldNode*) {},
+                    [] (Model::LayerNode*) {},
+                    [] (Model::GroupNode*) {},
+                    [&](Model::EntityNode* entityNode) {
+                        CHECK(entityNode->entity().definition() == entityDefinitionManager.definition(entityNode));
+                        CHECK(nodeTree.boundsOf(entityNode) == entityNode->physicalBounds());
+                    },
+                    [&](Model::BrushNode* brushNode) {
+                        for (const auto& face : brushNode->brush().faces()) {
+                            CHECK(face.texture() == textureManager.texture(face.attributes().textureName()));
+                        }
+                        CHECK(nodeTree.boundsOf(brushNode) == brushNode->physicalBounds());
+                    },
+                    [&](Model::PatchNode* patchNode) {
+                        CHECK(patchNode->patch().texture() == textureManager.texture(patchNode->patch().textureName()));
+                        CHECK(nodeTree.boundsOf(patchNode) == patchNode->physicalBounds());
+                    }
+                ));
+            }
+
+            const auto textures = collectTextures(nodes);
+            const auto tagMasks = kdl::vec_transform(nodes, [](const auto* node) { return node->tagMask(); });
+            const auto faceTagMasks = collectFaceTagMasks(nodes);
+            CHECK(std::any_of(std::begin(faceTagMasks), std::end(faceTagMasks), [](const auto mask) { return mask != 0; }));
+
+            // reset the nodes, initialize them again serially and compare with the parallel initialization
+            clearTexturesAndTags(nodes);
+            REQUIRE(std::all_of(std::begin(nodes), std::end(nodes), [](const auto* node) { return node->tagMask() == 0; }));
+
+            auto tagManager = Model::TagManager{};
+            tagManager.registerSmartTags(document->smartTags());
+            initializeNodesSerially(nodes, textureManager, tagManager);
+
+            CHECK(collectTextures(nodes) == textures);
+            CHECK(kdl::vec_transform(nodes, [](const auto* node) { return node->tagMask(); }) == tagMasks);
+            CHECK(collectFaceTagMasks(nodes) == faceTagMasks);
+        }
+
         TEST_CASE("MapDocumentTest.mixedFormats", "[MapDocumentTest]") {
             // map has both Standard and Valve brushes
             CHECK_THROWS_AS(View::loadMapDocument(IO::Path("fixture/test/View/MapDocumentTest/mixedFormats.map"),
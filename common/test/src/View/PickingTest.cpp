@@ -70,6 +70,32 @@ namespace TrenchBroom {
             CHECK(pickResult.all().empty());
         }
 
+        TEST_CASE_METHOD(MapDocumentTest, "PickingTest.pickRestoresGeometryOfNearestBrush") {
+            // delete default brush
+            document->selectAllNodes();
+            document->deleteObjects();
+
+            const Model::BrushBuilder builder(document->world()->mapFormat(), document->worldBounds());
+
+            auto* brushNode1 = new Model::BrushNode(builder.createCuboid(vm::bbox3(vm::vec3(0, 0, 0), vm::vec3(64, 64, 64)), "texture").value());
+            auto* brushNode2 = new Model::BrushNode(builder.createCuboid(vm::bbox3(vm::vec3(128, 0, 0), vm::vec3(192, 64, 64)), "texture").value());
+            addNode(*document, document->parentForNodes(), brushNode1);
+            addNode(*document, document->parentForNodes(), brushNode2);
+
+            // new brushes count as used, so they are only compacted on the second attempt
+            document->compactUnusedBrushGeometry();
+            document->compactUnusedBrushGeometry();
+            REQUIRE(brushNode1->brushWithoutRestoringGeometry().geometryCompacted());
+            REQUIRE(brushNode2->brushWithoutRestoringGeometry().geometryCompacted());
+
+            Model::PickResult pickResult;
+            document->pick(vm::ray3(vm::vec3(-32, 32, 32), vm::vec3::pos_x()), pickResult);
+            CHECK(pickResult.all().size() == 2u);
+
+            CHECK_FALSE(brushNode1->brushWithoutRestoringGeometry().geometryCompacted());
+            CHECK(brushNode2->brushWithoutRestoringGeometry().geometryCompacted());
+        }
+
         TEST_CASE_METHOD(MapDocumentTest, "PickingTest.pickSingleEntity") {
             // delete default brush
             document->selectAllNodes();
@@ -18,6 +18,9 @@
  */
 
 #include "Exceptions.h"
+#include "Model/Brush.h"
+#include "Model/BrushFace.h"
+#include "Model/BrushFaceHandle.h"
 #include "Model/BrushNode.h"
 #include "Model/BrushBuilder.h"
 #include "Model/EntityNode.h"
@@ -37,6 +40,8 @@
 
 #include <kdl/result.h>
 
+#include <vector>
+
 #include "Catch2.h"
 
 #include "TestUtils.h"
@@ -436,6 +441,26 @@ namespace TrenchBroom {
             CHECK(document->lastSelectionBounds() == bounds);
         }
 
+        TEST_CASE_METHOD(MapDocumentTest, "SelectionTest.deselectSomeBrushFaces") {
+            Model::BrushNode* brushNode = createBrushNode();
+            addNode(*document, document->parentForNodes(), brushNode);
+
+            auto handles = std::vector<Model::BrushFaceHandle>{};
+            for (size_t i = 0u; i < brushNode->brush().faceCount(); ++i) {
+                handles.emplace_back(brushNode, i);
+            }
+            document->select(handles);
+            CHECK_THAT(document->selectedBrushFaces(), Catch::Equals(handles));
+
+            document->deselect(handles[1]);
+            document->deselect(handles[4]);
+
+            // the remaining faces keep their order
+            CHECK_THAT(document->selectedBrushFaces(), Catch::Equals(std::vector<Model::BrushFaceHandle>{ handles[0], handles[2], handles[3], handles[5] }));
+            CHECK_FALSE(brushNode->brush().face(1).selected());
+            CHECK(brushNode->brush().face(2).selected());
+        }
+
         TEST_CASE_METHOD(MapDocumentTest, "SelectionCommandTest.faceSelectionUndoAfterTranslationUndo") {
             Model::BrushNode* brushNode = createBrushNode();
             CHECK(brushNode->logicalBounds().center() == vm::vec3::zero());
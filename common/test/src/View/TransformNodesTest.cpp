@@ -44,6 +44,7 @@
 #include <kdl/vector_utils.h>
 #include <kdl/zip_iterator.h>
 
+#include <optional>
 #include <vector>
 
 #include "Catch2.h"
@@ -307,6 +308,32 @@ namespace TrenchBroom {
             CHECK(brush.face(*brush.findFace(vm::vec3::pos_z())).boundary() == vm::plane3(200.0, vm::vec3::pos_z()));
         }
 
+        TEST_CASE_METHOD(MapDocumentTest, "TransformNodesTest.selectionPreviewTransformation") {
+            const vm::bbox3 bounds(vm::vec3(-16, -16, -16), vm::vec3(16, 16, 16));
+
+            Model::BrushBuilder builder(document->world()->mapFormat(), document->worldBounds());
+            Model::BrushNode* brushNode = new Model::BrushNode(builder.createCuboid(bounds, "texture").value());
+
+            addNode(*document, document->parentForNodes(), brushNode);
+            document->select(std::vector<Model::Node*>{brushNode});
+
+            CHECK(document->selectionPreviewTransformation() == std::nullopt);
+            CHECK(document->previewSelectionBounds() == bounds);
+
+            const auto translation = vm::translation_matrix(vm::vec3(32, 0, 0));
+            document->setSelectionPreviewTransformation(translation);
+
+            // the preview does not change the objects
+            CHECK(document->selectionPreviewTransformation() == translation);
+            CHECK(brushNode->logicalBounds() == bounds);
+            CHECK(document->selectionBounds() == bounds);
+            CHECK(document->previewSelectionBounds() == bounds.translate(vm::vec3(32, 0, 0)));
+
+            document->clearSelectionPreviewTransformation();
+            CHECK(document->selectionPreviewTransformation() == std::nullopt);
+            CHECK(document->previewSelectionBounds() == bounds);
+        }
+
         TEST_CASE_METHOD(MapDocumentTest, "TransformNodesTest.scaleObjectsInGroup") {
             const vm::bbox3 initialBBox(vm::vec3(-100, -100, -100), vm::vec3(100, 100, 100));
             const vm::bbox3 doubleBBox(2.0 * initialBBox.min, 2.0 * initialBBox.max);
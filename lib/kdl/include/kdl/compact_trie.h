@@ -522,6 +522,26 @@ namespace kdl {
                     child.get_keys(key, out);
                 }
             }
+
+            /**
+             * Returns an estimate of the number of bytes allocated on the heap by this node's subtree. The estimate
+             * assumes that every element of a set or a hash map is allocated separately along with its bookkeeping
+             * pointers, and it does not include allocator overhead.
+             *
+             * @return the number of bytes
+             */
+            std::size_t memory_usage() const {
+                static const auto inline_key_capacity = std::string{}.capacity();
+
+                auto result = m_key.capacity() > inline_key_capacity ? m_key.capacity() + 1u : 0u;
+                result += m_values.bucket_count() * sizeof(void*);
+                result += m_values.size() * (sizeof(typename value_container::value_type) + sizeof(void*));
+
+                for (const auto& child : m_children) {
+                    result += sizeof(node) + 3u * sizeof(void*) + child.memory_usage();
+                }
+                return result;
+            }
         private:
             void insert_value(const V& value) const {
                 m_values[value]++;
@@ -704,6 +724,15 @@ namespace kdl {
         void get_keys(O out) const {
             m_root.get_keys("", out);
         }
+
+        /**
+         * Returns an estimate of the number of bytes allocated for this trie, including the trie itself.
+         *
+         * @return the number of bytes
+         */
+        std::size_t memory_usage() const {
+            return sizeof(compact_trie) + m_root.memory_usage();
+        }
     };
 }
 
@@ -192,4 +192,23 @@ namespace kdl {
 
         CHECK_THAT(keys, Catch::UnorderedEquals(std::vector<std::string>{ "key", "key2", "key22", "key22bs", "k1" }));
     }
+
+    TEST_CASE("compact_trie_test.memory_usage", "[compact_trie_test]") {
+        test_index index;
+        const auto emptySize = index.memory_usage();
+        CHECK(emptySize >= sizeof(test_index));
+
+        index.insert("key", "value");
+        const auto oneKeySize = index.memory_usage();
+        CHECK(oneKeySize > emptySize);
+
+        index.insert("key2", "value");
+        index.insert("k1", "value3");
+        CHECK(index.memory_usage() > oneKeySize);
+
+        index.remove("key2", "value");
+        index.remove("k1", "value3");
+        index.remove("key", "value");
+        CHECK(index.memory_usage() == emptySize);
+    }
 }
@@ -0,0 +1,584 @@
+/*
+ Copyright (C) 2021 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Exceptions.h"
+#include "Logger.h"
+#include "MemoryReport.h"
+#include "Assets/EntityDefinitionFileSpec.h"
+#include "Assets/EntityDefinitionManager.h"
+#include "IO/DiskIO.h"
+#include "IO/File.h"
+#include "IO/GameConfigParser.h"
+#include "IO/IOUtils.h"
+#include "IO/MapStreamConverter.h"
+#include "IO/Path.h"
+#include "IO/PathQt.h"
+#include "IO/Reader.h"
+#include "IO/SimpleParserStatus.h"
+#include "IO/WorldReader.h"
+#include "Model/BrushNode.h"
+#include "Model/EmptyBrushEntityIssueGenerator.h"
+#include "Model/EmptyGroupIssueGenerator.h"
+#include "Model/EmptyPropertyKeyIssueGenerator.h"
+#include "Model/EmptyPropertyValueIssueGenerator.h"
+#include "Model/EntityNode.h"
+#include "Model/EntityProperties.h"
+#include "Model/ExportFormat.h"
+#include "Model/GameConfig.h"
+#include "Model/GameImpl.h"
+#include "Model/GroupNode.h"
+#include "Model/InvalidTextureScaleIssueGenerator.h"
+#include "Model/Issue.h"
+#include "Model/LayerNode.h"
+#include "Model/LinkSourceIssueGenerator.h"
+#include "Model/LinkTargetIssueGenerator.h"
+#include "Model/LongPropertyKeyIssueGenerator.h"
+#include "Model/LongPropertyValueIssueGenerator.h"
+#include "Model/MapFormat.h"
+#include "Model/MissingClassnameIssueGenerator.h"
+#include "Model/MissingDefinitionIssueGenerator.h"
+#include "Model/MissingModIssueGenerator.h"
+#include "Model/MixedBrushContentsIssueGenerator.h"
+#include "Model/ModelUtils.h"
+#include "Model/NonIntegerVerticesIssueGenerator.h"
+#include "Model/PatchNode.h"
+#include "Model/PointEntityWithBrushesIssueGenerator.h"
+#include "Model/PropertyKeyWithDoubleQuotationMarksIssueGenerator.h"
+#include "Model/PropertyValueWithDoubleQuotationMarksIssueGenerator.h"
+#include "Model/RedundantBrushIssueGenerator.h"
+#include "Model/SoftMapBoundsIssueGenerator.h"
+#include "Model/WorldBoundsIssueGenerator.h"
+#include "Model/WorldNode.h"
+#include "View/MapDocument.h"
+
+#include <kdl/overload.h>
+#include <kdl/parallel.h>
+#include <kdl/vector_utils.h>
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QFileInfo>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace TrenchBroom {
+    /**
+     * Collects the messages logged while processing a map so that the output of maps which are processed concurrently
+     * is not interleaved.
+     */
+    class BufferedLogger : public Logger {
+    private:
+        std::vector<std::pair<LogLevel, std::string>> m_messages;
+        std::mutex m_mutex;
+    public:
+        void printTo(std::ostream& out, const std::string& prefix) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (const auto& [level, message] : m_messages) {
+                out << prefix << levelName(level) << message << "\n";
+            }
+            m_messages.clear();
+        }
+    private:
+        static const char* levelName(const LogLevel level) {
+            switch (level) {
+                case LogLevel::Debug:
+                    return "debug: ";
+                case LogLevel::Info:
+                    return "";
+                case LogLevel::Warn:
+                    return "warning: ";
+                case LogLevel::Error:
+                    return "error: ";
+            }
+            return "";
+        }
+
+        void doLog(const LogLevel level, const std::string& message) override {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_messages.emplace_back(level, message);
+        }
+
+        void doLog(const LogLevel level, const QString& message) override {
+            doLog(level, message.toStdString());
+        }
+    };
+
+    struct Options {
+        IO::Path configPath;
+        IO::Path gamePath;
+        Model::MapFormat targetFormat = Model::MapFormat::Unknown;
+        bool check = false;
+        bool failOnIssues = false;
+        bool exportObj = false;
+        bool memory = false;
+        bool stream = false;
+        std::optional<IO::Path> outputDir;
+        size_t jobs = 1;
+        std::vector<IO::Path> mapPaths;
+    };
+
+    struct StageTiming {
+        std::string stage;
+        std::chrono::milliseconds duration;
+    };
+
+    struct MapResult {
+        IO::Path path;
+        std::vector<StageTiming> timings;
+        std::vector<std::string> issues;
+        std::optional<MemoryReport> memoryReport;
+        std::unique_ptr<BufferedLogger> logger = std::make_unique<BufferedLogger>();
+        bool success = false;
+    };
+
+    template <typename F>
+    static auto timeStage(MapResult& result, const std::string& stage, F&& f) {
+        const auto start = std::chrono::steady_clock::now();
+        auto finish = [&]() {
+            const auto end = std::chrono::steady_clock::now();
+            result.timings.push_back({stage, std::chrono::duration_cast<std::chrono::milliseconds>(end - start)});
+        };
+
+        if constexpr (std::is_void_v<decltype(f())>) {
+            f();
+            finish();
+        } else {
+            auto value = f();
+            finish();
+            return value;
+        }
+    }
+
+    static std::vector<Model::MapFormat> mapFormatsToTry(const Model::GameConfig& config) {
+        return kdl::vec_transform(config.fileFormats, [](const Model::MapFormatConfig& formatConfig) {
+            return Model::formatFromName(formatConfig.format);
+        });
+    }
+
+    static std::unique_ptr<Model::WorldNode> loadMap(const Model::GameConfig& config, const IO::Path& path, Logger& logger) {
+        const auto entityPropertyConfig = Model::EntityPropertyConfig{config.entityConfig.scaleExpression};
+        auto parserStatus = IO::SimpleParserStatus{logger};
+        auto file = IO::Disk::openFile(IO::Disk::fixPath(path));
+        auto fileReader = file->reader().buffer();
+        return IO::WorldReader::tryRead(fileReader.stringView(), mapFormatsToTry(config), View::MapDocument::DefaultWorldBounds, entityPropertyConfig, parserStatus);
+    }
+
+    /**
+     * Converts the given map file to the given target format and writes it to the given output path without loading
+     * it into a world. The source format is found by trying every format of the game configuration in order.
+     */
+    static void streamMap(const Model::GameConfig& config, const std::shared_ptr<Model::Game>& game, const Model::MapFormat targetFormat, const IO::Path& path, const IO::Path& outputPath, Logger& logger) {
+        auto file = IO::Disk::openFile(IO::Disk::fixPath(path));
+        auto fileReader = file->reader().buffer();
+
+        auto parserExceptions = std::vector<std::tuple<Model::MapFormat, std::string>>{};
+        for (const auto sourceFormat : mapFormatsToTry(config)) {
+            if (sourceFormat == Model::MapFormat::Unknown) {
+                continue;
+            }
+
+            // start over if the map cannot be parsed in this format
+            auto stream = IO::openPathAsOutputStream(outputPath);
+            if (!stream) {
+                throw FileSystemException("Cannot open file: " + outputPath.asString());
+            }
+            IO::writeGameComment(stream, game->gameName(), Model::formatName(targetFormat));
+
+            try {
+                auto parserStatus = IO::SimpleParserStatus{logger};
+                auto converter = IO::MapStreamConverter{fileReader.stringView(), sourceFormat, targetFormat, stream};
+                converter.convert(View::MapDocument::DefaultWorldBounds, parserStatus);
+                return;
+            } catch (const ParserException& e) {
+                parserExceptions.emplace_back(sourceFormat, std::string{e.what()});
+            }
+        }
+
+        throw IO::WorldReaderException{parserExceptions};
+    }
+
+    static void loadEntityDefinitions(const std::shared_ptr<Model::Game>& game, const IO::Path& mapPath, Model::WorldNode& world, Assets::EntityDefinitionManager& entityDefinitionManager, Logger& logger) {
+        const auto spec = game->extractEntityDefinitionFile(world.entity());
+        const auto path = game->findEntityDefinitionFile(spec, {mapPath.deleteLastComponent()});
+        auto status = IO::SimpleParserStatus{logger};
+        entityDefinitionManager.loadDefinitions(path, *game, status);
+
+        const auto setEntityDefinition = [&](auto* node) {
+            node->setDefinition(entityDefinitionManager.definition(node));
+        };
+        world.accept(kdl::overload(
+            [=](auto&& thisLambda, Model::WorldNode* worldNode) { setEntityDefinition(worldNode); worldNode->visitChildren(thisLambda); },
+            [] (auto&& thisLambda, Model::LayerNode* layer) { layer->visitChildren(thisLambda); },
+            [] (auto&& thisLambda, Model::GroupNode* group) { group->visitChildren(thisLambda); },
+            [=](Model::EntityNode* entity)                  { setEntityDefinition(entity); },
+            [] (Model::BrushNode*) {},
+            [] (Model::PatchNode*) {}
+        ));
+    }
+
+    static void registerIssueGenerators(const std::shared_ptr<Model::Game>& game, Model::WorldNode& world) {
+        world.registerIssueGenerator(new Model::MissingClassnameIssueGenerator());
+        world.registerIssueGenerator(new Model::MissingDefinitionIssueGenerator());
+        world.registerIssueGenerator(new Model::MissingModIssueGenerator(game));
+        world.registerIssueGenerator(new Model::EmptyGroupIssueGenerator());
+        world.registerIssueGenerator(new Model::EmptyBrushEntityIssueGenerator());
+        world.registerIssueGenerator(new Model::PointEntityWithBrushesIssueGenerator());
+        world.registerIssueGenerator(new Model::LinkSourceIssueGenerator());
+        world.registerIssueGenerator(new Model::LinkTargetIssueGenerator());
+        world.registerIssueGenerator(new Model::NonIntegerVerticesIssueGenerator());
+        world.registerIssueGenerator(new Model::MixedBrushContentsIssueGenerator());
+        world.registerIssueGenerator(new Model::WorldBoundsIssueGenerator(View::MapDocument::DefaultWorldBounds));
+        world.registerIssueGenerator(new Model::SoftMapBoundsIssueGenerator(game, &world));
+        world.registerIssueGenerator(new Model::EmptyPropertyKeyIssueGenerator());
+        world.registerIssueGenerator(new Model::EmptyPropertyValueIssueGenerator());
+        world.registerIssueGenerator(new Model::LongPropertyKeyIssueGenerator(game->maxPropertyLength()));
+        world.registerIssueGenerator(new Model::LongPropertyValueIssueGenerator(game->maxPropertyLength()));
+        world.registerIssueGenerator(new Model::PropertyKeyWithDoubleQuotationMarksIssueGenerator());
+        world.registerIssueGenerator(new Model::PropertyValueWithDoubleQuotationMarksIssueGenerator());
+        world.registerIssueGenerator(new Model::InvalidTextureScaleIssueGenerator());
+        world.registerIssueGenerator(new Model::RedundantBrushIssueGenerator(&world));
+    }
+
+    /**
+     * Generates the issues of every node of the given world. The nodes are independent of each other, so their issues
+     * are generated in parallel.
+     */
+    static std::vector<std::string> generateIssues(Model::WorldNode& world) {
+        auto nodes = std::vector<Model::Node*>{};
+        world.accept(kdl::overload(
+            [&](auto&& thisLambda, Model::WorldNode* worldNode) { nodes.push_back(worldNode); worldNode->visitChildren(thisLambda); },
+            [&](auto&& thisLambda, Model::LayerNode* layer)     { nodes.push_back(layer); layer->visitChildren(thisLambda); },
+            [&](auto&& thisLambda, Model::GroupNode* group)     { nodes.push_back(group); group->visitChildren(thisLambda); },
+            [&](auto&& thisLambda, Model::EntityNode* entity)   { nodes.push_back(entity); entity->visitChildren(thisLambda); },
+            [&](Model::BrushNode* brush)                        { nodes.push_back(brush); },
+            [&](Model::PatchNode* patch)                        { nodes.push_back(patch); }
+        ));
+
+        const auto& issueGenerators = world.registeredIssueGenerators();
+        kdl::parallel_for(nodes.size(), [&](const size_t i) {
+            nodes[i]->issues(issueGenerators);
+        });
+
+        auto result = std::vector<std::string>{};
+        for (auto* node : nodes) {
+            for (const auto* issue : node->issues(issueGenerators)) {
+                result.push_back("line " + std::to_string(issue->lineNumber()) + ": " + issue->description());
+            }
+        }
+        return result;
+    }
+
+    static MapResult processMap(const Options& options, const Model::GameConfig& config, const std::shared_ptr<Model::Game>& game, const IO::Path& path) {
+        auto result = MapResult{};
+        result.path = path;
+        auto& logger = *result.logger;
+
+        try {
+            if (options.stream) {
+                timeStage(result, "stream", [&]() {
+                    streamMap(config, game, options.targetFormat, path, *options.outputDir + IO::Path{path.filename()}, logger);
+                });
+
+                result.success = true;
+                return result;
+            }
+
+            // the entities refer to their definitions, so the definitions must outlive the world
+            auto entityDefinitionManager = Assets::EntityDefinitionManager{};
+            auto world = timeStage(result, "load", [&]() {
+                return loadMap(config, path, logger);
+            });
+
+            if (options.targetFormat != Model::MapFormat::Unknown) {
+                timeStage(result, "convert", [&]() {
+                    world->convertToMapFormat(options.targetFormat);
+                });
+            }
+
+            if (options.check) {
+                timeStage(result, "definitions", [&]() {
+                    try {
+                        loadEntityDefinitions(game, path, *world, entityDefinitionManager, logger);
+                    } catch (const Exception& e) {
+                        logger.error() << "Could not load entity definitions: " << e.what();
+                    }
+                });
+
+                registerIssueGenerators(game, *world);
+                result.issues = timeStage(result, "issues", [&]() {
+                    return generateIssues(*world);
+                });
+            }
+
+            if (options.memory) {
+                auto report = MemoryReport{};
+                Model::reportMemoryUsage(*world, report, 10u);
+                result.memoryReport = std::move(report);
+            }
+
+            if (options.outputDir) {
+                const auto outputPath = *options.outputDir + IO::Path{path.filename()};
+                timeStage(result, "write", [&]() {
+                    game->writeMap(*world, outputPath);
+                });
+
+                if (options.exportObj) {
+                    timeStage(result, "export", [&]() {
+                        game->exportMap(*world, Model::ExportFormat::WavefrontObj, outputPath.replaceExtension("obj"));
+                    });
+                }
+            }
+
+            result.success = true;
+        } catch (const std::exception& e) {
+            logger.error() << e.what();
+        } catch (...) {
+            logger.error() << "Unknown error";
+        }
+
+        return result;
+    }
+
+    /**
+     * Processes the given maps using the given number of worker threads. Each map is loaded into its own world, so the
+     * maps can be processed independently. The results are returned in the order of the given paths.
+     */
+    static std::vector<MapResult> processMaps(const Options& options, const Model::GameConfig& config, const std::shared_ptr<Model::Game>& game) {
+        auto results = std::vector<std::optional<MapResult>>(options.mapPaths.size());
+        auto nextIndex = std::atomic<size_t>{0};
+
+        const auto numJobs = std::max(size_t(1), std::min(options.jobs, options.mapPaths.size()));
+        auto workers = std::vector<std::future<void>>{};
+        for (size_t i = 0; i < numJobs; ++i) {
+            workers.push_back(std::async(std::launch::async, [&]() {
+                while (true) {
+                    const auto index = nextIndex++;
+                    if (index >= options.mapPaths.size()) {
+                        break;
+                    }
+                    try {
+                        results[index] = processMap(options, config, game, options.mapPaths[index]);
+                    } catch (...) {
+                        // processMap reports every exception in its result, so this is only reached if the result
+                        // itself could not be created; the map is reported as failed below
+                    }
+                }
+            }));
+        }
+
+        for (auto& worker : workers) {
+            worker.wait();
+        }
+
+        auto mapResults = std::vector<MapResult>{};
+        mapResults.reserve(results.size());
+        for (size_t i = 0; i < results.size(); ++i) {
+            if (results[i].has_value()) {
+                mapResults.push_back(std::move(*results[i]));
+            } else {
+                auto failure = MapResult{};
+                failure.path = options.mapPaths[i];
+                failure.logger->error() << "Could not process map";
+                mapResults.push_back(std::move(failure));
+            }
+        }
+        return mapResults;
+    }
+
+    static void printReport(std::ostream& out, std::vector<MapResult>& results) {
+        auto totals = std::vector<StageTiming>{};
+        auto issueCount = size_t(0);
+        auto failureCount = size_t(0);
+
+        for (auto& result : results) {
+            const auto prefix = result.path.asString() + ": ";
+            result.logger->printTo(out, prefix);
+            for (const auto& issue : result.issues) {
+                out << prefix << issue << "\n";
+            }
+
+            out << prefix << (result.success ? "done" : "failed");
+            auto total = std::chrono::milliseconds{0};
+            for (const auto& timing : result.timings) {
+                out << ", " << timing.stage << " " << timing.duration.count() << "ms";
+                total += timing.duration;
+
+                auto it = std::find_if(std::begin(totals), std::end(totals), [&](const auto& t) { return t.stage == timing.stage; });
+                if (it == std::end(totals)) {
+                    totals.push_back(timing);
+                } else {
+                    it->duration += timing.duration;
+                }
+            }
+            out << ", total " << total.count() << "ms";
+            if (!result.issues.empty()) {
+                out << ", " << result.issues.size() << " issue(s)";
+            }
+            out << "\n";
+
+            if (result.memoryReport) {
+                auto str = std::stringstream{};
+                str << *result.memoryReport;
+                for (auto line = std::string{}; std::getline(str, line);) {
+                    out << prefix << line << "\n";
+                }
+            }
+
+            issueCount += result.issues.size();
+            if (!result.success) {
+                ++failureCount;
+            }
+        }
+
+        out << "Processed " << results.size() << " map(s)";
+        for (const auto& timing : totals) {
+            out << ", " << timing.stage << " " << timing.duration.count() << "ms";
+        }
+        out << "; " << failureCount << " failed, " << issueCount << " issue(s)\n";
+    }
+
+    static IO::Path absolutePath(const QString& path) {
+        return IO::pathFromQString(QFileInfo{path}.absoluteFilePath());
+    }
+
+    static std::optional<Options> parseOptions(const QCoreApplication& app) {
+        auto parser = QCommandLineParser{};
+        parser.setApplicationDescription("Loads, checks, converts and exports map files without a user interface.");
+        parser.addHelpOption();
+
+        const auto configOption = QCommandLineOption{"config", "The game configuration file (GameConfig.cfg).", "file"};
+        const auto gamePathOption = QCommandLineOption{"game-path", "The game directory, used to find mods and entity definitions.", "dir"};
+        const auto formatOption = QCommandLineOption{"format", "Convert the maps to the given map format, e.g. Valve or Quake2.", "format"};
+        const auto checkOption = QCommandLineOption{"check", "Run the issue generators on every map and report the issues."};
+        const auto failOnIssuesOption = QCommandLineOption{"fail-on-issues", "Exit with a non-zero status if any issues were found."};
+        const auto outputOption = QCommandLineOption{"output", "Write the processed maps to the given directory.", "dir"};
+        const auto exportObjOption = QCommandLineOption{"export-obj", "Also export every map as a Wavefront OBJ file to the output directory."};
+        const auto memoryOption = QCommandLineOption{"memory", "Report the memory used by every map and its largest nodes."};
+        const auto streamOption = QCommandLineOption{"stream", "Convert the maps to the format given by --format while reading them, without loading them completely."};
+        const auto jobsOption = QCommandLineOption{"jobs", "The number of maps to process concurrently.", "count", QString::number(std::max(1u, std::thread::hardware_concurrency()))};
+
+        parser.addOptions({configOption, gamePathOption, formatOption, checkOption, failOnIssuesOption, outputOption, exportObjOption, memoryOption, streamOption, jobsOption});
+        parser.addPositionalArgument("maps", "The map files to process.", "<map>...");
+        parser.process(app);
+
+        if (!parser.isSet(configOption) || parser.positionalArguments().isEmpty()) {
+            std::cerr << parser.helpText().toStdString();
+            return std::nullopt;
+        }
+
+        auto options = Options{};
+        options.configPath = absolutePath(parser.value(configOption));
+        options.gamePath = parser.isSet(gamePathOption) ? absolutePath(parser.value(gamePathOption)) : IO::Path{};
+        options.check = parser.isSet(checkOption);
+        options.failOnIssues = parser.isSet(failOnIssuesOption);
+        options.exportObj = parser.isSet(exportObjOption);
+        options.memory = parser.isSet(memoryOption);
+        options.stream = parser.isSet(streamOption);
+
+        if (parser.isSet(formatOption)) {
+            options.targetFormat = Model::formatFromName(parser.value(formatOption).toStdString());
+            if (options.targetFormat == Model::MapFormat::Unknown) {
+                std::cerr << "Unknown map format: " << parser.value(formatOption).toStdString() << "\n";
+                return std::nullopt;
+            }
+        }
+
+        if (parser.isSet(outputOption)) {
+            options.outputDir = absolutePath(parser.value(outputOption));
+        } else if (options.exportObj || options.targetFormat != Model::MapFormat::Unknown) {
+            std::cerr << "Converting or exporting maps requires an output directory\n";
+            return std::nullopt;
+        }
+
+        if (options.stream && (options.targetFormat == Model::MapFormat::Unknown || options.check || options.exportObj || options.memory)) {
+            std::cerr << "Streaming requires a map format and cannot be combined with --check, --export-obj or --memory\n";
+            return std::nullopt;
+        }
+
+        auto ok = false;
+        const auto jobs = parser.value(jobsOption).toUInt(&ok);
+        if (!ok || jobs == 0) {
+            std::cerr << "Invalid number of jobs: " << parser.value(jobsOption).toStdString() << "\n";
+            return std::nullopt;
+        }
+        options.jobs = size_t(jobs);
+
+        for (const auto& mapPath : parser.positionalArguments()) {
+            options.mapPaths.push_back(absolutePath(mapPath));
+        }
+
+        return options;
+    }
+
+    static Model::GameConfig loadGameConfig(const IO::Path& path) {
+        auto file = IO::Disk::openFile(IO::Disk::fixPath(path));
+        auto reader = file->reader().buffer();
+        auto parser = IO::GameConfigParser{reader.stringView(), path};
+        return parser.parse();
+    }
+}
+
+int main(int argc, char* argv[]) {
+    using namespace TrenchBroom;
+
+    // only QtCore is used, so this runs without a display
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("process-maps");
+
+    const auto options = parseOptions(app);
+    if (!options) {
+        return 1;
+    }
+
+    try {
+        auto config = loadGameConfig(options->configPath);
+
+        auto logger = BufferedLogger{};
+        const auto game = std::shared_ptr<Model::Game>{std::make_shared<Model::GameImpl>(config, options->gamePath, logger)};
+        logger.printTo(std::cout, "");
+
+        if (options->outputDir) {
+            IO::Disk::ensureDirectoryExists(*options->outputDir);
+        }
+
+        auto results = processMaps(*options, config, game);
+        printReport(std::cout, results);
+
+        const auto failed = std::any_of(std::begin(results), std::end(results), [](const auto& result) { return !result.success; });
+        const auto hasIssues = std::any_of(std::begin(results), std::end(results), [](const auto& result) { return !result.issues.empty(); });
+        return failed || (options->failOnIssues && hasIssues) ? 1 : 0;
+    } catch (const Exception& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+}